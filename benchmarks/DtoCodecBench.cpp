@@ -0,0 +1,327 @@
+/**
+ * @file DtoCodecBench.cpp
+ * @brief DTO 编解码微基准
+ *
+ * 逐个 DTO 对比两条路径在“解析 + 校验 + 序列化”上的耗时：
+ * - baseline：字段表 codec 引入之前的实现（QJsonDocument → QJsonObject 取值 → 手写校验 →
+ *   QJsonObject 组装 → QJsonDocument::toJson），按原代码在本文件中保留一份；
+ * - codec：Req::fromJson(body) → validate() → encodeJson()。
+ * 响应 DTO 只有序列化一步，并额外检查两条路径的输出逐字节一致。
+ *
+ * 用法：wekey-bench-codec [迭代次数]，默认 100000。建议在 Release 构建下运行。
+ */
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QTextStream>
+
+#include <functional>
+
+#include "api/dto/JsonCodec.h"
+#include "api/dto/Request.h"
+#include "api/dto/Response.h"
+
+using namespace wekey;
+using namespace wekey::api;
+
+namespace {
+
+// ==============================================================================
+// 原 QJsonDocument 路径
+// ==============================================================================
+
+Result<void> requireNonEmpty(const QString& value, const QString& field, const QString& context) {
+    if (value.isEmpty()) {
+        return Result<void>::err(Error(Error::InvalidParam, QString("字段 '%1' 不能为空").arg(field), context));
+    }
+    return Result<void>::ok();
+}
+
+bool hasField(const QJsonObject& json, const QString& field) {
+    return json.contains(field) && !json[field].toString().isEmpty();
+}
+
+bool parseObject(const QByteArray& body, QJsonObject& json) {
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(body, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        return false;
+    }
+    json = doc.object();
+    return true;
+}
+
+QByteArray baselineLogin(const QByteArray& body) {
+    QJsonObject json;
+    if (!parseObject(body, json) || !hasField(json, "serialNumber") || !hasField(json, "pin")) {
+        return {};
+    }
+    LoginRequest req;
+    req.serialNumber = json["serialNumber"].toString();
+    req.appName = json.value("appName").toString();
+    req.role = json.value("role").toString();
+    req.pin = json["pin"].toString();
+
+    if (requireNonEmpty(req.serialNumber, "serialNumber", "LoginRequest::validate").isErr() ||
+        (!req.role.isEmpty() && req.role != "user" && req.role != "admin") ||
+        requireNonEmpty(req.pin, "pin", "LoginRequest::validate").isErr()) {
+        return {};
+    }
+
+    QJsonObject out;
+    out["serialNumber"] = req.serialNumber;
+    out["appName"] = req.appName;
+    out["role"] = req.role;
+    out["pin"] = req.pin;
+    return QJsonDocument(out).toJson(QJsonDocument::Compact);
+}
+
+QByteArray baselineCsr(const QByteArray& body) {
+    QJsonObject json;
+    if (!parseObject(body, json) || !hasField(json, "serialNumber")) {
+        return {};
+    }
+    CsrRequest req;
+    req.serialNumber = json["serialNumber"].toString();
+    req.appName = json.value("appName").toString();
+    req.containerName = json.value("containerName").toString();
+    req.keyPairType = json.value("keyPairType").toString();
+    req.renew = json.value("renew").toBool(false);
+    req.cname = json.value("cname").toString();
+    req.org = json.value("org").toString();
+    req.unit = json.value("unit").toString();
+
+    const QString context = "CsrRequest::validate";
+    if (requireNonEmpty(req.serialNumber, "serialNumber", context).isErr() ||
+        requireNonEmpty(req.appName, "appName", context).isErr() ||
+        requireNonEmpty(req.containerName, "containerName", context).isErr() ||
+        requireNonEmpty(req.cname, "cname", context).isErr() || requireNonEmpty(req.org, "org", context).isErr() ||
+        requireNonEmpty(req.unit, "unit", context).isErr()) {
+        return {};
+    }
+
+    QJsonObject out;
+    out["serialNumber"] = req.serialNumber;
+    out["appName"] = req.appName;
+    out["containerName"] = req.containerName;
+    out["keyPairType"] = req.keyPairType;
+    out["renew"] = req.renew;
+    out["cname"] = req.cname;
+    out["org"] = req.org;
+    out["unit"] = req.unit;
+    return QJsonDocument(out).toJson(QJsonDocument::Compact);
+}
+
+QByteArray baselineImportCert(const QByteArray& body) {
+    QJsonObject json;
+    if (!parseObject(body, json)) {
+        return {};
+    }
+    ImportCertRequest req;
+    req.serialNumber = json["serialNumber"].toString();
+    req.appName = json["appName"].toString();
+    req.containerName = json["containerName"].toString();
+    req.sigCert = json["sigCert"].toString();
+    req.encCert = json["encCert"].toString();
+    req.encPrivate = json["encPrivate"].toString();
+    req.label = json["label"].toString();
+    req.keyAlgorithm = json["keyAlgorithm"].toString();
+    req.nonGM = json["nonGM"].toBool(false);
+
+    const QString context = "ImportCertRequest::validate";
+    if (requireNonEmpty(req.serialNumber, "serialNumber", context).isErr() ||
+        requireNonEmpty(req.appName, "appName", context).isErr() ||
+        requireNonEmpty(req.containerName, "containerName", context).isErr() ||
+        (req.sigCert.isEmpty() && req.encCert.isEmpty() && req.encPrivate.isEmpty())) {
+        return {};
+    }
+
+    QJsonObject out;
+    out["serialNumber"] = req.serialNumber;
+    out["appName"] = req.appName;
+    out["containerName"] = req.containerName;
+    out["sigCert"] = req.sigCert;
+    out["encCert"] = req.encCert;
+    out["encPrivate"] = req.encPrivate;
+    out["label"] = req.label;
+    out["keyAlgorithm"] = req.keyAlgorithm;
+    out["nonGM"] = req.nonGM;
+    return QJsonDocument(out).toJson(QJsonDocument::Compact);
+}
+
+QByteArray baselineSign(const QByteArray& body) {
+    QJsonObject json;
+    if (!parseObject(body, json)) {
+        return {};
+    }
+    SignRequest req;
+    req.serialNumber = json["serialNumber"].toString();
+    req.appName = json["appName"].toString();
+    req.containerName = json["containerName"].toString();
+    req.data = json["data"].toString().toUtf8();
+
+    const QString context = "SignRequest::validate";
+    if (requireNonEmpty(req.serialNumber, "serialNumber", context).isErr() ||
+        requireNonEmpty(req.appName, "appName", context).isErr() ||
+        requireNonEmpty(req.containerName, "containerName", context).isErr() || req.data.isEmpty()) {
+        return {};
+    }
+
+    QJsonObject out;
+    out["serialNumber"] = req.serialNumber;
+    out["appName"] = req.appName;
+    out["containerName"] = req.containerName;
+    out["data"] = QString::fromUtf8(req.data);
+    return QJsonDocument(out).toJson(QJsonDocument::Compact);
+}
+
+QByteArray baselineDeviceList(const QList<DeviceInfo>& devices) {
+    QJsonArray arr;
+    for (const auto& info : devices) {
+        QJsonObject obj;
+        obj["deviceName"] = info.deviceName;
+        obj["serialNumber"] = info.serialNumber;
+        obj["manufacturer"] = info.manufacturer;
+        obj["label"] = info.label;
+        obj["hwVersion"] = info.hardwareVersion;
+        obj["firmwareVersion"] = info.firmwareVersion;
+        obj["isLogin"] = info.isLoggedIn;
+        arr.append(obj);
+    }
+    return QJsonDocument(arr).toJson(QJsonDocument::Compact);
+}
+
+// ==============================================================================
+// 字段表 codec 路径
+// ==============================================================================
+
+template <typename T>
+QByteArray codecRequest(const QByteArray& body) {
+    auto req = T::fromJson(body);
+    if (req.isErr() || req.value().validate().isErr()) {
+        return {};
+    }
+    QByteArray out;
+    JsonWriter writer(out);
+    encodeJson(writer, req.value());
+    return out;
+}
+
+// ==============================================================================
+// 样本与计时
+// ==============================================================================
+
+QByteArray samplePem(int lines) {
+    QByteArray pem = "-----BEGIN CERTIFICATE-----\\n";
+    for (int i = 0; i < lines; ++i) {
+        pem += QByteArray(64, char('A' + i % 26)) + "\\n";
+    }
+    return pem + "-----END CERTIFICATE-----\\n";
+}
+
+QList<DeviceInfo> sampleDevices(int count) {
+    QList<DeviceInfo> devices;
+    for (int i = 0; i < count; ++i) {
+        DeviceInfo info;
+        info.deviceName = QString("TrustAsia Key %1").arg(i);
+        info.serialNumber = QString("TA%1").arg(100000 + i);
+        info.manufacturer = "TrustAsia";
+        info.label = QString("标签 \"%1\"").arg(i);
+        info.hardwareVersion = "1.2";
+        info.firmwareVersion = "3.4.5";
+        info.isLoggedIn = (i % 2) == 0;
+        devices.append(info);
+    }
+    return devices;
+}
+
+/**
+ * @brief 运行 fn 共 iterations 次，返回每次平均纳秒数；输出长度累加到 sink 防止被优化掉
+ */
+double measure(int iterations, const std::function<QByteArray()>& fn, qsizetype& sink) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        sink += fn().size();
+    }
+    return double(timer.nsecsElapsed()) / iterations;
+}
+
+struct Case {
+    const char* name;
+    std::function<QByteArray()> baseline;
+    std::function<QByteArray()> codec;
+    bool sameBytes;  ///< 两条路径的输出应逐字节一致
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = 100000;
+    if (argc > 1) {
+        iterations = QByteArray(argv[1]).toInt();
+        if (iterations <= 0) {
+            QTextStream(stderr) << "用法：wekey-bench-codec [迭代次数]\n";
+            return 2;
+        }
+    }
+
+    const QByteArray login =
+        R"({"serialNumber":"TA100001","appName":"TAGM","role":"user","pin":"12345678"})";
+    const QByteArray csr =
+        R"({"serialNumber":"TA100001","appName":"TAGM","containerName":"sign","keyPairType":"SM2_sm2p256v1",)"
+        R"("renew":true,"cname":"测试用户","org":"TrustAsia","unit":"R&D"})";
+    const QByteArray importCert =
+        R"({"serialNumber":"TA100001","appName":"TAGM","containerName":"sign","sigCert":")" + samplePem(20) +
+        R"(","encCert":")" + samplePem(20) + R"(","encPrivate":")" + QByteArray(160, 'Q') +
+        R"(","label":"","keyAlgorithm":"SM2","nonGM":false})";
+    const QByteArray sign =
+        R"({"serialNumber":"TA100001","appName":"TAGM","containerName":"sign","data":")" + QByteArray(256, 'x') +
+        R"("})";
+    const QList<DeviceInfo> devices = sampleDevices(8);
+
+    const QList<Case> cases = {
+        {"LoginRequest", [&] { return baselineLogin(login); }, [&] { return codecRequest<LoginRequest>(login); },
+         false},
+        {"CsrRequest", [&] { return baselineCsr(csr); }, [&] { return codecRequest<CsrRequest>(csr); }, false},
+        {"ImportCertRequest", [&] { return baselineImportCert(importCert); },
+         [&] { return codecRequest<ImportCertRequest>(importCert); }, false},
+        {"SignRequest", [&] { return baselineSign(sign); }, [&] { return codecRequest<SignRequest>(sign); }, false},
+        {"DeviceInfo[8]", [&] { return baselineDeviceList(devices); }, [&] { return encodeJsonList(devices); },
+         true},
+    };
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4\n")
+               .arg("DTO", -20)
+               .arg("baseline ns/op", 16)
+               .arg("codec ns/op", 14)
+               .arg("speedup", 9);
+
+    qsizetype sink = 0;
+    int failures = 0;
+    for (const auto& c : cases) {
+        const QByteArray expected = c.baseline();
+        const QByteArray actual = c.codec();
+        if (expected.isEmpty() || actual.isEmpty() || (c.sameBytes && expected != actual)) {
+            out << c.name << ": 两条路径的结果不一致，跳过\n";
+            ++failures;
+            continue;
+        }
+        // 先各跑一轮预热，再正式计时
+        measure(iterations / 10 + 1, c.baseline, sink);
+        measure(iterations / 10 + 1, c.codec, sink);
+        const double baselineNs = measure(iterations, c.baseline, sink);
+        const double codecNs = measure(iterations, c.codec, sink);
+        out << QString("%1 %2 %3 %4x\n")
+                   .arg(c.name, -20)
+                   .arg(baselineNs, 16, 'f', 1)
+                   .arg(codecNs, 14, 'f', 1)
+                   .arg(baselineNs / codecNs, 8, 'f', 2);
+    }
+    out << "(" << iterations << " 次/项, 输出共 " << sink << " 字节)\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,356 @@
+/**
+ * @file DtoCodecCheck.cpp
+ * @brief DTO 编解码行为检查
+ *
+ * 与 DtoCodecBench 配套，以原 QJsonDocument 路径为参照检查字段表 codec 的行为：
+ * - 往返：encodeJson → fromJson → encodeJson 输出不变，字符串转义与 QJsonDocument::Compact 逐字节一致；
+ * - 字符串：转义、代理对、孤立代理项（按 U+FFFD），无转义时零拷贝引用与含转义时解码结果一致；
+ * - 容错：未知键（含嵌套值）被跳过，类型不符的值按空值处理，嵌套层数上限；
+ * - 错误：畸形请求体的错误文本与原 HttpRequest::jsonBody() 相同，DtoSchema 规则的校验文本和顺序。
+ *
+ * 用法：wekey-check-codec，全部通过时返回 0，否则逐条输出失败项并返回 1。
+ */
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QList>
+#include <QTextStream>
+
+#include "api/dto/JsonCodec.h"
+#include "api/dto/Request.h"
+
+using namespace wekey;
+using namespace wekey::api;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const QString& what) {
+    if (!ok) {
+        QTextStream(stderr) << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+void checkEqual(const QString& actual, const QString& expected, const QString& what) {
+    check(actual == expected, QString("%1：期望 \"%2\"，实际 \"%3\"").arg(what, expected, actual));
+}
+
+template <typename T>
+QByteArray encode(const T& obj) {
+    QByteArray out;
+    JsonWriter writer(out);
+    encodeJson(writer, obj);
+    return out;
+}
+
+/// 原 HttpRequest::jsonBody() 对 body 给出的错误文本，QJsonDocument 接受时为空
+QString legacyParseMessage(const QByteArray& body) {
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(body, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        return QString("JSON 解析失败: %1").arg(parseError.errorString());
+    }
+    if (!doc.isObject()) {
+        return "请求体不是有效的 JSON 对象";
+    }
+    return {};
+}
+
+/// 把 value 放进单元素数组编码，与 QJsonDocument::Compact 的输出逐字节比较
+void checkStringEncoding(const QString& value, const QString& what) {
+    QByteArray out;
+    JsonWriter writer(out);
+    writer.beginArray();
+    writer.writeString(value);
+    writer.endArray();
+    const QByteArray expected = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+    check(out == expected,
+          QString("%1 编码：期望 %2，实际 %3").arg(what, QString::fromUtf8(expected), QString::fromUtf8(out)));
+}
+
+/// 解码 LoginRequest 的 serialNumber，并与 QJsonDocument 取到的值比较
+void checkStringDecoding(const QByteArray& escaped, const QString& what) {
+    const QByteArray body = R"({"serialNumber":")" + escaped + R"(","pin":"1"})";
+    auto req = LoginRequest::fromJson(body);
+    if (req.isErr()) {
+        check(false, QString("%1 解码失败：%2").arg(what, req.error().message()));
+        return;
+    }
+    const QString expected = QJsonDocument::fromJson(body).object().value("serialNumber").toString();
+    checkEqual(req.value().serialNumber, expected, what);
+}
+
+// ==============================================================================
+// 往返
+// ==============================================================================
+
+void checkRoundTrips() {
+    LoginRequest login;
+    login.serialNumber = QString::fromUtf8("TA\"100\\001/\n\t\x01 测试 \xF0\x9F\x98\x80");
+    login.appName = "TAGM";
+    login.role = "admin";
+    login.pin = "12345678";
+    const QByteArray loginJson = encode(login);
+    auto loginBack = LoginRequest::fromJson(loginJson);
+    check(loginBack.isOk(), "LoginRequest 往返解码");
+    if (loginBack.isOk()) {
+        checkEqual(loginBack.value().serialNumber, login.serialNumber, "LoginRequest.serialNumber 往返");
+        check(encode(loginBack.value()) == loginJson, "LoginRequest 二次编码输出不变");
+    }
+
+    CsrRequest csr;
+    csr.serialNumber = "TA100001";
+    csr.appName = "TAGM";
+    csr.containerName = "sign";
+    csr.keyPairType = "SM2_sm2p256v1";
+    csr.renew = true;
+    csr.cname = QString::fromUtf8("测试用户");
+    csr.org = "TrustAsia";
+    csr.unit = "R&D";
+    const QByteArray csrJson = encode(csr);
+    auto csrBack = CsrRequest::fromJson(csrJson);
+    check(csrBack.isOk() && csrBack.value().renew && encode(csrBack.value()) == csrJson, "CsrRequest 往返");
+
+    EnvelopeRequest envelope;
+    envelope.serialNumber = "TA100001";
+    envelope.appName = "TAGM";
+    envelope.containerName = "enc";
+    envelope.data = QByteArray("\x00\xff binary", 9);
+    const QByteArray envelopeJson = encode(envelope);
+    check(envelopeJson.contains(R"("data":")" + envelope.data.toBase64() + '"'), "Base64 字段按 Base64 编码");
+    auto envelopeBack = EnvelopeRequest::fromJson(envelopeJson);
+    check(envelopeBack.isOk() && envelopeBack.value().data == envelope.data, "EnvelopeRequest Base64 往返");
+
+    RandomRequest random;
+    random.serialNumber = "TA100001";
+    random.count = -42;
+    auto randomBack = RandomRequest::fromJson(encode(random));
+    check(randomBack.isOk() && randomBack.value().count == -42, "RandomRequest 负数往返");
+
+    for (const QString& value : {QString(), QString("plain"), QString::fromUtf8("中文 \xF0\x9F\x98\x80"),
+                                 QString("\"\\/\b\f\n\r\t"), QString(QChar(0x01)) + QChar(0x1f) + QChar(0x7f),
+                                 QString(QChar(0x2028)) + QChar(0x2029)}) {
+        checkStringEncoding(value, QString("字符串 \"%1\"").arg(value));
+    }
+}
+
+// ==============================================================================
+// 字符串解码
+// ==============================================================================
+
+void checkStrings() {
+    checkStringDecoding(R"(plain)", "无转义");
+    checkStringDecoding("\xE6\xB5\x8B\xE8\xAF\x95", "无转义 UTF-8");
+    checkStringDecoding(R"(a\"b\\c\/d\b\f\n\r\t)", "简单转义");
+    checkStringDecoding(R"(\u00e9\u4E2D\u0041)", "\\u 转义");
+    checkStringDecoding(R"(x\ud83d\ude00y)", "代理对");
+
+    const QString replacement(QChar(0xfffd));
+    auto lone = [](const QByteArray& escaped) {
+        auto req = LoginRequest::fromJson(R"({"serialNumber":")" + escaped + R"(","pin":"1"})");
+        return req.isOk() ? req.value().serialNumber : QString("<error>");
+    };
+    checkEqual(lone(R"(a\ud83db)"), "a" + replacement + "b", "孤立高代理项");
+    checkEqual(lone(R"(a\ude00b)"), "a" + replacement + "b", "孤立低代理项");
+    checkEqual(lone(R"(a\ud83d\u0041)"), "a" + replacement + "A", "高代理项后接非低代理项");
+    checkEqual(lone(R"(\ud83d)"), replacement, "字符串末尾的高代理项");
+
+    // 无转义走零拷贝引用，含转义走解码缓冲；两条路径结果一致，QByteArray 字段同样适用
+    auto sign = [](const QByteArray& data) {
+        auto req = SignRequest::fromJson(R"({"data":")" + data + R"("})");
+        return req.isOk() ? req.value().data : QByteArray("<error>");
+    };
+    check(sign("hello") == "hello", "SignRequest.data 零拷贝路径");
+    check(sign(R"(he\u006clo)") == "hello", "SignRequest.data 转义路径");
+    check(sign(R"(\"\\)") == "\"\\", "SignRequest.data 仅含转义");
+
+    // 含转义的键解码到缓冲区后仍能匹配字段，且相邻键之间不残留
+    auto escapedKeys = LoginRequest::fromJson(R"({"serial\u004eumber":"S","\u0070in":"P","app\u004eame":"A"})");
+    check(escapedKeys.isOk() && escapedKeys.value().serialNumber == "S" && escapedKeys.value().pin == "P" &&
+              escapedKeys.value().appName == "A",
+          "含转义的键");
+}
+
+// ==============================================================================
+// 容错：未知键、类型不符、嵌套层数
+// ==============================================================================
+
+void checkLeniency() {
+    auto unknown = LoginRequest::fromJson(
+        R"({"x":{"a":[1,2,{"b":null,"c":"}"}],"d":{}},"serialNumber":"S","y":-1.5e3,"pin":"P","z":[true,false]})");
+    check(unknown.isOk() && unknown.value().serialNumber == "S" && unknown.value().pin == "P", "跳过未知键");
+
+    auto spaced = LoginRequest::fromJson(" \r\n\t{ \"serialNumber\" : \"S\" ,\n\t\"pin\"\t:\"P\" } \n");
+    check(spaced.isOk() && spaced.value().pin == "P", "各处空白");
+
+    auto duplicate = LoginRequest::fromJson(R"({"serialNumber":"A","pin":"P","serialNumber":"B"})");
+    check(duplicate.isOk() && duplicate.value().serialNumber == "B", "重复键取最后一个");
+
+    // 类型不符按空值处理（与 QJsonValue::toXxx() 缺省值一致），随后由必填规则报告
+    auto wrongType = LoginRequest::fromJson(R"({"serialNumber":123,"pin":"P"})");
+    check(wrongType.isErr(), "serialNumber 为数字时视为缺失");
+    if (wrongType.isErr()) {
+        checkEqual(wrongType.error().message(), "缺少必填字段：serialNumber", "类型不符的必填字段");
+    }
+    auto countString = RandomRequest::fromJson(R"({"serialNumber":"S","count":"12"})");
+    check(countString.isOk() && countString.value().count == 0, "count 为字符串时为 0");
+    auto countFraction = RandomRequest::fromJson(R"({"serialNumber":"S","count":1.5})");
+    check(countFraction.isOk() && countFraction.value().count == 0, "count 为小数时为 0");
+    auto countHuge = RandomRequest::fromJson(R"({"serialNumber":"S","count":1e12})");
+    check(countHuge.isOk() && countHuge.value().count == 0, "count 超出 int 范围时为 0");
+    auto countExp = RandomRequest::fromJson(R"({"serialNumber":"S","count":2.5e2})");
+    check(countExp.isOk() && countExp.value().count == 250, "count 为整数值的指数形式");
+    auto renewString = CsrRequest::fromJson(R"({"serialNumber":"S","renew":"true"})");
+    check(renewString.isOk() && !renewString.value().renew, "renew 为字符串时为 false");
+    auto dataObject = SignRequest::fromJson(R"({"data":{"nested":"x"},"serialNumber":"S"})");
+    check(dataObject.isOk() && dataObject.value().data.isEmpty() && dataObject.value().serialNumber == "S",
+          "QByteArray 字段为对象时跳过");
+
+    // 未知值的嵌套层数上限为 64：63 层可以解析，64 层报错。QJsonDocument 的上限更高，此时使用读取器的描述
+    auto nested = [](int depth) {
+        return R"({"x":)" + QByteArray(depth, '[') + QByteArray(depth, ']') + R"(,"serialNumber":"S","pin":"P"})";
+    };
+    check(LoginRequest::fromJson(nested(63)).isOk(), "63 层嵌套");
+    auto tooDeep = LoginRequest::fromJson(nested(64));
+    check(tooDeep.isErr() && tooDeep.error().message().contains("嵌套层级过深"), "64 层嵌套报错");
+    // QJsonDocument 也拒绝时沿用其错误文本
+    const QByteArray veryDeep = nested(4096);
+    auto veryDeepResult = LoginRequest::fromJson(veryDeep);
+    const QString veryDeepLegacy = legacyParseMessage(veryDeep);
+    check(veryDeepResult.isErr(), "4096 层嵌套报错");
+    if (veryDeepResult.isErr() && !veryDeepLegacy.isEmpty()) {
+        checkEqual(veryDeepResult.error().message(), veryDeepLegacy, "4096 层嵌套的错误文本");
+    }
+}
+
+// ==============================================================================
+// 畸形请求体：错误文本与原 HttpRequest::jsonBody() 相同
+// ==============================================================================
+
+void checkMalformed() {
+    const QList<QByteArray> bodies = {
+        "",
+        "   ",
+        "{",
+        R"({"serialNumber")",
+        R"({"serialNumber":)",
+        R"({"serialNumber":"S")",
+        R"({"serialNumber":"S)",
+        R"({"serialNumber" "S"})",
+        R"({"serialNumber":"S" "pin":"P"})",
+        R"({serialNumber:"S"})",
+        R"({"serialNumber":"S"} x)",
+        R"({"serialNumber":"S"}{})",
+        R"({"x":tru})",
+        R"({"x":-})",
+        R"({"x":1.})",
+        R"({"x":[1 2]})",
+        R"({"serialNumber":"\x"})",
+        R"({"serialNumber":"\u12"})",
+        R"({"serialNumber":"\uZZZZ"})",
+        "{\"serialNumber\":\"a\nb\"}",
+        "[]",
+        "[{\"serialNumber\":\"S\"}]",
+        "\"S\"",
+        "123",
+        "null",
+        "true",
+    };
+
+    for (const QByteArray& body : bodies) {
+        const QString what = QString("畸形请求体 %1").arg(QString::fromUtf8(body).replace('\n', "\\n"));
+        auto result = LoginRequest::fromJson(body);
+        check(result.isErr(), what + " 应报错");
+        if (result.isErr()) {
+            const QString legacy = legacyParseMessage(body);
+            if (legacy.isEmpty()) {
+                check(!result.error().message().isEmpty(), what + " 的错误文本为空");
+            } else {
+                checkEqual(result.error().message(), legacy, what);
+            }
+            check(result.error().code() == Error::InvalidParam, what + " 的错误码");
+        }
+    }
+    auto array = LoginRequest::fromJson("[]");
+    check(array.isErr() && array.error().message() == "请求体不是有效的 JSON 对象", "顶层为数组");
+}
+
+// ==============================================================================
+// DtoSchema 校验规则
+// ==============================================================================
+
+template <typename T>
+void checkRejected(const QByteArray& body, const QString& expected, const QString& what) {
+    auto req = T::fromJson(body);
+    if (req.isErr()) {
+        checkEqual(req.error().message(), expected, what);
+        return;
+    }
+    auto valid = req.value().validate();
+    check(valid.isErr(), what + " 应校验失败");
+    if (valid.isErr()) {
+        checkEqual(valid.error().message(), expected, what);
+    }
+}
+
+template <typename T>
+void checkAccepted(const QByteArray& body, const QString& what) {
+    auto req = T::fromJson(body);
+    check(req.isOk() && req.value().validate().isOk(), what + " 应通过");
+}
+
+void checkValidation() {
+    // Required：解码时检查
+    checkRejected<LoginRequest>(R"({"pin":"P"})", "缺少必填字段：serialNumber", "LoginRequest 缺少 serialNumber");
+    checkRejected<LoginRequest>(R"({"serialNumber":"S","pin":""})", "缺少必填字段：pin", "LoginRequest pin 为空");
+    checkRejected<LoginRequest>("{}", "缺少必填字段：serialNumber", "必填字段按声明顺序报告");
+    checkRejected<ProvisionRequest>(R"({"fresh":true})", "缺少必填字段：plan", "ProvisionRequest 缺少 plan");
+
+    // oneOf：空值允许，非空时必须是候选之一
+    checkAccepted<LoginRequest>(R"({"serialNumber":"S","pin":"P"})", "LoginRequest role 为空");
+    checkAccepted<LoginRequest>(R"({"serialNumber":"S","pin":"P","role":"admin"})", "LoginRequest role=admin");
+    checkRejected<LoginRequest>(R"({"serialNumber":"S","pin":"P","role":"root"})", "role 必须为 'user' 或 'admin'",
+                                "LoginRequest role=root");
+
+    // NonEmpty：validate() 时检查，遇到第一个错误即返回
+    checkRejected<CsrRequest>(R"({"serialNumber":"S","containerName":"c","cname":"n","org":"o","unit":"u"})",
+                              "字段 'appName' 不能为空", "CsrRequest appName 为空");
+    checkRejected<CsrRequest>(R"({"serialNumber":"S","appName":"a","containerName":"c"})", "字段 'cname' 不能为空",
+                              "CsrRequest 多个字段为空时报告第一个");
+    checkRejected<SignRequest>(R"({"serialNumber":"S","appName":"a","containerName":"c","data":""})",
+                               "字段 'data' 不能为空", "SignRequest data 为空");
+
+    // Base64：解码后再检查非空
+    auto envelope = EnvelopeRequest::fromJson(R"({"serialNumber":"S","appName":"a","containerName":"c",)"
+                                              R"("data":"aGVsbG8="})");
+    check(envelope.isOk() && envelope.value().data == "hello", "EnvelopeRequest data 按 Base64 解码");
+    checkRejected<EnvelopeRequest>(R"({"serialNumber":"S","appName":"a","containerName":"c","data":""})",
+                                   "字段 'data' 不能为空", "EnvelopeRequest data 为空");
+
+    // atMost：上限包含在内；count <= 0 由 handler 换成默认值，不在这里报错
+    checkAccepted<RandomRequest>(R"({"serialNumber":"S","count":4096})", "RandomRequest count=4096");
+    checkAccepted<RandomRequest>(R"({"serialNumber":"S","count":-1})", "RandomRequest count=-1");
+    checkRejected<RandomRequest>(R"({"serialNumber":"S","count":4097})", "count 不能超过 4096",
+                                 "RandomRequest count=4097");
+}
+
+}  // namespace
+
+int main() {
+    checkRoundTrips();
+    checkStrings();
+    checkLeniency();
+    checkMalformed();
+    checkValidation();
+
+    if (failures > 0) {
+        QTextStream(stderr) << failures << " 项检查失败\n";
+        return 1;
+    }
+    QTextStream(stdout) << "全部检查通过\n";
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file LoggingBench.cpp
+ * @brief 调试日志按分类 / 级别过滤前后的单次签名 CPU 开销
+ *
+ * 日志级别为 Info（调试输出关闭）时对比两条路径：
+ * - before：原实现。qDebug 总是求值参数（含 digest.toHex()），消息处理器拼接文件名和行号后
+ *   交给 Logger，再由 Logger 按级别丢弃；LOG_DEBUG 总是构造 QString 后调用 Logger::debug()；
+ * - after：当前实现。qCDebug(lcSkf) 在分类关闭时不求值参数，LOG_DEBUG 先检查级别。
+ * 签名一行复现 SkfPlugin::sign（RSA 分支）中每次签名执行的全部调试输出。
+ *
+ * 用法：wekey-bench-logging [迭代次数]，默认 200000。建议在 Release 构建下运行。
+ */
+
+// 需要对比未移除的调试输出，不受 STRIP_DEBUG_LOGS 影响
+#undef QT_NO_DEBUG_OUTPUT
+#undef WEKEY_NO_DEBUG_LOG
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QList>
+#include <QTextStream>
+
+#include <functional>
+
+#include "common/LogCategories.h"
+#include "log/Logger.h"
+
+using namespace wekey;
+
+namespace {
+
+/// 一次 RSA 签名中参与调试输出的值
+struct SignTrace {
+    QString role = "user";
+    ulong containerType = 1;
+    QByteArray digest = QCryptographicHash::hash("wekey-bench-logging", QCryptographicHash::Sha256);
+    qsizetype digestInfoSize = 51;
+    quint32 signatureLength = 256;
+};
+
+/// 原 Qt 消息处理器：先拼接文件名和行号，再交给 Logger 按级别过滤
+void legacyMessageHandler(QtMsgType type, const QMessageLogContext& ctx, const QString& msg) {
+    QString location;
+    if (ctx.file && ctx.line > 0) {
+        QString file = QString::fromUtf8(ctx.file);
+        int slash = file.lastIndexOf('/');
+        if (slash < 0) slash = file.lastIndexOf('\\');
+        file = (slash >= 0) ? file.mid(slash + 1) : file;
+        location = QString(" (%1:%2)").arg(file).arg(ctx.line);
+    }
+    if (type == QtDebugMsg) {
+        Logger::instance().debug(msg + location);
+    }
+}
+
+void signLogsBefore(const SignTrace& t) {
+    qDebug() << "[sign] VerifyPIN 成功, role:" << t.role;
+    qDebug() << "[sign] containerType:" << t.containerType << "(1=RSA, 2=SM2)";
+    qDebug() << "[sign] RSA SHA-256 digest(hex):" << t.digest.toHex();
+    qDebug() << "[sign] RSA DigestInfo length:" << t.digestInfoSize;
+    qDebug() << "[sign] RSA signature length:" << t.signatureLength;
+}
+
+void signLogsAfter(const SignTrace& t) {
+    qCDebug(lcSkf) << "[sign] VerifyPIN 成功, role:" << t.role;
+    qCDebug(lcSkf) << "[sign] containerType:" << t.containerType << "(1=RSA, 2=SM2)";
+    qCDebug(lcSkf) << "[sign] RSA SHA-256 digest(hex):" << t.digest.toHex();
+    qCDebug(lcSkf) << "[sign] RSA DigestInfo length:" << t.digestInfoSize;
+    qCDebug(lcSkf) << "[sign] RSA signature length:" << t.signatureLength;
+}
+
+void logDebugBefore(const SignTrace& t) {
+    Logger::instance().debug(QString("[sign] digest: %1").arg(QString::fromLatin1(t.digest.toHex())), __FUNCTION__);
+}
+
+void logDebugAfter(const SignTrace& t) {
+    LOG_DEBUG(QString("[sign] digest: %1").arg(QString::fromLatin1(t.digest.toHex())));
+}
+
+double measure(int iterations, const std::function<void()>& fn) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return static_cast<double>(timer.nsecsElapsed()) / iterations;
+}
+
+struct Case {
+    const char* name;
+    std::function<void()> before;
+    std::function<void()> after;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = 200000;
+    if (argc > 1) {
+        iterations = QByteArray(argv[1]).toInt();
+        if (iterations <= 0) {
+            QTextStream(stderr) << "用法：wekey-bench-logging [迭代次数]\n";
+            return 2;
+        }
+    }
+
+    // 生产环境的默认级别：关闭 wekey.* 的调试分类。原实现的 qDebug 不受分类控制，
+    // 这里单独打开 default.debug 以复现其“总是求值、由 Logger 丢弃”的行为
+    Logger& logger = Logger::instance();
+    logger.setCategoryRules("default.debug=true");
+    logger.setLevel(LogLevel::Info);
+    qInstallMessageHandler(legacyMessageHandler);
+
+    const SignTrace trace;
+    const QList<Case> cases = {
+        {"sign 调试输出（5 条）", [&] { signLogsBefore(trace); }, [&] { signLogsAfter(trace); }},
+        {"LOG_DEBUG（1 条）", [&] { logDebugBefore(trace); }, [&] { logDebugAfter(trace); }},
+    };
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4\n")
+               .arg("path", -24)
+               .arg("before ns/op", 14)
+               .arg("after ns/op", 14)
+               .arg("saved ns/op", 14);
+
+    for (const auto& c : cases) {
+        // 先各跑一轮预热，再正式计时
+        measure(iterations / 10 + 1, c.before);
+        measure(iterations / 10 + 1, c.after);
+        const double beforeNs = measure(iterations, c.before);
+        const double afterNs = measure(iterations, c.after);
+        out << QString("%1 %2 %3 %4\n")
+                   .arg(QString::fromUtf8(c.name), -24)
+                   .arg(beforeNs, 14, 'f', 1)
+                   .arg(afterNs, 14, 'f', 1)
+                   .arg(beforeNs - afterNs, 14, 'f', 1);
+    }
+    out << "(" << iterations << " 次/项，日志级别 Info)\n";
+
+    qInstallMessageHandler(nullptr);
+    logger.shutdown();
+    return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file TransportBench.cpp
+ * @brief 本地套接字与回环 TCP 的请求延迟对比
+ *
+ * 在进程内启动 HttpServer，同时监听回环 TCP 端口和本地套接字，只注册 GET /health。
+ * 客户端线程在两种连接上各保持一条 keep-alive 连接，串行发送请求并记录每个请求的往返时间，
+ * 输出中位数、p99 和吞吐。两条路径经过相同的路由和工作线程池，差值即为传输层开销。
+ *
+ * 用法：wekey-bench-transport [请求数]，默认 5000。建议在 Release 构建下运行。
+ */
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QList>
+#include <QLocalSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTextStream>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "api/ApiRouter.h"
+#include "api/HttpServer.h"
+#include "api/dto/HttpTypes.h"
+#include "api/handlers/PublicHandlers.h"
+
+using namespace wekey;
+using namespace wekey::api;
+
+namespace {
+
+const QByteArray kRequest = "GET /health HTTP/1.1\r\nHost: localhost\r\nConnection: keep-alive\r\n\r\n";
+constexpr int kIoTimeoutMs = 3000;
+
+struct Stats {
+    QString error;       ///< 非空表示测量失败
+    double medianUs = 0;
+    double p99Us = 0;
+    double requestsPerSec = 0;
+};
+
+/// 从 buffer 中取出一个完整响应（按 Content-Length 判断），不足时继续读
+bool readResponse(QIODevice* device, QByteArray& buffer) {
+    for (;;) {
+        const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd >= 0) {
+            const QByteArray headers = buffer.left(headerEnd).toLower();
+            qsizetype length = 0;
+            const qsizetype at = headers.indexOf("content-length:");
+            if (at >= 0) {
+                const qsizetype lineEnd = headers.indexOf("\r\n", at);
+                length = headers.mid(at + 15, lineEnd < 0 ? -1 : lineEnd - at - 15).trimmed().toLongLong();
+            }
+            const qsizetype total = headerEnd + 4 + length;
+            if (buffer.size() >= total) {
+                buffer.remove(0, total);
+                return true;
+            }
+        }
+        if (!device->waitForReadyRead(kIoTimeoutMs)) {
+            return false;
+        }
+        buffer.append(device->readAll());
+    }
+}
+
+/// 在已连接的 device 上串行发送 warmup + rounds 个请求，统计后 rounds 个的往返时间
+Stats roundTrips(QIODevice* device, int rounds) {
+    Stats stats;
+    const int warmup = rounds / 10 + 1;
+    QList<qint64> samples;
+    samples.reserve(rounds);
+    QByteArray buffer;
+    QElapsedTimer total;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < warmup + rounds; ++i) {
+        if (i == warmup) {
+            total.start();
+        }
+        timer.start();
+        device->write(kRequest);
+        if (!device->waitForBytesWritten(kIoTimeoutMs) || !readResponse(device, buffer)) {
+            stats.error = QString("第 %1 个请求超时：%2").arg(i + 1).arg(device->errorString());
+            return stats;
+        }
+        if (i >= warmup) {
+            samples.append(timer.nsecsElapsed());
+        }
+    }
+
+    const double elapsedNs = static_cast<double>(total.nsecsElapsed());
+    std::sort(samples.begin(), samples.end());
+    stats.medianUs = samples[samples.size() / 2] / 1000.0;
+    stats.p99Us = samples[std::min<qsizetype>(samples.size() - 1, samples.size() * 99 / 100)] / 1000.0;
+    stats.requestsPerSec = rounds / (elapsedNs / 1e9);
+    return stats;
+}
+
+Stats measureTcp(quint16 port, int rounds) {
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    if (!socket.waitForConnected(kIoTimeoutMs)) {
+        return Stats{QString("连接失败：%1").arg(socket.errorString())};
+    }
+    // 与常见 HTTP 客户端一致，关闭 Nagle
+    socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    return roundTrips(&socket, rounds);
+}
+
+Stats measureLocal(const QString& path, int rounds) {
+    QLocalSocket socket;
+    socket.connectToServer(path);
+    if (!socket.waitForConnected(kIoTimeoutMs)) {
+        return Stats{QString("连接失败：%1").arg(socket.errorString())};
+    }
+    return roundTrips(&socket, rounds);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    int rounds = 5000;
+    if (argc > 1) {
+        rounds = QByteArray(argv[1]).toInt();
+        if (rounds <= 0) {
+            QTextStream(stderr) << "用法：wekey-bench-transport [请求数]\n";
+            return 2;
+        }
+    }
+
+    // 声明顺序保证 server 先于 router 析构（析构时等待在途请求）
+    ApiRouter router;
+    router.addRoute(HttpMethod::GET, "/health", PublicHandlers::handleHealth);
+    HttpServer server;
+    server.setRouter(&router);
+
+    // 端口 0 由系统分配，实际端口从底层监听器取
+    auto tcpResult = server.start(0);
+    if (tcpResult.isErr()) {
+        QTextStream(stderr) << tcpResult.error().message() << "\n";
+        return 1;
+    }
+    const quint16 port = server.server()->servers().constFirst()->serverPort();
+
+    const QString path =
+        QDir::temp().filePath(QString("wekey-bench-%1.sock").arg(QCoreApplication::applicationPid()));
+    auto localResult = server.startLocal(path);
+    if (localResult.isErr()) {
+        QTextStream(stderr) << localResult.error().message() << "\n";
+        return 1;
+    }
+
+    // 服务端在主线程事件循环中运行，客户端使用阻塞 I/O，放在单独线程
+    Stats tcp;
+    Stats local;
+    std::thread client([&] {
+        tcp = measureTcp(port, rounds);
+        local = measureLocal(path, rounds);
+        QMetaObject::invokeMethod(&app, [] { QCoreApplication::quit(); }, Qt::QueuedConnection);
+    });
+    app.exec();
+    client.join();
+    server.stop();
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4\n").arg("transport", -14).arg("median us", 12).arg("p99 us", 12).arg("req/s", 12);
+    int failures = 0;
+    const QList<std::pair<QString, Stats>> rows = {{"loopback TCP", tcp}, {"local socket", local}};
+    for (const auto& [name, stats] : rows) {
+        if (!stats.error.isEmpty()) {
+            out << name << ": " << stats.error << "\n";
+            ++failures;
+            continue;
+        }
+        out << QString("%1 %2 %3 %4\n")
+                   .arg(name, -14)
+                   .arg(stats.medianUs, 12, 'f', 1)
+                   .arg(stats.p99Us, 12, 'f', 1)
+                   .arg(stats.requestsPerSec, 12, 'f', 0);
+    }
+    if (failures == 0) {
+        out << QString("本地套接字中位延迟为回环 TCP 的 %1%\n").arg(local.medianUs / tcp.medianUs * 100, 0, 'f', 1);
+    }
+    out << "(" << rounds << " 个请求/项，单连接串行，keep-alive)\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GUI（wekey-skf）与守护进程（wekey-skfd）的启动时间 / 常驻内存对比
+#
+# 依次启动两个程序（共用单例锁，不能同时运行），记录从启动到 /health 返回 200 的时间，
+# 就绪后稍等片刻再读取 RSS，随后发送 SIGTERM 退出。每个程序运行多轮，输出中位数。
+#
+# 用法: bash benchmarks/compare_startup.sh <wekey-skf 路径> <wekey-skfd 路径> [轮数]
+#       或 cmake --build <build> --target bench-startup（BUILD_BENCHMARKS=ON 且 BUILD_GUI=ON）
+# 环境变量: WEKEY_PORT（默认 9001，需与配置中的 listenPort 一致）、SETTLE_SEC（默认 2）
+# 依赖: curl；GUI 在无显示环境下以 QT_QPA_PLATFORM=offscreen 运行
+# ==============================================================================
+
+set -euo pipefail
+
+if [ $# -lt 2 ]; then
+    echo "用法: $0 <wekey-skf> <wekey-skfd> [轮数]"
+    exit 2
+fi
+
+GUI_BIN="$1"
+DAEMON_BIN="$2"
+ROUNDS="${3:-5}"
+PORT="${WEKEY_PORT:-9001}"
+SETTLE_SEC="${SETTLE_SEC:-2}"
+TIMEOUT_SEC=30
+
+if ! command -v curl &>/dev/null; then
+    echo "ERROR: curl not found"
+    exit 1
+fi
+
+now_ms() {
+    if date +%s%N | grep -q N; then
+        # BSD date 不支持 %N
+        python3 -c 'import time; print(int(time.time() * 1000))'
+    else
+        echo $(( $(date +%s%N) / 1000000 ))
+    fi
+}
+
+rss_kb() {
+    ps -o rss= -p "$1" | tr -d ' '
+}
+
+median() {
+    sort -n | awk '{ v[NR] = $1 } END { print (NR % 2) ? v[(NR + 1) / 2] : int((v[NR / 2] + v[NR / 2 + 1]) / 2) }'
+}
+
+# 运行一轮，输出 "启动毫秒 RSS(KB)"
+run_once() {
+    local bin="$1"
+    local start pid ready rss
+
+    if curl -s -o /dev/null "http://127.0.0.1:${PORT}/health"; then
+        echo "ERROR: 端口 ${PORT} 已被占用，请先退出正在运行的实例" >&2
+        exit 1
+    fi
+
+    start=$(now_ms)
+    QT_QPA_PLATFORM="${QT_QPA_PLATFORM:-offscreen}" "$bin" >/dev/null 2>&1 &
+    pid=$!
+
+    ready=""
+    while [ $(( $(now_ms) - start )) -lt $(( TIMEOUT_SEC * 1000 )) ]; do
+        if curl -s -o /dev/null -w '%{http_code}' "http://127.0.0.1:${PORT}/health" | grep -q 200; then
+            ready=$(( $(now_ms) - start ))
+            break
+        fi
+        if ! kill -0 "$pid" 2>/dev/null; then
+            break
+        fi
+        sleep 0.01
+    done
+
+    if [ -z "$ready" ]; then
+        kill -TERM "$pid" 2>/dev/null || true
+        wait "$pid" 2>/dev/null || true
+        echo "ERROR: $bin 在 ${TIMEOUT_SEC}s 内未就绪" >&2
+        exit 1
+    fi
+
+    sleep "$SETTLE_SEC"
+    rss=$(rss_kb "$pid")
+
+    kill -TERM "$pid"
+    wait "$pid" 2>/dev/null || true
+    echo "$ready $rss"
+}
+
+measure() {
+    local name="$1" bin="$2"
+    local times="" rsses="" result
+
+    for _ in $(seq "$ROUNDS"); do
+        result=$(run_once "$bin")
+        times+="${result%% *}"$'\n'
+        rsses+="${result##* }"$'\n'
+    done
+
+    printf "%-12s %12s %12s\n" "$name" "$(printf '%s' "$times" | median)" \
+        "$(printf '%s' "$rsses" | median | awk '{ printf "%.1f", $1 / 1024 }')"
+}
+
+echo "==> ${ROUNDS} 轮，端口 ${PORT}，就绪后 ${SETTLE_SEC}s 采样 RSS"
+printf "%-12s %12s %12s\n" "binary" "ready (ms)" "RSS (MiB)"
+measure "wekey-skf" "$GUI_BIN"
+measure "wekey-skfd" "$DAEMON_BIN"
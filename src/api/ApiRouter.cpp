@@ -5,10 +5,21 @@
 
 #include "ApiRouter.h"
 
+#include <QElapsedTimer>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QUrl>
 
+#include "common/Metrics.h"
+#include "common/RequestTiming.h"
+#include "config/Config.h"
+#include "core/device/DeviceService.h"
+#include "log/Logger.h"
+
+#include "JobManager.h"
 #include "handlers/BusinessHandlers.h"
+#include "handlers/JobHandlers.h"
+#include "handlers/ProvisionHandlers.h"
 #include "handlers/PublicHandlers.h"
 
 namespace wekey {
@@ -27,54 +38,172 @@ HttpResponse makeErrorResponse(int statusCode, const QString& statusText, const
     body["message"] = message;
     body["data"] = QJsonValue::Null;
 
-    QJsonDocument doc(body);
-    resp.body = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+    resp.body = QJsonDocument(body).toJson(QJsonDocument::Compact);
     return resp;
 }
 
+/// 客户端是否请求异步执行（RFC 7240 Prefer: respond-async，或查询参数 async=1/true）
+bool wantsAsync(const HttpRequest& request) {
+    const auto prefs = request.header("Prefer").split(',');
+    for (const auto& pref : prefs) {
+        if (pref.trimmed().compare("respond-async", Qt::CaseInsensitive) == 0) {
+            return true;
+        }
+    }
+    const QString flag = request.queryParams.value("async");
+    return flag == "1" || flag.compare("true", Qt::CaseInsensitive) == 0;
+}
+
+/// 合并键中的单个片段：百分号编码后不含 ' '、'&'、'='，不同的路径和参数组合不会拼出同一个键
+QString keyPart(const QString& value) {
+    return QString::fromLatin1(QUrl::toPercentEncoding(value));
+}
+
 }  // namespace
 
+ApiRouter::~ApiRouter() {
+    for (const auto& connection : deviceConnections_) {
+        QObject::disconnect(connection);
+    }
+    // 后台任务会回调 singleFlight_，路由器销毁前必须等其结束
+    JobManager::instance().drain();
+}
+
 void ApiRouter::setupRoutes(PublicHandlers* publicHandlers) {
     // Public
     addRoute(HttpMethod::GET, "/health", PublicHandlers::handleHealth);
+    addRoute(HttpMethod::GET, "/metrics", PublicHandlers::handleMetrics);
     addRoute(HttpMethod::GET, "/exit",
              [publicHandlers](const HttpRequest& req) { return publicHandlers->handleExit(req); });
 
     // Business
-    addRoute(HttpMethod::GET, "/api/v1/enum-dev", BusinessHandlers::handleEnumDev);
+    singleFlight_.setTtl(Config::instance().readCacheTtlMs());
+    // 插拔不经过写接口，缓存的设备列表 / 证书会过时（信号来自监听线程，invalidate 自带锁）
+    auto& devices = DeviceService::instance();
+    auto invalidate = [this](const QString& /*devName*/) { singleFlight_.invalidate(); };
+    deviceConnections_.append(QObject::connect(&devices, &DeviceService::deviceInserted, invalidate));
+    deviceConnections_.append(QObject::connect(&devices, &DeviceService::deviceRemoved, invalidate));
+
+    addRoute(HttpMethod::GET, "/api/v1/enum-dev", coalesced(BusinessHandlers::handleEnumDev));
     addRoute(HttpMethod::POST, "/api/v1/login", BusinessHandlers::handleLogin);
     addRoute(HttpMethod::POST, "/api/v1/logout", BusinessHandlers::handleLogout);
-    addRoute(HttpMethod::POST, "/api/v1/csr", BusinessHandlers::handleGenCsr);
-    addRoute(HttpMethod::POST, "/api/v1/import-cert", BusinessHandlers::handleImportCert);
-    addRoute(HttpMethod::GET, "/api/v1/export-cert", BusinessHandlers::handleExportCert);
+    addRoute(HttpMethod::POST, "/api/v1/csr",
+             asyncCapable("POST /api/v1/csr", BusinessHandlers::handleGenCsr));
+    addRoute(HttpMethod::POST, "/api/v1/import-cert",
+             asyncCapable("POST /api/v1/import-cert", BusinessHandlers::handleImportCert));
+    addRoute(HttpMethod::GET, "/api/v1/export-cert", coalesced(BusinessHandlers::handleExportCert));
     addRoute(HttpMethod::POST, "/api/v1/sign", BusinessHandlers::handleSign);
+    addRoute(HttpMethod::POST, "/api/v1/encrypt", BusinessHandlers::handleEncrypt);
+    addRoute(HttpMethod::POST, "/api/v1/decrypt", BusinessHandlers::handleDecrypt);
     addRoute(HttpMethod::POST, "/api/v1/random", BusinessHandlers::handleRandom);
-
+    addRoute(HttpMethod::POST, "/api/v1/file/write",
+             asyncCapable("POST /api/v1/file/write", BusinessHandlers::handleWriteFile));
+    addRoute(HttpMethod::POST, "/api/v1/execute",
+             asyncCapable("POST /api/v1/execute", BusinessHandlers::handleExecute));
+
+    // Provision
+    addRoute(HttpMethod::POST, "/api/v1/provision", ProvisionHandlers::handleStart);
+    addRoute(HttpMethod::GET, "/api/v1/provision", ProvisionHandlers::handleStatus);
+    addRoute(HttpMethod::DELETE, "/api/v1/provision", ProvisionHandlers::handleCancel);
+
+    // Jobs
+    addRoute(HttpMethod::GET, "/api/v1/jobs/{id}", JobHandlers::handleGetJob);
+    addRoute(HttpMethod::DELETE, "/api/v1/jobs/{id}", JobHandlers::handleCancelJob);
 }
 
 void ApiRouter::addRoute(HttpMethod method, const QString& path, RouteHandler handler) {
-    routes_[makeKey(method, path)] = std::move(handler);
-    knownPaths_[path] = true;
+    int metricsId = Metrics::instance().registerRoute(httpMethodToString(method), path);
+    int routeId = static_cast<int>(routes_.size());
+    if (!table_.insert(method, path, routeId)) {
+        LOG_ERROR(QString("[ApiRouter] 路由参数过多，忽略: %1").arg(path));
+        return;
+    }
+    routes_.push_back(RouteEntry{std::move(handler), metricsId});
 }
 
 HttpResponse ApiRouter::handleRequest(const HttpRequest& request) {
-    auto key = makeKey(request.method, request.path);
-    auto it = routes_.find(key);
+    QElapsedTimer timer;
+    timer.start();
 
-    if (it != routes_.end()) {
-        return it.value()(request);
+    auto match = table_.match(request.method, request.path);
+    if (auto* timing = RequestTiming::current()) {
+        timing->add(RequestTiming::Dispatch, timer.nsecsElapsed() / 1000);
     }
 
-    if (knownPaths_.contains(request.path)) {
-        return makeErrorResponse(405, "Method Not Allowed", "method not allowed");
+    HttpResponse resp;
+    int metricsId = Metrics::unmatchedRoute();
+    if (match.routeId >= 0) {
+        const auto& route = routes_[static_cast<size_t>(match.routeId)];
+        metricsId = route.metricsId;
+        if (match.paramCount == 0) {
+            resp = route.handler(request);
+        } else {
+            // 仅带路径参数的路由需要复制请求以填充 pathParams
+            HttpRequest withParams = request;
+            for (int i = 0; i < match.paramCount; ++i) {
+                withParams.pathParams.insert(*match.names[i], match.values[i].toString());
+            }
+            resp = route.handler(withParams);
+        }
+        // 写操作可能改变设备/证书状态，丢弃只读结果缓存
+        if (request.method != HttpMethod::GET) {
+            singleFlight_.invalidate();
+        }
+    } else if (match.pathKnown) {
+        resp = makeErrorResponse(405, "Method Not Allowed", "method not allowed");
+    } else {
+        resp = makeErrorResponse(404, "Not Found", "not found");
     }
 
-    return makeErrorResponse(404, "Not Found", "not found");
+    Metrics::instance().recordRequest(metricsId, resp.statusCode, timer.nsecsElapsed() / 1000);
+    return resp;
 }
 
 QString ApiRouter::makeKey(HttpMethod method, const QString& path) {
     return httpMethodToString(method) + " " + path;
 }
 
+RouteHandler ApiRouter::coalesced(RouteHandler handler) {
+    return [this, handler = std::move(handler)](const HttpRequest& request) {
+        QString key = makeKey(request.method, keyPart(request.path));
+        for (auto it = request.queryParams.cbegin(); it != request.queryParams.cend(); ++it) {
+            key += '&' + keyPart(it.key()) + '=' + keyPart(it.value());
+        }
+        return singleFlight_.run(key, [&handler, &request]() { return handler(request); });
+    };
+}
+
+RouteHandler ApiRouter::asyncCapable(const QString& operation, RouteHandler handler) {
+    return [this, operation, handler = std::move(handler)](const HttpRequest& request) {
+        if (!wantsAsync(request)) {
+            return handler(request);
+        }
+
+        auto submitted = JobManager::instance().submit(operation, [this, handler, request]() {
+            HttpResponse result = handler(request);
+            // 提交时的失效发生在真正写入之前，完成后需再次失效
+            singleFlight_.invalidate();
+            return result;
+        });
+        if (submitted.isErr()) {
+            HttpResponse resp = makeErrorResponse(503, "Service Unavailable", submitted.error().message());
+            resp.headers["Retry-After"] = "1";
+            return resp;
+        }
+
+        const QString& jobId = submitted.value();
+        QJsonObject data;
+        data["jobId"] = jobId;
+        data["status"] = jobStatusToString(JobStatus::Queued);
+
+        HttpResponse resp;
+        resp.setSuccess(data);
+        resp.statusCode = 202;
+        resp.statusText = "Accepted";
+        resp.headers["Location"] = "/api/v1/jobs/" + jobId;
+        return resp;
+    };
+}
+
 }  // namespace api
 }  // namespace wekey
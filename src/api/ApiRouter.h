@@ -7,10 +7,14 @@
 
 #pragma once
 
-#include <QMap>
+#include <QList>
+#include <QMetaObject>
 #include <QString>
 #include <functional>
+#include <vector>
 
+#include "RouteTable.h"
+#include "SingleFlight.h"
 #include "dto/HttpTypes.h"
 
 namespace wekey {
@@ -26,24 +30,29 @@ using RouteHandler = std::function<HttpResponse(const HttpRequest&)>;
 /**
  * @brief API 路由器
  *
- * 维护 method+path -> handler 的映射表
+ * 维护 method+path -> handler 的映射表。路由在启动时编译为按路径段组织的前缀树，
+ * 支持 {param} 路径参数，分发时不分配堆内存（带参数路由填充 pathParams 除外）。
  */
 class ApiRouter {
 public:
     ApiRouter() = default;
+    ~ApiRouter();
+
+    ApiRouter(const ApiRouter&) = delete;
+    ApiRouter& operator=(const ApiRouter&) = delete;
 
-    /**
-     * @brief 添加路由
-     * @param method HTTP 方法
-     * @param path 路径
-     * @param handler 处理函数
-     */
     /**
      * @brief 注册所有 API 路由
      * @param publicHandlers 公共处理器实例（用于 /exit 信号）
      */
     void setupRoutes(PublicHandlers* publicHandlers);
 
+    /**
+     * @brief 添加路由
+     * @param method HTTP 方法
+     * @param path 路径模板，可包含 {param} 段，如 /api/v1/jobs/{id}
+     * @param handler 处理函数
+     */
     void addRoute(HttpMethod method, const QString& path, RouteHandler handler);
 
     /**
@@ -55,14 +64,35 @@ public:
 
 private:
     /**
-     * @brief 路由键: "METHOD /path"
+     * @brief 请求键: "METHOD /path"（用于只读请求合并）
      */
     static QString makeKey(HttpMethod method, const QString& path);
 
-    // method+path -> handler
-    QMap<QString, RouteHandler> routes_;
-    // path -> 是否存在（用于区分 404 和 405）
-    QMap<QString, bool> knownPaths_;
+    /**
+     * @brief 包装幂等只读处理器：并发的相同请求（方法 + 路径 + 查询参数）只执行一次
+     */
+    RouteHandler coalesced(RouteHandler handler);
+
+    /**
+     * @brief 包装耗时写操作：请求带 "Prefer: respond-async" 或 ?async=1 时转为后台任务，
+     *        立即返回 202 和任务 ID，否则同步执行
+     * @param operation 任务描述（如 "POST /api/v1/csr"）
+     */
+    RouteHandler asyncCapable(const QString& operation, RouteHandler handler);
+
+    struct RouteEntry {
+        RouteHandler handler;
+        int metricsId = 0;  ///< Metrics 路由槽位
+    };
+
+    // 路由号 -> handler
+    std::vector<RouteEntry> routes_;
+    // 路径段前缀树（区分 404 和 405）
+    RouteTable table_;
+    // 只读请求合并 / 短时结果缓存
+    SingleFlight singleFlight_;
+    // 设备插拔时清空结果缓存
+    QList<QMetaObject::Connection> deviceConnections_;
 };
 
 }  // namespace api
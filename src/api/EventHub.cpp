@@ -0,0 +1,236 @@
+/**
+ * @file EventHub.cpp
+ * @brief 服务端事件推送（SSE）实现
+ */
+
+#include "EventHub.h"
+
+#include <QJsonDocument>
+#include <QThread>
+
+#include "common/Metrics.h"
+#include "config/Defaults.h"
+#include "core/application/AppService.h"
+#include "core/device/DeviceService.h"
+#include "core/provision/ProvisionService.h"
+#include "log/Logger.h"
+
+namespace wekey {
+namespace api {
+
+namespace {
+
+QByteArray makeFrame(quint64 id, const QString& type, const QJsonObject& data) {
+    QByteArray frame;
+    frame.reserve(64 + type.size());
+    frame += "id: " + QByteArray::number(id) + '\n';
+    frame += "event: " + type.toUtf8() + '\n';
+    frame += "data: " + QJsonDocument(data).toJson(QJsonDocument::Compact) + "\n\n";
+    return frame;
+}
+
+}  // namespace
+
+EventHub::EventHub(QObject* parent) : QObject(parent) {
+    clock_.start();
+
+    flushTimer_.setSingleShot(true);
+    flushTimer_.setInterval(defaults::SSE_FLUSH_INTERVAL_MS);
+    connect(&flushTimer_, &QTimer::timeout, this, &EventHub::flush);
+
+    heartbeatTimer_.setInterval(defaults::SSE_HEARTBEAT_SEC * 1000);
+    connect(&heartbeatTimer_, &QTimer::timeout, this, &EventHub::heartbeat);
+
+    // 设备监控线程和 HTTP 工作线程发出的信号经队列连接回到本线程
+    auto& devices = DeviceService::instance();
+    connect(&devices, &DeviceService::deviceInserted, this, [this](const QString& devName) {
+        publish("device-inserted", QJsonObject{{"devName", devName}});
+    });
+    connect(&devices, &DeviceService::deviceRemoved, this, [this](const QString& devName) {
+        publish("device-removed", QJsonObject{{"devName", devName}});
+    });
+    connect(&devices, &DeviceService::deviceListChanged, this, [this]() {
+        publish("device-list-changed", QJsonObject());
+    });
+    connect(&AppService::instance(), &AppService::loginStateChanged, this,
+            [this](const QString& devName, const QString& appName, bool loggedIn) {
+                publish("login-state-changed",
+                        QJsonObject{{"devName", devName}, {"appName", appName}, {"loggedIn", loggedIn}});
+            });
+    auto& provision = ProvisionService::instance();
+    connect(&provision, &ProvisionService::deviceProgress, this,
+            [this](const QString& serialNumber, const QString& step, const QString& state, const QString& message) {
+                publish("provision-progress", QJsonObject{{"serialNumber", serialNumber},
+                                                          {"step", step},
+                                                          {"state", state},
+                                                          {"message", message}});
+            });
+    connect(&provision, &ProvisionService::runFinished, this, [this](int succeeded, int waiting, int failed) {
+        publish("provision-finished", QJsonObject{{"succeeded", succeeded}, {"waiting", waiting}, {"failed", failed}});
+    });
+}
+
+EventHub::~EventHub() {
+    for (auto& subscriber : subscribers_) {
+        close(subscriber);
+    }
+}
+
+void EventHub::subscribe(std::shared_ptr<QHttpServerResponder> responder, QHttpHeaders headers,
+                         quint64 lastEventId, QIODevice* connection) {
+    // 客户端断开后无法从 responder 得知：已知连接时在心跳中回收，否则靠订阅者上限和连接时长上限回收
+    if (static_cast<int>(subscribers_.size()) >= defaults::SSE_MAX_SUBSCRIBERS) {
+        close(subscribers_.front());
+        subscribers_.pop_front();
+    }
+
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType, "text/event-stream; charset=utf-8");
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "no-cache");
+    headers.append("X-Accel-Buffering", "no");
+    responder->writeBeginChunked(headers);
+    responder->writeChunk(": connected\nretry: 1000\n\n");
+
+    Subscriber added;
+    added.responder = std::move(responder);
+    added.connection = connection;
+    added.tracked = connection != nullptr;
+    added.openedAtMs = clock_.elapsed();
+    subscribers_.push_back(std::move(added));
+    Metrics::instance().sseSubscribed();
+    auto& subscriber = subscribers_.back();
+
+    // 断线续传：补发 Last-Event-ID 之后的历史事件，历史已淘汰的部分计为丢弃
+    if (lastEventId > 0 && !history_.empty()) {
+        if (history_.front().id > lastEventId + 1) {
+            subscriber.dropped += history_.front().id - lastEventId - 1;
+        }
+        for (const auto& entry : history_) {
+            if (entry.id > lastEventId) {
+                enqueue(subscriber, entry.frame);
+            }
+        }
+        if (!flushTimer_.isActive()) {
+            flushTimer_.start();
+        }
+    }
+
+    if (!heartbeatTimer_.isActive()) {
+        heartbeatTimer_.start();
+    }
+    LOG_DEBUG(QString("[EventHub] 新订阅者，当前 %1 个").arg(subscribers_.size()));
+}
+
+void EventHub::publish(const QString& type, const QJsonObject& data) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, [this, type, data]() { publish(type, data); }, Qt::QueuedConnection);
+        return;
+    }
+
+    const quint64 id = nextId_++;
+    QByteArray frame = makeFrame(id, type, data);
+
+    history_.push_back(HistoryEntry{id, frame});
+    while (static_cast<int>(history_.size()) > defaults::SSE_HISTORY_EVENTS) {
+        history_.pop_front();
+    }
+
+    if (subscribers_.empty()) {
+        return;
+    }
+    for (auto& subscriber : subscribers_) {
+        enqueue(subscriber, frame);
+    }
+    // 合并同一时刻的多条事件（插拔通常伴随 device-list-changed）为一次写入
+    if (!flushTimer_.isActive()) {
+        flushTimer_.start();
+    }
+}
+
+int EventHub::subscriberCount() const {
+    return static_cast<int>(subscribers_.size());
+}
+
+void EventHub::enqueue(Subscriber& subscriber, const QByteArray& frame) {
+    if (static_cast<int>(subscriber.pending.size()) >= defaults::SSE_BUFFER_EVENTS) {
+        subscriber.pending.pop_front();
+        ++subscriber.dropped;
+        Metrics::instance().recordSseDropped(1);
+    }
+    subscriber.pending.push_back(frame);
+}
+
+void EventHub::flush() {
+    bool backlog = false;
+    for (auto& subscriber : subscribers_) {
+        if (subscriber.pending.empty() && subscriber.dropped == 0) {
+            continue;
+        }
+        if (disconnected(subscriber)) {
+            continue;  // 由心跳回收
+        }
+        // 客户端读得慢：先不写，事件留在有界队列中（满了丢弃最旧的并补发 overflow），稍后重试
+        if (congested(subscriber)) {
+            backlog = true;
+            continue;
+        }
+
+        QByteArray chunk;
+        if (subscriber.dropped > 0) {
+            chunk += "event: overflow\ndata: {\"dropped\":" + QByteArray::number(subscriber.dropped) + "}\n\n";
+            subscriber.dropped = 0;
+        }
+        for (int i = 0; i < defaults::SSE_FLUSH_BATCH && !subscriber.pending.empty(); ++i) {
+            chunk += subscriber.pending.front();
+            subscriber.pending.pop_front();
+        }
+        subscriber.responder->writeChunk(chunk);
+        backlog = backlog || !subscriber.pending.empty();
+    }
+
+    if (backlog) {
+        flushTimer_.start();
+    }
+}
+
+void EventHub::heartbeat() {
+    const qint64 maxAgeMs = static_cast<qint64>(defaults::SSE_MAX_STREAM_SEC) * 1000;
+    const qint64 now = clock_.elapsed();
+
+    for (auto it = subscribers_.begin(); it != subscribers_.end();) {
+        if (disconnected(*it)) {
+            Metrics::instance().sseUnsubscribed();
+            it = subscribers_.erase(it);
+            continue;
+        }
+        if (now - it->openedAtMs >= maxAgeMs) {
+            close(*it);
+            it = subscribers_.erase(it);
+            continue;
+        }
+        // 发送缓冲未清空时连接显然仍有数据在途，不必再追加心跳
+        if (!congested(*it)) {
+            it->responder->writeChunk(": ping\n\n");
+        }
+        ++it;
+    }
+
+    if (subscribers_.empty()) {
+        heartbeatTimer_.stop();
+    }
+}
+
+bool EventHub::congested(const Subscriber& subscriber) {
+    return subscriber.connection && subscriber.connection->bytesToWrite() >= defaults::SSE_HIGH_WATER_BYTES;
+}
+
+bool EventHub::disconnected(const Subscriber& subscriber) {
+    return subscriber.tracked && (!subscriber.connection || !subscriber.connection->isOpen());
+}
+
+void EventHub::close(Subscriber& subscriber) {
+    subscriber.responder->writeEndChunked({});
+    Metrics::instance().sseUnsubscribed();
+}
+
+}  // namespace api
+}  // namespace wekey
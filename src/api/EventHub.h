@@ -0,0 +1,106 @@
+/**
+ * @file EventHub.h
+ * @brief 服务端事件推送（SSE）
+ *
+ * 将 DeviceService 的插拔事件、AppService 的登录状态变化和 ProvisionService 的批量初始化进度通过
+ * GET /api/v1/events 以 text/event-stream 推送给订阅者，替代客户端轮询 enum-dev。
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHttpHeaders>
+#include <QHttpServerResponder>
+#include <QIODevice>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <deque>
+#include <list>
+#include <memory>
+
+namespace wekey {
+namespace api {
+
+/**
+ * @brief SSE 事件分发器
+ *
+ * 所有订阅者状态只在所属线程（主线程）访问；publish() 可在任意线程调用。
+ * 每个订阅者有独立的有界待发送队列，满时丢弃最旧事件，并在下次发送前
+ * 补发一条 overflow 事件告知客户端需要重新同步。连接的发送缓冲超过高水位时暂停写入，
+ * 事件留在队列中，慢客户端不会让服务端内存无限增长。
+ */
+class EventHub : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr const char* kPath = "/api/v1/events";
+
+    explicit EventHub(QObject* parent = nullptr);
+    ~EventHub() override;
+
+    /**
+     * @brief 接管一个 SSE 连接
+     * @param responder 响应器（必须在主线程使用）
+     * @param headers 基础响应头（CORS 等）
+     * @param lastEventId 客户端 Last-Event-ID，0 表示不续传
+     * @param connection 底层连接，用于检查发送缓冲和断开；为空时只受队列上限约束
+     */
+    void subscribe(std::shared_ptr<QHttpServerResponder> responder, QHttpHeaders headers, quint64 lastEventId,
+                   QIODevice* connection = nullptr);
+
+    /**
+     * @brief 发布事件（线程安全）
+     * @param type 事件类型，如 "device-inserted"
+     * @param data 事件数据
+     */
+    void publish(const QString& type, const QJsonObject& data);
+
+    /**
+     * @brief 当前订阅者数
+     */
+    [[nodiscard]] int subscriberCount() const;
+
+private:
+    struct Subscriber {
+        std::shared_ptr<QHttpServerResponder> responder;
+        QPointer<QIODevice> connection;  ///< 底层连接（已知时），断开后自动置空
+        bool tracked = false;            ///< 订阅时是否已知底层连接
+        std::deque<QByteArray> pending;  ///< 待发送的事件帧
+        quint64 dropped = 0;             ///< 自上次发送以来丢弃的事件数
+        qint64 openedAtMs = 0;
+    };
+
+    struct HistoryEntry {
+        quint64 id;
+        QByteArray frame;
+    };
+
+    void enqueue(Subscriber& subscriber, const QByteArray& frame);
+    void flush();
+    void heartbeat();
+    void close(Subscriber& subscriber);
+
+    /**
+     * @brief 连接的发送缓冲是否已达高水位（未知连接视为未满）
+     */
+    static bool congested(const Subscriber& subscriber);
+
+    /**
+     * @brief 已知连接已断开
+     */
+    static bool disconnected(const Subscriber& subscriber);
+
+    std::list<Subscriber> subscribers_;
+    std::deque<HistoryEntry> history_;  ///< 最近事件，供断线续传
+    quint64 nextId_ = 1;
+
+    QTimer flushTimer_;
+    QTimer heartbeatTimer_;
+    QElapsedTimer clock_;
+};
+
+}  // namespace api
+}  // namespace wekey
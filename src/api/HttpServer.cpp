@@ -5,26 +5,224 @@
 
 #include "HttpServer.h"
 
+#include <QElapsedTimer>
 #include <QHttpHeaders>
 #include <QHttpServerRequest>
 #include <QHttpServerResponder>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+#include <QSemaphore>
 #include <QTcpServer>
+#include <QTcpSocket>
 #include <QUrlQuery>
-#include <QThreadPool>
 
+#include <utility>
+
+#include "common/Metrics.h"
+#include "common/RequestTiming.h"
+#include "config/Config.h"
+#include "config/Defaults.h"
 #include "dto/HttpTypes.h"
 #include "log/Logger.h"
 
 namespace wekey {
 namespace api {
 
+namespace {
+
+/**
+ * @brief CORS 响应头块
+ *
+ * 只构建一次；QHttpHeaders 隐式共享，按值复制仅增加引用计数
+ */
+const QHttpHeaders& corsHeaderBlock() {
+    static const QHttpHeaders headers = [] {
+        QHttpHeaders h;
+        h.append(QHttpHeaders::WellKnownHeader::AccessControlAllowOrigin, "*");
+        h.append(QHttpHeaders::WellKnownHeader::AccessControlAllowMethods,
+                 "GET, POST, PUT, DELETE, PATCH, OPTIONS");
+        h.append(QHttpHeaders::WellKnownHeader::AccessControlAllowHeaders,
+                 "Content-Type, Authorization, X-Requested-With, "
+                 "X-Serial-Number, X-App-Name, X-Container-Name, X-Cipher");
+        h.append(QHttpHeaders::WellKnownHeader::AccessControlMaxAge, "86400");
+        return h;
+    }();
+    return headers;
+}
+
+/**
+ * @brief 记录正在读取请求的连接
+ *
+ * 接入的连接是监听器的子对象。这里先于 QHttpServer 连接 newConnection 和 readyRead，
+ * 请求处理器在同一次 readyRead 中同步调用，此时 current 即为该请求所在的连接。
+ * 须在 QHttpServer::bind() 之前调用。
+ */
+template <typename Server, typename Socket>
+void trackConnections(Server* server, QObject* context, QPointer<QIODevice>* current) {
+    QObject::connect(server, &Server::newConnection, context, [server, context, current]() {
+        const auto sockets = server->template findChildren<Socket*>(Qt::FindDirectChildrenOnly);
+        for (Socket* socket : sockets) {
+            if (socket->property("wekeyTracked").toBool()) {
+                continue;
+            }
+            socket->setProperty("wekeyTracked", true);
+            QObject::connect(socket, &QIODevice::readyRead, context, [socket, current]() { *current = socket; });
+        }
+    });
+}
+
+/// 把处理器设置的响应头追加到 headers（Content-Type 缺省为 JSON，其余如 Location、Retry-After 原样透传）
+void appendResponseHeaders(QHttpHeaders& headers, const HttpResponse& resp) {
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType,
+                   resp.headers.value("Content-Type", "application/json; charset=utf-8"));
+    for (auto it = resp.headers.cbegin(); it != resp.headers.cend(); ++it) {
+        if (it.key().compare("Content-Type", Qt::CaseInsensitive) != 0) {
+            headers.append(it.key(), it.value());
+        }
+    }
+}
+
+/**
+ * @brief 连接的发送缓冲降到高水位以下后归还一个发送额度（主线程调用）
+ */
+void releaseWhenDrained(const QPointer<QIODevice>& connection, const std::shared_ptr<QSemaphore>& credits) {
+    if (!connection || !connection->isOpen() ||
+        connection->bytesToWrite() < defaults::HTTP_STREAM_HIGH_WATER_BYTES) {
+        credits->release();
+        return;
+    }
+
+    auto released = std::make_shared<bool>(false);
+    auto links = std::make_shared<QList<QMetaObject::Connection>>();
+    auto release = [credits, released, links]() {
+        if (*released) {
+            return;
+        }
+        *released = true;
+        for (const auto& link : std::as_const(*links)) {
+            QObject::disconnect(link);
+        }
+        credits->release();
+    };
+    QIODevice* device = connection.data();
+    links->append(QObject::connect(device, &QIODevice::bytesWritten, device, [device, release]() {
+        if (device->bytesToWrite() < defaults::HTTP_STREAM_HIGH_WATER_BYTES) {
+            release();
+        }
+    }));
+    links->append(QObject::connect(device, &QIODevice::aboutToClose, device, release));
+    links->append(QObject::connect(device, &QObject::destroyed, device, release));
+}
+
+/**
+ * @brief 流式响应的输出设备（工作线程写入）
+ *
+ * 数据攒满一块后交给主线程以 chunked 编码写出。第一块写出时才发送响应头，生成器在输出前失败时
+ * 仍可改为普通错误响应。交给主线程未写出的块数和连接的发送缓冲都有上限，客户端读得慢时
+ * 生成器在 write() 中等待，内存占用与响应大小无关。
+ */
+class ChunkedResponseWriter : public QIODevice {
+public:
+    ChunkedResponseWriter(QObject* context, std::shared_ptr<QHttpServerResponder> responder,
+                          QPointer<QIODevice> connection, QHttpHeaders headers)
+        : context_(context),
+          responder_(std::move(responder)),
+          connection_(std::move(connection)),
+          headers_(std::move(headers)),
+          credits_(std::make_shared<QSemaphore>(defaults::HTTP_STREAM_MAX_INFLIGHT)) {
+        headers_.append("Trailer", "X-Stream-Status");
+        open(QIODevice::WriteOnly);
+    }
+
+    /// 是否已发送响应头
+    [[nodiscard]] bool started() const { return started_; }
+
+    /// 取出尚未发送的数据（未开始发送时即全部输出）
+    QByteArray takeBuffer() { return std::exchange(buffer_, {}); }
+
+    /**
+     * @brief 发送剩余数据并结束响应
+     * @param tail 生成器返回的收尾响应，非 2xx 时尾部标记 X-Stream-Status: error
+     */
+    void finish(const HttpResponse& tail) {
+        bool ok = tail.statusCode < 300 && !aborted_ && sendBuffer();
+        if (!ok) {
+            buffer_.clear();
+            LOG_WARN(QString("[HttpServer] 流式响应中途失败: %1").arg(errorString()));
+        }
+        QHttpHeaders trailers;
+        trailers.append("X-Stream-Status", ok ? "ok" : "error");
+        QMetaObject::invokeMethod(context_, [responder = responder_, trailers]() {
+            responder->writeEndChunked({}, trailers);
+        });
+    }
+
+protected:
+    qint64 readData(char* /*data*/, qint64 /*maxSize*/) override { return -1; }
+
+    qint64 writeData(const char* data, qint64 len) override {
+        if (aborted_) {
+            return -1;
+        }
+        buffer_.append(data, len);
+        if (buffer_.size() >= defaults::HTTP_STREAM_CHUNK_BYTES && !sendBuffer()) {
+            return -1;
+        }
+        return len;
+    }
+
+private:
+    bool sendBuffer() {
+        if (buffer_.isEmpty()) {
+            return true;
+        }
+        if (!credits_->tryAcquire(1, defaults::HTTP_STREAM_STALL_MS)) {
+            aborted_ = true;
+            setErrorString("客户端长时间未读取，流式响应中止");
+            return false;
+        }
+        if (!started_) {
+            started_ = true;
+            QMetaObject::invokeMethod(context_, [responder = responder_, headers = headers_]() {
+                responder->writeBeginChunked(headers);
+            });
+        }
+        QMetaObject::invokeMethod(context_, [responder = responder_, connection = connection_, credits = credits_,
+                                             chunk = std::exchange(buffer_, {})]() {
+            responder->writeChunk(chunk);
+            releaseWhenDrained(connection, credits);
+        });
+        return true;
+    }
+
+    QObject* context_;
+    std::shared_ptr<QHttpServerResponder> responder_;
+    QPointer<QIODevice> connection_;
+    QHttpHeaders headers_;
+    std::shared_ptr<QSemaphore> credits_;  ///< 交给主线程、尚未确认写出的块数额度
+    QByteArray buffer_;
+    bool started_ = false;
+    bool aborted_ = false;
+};
+
+}  // namespace
+
 HttpServer::HttpServer(QObject* parent)
-    : QObject(parent), server_(new QHttpServer(this)) {}
+    : QObject(parent),
+      server_(new QHttpServer(this)),
+      pool_(new QThreadPool(this)),
+      events_(new EventHub(this)) {
+    pool_->setObjectName("HttpWorkerPool");
+    setWorkerLimits(Config::instance().httpMaxThreads(), Config::instance().httpMaxQueue());
+}
 
 HttpServer::~HttpServer() {
     if (running_) {
         stop();
     }
+    // 等待在途请求完成，避免工作线程访问已析构的 router
+    pool_->waitForDone();
 }
 
 Result<void> HttpServer::start(int port) {
@@ -49,6 +247,7 @@ Result<void> HttpServer::start(int port) {
                   "HttpServer::start"));
     }
 
+    trackConnections<QTcpServer, QTcpSocket>(tcpServer_, this, &currentConnection_);
     server_->bind(tcpServer_);
     running_ = true;
     port_ = port;
@@ -57,7 +256,49 @@ Result<void> HttpServer::start(int port) {
     return Result<void>::ok();
 }
 
+Result<void> HttpServer::startLocal(const QString& path) {
+    if (localServer_) {
+        return Result<void>::err(
+            Error(Error::Fail, "本地套接字已在监听", "HttpServer::startLocal"));
+    }
+
+    // 同名套接字仍有进程应答时不能抢占；无人应答说明是上次异常退出留下的文件，移除后才能 listen
+    {
+        QLocalSocket probe;
+        probe.connectToServer(path);
+        if (probe.waitForConnected(defaults::LISTEN_SOCKET_PROBE_MS)) {
+            probe.disconnectFromServer();
+            return Result<void>::err(
+                Error(Error::PortInUse, QString("本地套接字 %1 已有进程在监听").arg(path),
+                      "HttpServer::startLocal"));
+        }
+    }
+    QLocalServer::removeServer(path);
+
+    localServer_ = new QLocalServer(this);
+    localServer_->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!localServer_->listen(path)) {
+        QString errorMsg = localServer_->errorString();
+        delete localServer_;
+        localServer_ = nullptr;
+        return Result<void>::err(
+            Error(Error::PortInUse,
+                  QString("监听本地套接字 %1 失败：%2").arg(path, errorMsg),
+                  "HttpServer::startLocal"));
+    }
+
+    trackConnections<QLocalServer, QLocalSocket>(localServer_, this, &currentConnection_);
+    server_->bind(localServer_);
+    return Result<void>::ok();
+}
+
 void HttpServer::stop() {
+    if (localServer_) {
+        localServer_->close();
+        delete localServer_;
+        localServer_ = nullptr;
+    }
+
     if (!running_) {
         return;
     }
@@ -86,14 +327,8 @@ void HttpServer::setRouter(ApiRouter* router) {
     router_ = router;
 
     server_->setMissingHandler(this, [this](const QHttpServerRequest& req, QHttpServerResponder& responder) {
-        // 构建 CORS 响应头
-        QHttpHeaders corsHeaders;
-        corsHeaders.append(QHttpHeaders::WellKnownHeader::AccessControlAllowOrigin, "*");
-        corsHeaders.append(QHttpHeaders::WellKnownHeader::AccessControlAllowMethods,
-                           "GET, POST, PUT, DELETE, PATCH, OPTIONS");
-        corsHeaders.append(QHttpHeaders::WellKnownHeader::AccessControlAllowHeaders,
-                           "Content-Type, Authorization, X-Requested-With");
-        corsHeaders.append(QHttpHeaders::WellKnownHeader::AccessControlMaxAge, "86400");
+        // CORS 响应头（共享同一份数据，追加头部时才分离）
+        QHttpHeaders corsHeaders = corsHeaderBlock();
 
         // OPTIONS 预检请求直接返回 204（无需异步）
         if (req.method() == QHttpServerRequest::Method::Options) {
@@ -101,10 +336,39 @@ void HttpServer::setRouter(ApiRouter* router) {
             return;
         }
 
+        // SSE 长连接直接交给 EventHub，在主线程推送，不经过工作线程池
+        if (req.method() == QHttpServerRequest::Method::Get && req.url().path() == QLatin1String(EventHub::kPath)) {
+            quint64 lastEventId = QByteArray(req.headers().value("Last-Event-ID")).toULongLong();
+            events_->subscribe(std::make_shared<QHttpServerResponder>(std::move(responder)),
+                               std::move(corsHeaders), lastEventId, currentConnection_.data());
+            return;
+        }
+
+        // 准入控制：执行中 + 排队已达上限时直接拒绝，避免请求无限堆积
+        // admitted_ 仅在主线程递增，检查与递增之间不存在竞争
+        if (admitted_.load(std::memory_order_relaxed) >= pool_->maxThreadCount() + maxQueue_) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            Metrics::instance().taskRejected();
+            LOG_WARN(QString("[HttpServer] 工作队列已满，拒绝请求: %1").arg(req.url().path()));
+
+            QJsonObject body;
+            body["code"] = 503;
+            body["message"] = "server busy";
+            body["data"] = QJsonValue::Null;
+            corsHeaders.append(QHttpHeaders::WellKnownHeader::RetryAfter, "1");
+            corsHeaders.append(QHttpHeaders::WellKnownHeader::ContentType, "application/json; charset=utf-8");
+            responder.write(QJsonDocument(body).toJson(QJsonDocument::Compact), corsHeaders,
+                            QHttpServerResponder::StatusCode::ServiceUnavailable);
+            return;
+        }
+
+        // 分阶段计时：主线程提取 → 排队 → 工作线程处理 → 主线程写回
+        auto timing = std::make_shared<RequestTiming>();
+
         // 在主线程中提取请求数据（QHttpServerRequest 不可跨线程使用）
         HttpRequest httpReq;
         httpReq.path = req.url().path();
-        httpReq.body = QString::fromUtf8(req.body());
+        httpReq.body = req.body();
 
         // Convert method
         switch (req.method()) {
@@ -131,35 +395,116 @@ void HttpServer::setRouter(ApiRouter* router) {
                 QString::fromUtf8(headers.valueAt(i));
         }
 
+        timing->add(RequestTiming::Extract, timing->elapsedMicros());
+
         // 将阻塞的业务处理移到线程池中异步执行，避免阻塞主线程事件循环
         // QHttpServerResponder 底层 socket 绑定主线程，write() 必须在主线程调用
         // 因此：线程池执行业务逻辑 → QMetaObject::invokeMethod 回主线程写响应
         auto responderPtr = std::make_shared<QHttpServerResponder>(std::move(responder));
+        QPointer<QIODevice> connection = currentConnection_;
         auto* router = router_;
         auto* self = this;
 
-        QThreadPool::globalInstance()->start([httpReq = std::move(httpReq), corsHeaders = std::move(corsHeaders),
-                           responderPtr, router, self]() mutable {
+        QElapsedTimer queued;
+        queued.start();
+
+        admitted_.fetch_add(1, std::memory_order_relaxed);
+        Metrics::instance().taskQueued();
+        pool_->start([httpReq = std::move(httpReq), corsHeaders = std::move(corsHeaders),
+                      responderPtr, connection, router, self, timing, queued]() mutable {
+            self->active_.fetch_add(1, std::memory_order_relaxed);
+            Metrics::instance().taskStarted();
+            timing->add(RequestTiming::QueueWait, queued.nsecsElapsed() / 1000);
             LOG_DEBUG(QString("[HttpServer] 异步处理请求: %1").arg(httpReq.path));
 
             // 在线程池中执行路由分发和业务逻辑（可能涉及耗时的硬件操作）
-            auto httpResp = router->handleRequest(httpReq);
+            HttpResponse httpResp;
+            {
+                RequestTiming::Scope scope(timing.get());
+                httpResp = router->handleRequest(httpReq);
+            }
+
+            // 流式响应：在本工作线程生成，逐块交给主线程写出
+            bool streamed = false;
+            if (httpResp.stream) {
+                QHttpHeaders streamHeaders = corsHeaders;
+                appendResponseHeaders(streamHeaders, httpResp);
+                ChunkedResponseWriter writer(self, responderPtr, connection, std::move(streamHeaders));
+                HttpResponse tail = httpResp.stream(&writer);
+                streamed = writer.started();
+                if (streamed) {
+                    writer.finish(tail);
+                } else if (tail.statusCode < 300) {
+                    // 输出不足一块：按普通响应一次写出
+                    httpResp.body = writer.takeBuffer();
+                } else {
+                    httpResp = std::move(tail);
+                }
+                httpResp.stream = nullptr;
+            }
 
             LOG_DEBUG(QString("[HttpServer] 业务处理完成: %1 -> %2").arg(httpReq.path).arg(httpResp.statusCode));
+            Metrics::instance().taskFinished();
+            self->active_.fetch_sub(1, std::memory_order_relaxed);
+            self->admitted_.fetch_sub(1, std::memory_order_relaxed);
+            if (streamed) {
+                return;
+            }
+
+            corsHeaders.append("Server-Timing", timing->serverTimingHeader());
+            corsHeaders.append("Timing-Allow-Origin", "*");
+
+            QElapsedTimer writeBack;
+            writeBack.start();
 
             // 回到主线程写响应（QHttpServerResponder::write 必须在主线程调用）
             QMetaObject::invokeMethod(self, [responderPtr, httpResp = std::move(httpResp),
-                                              corsHeaders = std::move(corsHeaders)]() mutable {
-                QByteArray body = httpResp.body.toUtf8();
-                corsHeaders.append(QHttpHeaders::WellKnownHeader::ContentType,
-                                   "application/json; charset=utf-8");
+                                              corsHeaders = std::move(corsHeaders), timing, writeBack,
+                                              method = httpReq.method, path = httpReq.path]() mutable {
+                appendResponseHeaders(corsHeaders, httpResp);
                 auto status = static_cast<QHttpServerResponder::StatusCode>(httpResp.statusCode);
-                responderPtr->write(body, corsHeaders, status);
+                responderPtr->write(httpResp.body, corsHeaders, status);
+
+                timing->add(RequestTiming::WriteBack, writeBack.nsecsElapsed() / 1000);
+                int slowMs = Config::instance().slowRequestMs();
+                qint64 totalUs = timing->elapsedMicros();
+                if (slowMs > 0 && totalUs >= static_cast<qint64>(slowMs) * 1000) {
+                    LOG_WARN(QString("[HttpServer] 慢请求: %1 %2 -> %3, 总耗时 %4ms (%5)")
+                                 .arg(httpMethodToString(method), path)
+                                 .arg(httpResp.statusCode)
+                                 .arg(static_cast<double>(totalUs) / 1000.0, 0, 'f', 3)
+                                 .arg(timing->summary()));
+                }
             });
         });
     });
 }
 
+void HttpServer::setWorkerLimits(int maxThreads, int maxQueue) {
+    pool_->setMaxThreadCount(qMax(1, maxThreads));
+    maxQueue_ = qMax(0, maxQueue);
+}
+
+int HttpServer::queueDepth() const {
+    return qMax(0, admitted_.load(std::memory_order_relaxed) - active_.load(std::memory_order_relaxed));
+}
+
+int HttpServer::activeWorkers() const {
+    return active_.load(std::memory_order_relaxed);
+}
+
+quint64 HttpServer::rejectedCount() const {
+    return rejected_.load(std::memory_order_relaxed);
+}
+
+QString HttpServer::localPath() const {
+    return localServer_ ? localServer_->fullServerName() : QString();
+}
+
+EventHub* HttpServer::eventHub() const {
+    return events_;
+}
+
 QHttpServer* HttpServer::server() const {
     return server_;
 }
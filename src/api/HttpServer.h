@@ -8,9 +8,15 @@
 #pragma once
 
 #include <QHttpServer>
+#include <QLocalServer>
 #include <QObject>
+#include <QPointer>
+#include <QThreadPool>
+
+#include <atomic>
 
 #include "ApiRouter.h"
+#include "EventHub.h"
 #include "common/Result.h"
 
 namespace wekey {
@@ -35,6 +41,17 @@ public:
      */
     Result<void> start(int port);
 
+    /**
+     * @brief 在本地套接字上提供同一套 API（与 TCP 监听并存）
+     *
+     * 供同机客户端使用，省去回环 TCP 开销且不暴露到网络。
+     * 套接字仅当前用户可访问。同名套接字仍有进程应答时返回 PortInUse，
+     * 无人应答的残留套接字文件会先被移除。
+     * @param path Unix 域套接字路径（Windows 为命名管道名）
+     * @return Result<void> 成功或错误
+     */
+    Result<void> startLocal(const QString& path);
+
     /**
      * @brief 停止服务器
      */
@@ -45,6 +62,11 @@ public:
      */
     [[nodiscard]] bool isRunning() const;
 
+    /**
+     * @brief 本地套接字路径，未启用时为空
+     */
+    [[nodiscard]] QString localPath() const;
+
     /**
      * @brief 获取当前监听端口
      * @return 端口号，未运行时返回 0
@@ -59,6 +81,33 @@ public:
      */
     void setRouter(ApiRouter* router);
 
+    /**
+     * @brief 设置工作线程池上限
+     * @param maxThreads 最大工作线程数（>= 1）
+     * @param maxQueue 线程全忙时允许排队的请求数（>= 0），超出后返回 503
+     */
+    void setWorkerLimits(int maxThreads, int maxQueue);
+
+    /**
+     * @brief 当前排队等待工作线程的请求数
+     */
+    [[nodiscard]] int queueDepth() const;
+
+    /**
+     * @brief 当前正在执行的请求数
+     */
+    [[nodiscard]] int activeWorkers() const;
+
+    /**
+     * @brief 因队列已满被拒绝的请求总数
+     */
+    [[nodiscard]] quint64 rejectedCount() const;
+
+    /**
+     * @brief 事件推送中心（GET /api/v1/events）
+     */
+    [[nodiscard]] EventHub* eventHub() const;
+
     /**
      * @brief 获取底层 QHttpServer 指针
      */
@@ -85,7 +134,15 @@ signals:
 private:
     QHttpServer* server_ = nullptr;
     QTcpServer* tcpServer_ = nullptr;
+    QLocalServer* localServer_ = nullptr;
     ApiRouter* router_ = nullptr;
+    QThreadPool* pool_ = nullptr;       ///< HTTP 专用工作线程池
+    EventHub* events_ = nullptr;        ///< SSE 长连接，不占用工作线程
+    QPointer<QIODevice> currentConnection_;  ///< 正在读取请求的连接（仅主线程访问）
+    int maxQueue_ = 0;
+    std::atomic<int> admitted_{0};      ///< 已接纳未完成（排队 + 执行中）
+    std::atomic<int> active_{0};        ///< 执行中
+    std::atomic<quint64> rejected_{0};
     bool running_ = false;
     int port_ = 0;
 };
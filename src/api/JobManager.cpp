@@ -0,0 +1,187 @@
+/**
+ * @file JobManager.cpp
+ * @brief 异步任务管理实现
+ */
+
+#include "JobManager.h"
+
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <QUuid>
+
+#include "config/Config.h"
+#include "config/Defaults.h"
+#include "log/Logger.h"
+
+namespace wekey {
+namespace api {
+
+QString jobStatusToString(JobStatus status) {
+    switch (status) {
+        case JobStatus::Queued:
+            return "queued";
+        case JobStatus::Running:
+            return "running";
+        case JobStatus::Succeeded:
+            return "succeeded";
+        case JobStatus::Failed:
+            return "failed";
+        case JobStatus::Cancelled:
+            return "cancelled";
+    }
+    return "queued";
+}
+
+JobManager& JobManager::instance() {
+    static JobManager instance;
+    return instance;
+}
+
+JobManager::JobManager() {
+    // 硬件操作在插件内本就串行，单线程执行即可保持提交顺序
+    pool_.setMaxThreadCount(1);
+    pool_.setObjectName("JobPool");
+}
+
+JobManager::~JobManager() {
+    pool_.waitForDone();
+}
+
+bool JobManager::isFinal(JobStatus status) {
+    return status == JobStatus::Succeeded || status == JobStatus::Failed || status == JobStatus::Cancelled;
+}
+
+Result<QString> JobManager::submit(const QString& operation, std::function<HttpResponse()> work) {
+    QMutexLocker locker(&mutex_);
+    pruneLocked();
+
+    if (queued_ >= defaults::JOB_MAX_QUEUED) {
+        return Result<QString>::err(
+            Error(Error::Fail, "排队任务过多，请稍后重试", "JobManager::submit"));
+    }
+
+    auto job = std::make_shared<Job>();
+    job->snapshot.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    job->snapshot.operation = operation;
+    job->snapshot.status = JobStatus::Queued;
+    job->snapshot.createdAt = QDateTime::currentDateTime();
+    jobs_.insert(job->snapshot.id, job);
+    ++queued_;
+
+    pool_.start([this, job, work = std::move(work)]() { run(job, work); });
+
+    LOG_INFO(QString("[JobManager] 任务已提交: %1 %2").arg(job->snapshot.id, operation));
+    return Result<QString>::ok(job->snapshot.id);
+}
+
+void JobManager::run(const std::shared_ptr<Job>& job, const std::function<HttpResponse()>& work) {
+    {
+        QMutexLocker locker(&mutex_);
+        if (job->snapshot.status == JobStatus::Cancelled) {
+            return;  // 排队期间已取消，cancel() 已处理计数
+        }
+        job->snapshot.status = JobStatus::Running;
+        --queued_;
+    }
+
+    HttpResponse result = work();
+
+    QMutexLocker locker(&mutex_);
+    job->snapshot.result = std::move(result);
+    // 业务错误也可能以 HTTP 200 返回；响应可能是 JSON、CBOR 或原始二进制，以 succeeded 为准
+    bool ok = job->snapshot.result.statusCode < 400 && job->snapshot.result.succeeded;
+    job->snapshot.status = ok ? JobStatus::Succeeded : JobStatus::Failed;
+    job->snapshot.finishedAt = QDateTime::currentDateTime();
+    finishedOrder_.push_back(job->snapshot.id);
+    job->finished.wakeAll();
+
+    LOG_INFO(QString("[JobManager] 任务结束: %1 -> %2")
+                 .arg(job->snapshot.id, jobStatusToString(job->snapshot.status)));
+}
+
+Result<JobSnapshot> JobManager::get(const QString& id, int waitMs) {
+    QMutexLocker locker(&mutex_);
+    pruneLocked();
+
+    auto it = jobs_.constFind(id);
+    if (it == jobs_.constEnd()) {
+        return Result<JobSnapshot>::err(Error(Error::NotFound, "任务不存在或已过期", "JobManager::get"));
+    }
+
+    auto job = it.value();
+    if (isFinal(job->snapshot.status) || waitMs <= 0) {
+        return Result<JobSnapshot>::ok(job->snapshot);
+    }
+
+    // 等待者占用 HTTP 工作线程，数量远小于线程数，避免长轮询挤占其余请求；
+    // 线程数不足 4 时仍允许一个等待者，否则 ?wait= 会静默失效
+    const int maxWaiters =
+        qMax(1, qMin(defaults::JOB_MAX_WAITERS, Config::instance().httpMaxThreads() / 4));
+    if (waiters_ >= maxWaiters) {
+        return Result<JobSnapshot>::ok(job->snapshot);
+    }
+
+    ++waiters_;
+    QDeadlineTimer deadline(qMin(waitMs, defaults::JOB_MAX_WAIT_MS));
+    while (!isFinal(job->snapshot.status) && !deadline.hasExpired()) {
+        job->finished.wait(&mutex_, deadline);
+    }
+    --waiters_;
+    return Result<JobSnapshot>::ok(job->snapshot);
+}
+
+Result<void> JobManager::cancel(const QString& id) {
+    QMutexLocker locker(&mutex_);
+
+    auto it = jobs_.constFind(id);
+    if (it == jobs_.constEnd()) {
+        return Result<void>::err(Error(Error::NotFound, "任务不存在或已过期", "JobManager::cancel"));
+    }
+
+    auto job = it.value();
+    if (job->snapshot.status != JobStatus::Queued) {
+        return Result<void>::err(
+            Error(Error::AlreadyExists, "任务已开始执行或已结束，无法取消", "JobManager::cancel"));
+    }
+
+    job->snapshot.status = JobStatus::Cancelled;
+    job->snapshot.finishedAt = QDateTime::currentDateTime();
+    finishedOrder_.push_back(id);
+    --queued_;
+    job->finished.wakeAll();
+    return Result<void>::ok();
+}
+
+void JobManager::drain() {
+    {
+        QMutexLocker locker(&mutex_);
+        for (auto it = jobs_.cbegin(); it != jobs_.cend(); ++it) {
+            auto& job = it.value();
+            if (job->snapshot.status == JobStatus::Queued) {
+                job->snapshot.status = JobStatus::Cancelled;
+                job->snapshot.finishedAt = QDateTime::currentDateTime();
+                finishedOrder_.push_back(job->snapshot.id);
+                job->finished.wakeAll();
+            }
+        }
+        queued_ = 0;
+    }
+    pool_.waitForDone();
+}
+
+void JobManager::pruneLocked() {
+    const QDateTime expireBefore = QDateTime::currentDateTime().addSecs(-defaults::JOB_RETENTION_SEC);
+    while (!finishedOrder_.empty()) {
+        auto it = jobs_.constFind(finishedOrder_.front());
+        bool overCount = static_cast<int>(finishedOrder_.size()) > defaults::JOB_MAX_RETAINED;
+        bool expired = it == jobs_.constEnd() || it.value()->snapshot.finishedAt < expireBefore;
+        if (!overCount && !expired) {
+            break;
+        }
+        jobs_.remove(finishedOrder_.front());
+        finishedOrder_.pop_front();
+    }
+}
+
+}  // namespace api
+}  // namespace wekey
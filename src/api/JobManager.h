@@ -0,0 +1,115 @@
+/**
+ * @file JobManager.h
+ * @brief 异步任务管理
+ *
+ * 将耗时的写操作（带 renew 的 CSR、导入证书密钥、大文件写入）转为后台任务：
+ * 提交后立即返回任务 ID，客户端通过 GET /api/v1/jobs/{id} 长轮询获取结果。
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include "common/Result.h"
+#include "dto/HttpTypes.h"
+
+namespace wekey {
+namespace api {
+
+/**
+ * @brief 任务状态
+ */
+enum class JobStatus { Queued, Running, Succeeded, Failed, Cancelled };
+
+/**
+ * @brief 任务状态转字符串（queued / running / succeeded / failed / cancelled）
+ */
+QString jobStatusToString(JobStatus status);
+
+/**
+ * @brief 任务快照（对外只读副本）
+ */
+struct JobSnapshot {
+    QString id;
+    QString operation;  ///< 路由模板，如 "POST /api/v1/csr"
+    JobStatus status = JobStatus::Queued;
+    QDateTime createdAt;
+    QDateTime finishedAt;
+    HttpResponse result;  ///< 仅 Succeeded / Failed 时有效
+};
+
+/**
+ * @brief 异步任务管理器（单例）
+ *
+ * 任务在独立线程池上串行执行；已结束的任务按数量和时间双重上限淘汰。
+ */
+class JobManager {
+public:
+    static JobManager& instance();
+
+    JobManager(const JobManager&) = delete;
+    JobManager& operator=(const JobManager&) = delete;
+
+    /**
+     * @brief 提交任务
+     * @param operation 操作描述
+     * @param work 任务体，返回最终 HTTP 响应
+     * @return 任务 ID；排队任务过多时返回错误
+     */
+    Result<QString> submit(const QString& operation, std::function<HttpResponse()> work);
+
+    /**
+     * @brief 查询任务（长轮询）
+     *
+     * 等待期间占用一个 HTTP 工作线程，同时等待的请求数有上限，超出时不等待、立即返回当前状态，
+     * 客户端照常再次轮询即可。
+     * @param id 任务 ID
+     * @param waitMs 任务未结束时最多等待的毫秒数，0 表示立即返回
+     * @return 任务快照；不存在或已过期时返回 NotFound
+     */
+    Result<JobSnapshot> get(const QString& id, int waitMs);
+
+    /**
+     * @brief 取消排队中的任务
+     * @param id 任务 ID
+     * @return 已开始或已结束的任务不可取消
+     */
+    Result<void> cancel(const QString& id);
+
+    /**
+     * @brief 取消所有排队任务并等待运行中的任务结束（退出前调用）
+     */
+    void drain();
+
+private:
+    JobManager();
+    ~JobManager();
+
+    struct Job {
+        JobSnapshot snapshot;
+        QWaitCondition finished;
+    };
+
+    void run(const std::shared_ptr<Job>& job, const std::function<HttpResponse()>& work);
+    void pruneLocked();
+    static bool isFinal(JobStatus status);
+
+    QMutex mutex_;
+    QHash<QString, std::shared_ptr<Job>> jobs_;
+    std::deque<QString> finishedOrder_;  ///< 按结束先后排列，用于淘汰
+    int queued_ = 0;
+    int waiters_ = 0;  ///< 正在长轮询等待的请求数
+    QThreadPool pool_;
+};
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,151 @@
+/**
+ * @file RouteTable.cpp
+ * @brief 预编译路由表实现
+ */
+
+#include "RouteTable.h"
+
+#include <algorithm>
+
+namespace wekey {
+namespace api {
+
+namespace {
+
+/// 去掉开头的 '/'，空路径视为根
+QStringView stripLeadingSlash(QStringView path) {
+    return path.startsWith(u'/') ? path.mid(1) : path;
+}
+
+/// 取出第一个路径段，rest 指向剩余部分（不含分隔符）；无剩余时 hasMore 为 false
+QStringView takeSegment(QStringView path, QStringView& rest, bool& hasMore) {
+    qsizetype slash = path.indexOf(u'/');
+    if (slash < 0) {
+        rest = QStringView();
+        hasMore = false;
+        return path;
+    }
+    rest = path.mid(slash + 1);
+    hasMore = true;
+    return path.left(slash);
+}
+
+bool isParamSegment(QStringView segment) {
+    return segment.size() > 2 && segment.startsWith(u'{') && segment.endsWith(u'}');
+}
+
+}  // namespace
+
+RouteTable::RouteTable() {
+    nodes_.emplace_back();
+    nodes_.back().routes.fill(-1);
+}
+
+int RouteTable::literalChild(int node, QStringView segment) const {
+    const auto& literals = nodes_[node].literals;
+    auto it = std::lower_bound(literals.cbegin(), literals.cend(), segment,
+                               [](const QPair<QString, int>& entry, QStringView seg) {
+                                   return QStringView(entry.first) < seg;
+                               });
+    if (it != literals.cend() && QStringView(it->first) == segment) {
+        return it->second;
+    }
+    return -1;
+}
+
+bool RouteTable::insert(HttpMethod method, const QString& pattern, int routeId) {
+    int node = 0;
+    int params = 0;
+    QStringView rest = stripLeadingSlash(pattern);
+    bool hasMore = true;
+
+    while (hasMore) {
+        QStringView segment = takeSegment(rest, rest, hasMore);
+
+        if (isParamSegment(segment)) {
+            if (++params > kMaxParams) {
+                return false;
+            }
+            if (nodes_[node].paramChild < 0) {
+                Node child;
+                child.routes.fill(-1);
+                child.paramName = segment.mid(1, segment.size() - 2).toString();
+                nodes_.push_back(std::move(child));
+                nodes_[node].paramChild = static_cast<int>(nodes_.size()) - 1;
+            }
+            node = nodes_[node].paramChild;
+            continue;
+        }
+
+        int child = literalChild(node, segment);
+        if (child < 0) {
+            Node fresh;
+            fresh.routes.fill(-1);
+            nodes_.push_back(std::move(fresh));
+            child = static_cast<int>(nodes_.size()) - 1;
+
+            auto& literals = nodes_[node].literals;
+            auto pos = std::lower_bound(literals.begin(), literals.end(), segment,
+                                        [](const QPair<QString, int>& entry, QStringView seg) {
+                                            return QStringView(entry.first) < seg;
+                                        });
+            literals.insert(pos, qMakePair(segment.toString(), child));
+        }
+        node = child;
+    }
+
+    nodes_[node].routes[static_cast<int>(method)] = routeId;
+    nodes_[node].hasRoute = true;
+    return true;
+}
+
+RouteTable::Match RouteTable::match(HttpMethod method, QStringView path) const {
+    Match out;
+    matchFrom(0, stripLeadingSlash(path), method, out);
+    return out;
+}
+
+bool RouteTable::matchFrom(int node, QStringView rest, HttpMethod method, Match& out) const {
+    QStringView remaining;
+    bool hasMore = false;
+    QStringView segment = takeSegment(rest, remaining, hasMore);
+
+    auto visit = [&](int child) -> bool {
+        if (!hasMore) {
+            const Node& leaf = nodes_[child];
+            if (!leaf.hasRoute) {
+                return false;
+            }
+            int routeId = leaf.routes[static_cast<int>(method)];
+            if (routeId < 0) {
+                out.pathKnown = true;
+                return false;
+            }
+            out.routeId = routeId;
+            return true;
+        }
+        return matchFrom(child, remaining, method, out);
+    };
+
+    // 静态段优先
+    int literal = literalChild(node, segment);
+    if (literal >= 0 && visit(literal)) {
+        return true;
+    }
+
+    // 回退到参数段（参数值不允许为空）
+    int param = nodes_[node].paramChild;
+    if (param >= 0 && !segment.isEmpty() && out.paramCount < kMaxParams) {
+        int slot = out.paramCount++;
+        out.names[slot] = &nodes_[param].paramName;
+        out.values[slot] = segment;
+        if (visit(param)) {
+            return true;
+        }
+        --out.paramCount;
+    }
+    return false;
+}
+
+}  // namespace api
+}  // namespace wekey
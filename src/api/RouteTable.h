@@ -0,0 +1,77 @@
+/**
+ * @file RouteTable.h
+ * @brief 预编译路由表
+ *
+ * 按路径段组织的前缀树，每个节点按 HttpMethod 下标存放路由号，
+ * 支持 {param} 形式的路径参数。匹配过程只做 QStringView 比较，不分配堆内存。
+ */
+
+#pragma once
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <vector>
+
+#include "dto/HttpTypes.h"
+
+namespace wekey {
+namespace api {
+
+/**
+ * @brief 路径段前缀树
+ */
+class RouteTable {
+public:
+    static constexpr int kMethodCount = static_cast<int>(HttpMethod::OPTIONS) + 1;
+    static constexpr int kMaxParams = 8;
+
+    /**
+     * @brief 匹配结果（栈上对象，参数值为请求路径的视图）
+     */
+    struct Match {
+        int routeId = -1;        ///< 命中的路由号，-1 表示未命中
+        bool pathKnown = false;  ///< 路径存在但方法不匹配时为 true（用于返回 405）
+        int paramCount = 0;
+        std::array<const QString*, kMaxParams> names{};
+        std::array<QStringView, kMaxParams> values{};
+    };
+
+    RouteTable();
+
+    /**
+     * @brief 插入路由
+     * @param method HTTP 方法
+     * @param pattern 路由模板，如 /api/v1/devices/{sn}/containers
+     * @param routeId 调用方的路由号
+     * @return 模板参数超过 kMaxParams 时返回 false
+     */
+    bool insert(HttpMethod method, const QString& pattern, int routeId);
+
+    /**
+     * @brief 匹配请求
+     * @param method HTTP 方法
+     * @param path 请求路径
+     */
+    [[nodiscard]] Match match(HttpMethod method, QStringView path) const;
+
+private:
+    struct Node {
+        QList<QPair<QString, int>> literals;  ///< 按段名排序的静态子节点
+        int paramChild = -1;                  ///< {param} 子节点
+        QString paramName;                    ///< 本节点为参数节点时的参数名
+        std::array<int, kMethodCount> routes; ///< 按方法下标存放路由号，-1 表示无
+        bool hasRoute = false;
+    };
+
+    int literalChild(int node, QStringView segment) const;
+    bool matchFrom(int node, QStringView rest, HttpMethod method, Match& out) const;
+
+    std::vector<Node> nodes_;
+};
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,100 @@
+/**
+ * @file SingleFlight.cpp
+ * @brief 只读请求合并执行实现
+ */
+
+#include "SingleFlight.h"
+
+#include <QMutexLocker>
+
+#include "common/Metrics.h"
+#include "config/Defaults.h"
+
+namespace wekey {
+namespace api {
+
+SingleFlight::SingleFlight() {
+    clock_.start();
+}
+
+HttpResponse SingleFlight::run(const QString& key, const Producer& producer) {
+    QMutexLocker locker(&mutex_);
+
+    if (ttlMs_ > 0) {
+        auto cached = cache_.constFind(key);
+        if (cached != cache_.constEnd() && cached->expiresAt > clock_.elapsed()) {
+            Metrics::instance().recordCache(Metrics::ResponseCache, true);
+            return cached->result;
+        }
+        Metrics::instance().recordCache(Metrics::ResponseCache, false);
+    }
+
+    // 已有相同请求在执行：等待其完成并共享结果
+    auto running = inflight_.constFind(key);
+    if (running != inflight_.constEnd()) {
+        auto call = running.value();
+        Metrics::instance().recordCoalesced();
+        while (!call->finished) {
+            call->done.wait(&mutex_);
+        }
+        return call->result;
+    }
+
+    auto call = std::make_shared<Call>();
+    inflight_.insert(key, call);
+    const quint64 generation = generation_;
+
+    locker.unlock();
+    HttpResponse result = producer();
+    locker.relock();
+
+    call->result = result;
+    call->finished = true;
+    inflight_.remove(key);
+
+    // 只缓存成功结果（业务错误也以 200 返回，需看 succeeded）；期间发生过写操作则丢弃
+    if (ttlMs_ > 0 && result.statusCode == 200 && result.succeeded && generation == generation_) {
+        storeLocked(key, result);
+    }
+
+    call->done.wakeAll();
+    return result;
+}
+
+void SingleFlight::storeLocked(const QString& key, const HttpResponse& result) {
+    const qint64 now = clock_.elapsed();
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        if (it->expiresAt <= now) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!cache_.contains(key) && cache_.size() >= defaults::READ_CACHE_MAX_ENTRIES) {
+        auto oldest = cache_.begin();
+        for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+            if (it->expiresAt < oldest->expiresAt) {
+                oldest = it;
+            }
+        }
+        cache_.erase(oldest);
+    }
+
+    cache_.insert(key, Cached{result, now + ttlMs_});
+}
+
+void SingleFlight::setTtl(int ms) {
+    QMutexLocker locker(&mutex_);
+    ttlMs_ = qMax(0, ms);
+    cache_.clear();
+}
+
+void SingleFlight::invalidate() {
+    QMutexLocker locker(&mutex_);
+    ++generation_;
+    cache_.clear();
+}
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,83 @@
+/**
+ * @file SingleFlight.h
+ * @brief 只读请求合并执行
+ *
+ * 相同键的并发请求只执行一次，其余请求等待并共享同一结果；
+ * 可选地在短 TTL 内直接复用最近一次成功结果（业务 code 为 0 的 200 响应）。
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+
+#include <functional>
+#include <memory>
+
+#include "dto/HttpTypes.h"
+
+namespace wekey {
+namespace api {
+
+/**
+ * @brief 单飞（single-flight）执行器
+ *
+ * 仅用于幂等只读接口（如 enum-dev、export-cert）
+ */
+class SingleFlight {
+public:
+    using Producer = std::function<HttpResponse()>;
+
+    SingleFlight();
+
+    /**
+     * @brief 按键合并执行
+     * @param key 请求键（方法 + 路径 + 查询参数）
+     * @param producer 实际执行函数，同一键同一时刻最多执行一次
+     * @return 本次或共享的响应
+     */
+    HttpResponse run(const QString& key, const Producer& producer);
+
+    /**
+     * @brief 设置结果缓存 TTL
+     * @param ms 毫秒，0 表示只合并并发请求、不缓存结果
+     */
+    void setTtl(int ms);
+
+    /**
+     * @brief 清空结果缓存（写操作后调用）
+     *
+     * 正在执行的请求完成后也不会写入缓存
+     */
+    void invalidate();
+
+private:
+    struct Call {
+        QWaitCondition done;
+        bool finished = false;
+        HttpResponse result;
+    };
+
+    struct Cached {
+        HttpResponse result;
+        qint64 expiresAt = 0;
+    };
+
+    /**
+     * @brief 写入缓存：先清掉已过期条目，仍达到上限时淘汰最早过期的一条
+     */
+    void storeLocked(const QString& key, const HttpResponse& result);
+
+    QMutex mutex_;
+    QHash<QString, std::shared_ptr<Call>> inflight_;
+    QHash<QString, Cached> cache_;
+    QElapsedTimer clock_;
+    quint64 generation_ = 0;  ///< invalidate 递增，用于丢弃过期结果
+    int ttlMs_ = 0;
+};
+
+}  // namespace api
+}  // namespace wekey
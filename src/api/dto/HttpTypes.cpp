@@ -5,8 +5,12 @@
 
 #include "HttpTypes.h"
 
+#include <QCborMap>
+#include <QJsonArray>
 #include <QJsonDocument>
 
+#include "common/RequestTiming.h"
+
 namespace wekey {
 namespace api {
 
@@ -51,8 +55,9 @@ HttpMethod stringToHttpMethod(const QString& str) {
 // ==============================================================================
 
 Result<QJsonObject> HttpRequest::jsonBody() const {
+    RequestTiming::StageTimer timer(RequestTiming::Parse);
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(body.toUtf8(), &parseError);
+    QJsonDocument doc = QJsonDocument::fromJson(body, &parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         return Result<QJsonObject>::err(
@@ -73,94 +78,188 @@ QString HttpRequest::query(const QString& key, const QString& defaultValue) cons
     return queryParams.value(key, defaultValue);
 }
 
+QString HttpRequest::pathParam(const QString& key, const QString& defaultValue) const {
+    return pathParams.value(key, defaultValue);
+}
+
 QString HttpRequest::header(const QString& key, const QString& defaultValue) const {
-    return headers.value(key, defaultValue);
+    auto it = headers.constFind(key);
+    if (it != headers.constEnd()) {
+        return it.value();
+    }
+    // HTTP 头名称大小写不敏感
+    for (auto ci = headers.constBegin(); ci != headers.constEnd(); ++ci) {
+        if (ci.key().compare(key, Qt::CaseInsensitive) == 0) {
+            return ci.value();
+        }
+    }
+    return defaultValue;
 }
 
 // ==============================================================================
 // HttpResponse 实现
 // ==============================================================================
 
-void HttpResponse::setJson(const QJsonObject& json) {
-    statusCode = 200;
-    statusText = "OK";
-    headers["Content-Type"] = "application/json; charset=utf-8";
+namespace {
 
-    QJsonDocument doc(json);
-    body = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+/// 将 JSON 值序列化后追加到 out（标量借助单元素数组序列化再去掉方括号）
+void appendJsonValue(QByteArray& out, const QJsonValue& value) {
+    if (value.isObject()) {
+        out.append(QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact));
+    } else if (value.isArray()) {
+        out.append(QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact));
+    } else if (value.isNull() || value.isUndefined()) {
+        out.append("null");
+    } else {
+        QByteArray wrapped = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+        out.append(wrapped.constData() + 1, wrapped.size() - 2);
+    }
 }
 
-void HttpResponse::setError(const Error& error) {
-    // 根据错误码映射 HTTP 状态码
+/// 根据错误码映射 HTTP 状态码
+void applyErrorStatus(HttpResponse& resp, const Error& error) {
     switch (error.code()) {
         case Error::InvalidParam:
-            statusCode = 400;
-            statusText = "Bad Request";
+            resp.statusCode = 400;
+            resp.statusText = "Bad Request";
             break;
         case Error::NotAuthorized:
         case Error::NotLoggedIn:
-            statusCode = 401;
-            statusText = "Unauthorized";
+            resp.statusCode = 401;
+            resp.statusText = "Unauthorized";
             break;
         case Error::NotFound:
-            statusCode = 404;
-            statusText = "Not Found";
+            resp.statusCode = 404;
+            resp.statusText = "Not Found";
             break;
         case Error::AlreadyExists:
-            statusCode = 409;
-            statusText = "Conflict";
+            resp.statusCode = 409;
+            resp.statusText = "Conflict";
             break;
         default:
-            statusCode = 200;
-            statusText = "OK";
+            resp.statusCode = 200;
+            resp.statusText = "OK";
             break;
     }
+}
+
+/**
+ * @brief 直接拼接标准响应信封，避免再构建一层 QJsonObject
+ *
+ * 键序与 QJsonObject 序列化结果一致：{"code":..,"data":..,"message":".."}
+ * @param encodedData 已编码的 data 部分（紧凑 JSON 文本）
+ */
+QByteArray makeEnvelope(qint64 code, const QByteArray& encodedData, const QString& message) {
+    QByteArray out;
+    out.reserve(encodedData.size() + 64);
+    out.append("{\"code\":").append(QByteArray::number(code)).append(",\"data\":");
+    out.append(encodedData);
+    out.append(",\"message\":");
+    appendJsonValue(out, QJsonValue(message));
+    out.append('}');
+    return out;
+}
+
+QByteArray makeEnvelope(qint64 code, const QJsonValue& data, const QString& message) {
+    QByteArray encoded;
+    appendJsonValue(encoded, data);
+    return makeEnvelope(code, encoded, message);
+}
+
+}  // namespace
 
+void HttpResponse::setJson(const QJsonObject& json) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
+    statusCode = 200;
+    statusText = "OK";
+    succeeded = true;
     headers["Content-Type"] = "application/json; charset=utf-8";
 
-    QJsonObject response;
-    response["code"] = static_cast<int>(error.code());
-    response["message"] = error.friendlyMessage();
-    response["data"] = QJsonValue::Null;
+    body = QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
+void HttpResponse::setError(const Error& error) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
+    applyErrorStatus(*this, error);
+    succeeded = false;
 
-    QJsonDocument doc(response);
-    body = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+    headers["Content-Type"] = "application/json; charset=utf-8";
+    body = makeEnvelope(static_cast<qint64>(error.code()), QJsonValue::Null, error.friendlyMessage());
 }
 
 void HttpResponse::setSuccess(const QJsonObject& data) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
     statusCode = 200;
     statusText = "OK";
+    succeeded = true;
     headers["Content-Type"] = "application/json; charset=utf-8";
 
-    QJsonObject response;
-    response["code"] = 0;
-    response["message"] = "success";
+    body = makeEnvelope(0, data.isEmpty() ? QJsonValue(QJsonValue::Null) : QJsonValue(data), QStringLiteral("success"));
+}
 
-    if (data.isEmpty()) {
-        response["data"] = QJsonValue::Null;
-    } else {
-        response["data"] = data;
-    }
+void HttpResponse::setSuccess(const QJsonValue& data) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
+    statusCode = 200;
+    statusText = "OK";
+    succeeded = true;
+    headers["Content-Type"] = "application/json; charset=utf-8";
 
-    QJsonDocument doc(response);
-    body = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+    body = makeEnvelope(0, data, QStringLiteral("success"));
 }
 
-void HttpResponse::setSuccess(const QJsonValue& data) {
+void HttpResponse::setSuccessJson(const QByteArray& data) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
     statusCode = 200;
     statusText = "OK";
+    succeeded = true;
     headers["Content-Type"] = "application/json; charset=utf-8";
 
-    QJsonObject response;
-    response["code"] = 0;
-    response["message"] = "success";
-    response["data"] = data;
+    body = makeEnvelope(0, data, QStringLiteral("success"));
+}
+
+void HttpResponse::setRaw(const QByteArray& data, const QString& contentType) {
+    statusCode = 200;
+    statusText = "OK";
+    succeeded = true;
+    headers["Content-Type"] = contentType;
+    body = data;
+}
+
+void HttpResponse::setStream(std::function<HttpResponse(QIODevice* out)> writer, const QString& contentType) {
+    statusCode = 200;
+    statusText = "OK";
+    succeeded = true;
+    headers["Content-Type"] = contentType;
+    body.clear();
+    stream = std::move(writer);
+}
+
+void HttpResponse::setCborSuccess(const QCborValue& data) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
+    statusCode = 200;
+    statusText = "OK";
+    succeeded = true;
+    headers["Content-Type"] = "application/cbor";
 
-    QJsonDocument doc(response);
-    body = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+    QCborMap response;
+    response[QStringLiteral("code")] = 0;
+    response[QStringLiteral("message")] = QStringLiteral("success");
+    response[QStringLiteral("data")] = data;
+    body = response.toCborValue().toCbor();
 }
 
+void HttpResponse::setCborError(const Error& error) {
+    RequestTiming::StageTimer timer(RequestTiming::Serialize);
+    applyErrorStatus(*this, error);
+    succeeded = false;
+    headers["Content-Type"] = "application/cbor";
 
+    QCborMap response;
+    response[QStringLiteral("code")] = static_cast<qint64>(error.code());
+    response[QStringLiteral("message")] = error.friendlyMessage();
+    response[QStringLiteral("data")] = QCborValue(QCborValue::Null);
+    body = response.toCborValue().toCbor();
+}
 
 }  // namespace api
 }  // namespace wekey
@@ -7,14 +7,20 @@
 
 #pragma once
 
+#include <QByteArray>
+#include <QCborValue>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QMap>
 #include <QString>
 
+#include <functional>
+
 #include "common/Error.h"
 #include "common/Result.h"
 
+class QIODevice;
+
 namespace wekey {
 namespace api {
 
@@ -51,7 +57,8 @@ struct HttpRequest {
     QString path;
     QMap<QString, QString> headers;
     QMap<QString, QString> queryParams;
-    QString body;
+    QMap<QString, QString> pathParams;  // 路由模板中 {param} 段的取值
+    QByteArray body;                    // 原始请求体（与 QHttpServerRequest::body 隐式共享）
 
     /**
      * @brief 解析 JSON 请求体
@@ -68,7 +75,15 @@ struct HttpRequest {
     QString query(const QString& key, const QString& defaultValue = QString()) const;
 
     /**
-     * @brief 获取请求头
+     * @brief 获取路径参数
+     * @param key 参数名（路由模板中花括号内的名字）
+     * @param defaultValue 默认值
+     * @return 参数值，不存在时返回默认值
+     */
+    QString pathParam(const QString& key, const QString& defaultValue = QString()) const;
+
+    /**
+     * @brief 获取请求头（名称大小写不敏感）
      * @param key 请求头名称
      * @param defaultValue 默认值
      * @return 请求头值，不存在时返回默认值
@@ -83,7 +98,20 @@ struct HttpResponse {
     int statusCode = 200;
     QString statusText = "OK";
     QMap<QString, QString> headers;
-    QString body;
+    QByteArray body;  // UTF-8 响应体，直接交给 QHttpServerResponder::write
+
+    /**
+     * 业务是否成功：setJson / setSuccess* / setCborSuccess / setRaw / setStream 置为 true，
+     * setError / setCborError 置为 false。业务错误也可能以 HTTP 200 返回，
+     * 调用方据此判断结果，不必按 Content-Type 解析响应体。
+     */
+    bool succeeded = false;
+
+    /**
+     * 流式响应体生成器，非空时忽略 body（见 setStream）。
+     * 参数为输出设备，返回值为收尾响应：成功时为 2xx，失败时为错误响应。
+     */
+    std::function<HttpResponse(QIODevice* out)> stream;
 
     /**
      * @brief 设置 JSON 响应体
@@ -118,6 +146,44 @@ struct HttpResponse {
      */
     void setSuccess(const QJsonValue& data);
 
+    /**
+     * @brief 设置成功响应（data 为已编码的紧凑 JSON 文本，如 encodeJsonList 的结果）
+     * @param data JSON 文本，原样嵌入信封
+     */
+    void setSuccessJson(const QByteArray& data);
+
+    /**
+     * @brief 设置原始二进制响应体
+     * @param data 响应数据
+     * @param contentType Content-Type，如 application/octet-stream
+     */
+    void setRaw(const QByteArray& data, const QString& contentType);
+
+    /**
+     * @brief 设置流式响应体
+     *
+     * writer 在工作线程执行，写入的数据以 chunked 编码逐块发送，不在内存中拼出完整响应体。
+     * 输出不足一块或在输出前失败时按普通响应一次写出（失败时即 writer 返回的错误响应）；
+     * 已开始发送后失败，以尾部 X-Stream-Status: error 结束，客户端应丢弃已收到的数据。
+     * @param writer 生成器
+     * @param contentType Content-Type，如 application/octet-stream
+     */
+    void setStream(std::function<HttpResponse(QIODevice* out)> writer, const QString& contentType);
+
+    /**
+     * @brief 设置 CBOR 成功响应
+     * @param data 任意 CBOR 值
+     *
+     * 响应格式与 JSON 一致：{ "code": 0, "message": "success", "data": <data> }
+     */
+    void setCborSuccess(const QCborValue& data);
+
+    /**
+     * @brief 设置 CBOR 错误响应
+     * @param error 错误对象（HTTP 状态码映射与 setError 相同）
+     */
+    void setCborError(const Error& error);
+
 };
 
 }  // namespace api
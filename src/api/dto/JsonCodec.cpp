@@ -0,0 +1,533 @@
+/**
+ * @file JsonCodec.cpp
+ * @brief 流式 JSON 读写器实现
+ */
+
+#include "JsonCodec.h"
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+#include <cmath>
+
+namespace wekey {
+namespace api {
+
+namespace {
+
+// 跳过未知值时允许的最大嵌套层数，防止恶意请求耗尽栈空间
+constexpr int kMaxDepth = 64;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/// 读取 p 起的 4 位十六进制数（调用方保证至少有 4 字节可读）
+bool readHex4(const char* p, uint& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int digit = hexValue(p[i]);
+        if (digit < 0) {
+            return false;
+        }
+        value = (value << 4) | static_cast<uint>(digit);
+    }
+    return true;
+}
+
+void appendCodePoint(QByteArray& out, uint cp) {
+    if (cp < 0x80) {
+        out.append(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.append(static_cast<char>(0xc0 | (cp >> 6)));
+        out.append(static_cast<char>(0x80 | (cp & 0x3f)));
+    } else if (cp < 0x10000) {
+        out.append(static_cast<char>(0xe0 | (cp >> 12)));
+        out.append(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+        out.append(static_cast<char>(0x80 | (cp & 0x3f)));
+    } else {
+        out.append(static_cast<char>(0xf0 | (cp >> 18)));
+        out.append(static_cast<char>(0x80 | ((cp >> 12) & 0x3f)));
+        out.append(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+        out.append(static_cast<char>(0x80 | (cp & 0x3f)));
+    }
+}
+
+}  // namespace
+
+// ==============================================================================
+// JsonReader
+// ==============================================================================
+
+JsonReader::JsonReader(const QByteArray& data)
+    : begin_(data.constData()), end_(data.constData() + data.size()), pos_(data.constData()) {}
+
+void JsonReader::skipSpace() {
+    while (pos_ < end_ && isSpace(*pos_)) {
+        ++pos_;
+    }
+}
+
+bool JsonReader::fail(const char* what) {
+    if (error_.isEmpty()) {
+        error_ = QString("JSON 解析失败: 偏移 %1 处%2").arg(pos_ - begin_).arg(QString::fromUtf8(what));
+    }
+    pos_ = end_;
+    return false;
+}
+
+bool JsonReader::beginObject() {
+    skipSpace();
+    if (pos_ < end_ && *pos_ == '{') {
+        ++pos_;
+        first_ = true;
+        return true;
+    }
+    if (pos_ < end_ && *pos_ != '\0' && std::strchr("[\"tfn-0123456789", *pos_)) {
+        error_ = QStringLiteral("请求体不是有效的 JSON 对象");
+        pos_ = end_;
+        return false;
+    }
+    return fail("缺少 '{'");
+}
+
+bool JsonReader::nextKey(QByteArrayView& key) {
+    if (hasError()) {
+        return false;
+    }
+    skipSpace();
+    if (pos_ >= end_) {
+        return fail("对象未结束");
+    }
+    if (*pos_ == '}') {
+        ++pos_;
+        return false;
+    }
+    if (!first_) {
+        if (*pos_ != ',') {
+            return fail("缺少 ',' 或 '}'");
+        }
+        ++pos_;
+        skipSpace();
+    }
+    first_ = false;
+
+    if (pos_ >= end_ || *pos_ != '"') {
+        return fail("缺少键名");
+    }
+    ++pos_;
+    keyBuffer_.clear();
+    if (!scanString(keyBuffer_, key)) {
+        return false;
+    }
+    skipSpace();
+    if (pos_ >= end_ || *pos_ != ':') {
+        return fail("缺少 ':'");
+    }
+    ++pos_;
+    skipSpace();
+    return true;
+}
+
+bool JsonReader::scanString(QByteArray& buffer, QByteArrayView& out) {
+    // 快速路径：不含转义时直接引用原始字节
+    const char* start = pos_;
+    while (pos_ < end_) {
+        const auto c = static_cast<uchar>(*pos_);
+        if (c == '"') {
+            out = QByteArrayView(start, pos_ - start);
+            ++pos_;
+            return true;
+        }
+        if (c == '\\') {
+            break;
+        }
+        if (c < 0x20) {
+            return fail("字符串中有未转义的控制字符");
+        }
+        ++pos_;
+    }
+    if (pos_ >= end_) {
+        return fail("字符串未结束");
+    }
+
+    // 含转义：解码到 buffer
+    buffer.append(start, pos_ - start);
+    while (pos_ < end_) {
+        const auto c = static_cast<uchar>(*pos_);
+        if (c == '"') {
+            out = QByteArrayView(buffer.constData(), buffer.size());
+            ++pos_;
+            return true;
+        }
+        if (c < 0x20) {
+            return fail("字符串中有未转义的控制字符");
+        }
+        if (c != '\\') {
+            buffer.append(static_cast<char>(c));
+            ++pos_;
+            continue;
+        }
+
+        if (++pos_ >= end_) {
+            break;
+        }
+        switch (*pos_++) {
+            case '"': buffer.append('"'); break;
+            case '\\': buffer.append('\\'); break;
+            case '/': buffer.append('/'); break;
+            case 'b': buffer.append('\b'); break;
+            case 'f': buffer.append('\f'); break;
+            case 'n': buffer.append('\n'); break;
+            case 'r': buffer.append('\r'); break;
+            case 't': buffer.append('\t'); break;
+            case 'u': {
+                uint cp = 0;
+                if (end_ - pos_ < 4 || !readHex4(pos_, cp)) {
+                    return fail("无效的 \\u 转义");
+                }
+                pos_ += 4;
+                if (cp >= 0xd800 && cp <= 0xdbff) {
+                    // 高代理项后应紧跟低代理项，否则按替换字符处理
+                    uint low = 0;
+                    if (end_ - pos_ >= 6 && pos_[0] == '\\' && pos_[1] == 'u' && readHex4(pos_ + 2, low) &&
+                        low >= 0xdc00 && low <= 0xdfff) {
+                        pos_ += 6;
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                    } else {
+                        cp = 0xfffd;
+                    }
+                } else if (cp >= 0xdc00 && cp <= 0xdfff) {
+                    cp = 0xfffd;
+                }
+                appendCodePoint(buffer, cp);
+                break;
+            }
+            default:
+                --pos_;
+                return fail("无效的转义字符");
+        }
+    }
+    return fail("字符串未结束");
+}
+
+bool JsonReader::scanNumber(double* value) {
+    const char* start = pos_;
+    if (pos_ < end_ && *pos_ == '-') {
+        ++pos_;
+    }
+    if (pos_ >= end_ || !isDigit(*pos_)) {
+        return fail("无效的数字");
+    }
+    if (*pos_ == '0') {
+        ++pos_;
+    } else {
+        while (pos_ < end_ && isDigit(*pos_)) ++pos_;
+    }
+    if (pos_ < end_ && *pos_ == '.') {
+        ++pos_;
+        if (pos_ >= end_ || !isDigit(*pos_)) {
+            return fail("无效的数字");
+        }
+        while (pos_ < end_ && isDigit(*pos_)) ++pos_;
+    }
+    if (pos_ < end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+        ++pos_;
+        if (pos_ < end_ && (*pos_ == '+' || *pos_ == '-')) {
+            ++pos_;
+        }
+        if (pos_ >= end_ || !isDigit(*pos_)) {
+            return fail("无效的数字");
+        }
+        while (pos_ < end_ && isDigit(*pos_)) ++pos_;
+    }
+    if (value) {
+        bool ok = false;
+        *value = QByteArray::fromRawData(start, pos_ - start).toDouble(&ok);
+        if (!ok) {
+            *value = std::nan("");
+        }
+    }
+    return true;
+}
+
+bool JsonReader::matchLiteral(const char* literal) {
+    const size_t length = std::strlen(literal);
+    if (static_cast<size_t>(end_ - pos_) >= length && std::memcmp(pos_, literal, length) == 0) {
+        pos_ += length;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::readString(QString& out) {
+    QByteArray buffer;
+    QByteArrayView view;
+    skipSpace();
+    if (pos_ >= end_ || *pos_ != '"') {
+        skipValue();
+        return false;
+    }
+    ++pos_;
+    if (!scanString(buffer, view)) {
+        return false;
+    }
+    out = QString::fromUtf8(view.data(), view.size());
+    return true;
+}
+
+bool JsonReader::readUtf8(QByteArray& out) {
+    QByteArray buffer;
+    QByteArrayView view;
+    skipSpace();
+    if (pos_ >= end_ || *pos_ != '"') {
+        skipValue();
+        return false;
+    }
+    ++pos_;
+    if (!scanString(buffer, view)) {
+        return false;
+    }
+    out = view.data() == buffer.constData() ? buffer : QByteArray(view.data(), view.size());
+    return true;
+}
+
+bool JsonReader::readBool(bool& out) {
+    skipSpace();
+    if (matchLiteral("true")) {
+        out = true;
+        return true;
+    }
+    if (matchLiteral("false")) {
+        out = false;
+        return true;
+    }
+    skipValue();
+    return false;
+}
+
+bool JsonReader::readInt(int& out) {
+    skipSpace();
+    if (pos_ >= end_ || (*pos_ != '-' && !isDigit(*pos_))) {
+        skipValue();
+        return false;
+    }
+    double value = 0;
+    if (!scanNumber(&value)) {
+        return false;
+    }
+    // 与 QJsonValue::toInt() 一致：只接受落在 int 范围内的整数值
+    if (!(value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max()) ||
+        value != std::floor(value)) {
+        return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+bool JsonReader::skipValue() {
+    return skipValueAt(1);
+}
+
+bool JsonReader::skipValueAt(int depth) {
+    if (hasError()) {
+        return false;
+    }
+    skipSpace();
+    if (pos_ >= end_) {
+        return fail("缺少值");
+    }
+
+    QByteArray scratch;
+    QByteArrayView view;
+    const char c = *pos_;
+    if (c == '"') {
+        ++pos_;
+        return scanString(scratch, view);
+    }
+    if (c == '{' || c == '[') {
+        if (depth >= kMaxDepth) {
+            return fail("嵌套层级过深");
+        }
+        const char close = c == '{' ? '}' : ']';
+        ++pos_;
+        skipSpace();
+        if (pos_ < end_ && *pos_ == close) {
+            ++pos_;
+            return true;
+        }
+        for (;;) {
+            if (c == '{') {
+                skipSpace();
+                if (pos_ >= end_ || *pos_ != '"') {
+                    return fail("缺少键名");
+                }
+                ++pos_;
+                scratch.clear();
+                if (!scanString(scratch, view)) {
+                    return false;
+                }
+                skipSpace();
+                if (pos_ >= end_ || *pos_ != ':') {
+                    return fail("缺少 ':'");
+                }
+                ++pos_;
+            }
+            if (!skipValueAt(depth + 1)) {
+                return false;
+            }
+            skipSpace();
+            if (pos_ < end_ && *pos_ == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < end_ && *pos_ == close) {
+                ++pos_;
+                return true;
+            }
+            return fail(c == '{' ? "缺少 ',' 或 '}'" : "缺少 ',' 或 ']'");
+        }
+    }
+    if (matchLiteral("true") || matchLiteral("false") || matchLiteral("null")) {
+        return true;
+    }
+    return scanNumber(nullptr);
+}
+
+bool JsonReader::finish() {
+    if (hasError()) {
+        return false;
+    }
+    skipSpace();
+    if (pos_ != end_) {
+        return fail("对象之后有多余内容");
+    }
+    return true;
+}
+
+// ==============================================================================
+// 解码错误
+// ==============================================================================
+
+namespace detail {
+
+Error decodeError(const QByteArray& body, const JsonReader& reader) {
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(body, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        return Error(Error::InvalidParam, QString("JSON 解析失败: %1").arg(parseError.errorString()), "decodeJson");
+    }
+    if (!doc.isObject()) {
+        return Error(Error::InvalidParam, "请求体不是有效的 JSON 对象", "decodeJson");
+    }
+    return Error(Error::InvalidParam, reader.errorString(), "decodeJson");
+}
+
+}  // namespace detail
+
+// ==============================================================================
+// JsonWriter
+// ==============================================================================
+
+void JsonWriter::separator() {
+    if (needComma_) {
+        out_.append(',');
+    }
+}
+
+void JsonWriter::beginObject() {
+    separator();
+    out_.append('{');
+    needComma_ = false;
+}
+
+void JsonWriter::endObject() {
+    out_.append('}');
+    needComma_ = true;
+}
+
+void JsonWriter::beginArray() {
+    separator();
+    out_.append('[');
+    needComma_ = false;
+}
+
+void JsonWriter::endArray() {
+    out_.append(']');
+    needComma_ = true;
+}
+
+void JsonWriter::key(const char* name) {
+    separator();
+    out_.append('"').append(name).append("\":");
+    needComma_ = false;
+}
+
+void JsonWriter::writeString(const QString& value) {
+    const QByteArray utf8 = value.toUtf8();
+    writeUtf8(utf8.constData(), utf8.size());
+}
+
+void JsonWriter::writeUtf8(const char* data, qsizetype size) {
+    static const char kHex[] = "0123456789abcdef";
+
+    separator();
+    out_.append('"');
+    const char* run = data;
+    const char* end = data + size;
+    for (const char* p = data; p < end; ++p) {
+        const auto c = static_cast<uchar>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out_.append(run, p - run);
+        run = p + 1;
+        switch (c) {
+            case '"': out_.append("\\\""); break;
+            case '\\': out_.append("\\\\"); break;
+            case '\b': out_.append("\\b"); break;
+            case '\f': out_.append("\\f"); break;
+            case '\n': out_.append("\\n"); break;
+            case '\r': out_.append("\\r"); break;
+            case '\t': out_.append("\\t"); break;
+            default:
+                out_.append("\\u00").append(kHex[c >> 4]).append(kHex[c & 0xf]);
+                break;
+        }
+    }
+    out_.append(run, end - run);
+    out_.append('"');
+    needComma_ = true;
+}
+
+void JsonWriter::writeBool(bool value) {
+    separator();
+    out_.append(value ? "true" : "false");
+    needComma_ = true;
+}
+
+void JsonWriter::writeInt(qint64 value) {
+    separator();
+    out_.append(QByteArray::number(value));
+    needComma_ = true;
+}
+
+void JsonWriter::writeNull() {
+    separator();
+    out_.append("null");
+    needComma_ = true;
+}
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,443 @@
+/**
+ * @file JsonCodec.h
+ * @brief 基于字段描述符的 DTO JSON 编解码
+ *
+ * 每个 DTO 通过 DtoSchema<T> 特化在编译期声明字段表（键名、成员指针、校验规则），
+ * 解码、校验和编码均由模板按字段表生成。解码直接扫描 UTF-8 请求体，
+ * 编码直接追加到输出缓冲区，都不经过 QJsonDocument/QJsonObject。
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+#include "common/Error.h"
+#include "common/RequestTiming.h"
+#include "common/Result.h"
+
+namespace wekey {
+namespace api {
+
+// ==============================================================================
+// 流式读写器
+// ==============================================================================
+
+/**
+ * @brief 单层 JSON 对象的流式读取器
+ *
+ * 只面向 DTO 解码：顶层必须是对象，按顺序逐个读取键和值；不关心的值（包括嵌套
+ * 对象和数组）用 skipValue() 跳过。值类型与读取方法不符时跳过该值并返回 false。
+ * 出错后所有方法都返回 false，错误信息由 errorString() 给出。
+ */
+class JsonReader {
+public:
+    explicit JsonReader(const QByteArray& data);
+
+    /**
+     * @brief 读取顶层对象的 '{'
+     */
+    bool beginObject();
+
+    /**
+     * @brief 读取下一个键及其后的 ':'
+     * @param key 键的 UTF-8 字节，在下一次调用 nextKey() 前有效
+     * @return 对象结束或出错时返回 false
+     */
+    bool nextKey(QByteArrayView& key);
+
+    bool readString(QString& out);
+    bool readUtf8(QByteArray& out);
+    bool readBool(bool& out);
+    bool readInt(int& out);
+
+    /**
+     * @brief 跳过一个任意类型的值
+     */
+    bool skipValue();
+
+    /**
+     * @brief 确认对象之后只剩空白
+     */
+    bool finish();
+
+    [[nodiscard]] bool hasError() const { return !error_.isEmpty(); }
+    [[nodiscard]] QString errorString() const { return error_; }
+
+private:
+    void skipSpace();
+    bool fail(const char* what);
+    bool scanString(QByteArray& buffer, QByteArrayView& out);
+    bool scanNumber(double* value);
+    bool matchLiteral(const char* literal);
+    bool skipValueAt(int depth);
+
+    const char* begin_;
+    const char* end_;
+    const char* pos_;
+    QByteArray keyBuffer_;  ///< 含转义字符的键解码到这里
+    QString error_;
+    bool first_ = true;     ///< 当前对象尚未读过成员
+};
+
+/**
+ * @brief 紧凑 JSON 输出器，直接追加到调用方的缓冲区
+ *
+ * 键名必须是无需转义的 ASCII 字面量。字符串转义规则与 QJsonDocument::Compact 一致。
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(QByteArray& out) : out_(out) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const char* name);
+
+    void writeString(const QString& value);
+    void writeUtf8(const char* data, qsizetype size);
+    void writeBool(bool value);
+    void writeInt(qint64 value);
+    void writeNull();
+
+private:
+    void separator();
+
+    QByteArray& out_;
+    bool needComma_ = false;
+};
+
+// ==============================================================================
+// 字段描述符
+// ==============================================================================
+
+/**
+ * @brief 字段规则位
+ */
+namespace rule {
+constexpr unsigned Required = 1u << 0;  ///< 解码时必须出现且非空，否则报“缺少必填字段”
+constexpr unsigned NonEmpty = 1u << 1;  ///< validate() 时不能为空
+constexpr unsigned Base64 = 1u << 2;    ///< QByteArray 字段在 JSON 中为 Base64 文本（缺省为 UTF-8 文本）
+}  // namespace rule
+
+/**
+ * @brief 数据成员字段描述
+ *
+ * 支持的成员类型：QString、QByteArray、bool、int 以及枚举（仅编码，按整数输出）。
+ */
+template <typename T, typename M>
+struct Field {
+    const char* name;
+    M T::*member;
+    unsigned rules = 0;
+    const char* const* choices = nullptr;  ///< 非空值必须为其中之一（以 nullptr 结尾）
+    qint64 lowerExclusive = std::numeric_limits<qint64>::min();
+    qint64 upperInclusive = std::numeric_limits<qint64>::max();
+
+    constexpr Field oneOf(const char* const* list) const {
+        Field f = *this;
+        f.choices = list;
+        return f;
+    }
+
+    constexpr Field greaterThan(qint64 bound) const {
+        Field f = *this;
+        f.lowerExclusive = bound;
+        return f;
+    }
+
+    constexpr Field atMost(qint64 bound) const {
+        Field f = *this;
+        f.upperInclusive = bound;
+        return f;
+    }
+};
+
+/**
+ * @brief 只参与编码的计算字段（如由多个成员拼出的数组）
+ */
+template <typename T>
+struct ComputedField {
+    const char* name;
+    void (*encode)(JsonWriter& writer, const T& value);
+};
+
+template <typename T, typename M>
+constexpr Field<T, M> field(const char* name, M T::*member, unsigned rules = 0) {
+    return Field<T, M>{name, member, rules};
+}
+
+template <typename T>
+constexpr ComputedField<T> computed(const char* name, void (*encode)(JsonWriter&, const T&)) {
+    return ComputedField<T>{name, encode};
+}
+
+/**
+ * @brief DTO 字段表，每个 DTO 特化一次：
+ *
+ *     template <> struct DtoSchema<Foo> {
+ *         static constexpr const char* name = "Foo";
+ *         static constexpr auto fields = std::make_tuple(field("a", &Foo::a, rule::NonEmpty), ...);
+ *     };
+ *
+ * 校验按字段声明顺序进行，遇到第一个错误即返回。
+ */
+template <typename T>
+struct DtoSchema;
+
+namespace detail {
+
+template <typename>
+constexpr bool kUnsupportedField = false;
+
+/**
+ * @brief 请求体解码失败时的错误
+ *
+ * 文本与原 HttpRequest::jsonBody() 一致，只在出错后用 QJsonDocument 重新解析一次取得；
+ * QJsonDocument 能接受而读取器拒绝时（如嵌套超过上限）使用读取器自己的描述。
+ */
+Error decodeError(const QByteArray& body, const JsonReader& reader);
+
+inline bool keyEquals(QByteArrayView key, const char* name) {
+    const size_t length = std::strlen(name);
+    return static_cast<size_t>(key.size()) == length && std::memcmp(key.data(), name, length) == 0;
+}
+
+template <typename M>
+bool isEmptyValue(const M& value) {
+    if constexpr (std::is_same_v<M, QString> || std::is_same_v<M, QByteArray>) {
+        return value.isEmpty();
+    } else {
+        return false;
+    }
+}
+
+template <typename T, typename M>
+void decodeValue(JsonReader& reader, T& obj, const Field<T, M>& f) {
+    M& target = obj.*(f.member);
+    if constexpr (std::is_same_v<M, QString>) {
+        if (!reader.readString(target)) {
+            target.clear();
+        }
+    } else if constexpr (std::is_same_v<M, QByteArray>) {
+        if (!reader.readUtf8(target)) {
+            target.clear();
+        } else if (f.rules & rule::Base64) {
+            target = QByteArray::fromBase64(target);
+        }
+    } else if constexpr (std::is_same_v<M, bool>) {
+        if (!reader.readBool(target)) {
+            target = false;
+        }
+    } else if constexpr (std::is_same_v<M, int>) {
+        if (!reader.readInt(target)) {
+            target = 0;
+        }
+    } else {
+        static_assert(kUnsupportedField<M>, "unsupported DTO field type");
+    }
+}
+
+template <typename T, typename M>
+bool decodeIfMatches(JsonReader& reader, T& obj, QByteArrayView key, const Field<T, M>& f) {
+    if (!keyEquals(key, f.name)) {
+        return false;
+    }
+    decodeValue(reader, obj, f);
+    return true;
+}
+
+template <typename T>
+bool decodeIfMatches(JsonReader& /*reader*/, T& /*obj*/, QByteArrayView /*key*/, const ComputedField<T>& /*f*/) {
+    return false;
+}
+
+template <typename T, typename M>
+bool checkRequired(const T& obj, const Field<T, M>& f, const char* context, Error& error) {
+    if ((f.rules & rule::Required) && isEmptyValue(obj.*(f.member))) {
+        error = Error(Error::InvalidParam, QString("缺少必填字段：%1").arg(QLatin1String(f.name)), context);
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool checkRequired(const T& /*obj*/, const ComputedField<T>& /*f*/, const char* /*context*/, Error& /*error*/) {
+    return true;
+}
+
+template <typename T>
+Result<T> checkAllRequired(T obj, const char* context) {
+    Error error;
+    const bool ok = std::apply(
+        [&](const auto&... f) { return (checkRequired(obj, f, context, error) && ...); }, DtoSchema<T>::fields);
+    if (!ok) {
+        return Result<T>::err(error);
+    }
+    return Result<T>::ok(std::move(obj));
+}
+
+template <typename T, typename M>
+bool checkField(const T& obj, const Field<T, M>& f, const QString& context, Error& error) {
+    const M& value = obj.*(f.member);
+    const QLatin1String name(f.name);
+
+    if ((f.rules & rule::NonEmpty) && isEmptyValue(value)) {
+        error = Error(Error::InvalidParam, QString("字段 '%1' 不能为空").arg(name), context);
+        return false;
+    }
+
+    if constexpr (std::is_same_v<M, QString>) {
+        if (f.choices && !value.isEmpty()) {
+            QStringList allowed;
+            for (const char* const* c = f.choices; *c; ++c) {
+                if (value == QLatin1String(*c)) {
+                    return true;
+                }
+                allowed << QString("'%1'").arg(QLatin1String(*c));
+            }
+            error = Error(Error::InvalidParam, QString("%1 必须为 %2").arg(name).arg(allowed.join(" 或 ")), context);
+            return false;
+        }
+    } else if constexpr (std::is_same_v<M, int>) {
+        if (value <= f.lowerExclusive) {
+            error = Error(Error::InvalidParam, QString("%1 必须大于 %2").arg(name).arg(f.lowerExclusive), context);
+            return false;
+        }
+        if (value > f.upperInclusive) {
+            error = Error(Error::InvalidParam, QString("%1 不能超过 %2").arg(name).arg(f.upperInclusive), context);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool checkField(const T& /*obj*/, const ComputedField<T>& /*f*/, const QString& /*context*/, Error& /*error*/) {
+    return true;
+}
+
+template <typename T, typename M>
+void encodeField(JsonWriter& writer, const T& obj, const Field<T, M>& f) {
+    const M& value = obj.*(f.member);
+    writer.key(f.name);
+    if constexpr (std::is_same_v<M, QString>) {
+        writer.writeString(value);
+    } else if constexpr (std::is_same_v<M, QByteArray>) {
+        const QByteArray text = (f.rules & rule::Base64) ? value.toBase64() : value;
+        writer.writeUtf8(text.constData(), text.size());
+    } else if constexpr (std::is_same_v<M, bool>) {
+        writer.writeBool(value);
+    } else if constexpr (std::is_integral_v<M>) {
+        writer.writeInt(static_cast<qint64>(value));
+    } else if constexpr (std::is_enum_v<M>) {
+        writer.writeInt(static_cast<qint64>(value));
+    } else {
+        static_assert(kUnsupportedField<M>, "unsupported DTO field type");
+    }
+}
+
+template <typename T>
+void encodeField(JsonWriter& writer, const T& obj, const ComputedField<T>& f) {
+    writer.key(f.name);
+    f.encode(writer, obj);
+}
+
+}  // namespace detail
+
+// ==============================================================================
+// 编解码入口
+// ==============================================================================
+
+/**
+ * @brief 从 UTF-8 JSON 请求体解码 DTO
+ *
+ * 未知键被忽略；已知键的值类型不符时按该类型的空值处理（与 QJsonValue::toXxx() 的缺省行为一致）。
+ */
+template <typename T>
+Result<T> decodeJson(const QByteArray& body) {
+    RequestTiming::StageTimer timer(RequestTiming::Parse);
+    T obj;
+    JsonReader reader(body);
+    if (reader.beginObject()) {
+        QByteArrayView key;
+        while (reader.nextKey(key)) {
+            const bool matched = std::apply(
+                [&](const auto&... f) { return (detail::decodeIfMatches(reader, obj, key, f) || ...); },
+                DtoSchema<T>::fields);
+            if (!matched) {
+                reader.skipValue();
+            }
+        }
+        reader.finish();
+    }
+    if (reader.hasError()) {
+        return Result<T>::err(detail::decodeError(body, reader));
+    }
+    return detail::checkAllRequired(std::move(obj), "fromJson");
+}
+
+/**
+ * @brief 从查询参数解码 DTO（只支持 QString 字段）
+ */
+template <typename T>
+Result<T> decodeQuery(const QMap<QString, QString>& query) {
+    T obj;
+    std::apply([&](const auto&... f) { ((obj.*(f.member) = query.value(QLatin1String(f.name))), ...); },
+               DtoSchema<T>::fields);
+    return detail::checkAllRequired(std::move(obj), "fromQuery");
+}
+
+/**
+ * @brief 按字段表校验 DTO
+ */
+template <typename T>
+Result<void> validateFields(const T& obj) {
+    const QString context = QString("%1::validate").arg(QLatin1String(DtoSchema<T>::name));
+    Error error;
+    const bool ok = std::apply(
+        [&](const auto&... f) { return (detail::checkField(obj, f, context, error) && ...); }, DtoSchema<T>::fields);
+    if (!ok) {
+        return Result<void>::err(error);
+    }
+    return Result<void>::ok();
+}
+
+/**
+ * @brief 将 DTO 编码为 JSON 对象写入 writer
+ */
+template <typename T>
+void encodeJson(JsonWriter& writer, const T& obj) {
+    writer.beginObject();
+    std::apply([&](const auto&... f) { (detail::encodeField(writer, obj, f), ...); }, DtoSchema<T>::fields);
+    writer.endObject();
+}
+
+/**
+ * @brief 将 DTO 列表编码为 JSON 数组
+ */
+template <typename T>
+QByteArray encodeJsonList(const QList<T>& list) {
+    QByteArray out;
+    out.reserve(64 * (list.size() + 1));
+    JsonWriter writer(out);
+    writer.beginArray();
+    for (const T& item : list) {
+        encodeJson(writer, item);
+    }
+    writer.endArray();
+    return out;
+}
+
+}  // namespace api
+}  // namespace wekey
@@ -2,19 +2,24 @@
  * @file Request.h
  * @brief API 请求 DTO 定义 (M4.1.4I)
  *
- * 定义所有 API 请求的数据传输对象
+ * 定义所有 API 请求的数据传输对象。JSON 解码、必填检查和 validate() 的字段级校验
+ * 由文件末尾的 DtoSchema 字段表生成（见 JsonCodec.h），fromJson 直接解析 UTF-8 请求体。
  */
 
 #pragma once
 
-#include <QJsonArray>
-#include <QJsonObject>
+#include <QByteArray>
+#include <QCborMap>
 #include <QList>
 #include <QMap>
 #include <QString>
 
+#include <tuple>
+
+#include "api/dto/JsonCodec.h"
 #include "common/Error.h"
 #include "common/Result.h"
+#include "plugin/interface/PluginTypes.h"
 
 namespace wekey {
 namespace api {
@@ -33,7 +38,7 @@ struct LoginRequest {
     QString role;  // "user" 或 "admin"
     QString pin;
 
-    static Result<LoginRequest> fromJson(const QJsonObject& json);
+    static Result<LoginRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -45,7 +50,7 @@ struct LogoutRequest {
     QString serialNumber;
     QString appName;  // 可选，为空时使用默认值
 
-    static Result<LogoutRequest> fromJson(const QJsonObject& json);
+    static Result<LogoutRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -63,7 +68,7 @@ struct CsrRequest {
     QString org;          // Organization
     QString unit;         // Organizational Unit
 
-    static Result<CsrRequest> fromJson(const QJsonObject& json);
+    static Result<CsrRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -84,7 +89,7 @@ struct ImportCertRequest {
     QString keyAlgorithm;        // 密钥算法（可选）
     bool nonGM = false;          // 是否非国密（影响私钥导入方式）
 
-    static Result<ImportCertRequest> fromJson(const QJsonObject& json);
+    static Result<ImportCertRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -104,14 +109,43 @@ struct ExportCertRequest {
 /**
  * @brief 签名请求
  * POST /api/v1/sign
+ *
+ * 支持三种请求体：
+ * - application/json：{"serialNumber", "appName", "containerName", "data"}（data 为文本）
+ * - application/cbor：同名键的 CBOR map，data 可为字节串或文本
+ * - application/octet-stream：请求体即待签名原文，其余参数取自查询参数或请求头
  */
 struct SignRequest {
     QString serialNumber;
     QString appName;
     QString containerName;
-    QString data;
+    QByteArray data;  // 待签名原文
+
+    static Result<SignRequest> fromJson(const QByteArray& body);
+    static Result<SignRequest> fromCbor(const QCborMap& map);
+    static Result<SignRequest> fromBinary(const QMap<QString, QString>& params, const QByteArray& body);
+    Result<void> validate() const;
+};
+
+/**
+ * @brief 数字信封加解密请求
+ * POST /api/v1/encrypt、POST /api/v1/decrypt
+ *
+ * 支持三种请求体：
+ * - application/json：{"serialNumber", "appName", "containerName", "cipher", "data"}（data 为 Base64）
+ * - application/cbor：同名键的 CBOR map，data 为字节串
+ * - application/octet-stream：请求体即明文（加密）或信封（解密），其余参数取自查询参数或请求头
+ */
+struct EnvelopeRequest {
+    QString serialNumber;
+    QString appName;
+    QString containerName;
+    QString cipher;   // 对称算法 "SM4-GCM" / "AES-256-GCM"，仅加密使用，空为按容器密钥类型选择
+    QByteArray data;  // 明文或信封
 
-    static Result<SignRequest> fromJson(const QJsonObject& json);
+    static Result<EnvelopeRequest> fromJson(const QByteArray& body);
+    static Result<EnvelopeRequest> fromCbor(const QCborMap& map);
+    static Result<EnvelopeRequest> fromBinary(const QMap<QString, QString>& params, const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -126,7 +160,7 @@ struct VerifyRequest {
     QString data;       // base64 编码的原始数据
     QString signature;  // hex 编码的签名
 
-    static Result<VerifyRequest> fromJson(const QJsonObject& json);
+    static Result<VerifyRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -138,7 +172,34 @@ struct RandomRequest {
     QString serialNumber;
     int count = 0;  // 随机数长度（字节），<= 0 时使用默认值
 
-    static Result<RandomRequest> fromJson(const QJsonObject& json);
+    static Result<RandomRequest> fromJson(const QByteArray& body);
+    Result<void> validate() const;
+};
+
+/**
+ * @brief 启动批量初始化请求
+ * POST /api/v1/provision
+ */
+struct ProvisionRequest {
+    QString plan;        // 计划文件路径（服务端本机路径）
+    bool fresh = false;  // 忽略已有检查点，所有设备从头开始
+
+    static Result<ProvisionRequest> fromJson(const QByteArray& body);
+    Result<void> validate() const;
+};
+
+/**
+ * @brief 批量执行请求
+ * POST /api/v1/execute
+ *
+ * operations 为对象数组（id、op、params、continueOnError），嵌套结构不走字段表，
+ * 由 fromJson 单独解析。
+ */
+struct ExecuteRequest {
+    QString serialNumber;
+    OperationList operations;
+
+    static Result<ExecuteRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -154,7 +215,7 @@ struct CreateModuleRequest {
     QString modName;
     QString modPath;
 
-    static Result<CreateModuleRequest> fromJson(const QJsonObject& json);
+    static Result<CreateModuleRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -165,7 +226,7 @@ struct CreateModuleRequest {
 struct ActiveModuleRequest {
     QString modName;
 
-    static Result<ActiveModuleRequest> fromJson(const QJsonObject& json);
+    static Result<ActiveModuleRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -176,7 +237,7 @@ struct ActiveModuleRequest {
 struct DeleteModuleRequest {
     QString modName;
 
-    static Result<DeleteModuleRequest> fromJson(const QJsonObject& json);
+    static Result<DeleteModuleRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -193,7 +254,7 @@ struct ChangeDeviceAuthRequest {
     QString oldPin;
     QString newPin;
 
-    static Result<ChangeDeviceAuthRequest> fromJson(const QJsonObject& json);
+    static Result<ChangeDeviceAuthRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -205,7 +266,7 @@ struct SetDeviceLabelRequest {
     QString serialNumber;
     QString label;
 
-    static Result<SetDeviceLabelRequest> fromJson(const QJsonObject& json);
+    static Result<SetDeviceLabelRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -223,7 +284,7 @@ struct CreateAppRequest {
     QString adminPin;
     QString userPin;
 
-    static Result<CreateAppRequest> fromJson(const QJsonObject& json);
+    static Result<CreateAppRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -235,7 +296,7 @@ struct DeleteAppRequest {
     QString serialNumber;
     QString appName;
 
-    static Result<DeleteAppRequest> fromJson(const QJsonObject& json);
+    static Result<DeleteAppRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -250,7 +311,7 @@ struct UpdateAppPinRequest {
     QString oldPin;
     QString newPin;
 
-    static Result<UpdateAppPinRequest> fromJson(const QJsonObject& json);
+    static Result<UpdateAppPinRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -263,7 +324,7 @@ struct UnblockAppRequest {
     QString appName;
     QString adminPin;
 
-    static Result<UnblockAppRequest> fromJson(const QJsonObject& json);
+    static Result<UnblockAppRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -280,7 +341,7 @@ struct CreateContainerRequest {
     QString appName;
     QString containerName;
 
-    static Result<CreateContainerRequest> fromJson(const QJsonObject& json);
+    static Result<CreateContainerRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -293,7 +354,7 @@ struct DeleteContainerRequest {
     QString appName;
     QString containerName;
 
-    static Result<DeleteContainerRequest> fromJson(const QJsonObject& json);
+    static Result<DeleteContainerRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -309,9 +370,9 @@ struct CreateFileRequest {
     QString serialNumber;
     QString appName;
     QString fileName;
-    int size;
+    int size = 0;
 
-    static Result<CreateFileRequest> fromJson(const QJsonObject& json);
+    static Result<CreateFileRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -328,6 +389,21 @@ struct ReadFileRequest {
     Result<void> validate() const;
 };
 
+/**
+ * @brief 写入文件请求
+ * POST /api/v1/file/write（JSON 中 data 为 Base64；application/octet-stream 时参数取自查询串）
+ */
+struct WriteFileRequest {
+    QString serialNumber;
+    QString appName;
+    QString fileName;
+    QByteArray data;
+
+    static Result<WriteFileRequest> fromJson(const QByteArray& body);
+    static Result<WriteFileRequest> fromBinary(const QMap<QString, QString>& params, const QByteArray& body);
+    Result<void> validate() const;
+};
+
 /**
  * @brief 删除文件请求
  * DELETE /admin/file/delete
@@ -337,7 +413,7 @@ struct DeleteFileRequest {
     QString appName;
     QString fileName;
 
-    static Result<DeleteFileRequest> fromJson(const QJsonObject& json);
+    static Result<DeleteFileRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
@@ -357,9 +433,275 @@ struct SetDefaultsRequest {
     QString unit;
     QString role;
 
-    static Result<SetDefaultsRequest> fromJson(const QJsonObject& json);
+    static Result<SetDefaultsRequest> fromJson(const QByteArray& body);
     Result<void> validate() const;
 };
 
+// ==============================================================================
+// 字段表
+// ==============================================================================
+
+/// 随机数长度上限（字节）
+constexpr int MAX_RANDOM_LENGTH = 4096;
+
+/// 单次批量执行的操作数上限
+constexpr int MAX_EXECUTE_OPERATIONS = 32;
+
+/// PIN 角色取值
+inline constexpr const char* kRoleChoices[] = {"user", "admin", nullptr};
+
+template <>
+struct DtoSchema<LoginRequest> {
+    static constexpr const char* name = "LoginRequest";
+    // appName 和 role 允许为空（将在 handler 中填充默认值），但 role 不为空时必须是合法值
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &LoginRequest::serialNumber, rule::Required | rule::NonEmpty),
+        field("appName", &LoginRequest::appName),
+        field("role", &LoginRequest::role).oneOf(kRoleChoices),
+        field("pin", &LoginRequest::pin, rule::Required | rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<LogoutRequest> {
+    static constexpr const char* name = "LogoutRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &LogoutRequest::serialNumber, rule::Required | rule::NonEmpty),
+        field("appName", &LogoutRequest::appName));
+};
+
+template <>
+struct DtoSchema<CsrRequest> {
+    static constexpr const char* name = "CsrRequest";
+    // appName, containerName, cname, org, unit 在 handler 中填充默认值，校验的是填充后的值
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &CsrRequest::serialNumber, rule::Required | rule::NonEmpty),
+        field("appName", &CsrRequest::appName, rule::NonEmpty),
+        field("containerName", &CsrRequest::containerName, rule::NonEmpty),
+        field("keyPairType", &CsrRequest::keyPairType),
+        field("renew", &CsrRequest::renew),
+        field("cname", &CsrRequest::cname, rule::NonEmpty),
+        field("org", &CsrRequest::org, rule::NonEmpty),
+        field("unit", &CsrRequest::unit, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<ImportCertRequest> {
+    static constexpr const char* name = "ImportCertRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &ImportCertRequest::serialNumber, rule::NonEmpty),
+        field("appName", &ImportCertRequest::appName, rule::NonEmpty),
+        field("containerName", &ImportCertRequest::containerName, rule::NonEmpty),
+        field("sigCert", &ImportCertRequest::sigCert),
+        field("encCert", &ImportCertRequest::encCert),
+        field("encPrivate", &ImportCertRequest::encPrivate),
+        field("label", &ImportCertRequest::label),
+        field("keyAlgorithm", &ImportCertRequest::keyAlgorithm),
+        field("nonGM", &ImportCertRequest::nonGM));
+};
+
+template <>
+struct DtoSchema<ExportCertRequest> {
+    static constexpr const char* name = "ExportCertRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &ExportCertRequest::serialNumber, rule::Required | rule::NonEmpty),
+        field("appName", &ExportCertRequest::appName, rule::NonEmpty),
+        field("containerName", &ExportCertRequest::containerName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<SignRequest> {
+    static constexpr const char* name = "SignRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &SignRequest::serialNumber, rule::NonEmpty),
+        field("appName", &SignRequest::appName, rule::NonEmpty),
+        field("containerName", &SignRequest::containerName, rule::NonEmpty),
+        field("data", &SignRequest::data, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<EnvelopeRequest> {
+    static constexpr const char* name = "EnvelopeRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &EnvelopeRequest::serialNumber, rule::NonEmpty),
+        field("appName", &EnvelopeRequest::appName, rule::NonEmpty),
+        field("containerName", &EnvelopeRequest::containerName, rule::NonEmpty),
+        field("cipher", &EnvelopeRequest::cipher),
+        field("data", &EnvelopeRequest::data, rule::Base64 | rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<VerifyRequest> {
+    static constexpr const char* name = "VerifyRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &VerifyRequest::serialNumber, rule::NonEmpty),
+        field("appName", &VerifyRequest::appName, rule::NonEmpty),
+        field("containerName", &VerifyRequest::containerName, rule::NonEmpty),
+        field("data", &VerifyRequest::data, rule::NonEmpty),
+        field("signature", &VerifyRequest::signature, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<RandomRequest> {
+    static constexpr const char* name = "RandomRequest";
+    // count <= 0 时使用默认值，只限制上限
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &RandomRequest::serialNumber, rule::NonEmpty),
+        field("count", &RandomRequest::count).atMost(MAX_RANDOM_LENGTH));
+};
+
+template <>
+struct DtoSchema<ProvisionRequest> {
+    static constexpr const char* name = "ProvisionRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("plan", &ProvisionRequest::plan, rule::Required | rule::NonEmpty),
+        field("fresh", &ProvisionRequest::fresh));
+};
+
+template <>
+struct DtoSchema<CreateModuleRequest> {
+    static constexpr const char* name = "CreateModuleRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("modName", &CreateModuleRequest::modName, rule::NonEmpty),
+        field("modPath", &CreateModuleRequest::modPath, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<ActiveModuleRequest> {
+    static constexpr const char* name = "ActiveModuleRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("modName", &ActiveModuleRequest::modName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<DeleteModuleRequest> {
+    static constexpr const char* name = "DeleteModuleRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("modName", &DeleteModuleRequest::modName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<ChangeDeviceAuthRequest> {
+    static constexpr const char* name = "ChangeDeviceAuthRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &ChangeDeviceAuthRequest::serialNumber, rule::NonEmpty),
+        field("oldPin", &ChangeDeviceAuthRequest::oldPin, rule::NonEmpty),
+        field("newPin", &ChangeDeviceAuthRequest::newPin, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<SetDeviceLabelRequest> {
+    static constexpr const char* name = "SetDeviceLabelRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &SetDeviceLabelRequest::serialNumber, rule::NonEmpty),
+        field("label", &SetDeviceLabelRequest::label, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<CreateAppRequest> {
+    static constexpr const char* name = "CreateAppRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &CreateAppRequest::serialNumber, rule::NonEmpty),
+        field("appName", &CreateAppRequest::appName, rule::NonEmpty),
+        field("adminPin", &CreateAppRequest::adminPin, rule::NonEmpty),
+        field("userPin", &CreateAppRequest::userPin, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<DeleteAppRequest> {
+    static constexpr const char* name = "DeleteAppRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &DeleteAppRequest::serialNumber, rule::NonEmpty),
+        field("appName", &DeleteAppRequest::appName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<UpdateAppPinRequest> {
+    static constexpr const char* name = "UpdateAppPinRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &UpdateAppPinRequest::serialNumber, rule::NonEmpty),
+        field("appName", &UpdateAppPinRequest::appName, rule::NonEmpty),
+        field("role", &UpdateAppPinRequest::role, rule::NonEmpty).oneOf(kRoleChoices),
+        field("oldPin", &UpdateAppPinRequest::oldPin, rule::NonEmpty),
+        field("newPin", &UpdateAppPinRequest::newPin, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<UnblockAppRequest> {
+    static constexpr const char* name = "UnblockAppRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &UnblockAppRequest::serialNumber, rule::NonEmpty),
+        field("appName", &UnblockAppRequest::appName, rule::NonEmpty),
+        field("adminPin", &UnblockAppRequest::adminPin, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<CreateContainerRequest> {
+    static constexpr const char* name = "CreateContainerRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &CreateContainerRequest::serialNumber, rule::NonEmpty),
+        field("appName", &CreateContainerRequest::appName, rule::NonEmpty),
+        field("containerName", &CreateContainerRequest::containerName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<DeleteContainerRequest> {
+    static constexpr const char* name = "DeleteContainerRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &DeleteContainerRequest::serialNumber, rule::NonEmpty),
+        field("appName", &DeleteContainerRequest::appName, rule::NonEmpty),
+        field("containerName", &DeleteContainerRequest::containerName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<CreateFileRequest> {
+    static constexpr const char* name = "CreateFileRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &CreateFileRequest::serialNumber, rule::NonEmpty),
+        field("appName", &CreateFileRequest::appName, rule::NonEmpty),
+        field("fileName", &CreateFileRequest::fileName, rule::NonEmpty),
+        field("size", &CreateFileRequest::size).greaterThan(0));
+};
+
+template <>
+struct DtoSchema<ReadFileRequest> {
+    static constexpr const char* name = "ReadFileRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &ReadFileRequest::serialNumber, rule::Required | rule::NonEmpty),
+        field("appName", &ReadFileRequest::appName, rule::Required | rule::NonEmpty),
+        field("fileName", &ReadFileRequest::fileName, rule::Required | rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<WriteFileRequest> {
+    static constexpr const char* name = "WriteFileRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &WriteFileRequest::serialNumber, rule::NonEmpty),
+        field("appName", &WriteFileRequest::appName, rule::NonEmpty),
+        field("fileName", &WriteFileRequest::fileName, rule::NonEmpty),
+        field("data", &WriteFileRequest::data, rule::Base64 | rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<DeleteFileRequest> {
+    static constexpr const char* name = "DeleteFileRequest";
+    static constexpr auto fields = std::make_tuple(
+        field("serialNumber", &DeleteFileRequest::serialNumber, rule::NonEmpty),
+        field("appName", &DeleteFileRequest::appName, rule::NonEmpty),
+        field("fileName", &DeleteFileRequest::fileName, rule::NonEmpty));
+};
+
+template <>
+struct DtoSchema<SetDefaultsRequest> {
+    static constexpr const char* name = "SetDefaultsRequest";
+    // 所有字段都是可选的
+    static constexpr auto fields = std::make_tuple(
+        field("appName", &SetDefaultsRequest::appName),
+        field("containerName", &SetDefaultsRequest::containerName),
+        field("commonName", &SetDefaultsRequest::commonName),
+        field("organization", &SetDefaultsRequest::organization),
+        field("unit", &SetDefaultsRequest::unit),
+        field("role", &SetDefaultsRequest::role));
+};
+
 }  // namespace api
 }  // namespace wekey
@@ -2,7 +2,7 @@
  * @file Response.h
  * @brief API 响应 DTO 定义 (M4.1.3I)
  *
- * 定义标准 API 响应格式和转换辅助函数
+ * 定义标准 API 响应格式，以及插件数据结构的 JSON 字段表（配合 encodeJsonList 使用）
  */
 
 #pragma once
@@ -13,6 +13,9 @@
 #include <QList>
 #include <QString>
 
+#include <tuple>
+
+#include "api/dto/JsonCodec.h"
 #include "common/Error.h"
 #include "common/Result.h"
 #include "plugin/interface/PluginTypes.h"
@@ -197,48 +200,59 @@ private:
 };
 
 // ==============================================================================
-// 转换辅助函数
+// 响应字段表
 // ==============================================================================
+// 键按字典序声明，编码结果与此前经 QJsonObject 序列化的输出逐字节一致
 
 /**
- * @brief 将 DeviceInfo 转换为 JSON 对象
- */
-QJsonObject deviceInfoToJson(const DeviceInfo& info);
-
-/**
- * @brief 将 DeviceInfo 列表转换为 JSON 数组
- */
-QJsonArray deviceInfoListToJson(const QList<DeviceInfo>& devices);
-
-/**
- * @brief 将 AppInfo 转换为 JSON 对象
+ * @brief 编码证书有效期数组 [开始时间, 结束时间]
  */
-QJsonObject appInfoToJson(const AppInfo& info);
+void encodeCertValidity(JsonWriter& writer, const CertInfo& info);
 
-/**
- * @brief 将 AppInfo 列表转换为 JSON 数组
- */
-QJsonArray appInfoListToJson(const QList<AppInfo>& apps);
-
-/**
- * @brief 将 ContainerInfo 转换为 JSON 对象
- */
-QJsonObject containerInfoToJson(const ContainerInfo& info);
+template <>
+struct DtoSchema<DeviceInfo> {
+    static constexpr const char* name = "DeviceInfo";
+    static constexpr auto fields = std::make_tuple(
+        field("deviceName", &DeviceInfo::deviceName),
+        field("firmwareVersion", &DeviceInfo::firmwareVersion),
+        field("hwVersion", &DeviceInfo::hardwareVersion),
+        field("isLogin", &DeviceInfo::isLoggedIn),
+        field("label", &DeviceInfo::label),
+        field("manufacturer", &DeviceInfo::manufacturer),
+        field("serialNumber", &DeviceInfo::serialNumber));
+};
 
-/**
- * @brief 将 ContainerInfo 列表转换为 JSON 数组
- */
-QJsonArray containerInfoListToJson(const QList<ContainerInfo>& containers);
+template <>
+struct DtoSchema<AppInfo> {
+    static constexpr const char* name = "AppInfo";
+    static constexpr auto fields = std::make_tuple(
+        field("appName", &AppInfo::appName),
+        field("isLogin", &AppInfo::isLoggedIn));
+};
 
-/**
- * @brief 将 CertInfo 转换为 JSON 对象
- */
-QJsonObject certInfoToJson(const CertInfo& info);
+template <>
+struct DtoSchema<ContainerInfo> {
+    static constexpr const char* name = "ContainerInfo";
+    static constexpr auto fields = std::make_tuple(
+        field("certImported", &ContainerInfo::certImported),
+        field("containerName", &ContainerInfo::containerName),
+        field("keyGenerated", &ContainerInfo::keyGenerated),
+        field("keyType", &ContainerInfo::keyType));
+};
 
-/**
- * @brief 将 CertInfo 列表转换为 JSON 数组
- */
-QJsonArray certInfoListToJson(const QList<CertInfo>& certs);
+template <>
+struct DtoSchema<CertInfo> {
+    static constexpr const char* name = "CertInfo";
+    static constexpr auto fields = std::make_tuple(
+        field("cert", &CertInfo::cert),
+        field("certType", &CertInfo::certType),
+        field("commonName", &CertInfo::commonName),
+        field("issuerDn", &CertInfo::issuerDn),
+        field("pubKeyHash", &CertInfo::pubKeyHash),
+        field("serialNumber", &CertInfo::serialNumber),
+        field("subjectDn", &CertInfo::subjectDn),
+        computed("validity", &encodeCertValidity));
+};
 
 }  // namespace api
 }  // namespace wekey
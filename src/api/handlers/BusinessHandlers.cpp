@@ -5,23 +5,266 @@
 
 #include "BusinessHandlers.h"
 
+#include <QBuffer>
+#include <QCborValue>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSet>
 
 #include "api/dto/HttpTypes.h"
 #include "api/dto/Request.h"
 #include "api/dto/Response.h"
+#include "common/LogCategories.h"
+#include "common/Metrics.h"
 #include "config/Config.h"
+#include "config/Defaults.h"
 #include "core/application/AppService.h"
 #include "core/container/ContainerService.h"
 #include "core/crypto/CertService.h"
+#include "core/crypto/EnvelopeService.h"
 #include "core/device/DeviceService.h"
 #include "core/file/FileService.h"
+#include "core/operation/OperationService.h"
 
 namespace wekey {
 namespace api {
 
+namespace {
+
+/**
+ * @brief 请求/响应载荷编码
+ */
+enum class PayloadFormat { Json, Cbor, OctetStream };
+
+/// 取媒体类型（去掉参数并转小写）
+QString mediaType(const QString& value) {
+    return value.section(';', 0, 0).trimmed().toLower();
+}
+
+/// 根据 Content-Type 判断请求体编码，缺省为 JSON
+PayloadFormat requestFormat(const HttpRequest& request) {
+    const QString type = mediaType(request.header("Content-Type"));
+    if (type == "application/cbor") {
+        return PayloadFormat::Cbor;
+    }
+    if (type == "application/octet-stream") {
+        return PayloadFormat::OctetStream;
+    }
+    return PayloadFormat::Json;
+}
+
+/// 根据 Accept 选择响应编码：取第一个可识别的类型，缺省为 JSON
+PayloadFormat responseFormat(const HttpRequest& request) {
+    const auto types = request.header("Accept").split(',');
+    for (const auto& part : types) {
+        const QString type = mediaType(part);
+        if (type == "application/json" || type == "*/*") {
+            return PayloadFormat::Json;
+        }
+        if (type == "application/cbor") {
+            return PayloadFormat::Cbor;
+        }
+        if (type == "application/octet-stream") {
+            return PayloadFormat::OctetStream;
+        }
+    }
+    return PayloadFormat::Json;
+}
+
+/**
+ * @brief 按响应编码生成错误响应
+ *
+ * 原始二进制无法承载错误信息，回退为 JSON。JSON/CBOR 信封中 code 非 0 即表示失败，
+ * 原始二进制的客户端只看状态码，因此这类错误一律返回非 2xx：设备错误 502，驱动未激活 503，其余 500。
+ */
+HttpResponse errorResponse(PayloadFormat format, const Error& error) {
+    HttpResponse resp;
+    if (format == PayloadFormat::Cbor) {
+        resp.setCborError(error);
+        return resp;
+    }
+    resp.setError(error);
+    if (format == PayloadFormat::OctetStream && resp.statusCode < 300) {
+        if (error.code() >= Error::SkfFail) {
+            resp.statusCode = 502;
+            resp.statusText = "Bad Gateway";
+        } else if (error.code() == Error::NoActiveModule) {
+            resp.statusCode = 503;
+            resp.statusText = "Service Unavailable";
+        } else {
+            resp.statusCode = 500;
+            resp.statusText = "Internal Server Error";
+        }
+    }
+    return resp;
+}
+
+/// 原始二进制请求的参数：优先取查询参数，其次取 X-* 请求头
+QMap<QString, QString> binaryRequestParams(const HttpRequest& request) {
+    static const std::pair<const char*, const char*> kHeaderParams[] = {
+        {"serialNumber", "X-Serial-Number"},
+        {"appName", "X-App-Name"},
+        {"containerName", "X-Container-Name"},
+        {"cipher", "X-Cipher"},
+    };
+    QMap<QString, QString> params = request.queryParams;
+    for (const auto& [field, header] : kHeaderParams) {
+        if (params.value(field).isEmpty()) {
+            QString value = request.header(header);
+            if (!value.isEmpty()) {
+                params[field] = value;
+            }
+        }
+    }
+    return params;
+}
+
+/// 按 Content-Type 解析可携带二进制数据的请求（签名、数字信封）
+template <typename Req>
+Result<Req> parsePayloadRequest(const HttpRequest& request, const char* context) {
+    switch (requestFormat(request)) {
+        case PayloadFormat::Cbor: {
+            QCborParserError parseError;
+            QCborValue value = QCborValue::fromCbor(request.body, &parseError);
+            if (parseError.error != QCborError::NoError || !value.isMap()) {
+                return Result<Req>::err(Error(Error::InvalidParam, "请求体不是有效的 CBOR map", context));
+            }
+            return Req::fromCbor(value.toMap());
+        }
+        case PayloadFormat::OctetStream:
+            return Req::fromBinary(binaryRequestParams(request), request.body);
+        case PayloadFormat::Json:
+            break;
+    }
+
+    return Req::fromJson(request.body);
+}
+
+/// 按响应编码返回二进制结果（JSON 中为 Base64 文本）
+HttpResponse bytesResponse(PayloadFormat format, const QByteArray& data) {
+    HttpResponse resp;
+    switch (format) {
+        case PayloadFormat::Cbor:
+            resp.setCborSuccess(QCborValue(data));
+            break;
+        case PayloadFormat::OctetStream:
+            resp.setRaw(data, "application/octet-stream");
+            break;
+        case PayloadFormat::Json:
+            resp.setSuccess(QJsonValue(QString::fromLatin1(data.toBase64())));
+            break;
+    }
+    return resp;
+}
+
+/**
+ * @brief 数字信封加密 / 解密的公共流程
+ *
+ * 请求体有大小上限。原始二进制响应以 chunked 编码流式输出（EnvelopeService 的 QIODevice 接口），
+ * 不在内存中拼出完整结果；JSON / CBOR 响应需要整体编码，仍一次生成。
+ */
+HttpResponse envelopeResponse(const HttpRequest& request, bool encrypt) {
+    const PayloadFormat replyFormat = responseFormat(request);
+    const char* context = encrypt ? "handleEncrypt" : "handleDecrypt";
+
+    if (request.body.size() > defaults::ENVELOPE_MAX_BODY_BYTES) {
+        HttpResponse resp = errorResponse(
+            replyFormat, Error(Error::InvalidParam,
+                               QString("请求体超过上限 %1 字节").arg(defaults::ENVELOPE_MAX_BODY_BYTES), context));
+        resp.statusCode = 413;
+        resp.statusText = "Payload Too Large";
+        return resp;
+    }
+
+    auto reqResult = parsePayloadRequest<EnvelopeRequest>(request, context);
+    if (reqResult.isErr()) {
+        return errorResponse(replyFormat, reqResult.error());
+    }
+
+    auto& req = reqResult.value();
+
+    // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
+    if (req.appName.isEmpty()) {
+        req.appName = cfg->defaultAppName;
+    }
+    if (req.containerName.isEmpty()) {
+        req.containerName = cfg->defaultContainerName;
+    }
+
+    auto valResult = req.validate();
+    if (valResult.isErr()) {
+        return errorResponse(replyFormat, valResult.error());
+    }
+
+    // 对称加解密在主机上完成，设备只参与会话密钥的解封（加密时公钥由插件缓存）
+    auto& envelope = EnvelopeService::instance();
+    if (replyFormat == PayloadFormat::OctetStream) {
+        HttpResponse resp;
+        resp.setStream(
+            [&envelope, req, encrypt](QIODevice* out) {
+                Metrics::DeviceInflight inflight(req.serialNumber);
+                QBuffer in;
+                in.setData(req.data);
+                in.open(QIODevice::ReadOnly);
+                auto result = encrypt
+                    ? envelope.encrypt(req.serialNumber, req.appName, req.containerName, &in, out, req.cipher)
+                    : envelope.decrypt(req.serialNumber, req.appName, req.containerName, &in, out);
+                return result.isErr() ? errorResponse(PayloadFormat::OctetStream, result.error()) : HttpResponse();
+            },
+            "application/octet-stream");
+        return resp;
+    }
+
+    Metrics::DeviceInflight inflight(req.serialNumber);
+    auto result = encrypt
+        ? envelope.encrypt(req.serialNumber, req.appName, req.containerName, req.data, req.cipher)
+        : envelope.decrypt(req.serialNumber, req.appName, req.containerName, req.data);
+    if (result.isErr()) {
+        return errorResponse(replyFormat, result.error());
+    }
+    return bytesResponse(replyFormat, result.value());
+}
+
+/// 按 Content-Type 解析写文件请求（原始二进制时参数取自查询串）
+Result<WriteFileRequest> parseWriteFileRequest(const HttpRequest& request) {
+    if (requestFormat(request) == PayloadFormat::OctetStream) {
+        return WriteFileRequest::fromBinary(request.queryParams, request.body);
+    }
+    return WriteFileRequest::fromJson(request.body);
+}
+
+/// 批量执行的步骤输出转 JSON（二进制为 Base64 文本）
+QJsonValue operationOutputToJson(const QVariant& output) {
+    switch (output.typeId()) {
+        case QMetaType::QByteArray:
+            return QString::fromLatin1(output.toByteArray().toBase64());
+        case QMetaType::QStringList:
+            return QJsonArray::fromStringList(output.toStringList());
+        case QMetaType::Bool:
+            return output.toBool();
+        case QMetaType::Int:
+            return output.toInt();
+        default:
+            return QJsonValue::Null;
+    }
+}
+
+QString operationStatusToString(OperationResult::Status status) {
+    switch (status) {
+        case OperationResult::Status::Succeeded:
+            return QStringLiteral("succeeded");
+        case OperationResult::Status::Failed:
+            return QStringLiteral("failed");
+        case OperationResult::Status::Skipped:
+            return QStringLiteral("skipped");
+    }
+    return {};
+}
+
+}  // namespace
+
 HttpResponse BusinessHandlers::handleEnumDev(const HttpRequest& /*request*/) {
     auto result = DeviceService::instance().enumDevices(false, false);
     HttpResponse resp;
@@ -29,19 +272,12 @@ HttpResponse BusinessHandlers::handleEnumDev(const HttpRequest& /*request*/) {
         resp.setError(result.error());
         return resp;
     }
-    resp.setSuccess(QJsonValue(deviceInfoListToJson(result.value())));
+    resp.setSuccessJson(encodeJsonList(result.value()));
     return resp;
 }
 
 HttpResponse BusinessHandlers::handleLogin(const HttpRequest& request) {
-    auto jsonResult = request.jsonBody();
-    if (jsonResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(jsonResult.error());
-        return resp;
-    }
-
-    auto reqResult = LoginRequest::fromJson(jsonResult.value());
+    auto reqResult = LoginRequest::fromJson(request.body);
     if (reqResult.isErr()) {
         HttpResponse resp;
         resp.setError(reqResult.error());
@@ -51,11 +287,12 @@ HttpResponse BusinessHandlers::handleLogin(const HttpRequest& request) {
     auto& req = reqResult.value();
 
     // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
     if (req.appName.isEmpty()) {
-        req.appName = Config::instance().defaultAppName();
+        req.appName = cfg->defaultAppName;
     }
     if (req.role.isEmpty()) {
-        req.role = Config::instance().defaultRole();
+        req.role = cfg->defaultRole;
     }
 
     auto valResult = req.validate();
@@ -64,6 +301,7 @@ HttpResponse BusinessHandlers::handleLogin(const HttpRequest& request) {
         resp.setError(valResult.error());
         return resp;
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
     auto result = AppService::instance().login(req.serialNumber, req.appName, req.role, req.pin, false);
 
@@ -77,14 +315,7 @@ HttpResponse BusinessHandlers::handleLogin(const HttpRequest& request) {
 }
 
 HttpResponse BusinessHandlers::handleLogout(const HttpRequest& request) {
-    auto jsonResult = request.jsonBody();
-    if (jsonResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(jsonResult.error());
-        return resp;
-    }
-
-    auto reqResult = LogoutRequest::fromJson(jsonResult.value());
+    auto reqResult = LogoutRequest::fromJson(request.body);
     if (reqResult.isErr()) {
         HttpResponse resp;
         resp.setError(reqResult.error());
@@ -94,8 +325,9 @@ HttpResponse BusinessHandlers::handleLogout(const HttpRequest& request) {
     auto& req = reqResult.value();
 
     // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
     if (req.appName.isEmpty()) {
-        req.appName = Config::instance().defaultAppName();
+        req.appName = cfg->defaultAppName;
     }
 
     auto valResult = req.validate();
@@ -104,6 +336,7 @@ HttpResponse BusinessHandlers::handleLogout(const HttpRequest& request) {
         resp.setError(valResult.error());
         return resp;
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
     auto result = AppService::instance().logout(req.serialNumber, req.appName, false);
 
@@ -117,14 +350,7 @@ HttpResponse BusinessHandlers::handleLogout(const HttpRequest& request) {
 }
 
 HttpResponse BusinessHandlers::handleGenCsr(const HttpRequest& request) {
-    auto jsonResult = request.jsonBody();
-    if (jsonResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(jsonResult.error());
-        return resp;
-    }
-
-    auto reqResult = CsrRequest::fromJson(jsonResult.value());
+    auto reqResult = CsrRequest::fromJson(request.body);
     if (reqResult.isErr()) {
         HttpResponse resp;
         resp.setError(reqResult.error());
@@ -134,20 +360,21 @@ HttpResponse BusinessHandlers::handleGenCsr(const HttpRequest& request) {
     auto& req = reqResult.value();
 
     // 填充默认值（与 Go 逻辑一致）
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
     if (req.appName.isEmpty()) {
-        req.appName = Config::instance().defaultAppName();
+        req.appName = cfg->defaultAppName;
     }
     if (req.containerName.isEmpty()) {
-        req.containerName = Config::instance().defaultContainerName();
+        req.containerName = cfg->defaultContainerName;
     }
     if (req.cname.isEmpty()) {
-        req.cname = Config::instance().defaultCommonName();
+        req.cname = cfg->defaultCommonName;
     }
     if (req.org.isEmpty()) {
-        req.org = Config::instance().defaultOrganization();
+        req.org = cfg->defaultOrganization;
     }
     if (req.unit.isEmpty()) {
-        req.unit = Config::instance().defaultUnit();
+        req.unit = cfg->defaultUnit;
     }
 
     auto valResult = req.validate();
@@ -156,6 +383,7 @@ HttpResponse BusinessHandlers::handleGenCsr(const HttpRequest& request) {
         resp.setError(valResult.error());
         return resp;
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
     // 检查容器是否存在，不存在则自动创建（与 Go 逻辑一致）
     auto containers = ContainerService::instance().enumContainers(req.serialNumber, req.appName);
@@ -226,14 +454,7 @@ HttpResponse BusinessHandlers::handleGenCsr(const HttpRequest& request) {
 }
 
 HttpResponse BusinessHandlers::handleImportCert(const HttpRequest& request) {
-    auto jsonResult = request.jsonBody();
-    if (jsonResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(jsonResult.error());
-        return resp;
-    }
-
-    auto reqResult = ImportCertRequest::fromJson(jsonResult.value());
+    auto reqResult = ImportCertRequest::fromJson(request.body);
     if (reqResult.isErr()) {
         HttpResponse resp;
         resp.setError(reqResult.error());
@@ -243,11 +464,12 @@ HttpResponse BusinessHandlers::handleImportCert(const HttpRequest& request) {
     auto& req = reqResult.value();
 
     // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
     if (req.appName.isEmpty()) {
-        req.appName = Config::instance().defaultAppName();
+        req.appName = cfg->defaultAppName;
     }
     if (req.containerName.isEmpty()) {
-        req.containerName = Config::instance().defaultContainerName();
+        req.containerName = cfg->defaultContainerName;
     }
 
     auto valResult = req.validate();
@@ -256,8 +478,9 @@ HttpResponse BusinessHandlers::handleImportCert(const HttpRequest& request) {
         resp.setError(valResult.error());
         return resp;
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
-    qDebug() << "[handleImportCert] serialNumber:" << req.serialNumber
+    qCDebug(lcApi) << "[handleImportCert] serialNumber:" << req.serialNumber
              << "appName:" << req.appName << "containerName:" << req.containerName
              << "nonGM:" << req.nonGM
              << "sigCert empty:" << req.sigCert.isEmpty()
@@ -292,7 +515,7 @@ HttpResponse BusinessHandlers::handleImportCert(const HttpRequest& request) {
             resp.setError(Error(Error::InvalidParam, "签名证书解码失败", "handleImportCert"));
             return resp;
         }
-        qDebug() << "[handleImportCert] sigCert decoded, size:" << sigCertBytes.size();
+        qCDebug(lcApi) << "[handleImportCert] sigCert decoded, size:" << sigCertBytes.size();
     }
 
     // 解析加密证书（同签名证书格式）
@@ -316,7 +539,7 @@ HttpResponse BusinessHandlers::handleImportCert(const HttpRequest& request) {
             resp.setError(Error(Error::InvalidParam, "加密证书解码失败", "handleImportCert"));
             return resp;
         }
-        qDebug() << "[handleImportCert] encCert decoded, size:" << encCertBytes.size();
+        qCDebug(lcApi) << "[handleImportCert] encCert decoded, size:" << encCertBytes.size();
     }
 
     // 解析加密私钥（Base64 编码的原始二进制数据）
@@ -327,7 +550,7 @@ HttpResponse BusinessHandlers::handleImportCert(const HttpRequest& request) {
             resp.setError(Error(Error::InvalidParam, "加密私钥解码失败", "handleImportCert"));
             return resp;
         }
-        qDebug() << "[handleImportCert] encPrivate decoded, size:" << encPrivateBytes.size();
+        qCDebug(lcApi) << "[handleImportCert] encPrivate decoded, size:" << encPrivateBytes.size();
     }
 
     // 统一调用 importKeyCert：在单个设备/容器会话中完成所有导入
@@ -356,11 +579,12 @@ HttpResponse BusinessHandlers::handleExportCert(const HttpRequest& request) {
     auto& req = reqResult.value();
 
     // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
     if (req.appName.isEmpty()) {
-        req.appName = Config::instance().defaultAppName();
+        req.appName = cfg->defaultAppName;
     }
     if (req.containerName.isEmpty()) {
-        req.containerName = Config::instance().defaultContainerName();
+        req.containerName = cfg->defaultContainerName;
     }
 
     auto valResult = req.validate();
@@ -369,6 +593,7 @@ HttpResponse BusinessHandlers::handleExportCert(const HttpRequest& request) {
         resp.setError(valResult.error());
         return resp;
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
     // 获取签名证书 (certType=0) 和加密证书 (certType=1)
     auto signCertResult = CertService::instance().getCertInfo(
@@ -376,86 +601,75 @@ HttpResponse BusinessHandlers::handleExportCert(const HttpRequest& request) {
     auto encCertResult = CertService::instance().getCertInfo(
         req.serialNumber, req.appName, req.containerName, false); // 加密证书
 
-    // 构建证书数组，使用 Response.cpp 中的 certInfoToJson 工具函数
-    QJsonArray dataArray;
+    // 构建证书数组，按 DtoSchema<CertInfo> 编码
+    QList<CertInfo> certs;
 
     // 添加签名证书 (certType=0 在前)
     if (signCertResult.isOk()) {
-        dataArray.append(certInfoToJson(signCertResult.value()));
+        certs.append(signCertResult.value());
     }
 
     // 添加加密证书 (certType=1 在后)
     if (encCertResult.isOk()) {
-        dataArray.append(certInfoToJson(encCertResult.value()));
+        certs.append(encCertResult.value());
     }
 
     HttpResponse resp;
-    if (dataArray.isEmpty()) {
+    if (certs.isEmpty()) {
         // 两个证书都获取失败，返回签名证书的错误
         auto& err = signCertResult.isErr() ? signCertResult.error() : encCertResult.error();
         resp.setError(err);
     } else {
-        resp.setSuccess(QJsonValue(dataArray));
+        resp.setSuccessJson(encodeJsonList(certs));
     }
     return resp;
 }
 
 HttpResponse BusinessHandlers::handleSign(const HttpRequest& request) {
-    auto jsonResult = request.jsonBody();
-    if (jsonResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(jsonResult.error());
-        return resp;
-    }
+    const PayloadFormat replyFormat = responseFormat(request);
 
-    auto reqResult = SignRequest::fromJson(jsonResult.value());
+    auto reqResult = parsePayloadRequest<SignRequest>(request, "handleSign");
     if (reqResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(reqResult.error());
-        return resp;
+        return errorResponse(replyFormat, reqResult.error());
     }
 
     auto& req = reqResult.value();
 
     // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
     if (req.appName.isEmpty()) {
-        req.appName = Config::instance().defaultAppName();
+        req.appName = cfg->defaultAppName;
     }
     if (req.containerName.isEmpty()) {
-        req.containerName = Config::instance().defaultContainerName();
+        req.containerName = cfg->defaultContainerName;
     }
 
     auto valResult = req.validate();
     if (valResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(valResult.error());
-        return resp;
+        return errorResponse(replyFormat, valResult.error());
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
-    auto data = req.data.toUtf8();
     // 签名算法由插件根据容器密钥类型自动选择（SM2→SM3, RSA→SHA256）
     auto result = CertService::instance().sign(
-        req.serialNumber, req.appName, req.containerName, data);
-
-    HttpResponse resp;
+        req.serialNumber, req.appName, req.containerName, req.data);
     if (result.isErr()) {
-        resp.setError(result.error());
-    } else {
-        resp.setSuccess(QJsonValue(QString::fromLatin1(result.value().toBase64())));
+        return errorResponse(replyFormat, result.error());
     }
-    return resp;
+
+    return bytesResponse(replyFormat, result.value());
 }
 
+HttpResponse BusinessHandlers::handleEncrypt(const HttpRequest& request) {
+    return envelopeResponse(request, true);
+}
 
-HttpResponse BusinessHandlers::handleRandom(const HttpRequest& request) {
-    auto jsonResult = request.jsonBody();
-    if (jsonResult.isErr()) {
-        HttpResponse resp;
-        resp.setError(jsonResult.error());
-        return resp;
-    }
+HttpResponse BusinessHandlers::handleDecrypt(const HttpRequest& request) {
+    return envelopeResponse(request, false);
+}
 
-    auto reqResult = RandomRequest::fromJson(jsonResult.value());
+HttpResponse BusinessHandlers::handleRandom(const HttpRequest& request) {
+    auto reqResult = RandomRequest::fromJson(request.body);
     if (reqResult.isErr()) {
         HttpResponse resp;
         resp.setError(reqResult.error());
@@ -469,11 +683,12 @@ HttpResponse BusinessHandlers::handleRandom(const HttpRequest& request) {
         resp.setError(valResult.error());
         return resp;
     }
+    Metrics::DeviceInflight inflight(req.serialNumber);
 
     // count <= 0 时使用默认值
     int count = req.count;
     if (count <= 0) {
-        count = Config::instance().defaultRandomLength();
+        count = Config::instance().snapshot()->defaultRandomLength;
     }
 
     auto result = FileService::instance().generateRandom(req.serialNumber, count);
@@ -489,5 +704,108 @@ HttpResponse BusinessHandlers::handleRandom(const HttpRequest& request) {
     return resp;
 }
 
+HttpResponse BusinessHandlers::handleWriteFile(const HttpRequest& request) {
+    auto reqResult = parseWriteFileRequest(request);
+    if (reqResult.isErr()) {
+        HttpResponse resp;
+        resp.setError(reqResult.error());
+        return resp;
+    }
+
+    auto& req = reqResult.value();
+
+    // 填充默认值
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
+    if (req.appName.isEmpty()) {
+        req.appName = cfg->defaultAppName;
+    }
+
+    auto valResult = req.validate();
+    if (valResult.isErr()) {
+        HttpResponse resp;
+        resp.setError(valResult.error());
+        return resp;
+    }
+    Metrics::DeviceInflight inflight(req.serialNumber);
+
+    auto result = FileService::instance().writeFile(req.serialNumber, req.appName, req.fileName, req.data);
+
+    HttpResponse resp;
+    if (result.isErr()) {
+        resp.setError(result.error());
+    } else {
+        resp.setSuccess();
+    }
+    return resp;
+}
+
+HttpResponse BusinessHandlers::handleExecute(const HttpRequest& request) {
+    auto reqResult = ExecuteRequest::fromJson(request.body);
+    if (reqResult.isErr()) {
+        HttpResponse resp;
+        resp.setError(reqResult.error());
+        return resp;
+    }
+
+    auto& req = reqResult.value();
+
+    // 填充默认值：除 enumApps / generateRandom 外都需要应用，涉及容器的操作缺省使用默认容器
+    static const QSet<QString> kDeviceOps = {"enumApps", "generateRandom"};
+    static const QSet<QString> kContainerOps = {"createContainer", "deleteContainer", "generateKeyPair",
+                                                "generateCsr", "importCert", "importKeyCert",
+                                                "exportCert", "sign", "verify"};
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
+    for (auto& operation : req.operations) {
+        if (!kDeviceOps.contains(operation.op) && !operation.params.contains("appName")) {
+            operation.params["appName"] = cfg->defaultAppName;
+        }
+        if (kContainerOps.contains(operation.op) && !operation.params.contains("containerName")) {
+            operation.params["containerName"] = cfg->defaultContainerName;
+        }
+    }
+
+    auto valResult = req.validate();
+    if (valResult.isErr()) {
+        HttpResponse resp;
+        resp.setError(valResult.error());
+        return resp;
+    }
+    Metrics::DeviceInflight inflight(req.serialNumber);
+
+    auto result = OperationService::instance().execute(req.serialNumber, req.operations);
+
+    HttpResponse resp;
+    if (result.isErr()) {
+        resp.setError(result.error());
+        return resp;
+    }
+
+    // 步骤失败不影响 HTTP 状态，由各步骤的 status 和 succeeded 表示
+    QJsonArray steps;
+    bool succeeded = true;
+    for (const auto& step : result.value()) {
+        QJsonObject item;
+        item["id"] = step.id;
+        item["op"] = step.op;
+        item["status"] = operationStatusToString(step.status);
+        if (step.status == OperationResult::Status::Succeeded) {
+            item["output"] = operationOutputToJson(step.output);
+        } else {
+            succeeded = false;
+        }
+        if (step.status == OperationResult::Status::Failed) {
+            item["code"] = static_cast<qint64>(step.error.code());
+            item["message"] = step.error.friendlyMessage();
+        }
+        steps.append(item);
+    }
+
+    QJsonObject data;
+    data["succeeded"] = succeeded;
+    data["results"] = steps;
+    resp.setSuccess(data);
+    return resp;
+}
+
 }  // namespace api
 }  // namespace wekey
@@ -14,6 +14,9 @@ namespace api {
 
 /**
  * @brief 业务接口处理器（全部静态方法）
+ *
+ * 处理器在 HTTP 工作线程上同步调用服务层，设备操作期间占用该线程；
+ * 服务层的 *Async 接口目前只供 GUI 使用。
  */
 class BusinessHandlers {
 public:
@@ -25,6 +28,23 @@ public:
     static HttpResponse handleExportCert(const HttpRequest& request);
     static HttpResponse handleSign(const HttpRequest& request);
     static HttpResponse handleRandom(const HttpRequest& request);
+    static HttpResponse handleWriteFile(const HttpRequest& request);
+
+    /**
+     * @brief POST /api/v1/encrypt、/api/v1/decrypt：数字信封加解密
+     *
+     * 数据在主机上分块加密，设备只用于解开会话密钥；请求体编码与 handleSign 相同。
+     */
+    static HttpResponse handleEncrypt(const HttpRequest& request);
+    static HttpResponse handleDecrypt(const HttpRequest& request);
+
+    /**
+     * @brief POST /api/v1/execute：同一设备上的多步操作，一次请求、一次会话完成
+     *
+     * 每步的 output 中二进制结果（CSR、签名、文件内容等）为 Base64 文本，
+     * 二进制参数同样以 Base64 文本传入；"${id}" 引用前序步骤的输出。
+     */
+    static HttpResponse handleExecute(const HttpRequest& request);
 };
 
 }  // namespace api
@@ -0,0 +1,70 @@
+/**
+ * @file JobHandlers.cpp
+ * @brief 异步任务接口处理器实现
+ */
+
+#include "JobHandlers.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "api/JobManager.h"
+
+namespace wekey {
+namespace api {
+
+namespace {
+
+QJsonValue timeToJson(const QDateTime& time) {
+    return time.isValid() ? QJsonValue(time.toString(Qt::ISODateWithMs)) : QJsonValue();
+}
+
+QJsonObject jobToJson(const JobSnapshot& job) {
+    QJsonObject data;
+    data["id"] = job.id;
+    data["operation"] = job.operation;
+    data["status"] = jobStatusToString(job.status);
+    data["createdAt"] = timeToJson(job.createdAt);
+    data["finishedAt"] = timeToJson(job.finishedAt);
+
+    if (job.status == JobStatus::Succeeded || job.status == JobStatus::Failed) {
+        // 结果为原接口的完整响应信封；非 JSON 响应体不内嵌
+        data["httpStatus"] = job.result.statusCode;
+        QJsonDocument doc = QJsonDocument::fromJson(job.result.body);
+        data["result"] = doc.isObject() ? QJsonValue(doc.object()) : QJsonValue();
+    } else {
+        data["httpStatus"] = QJsonValue();
+        data["result"] = QJsonValue();
+    }
+    return data;
+}
+
+}  // namespace
+
+HttpResponse JobHandlers::handleGetJob(const HttpRequest& request) {
+    int waitMs = request.queryParams.value("wait").toInt();
+    auto result = JobManager::instance().get(request.pathParam("id"), waitMs);
+
+    HttpResponse resp;
+    if (result.isErr()) {
+        resp.setError(result.error());
+        return resp;
+    }
+    resp.setSuccess(jobToJson(result.value()));
+    return resp;
+}
+
+HttpResponse JobHandlers::handleCancelJob(const HttpRequest& request) {
+    auto result = JobManager::instance().cancel(request.pathParam("id"));
+
+    HttpResponse resp;
+    if (result.isErr()) {
+        resp.setError(result.error());
+    } else {
+        resp.setSuccess();
+    }
+    return resp;
+}
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,33 @@
+/**
+ * @file JobHandlers.h
+ * @brief 异步任务接口处理器
+ *
+ * 处理 /api/v1/jobs/{id} 的查询（长轮询）与取消
+ */
+
+#pragma once
+
+#include "api/dto/HttpTypes.h"
+
+namespace wekey {
+namespace api {
+
+/**
+ * @brief 异步任务接口处理器（全部静态方法）
+ */
+class JobHandlers {
+public:
+    /**
+     * @brief GET /api/v1/jobs/{id}?wait=毫秒
+     * @return {"code":0,"data":{"id","operation","status","createdAt","finishedAt","httpStatus","result"}}
+     */
+    static HttpResponse handleGetJob(const HttpRequest& request);
+
+    /**
+     * @brief DELETE /api/v1/jobs/{id} - 取消排队中的任务
+     */
+    static HttpResponse handleCancelJob(const HttpRequest& request);
+};
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,93 @@
+/**
+ * @file ProvisionHandlers.cpp
+ * @brief 批量初始化接口处理器实现
+ */
+
+#include "ProvisionHandlers.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "api/dto/Request.h"
+#include "core/provision/ProvisionService.h"
+
+namespace wekey {
+namespace api {
+
+namespace {
+
+QJsonObject statusToJson(const ProvisionStatus& status) {
+    QJsonArray devices;
+    for (const auto& p : status.devices) {
+        QJsonObject device;
+        device["serialNumber"] = p.serialNumber;
+        device["step"] = provisionStepToString(p.step);
+        device["state"] = provisionStateToString(p.state);
+        device["message"] = p.message;
+        device["csrPath"] = p.csrPath;
+        device["updatedAt"] = p.updatedAt.isValid() ? QJsonValue(p.updatedAt.toString(Qt::ISODateWithMs))
+                                                    : QJsonValue();
+        devices.append(device);
+    }
+
+    QJsonObject data;
+    data["running"] = status.running;
+    data["plan"] = status.planPath;
+    data["checkpoint"] = status.checkpoint;
+    data["devices"] = devices;
+    return data;
+}
+
+}  // namespace
+
+HttpResponse ProvisionHandlers::handleStart(const HttpRequest& request) {
+    auto reqResult = ProvisionRequest::fromJson(request.body);
+    if (reqResult.isErr()) {
+        HttpResponse resp;
+        resp.setError(reqResult.error());
+        return resp;
+    }
+
+    const auto& req = reqResult.value();
+    auto valResult = req.validate();
+    if (valResult.isErr()) {
+        HttpResponse resp;
+        resp.setError(valResult.error());
+        return resp;
+    }
+
+    auto& service = ProvisionService::instance();
+    auto result = service.start(req.plan, req.fresh);
+
+    HttpResponse resp;
+    if (result.isErr()) {
+        resp.setError(result.error());
+        return resp;
+    }
+    resp.setSuccess(statusToJson(service.status()));
+    resp.statusCode = 202;
+    resp.statusText = "Accepted";
+    resp.headers["Location"] = "/api/v1/provision";
+    return resp;
+}
+
+HttpResponse ProvisionHandlers::handleStatus(const HttpRequest& /*request*/) {
+    HttpResponse resp;
+    resp.setSuccess(statusToJson(ProvisionService::instance().status()));
+    return resp;
+}
+
+HttpResponse ProvisionHandlers::handleCancel(const HttpRequest& /*request*/) {
+    auto& service = ProvisionService::instance();
+    HttpResponse resp;
+    if (!service.isRunning()) {
+        resp.setError(Error(Error::NotFound, "没有正在进行的批量初始化", "handleCancel"));
+        return resp;
+    }
+    service.cancel();
+    resp.setSuccess();
+    return resp;
+}
+
+}  // namespace api
+}  // namespace wekey
@@ -0,0 +1,40 @@
+/**
+ * @file ProvisionHandlers.h
+ * @brief 批量初始化接口处理器
+ *
+ * 处理 /api/v1/provision 的启动、状态查询与取消；逐设备进度通过 SSE provision-progress 事件推送
+ */
+
+#pragma once
+
+#include "api/dto/HttpTypes.h"
+
+namespace wekey {
+namespace api {
+
+/**
+ * @brief 批量初始化接口处理器（全部静态方法）
+ */
+class ProvisionHandlers {
+public:
+    /**
+     * @brief POST /api/v1/provision - 按计划文件启动批量初始化
+     * @return 202，data 与 GET 相同
+     */
+    static HttpResponse handleStart(const HttpRequest& request);
+
+    /**
+     * @brief GET /api/v1/provision
+     * @return {"code":0,"data":{"running","plan","checkpoint","devices":[...]}}，
+     *         devices 每项为 {"serialNumber","step","state","message","csrPath","updatedAt"}
+     */
+    static HttpResponse handleStatus(const HttpRequest& request);
+
+    /**
+     * @brief DELETE /api/v1/provision - 请求取消，各设备完成当前步骤后停止
+     */
+    static HttpResponse handleCancel(const HttpRequest& request);
+};
+
+}  // namespace api
+}  // namespace wekey
@@ -7,6 +7,7 @@
 
 #include <QJsonObject>
 
+#include "common/Metrics.h"
 #include "config/Defaults.h"
 
 namespace wekey {
@@ -24,6 +25,13 @@ HttpResponse PublicHandlers::handleHealth(const HttpRequest& /*request*/) {
     return resp;
 }
 
+HttpResponse PublicHandlers::handleMetrics(const HttpRequest& /*request*/) {
+    HttpResponse resp;
+    resp.headers["Content-Type"] = "text/plain; version=0.0.4; charset=utf-8";
+    resp.body = Metrics::instance().renderPrometheus();
+    return resp;
+}
+
 HttpResponse PublicHandlers::handleExit(const HttpRequest& /*request*/) {
     HttpResponse resp;
     resp.setSuccess();
@@ -2,7 +2,7 @@
  * @file PublicHandlers.h
  * @brief 公共接口处理器 (M4.4.3I)
  *
- * 处理 /health 和 /exit 等公共端点
+ * 处理 /health、/metrics 和 /exit 等公共端点
  */
 
 #pragma once
@@ -17,7 +17,7 @@ namespace api {
 /**
  * @brief 公共接口处理器
  *
- * handleHealth 为静态方法（无状态），
+ * handleHealth / handleMetrics 为静态方法（无状态），
  * handleExit 为成员方法（需要发信号）
  */
 class PublicHandlers : public QObject {
@@ -32,6 +32,12 @@ public:
      */
     static HttpResponse handleHealth(const HttpRequest& request);
 
+    /**
+     * @brief GET /metrics - Prometheus 指标
+     * @return text/plain; version=0.0.4 格式的指标文本
+     */
+    static HttpResponse handleMetrics(const HttpRequest& request);
+
     /**
      * @brief GET /exit - 触发应用退出
      * @return 成功响应，随后发出 exitRequested 信号
@@ -0,0 +1,259 @@
+/**
+ * @file AppBootstrap.cpp
+ * @brief 应用启动公共流程实现
+ */
+
+#include "app/AppBootstrap.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QMessageLogger>
+#include <QStandardPaths>
+
+#include "config/Config.h"
+#include "log/Logger.h"
+#include "plugin/PluginManager.h"
+
+namespace wekey {
+
+AppBootstrap::~AppBootstrap() {
+    releaseSingleInstanceLock();
+}
+
+void AppBootstrap::releaseSingleInstanceLock() {
+    if (lockFile_ && lockFile_->isLocked()) {
+        lockFile_->unlock();
+    }
+}
+
+bool AppBootstrap::isPrimaryInstance() const {
+    return isPrimary_;
+}
+
+bool AppBootstrap::acquireSingleInstanceLock() {
+    // 使用 QLockFile 实现单例检测
+    QString lockPath = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    lockPath += "/wekey-skf.lock";
+
+    lockFile_ = std::make_unique<QLockFile>(lockPath);
+    lockFile_->setStaleLockTime(0);  // 不自动删除旧锁
+
+    if (lockFile_->tryLock(100)) {
+        isPrimary_ = true;
+        return true;
+    }
+
+    // 检查锁是否是由已死进程持有
+    qint64 pid;
+    QString hostname;
+    QString appname;
+
+    if (lockFile_->getLockInfo(&pid, &hostname, &appname)) {
+        // 检查进程是否仍在运行
+        // 这里简化处理，假设锁有效
+        isPrimary_ = false;
+        return false;
+    }
+
+    // 锁文件损坏或过期，强制删除并重试
+    lockFile_->removeStaleLockFile();
+    if (lockFile_->tryLock(100)) {
+        isPrimary_ = true;
+        return true;
+    }
+
+    isPrimary_ = false;
+    return false;
+}
+
+bool AppBootstrap::loadConfig() {
+    Config& config = Config::instance();
+    return config.load();
+}
+
+// Qt 消息处理器：将 qDebug/qInfo/qWarning/qCritical 转发到 Logger 单例
+// 从 ctx 提取文件名和行号追加到消息末尾，方便定位代码位置
+// 到达这里的消息已通过所属分类的过滤（全局级别已转换为分类规则，见 Logger::applyCategoryFilter），
+// 不再按级别过滤，logRules 打开的分类在全局级别更高时也能输出
+static void qtMessageHandler(QtMsgType type, const QMessageLogContext& ctx, const QString& msg) {
+    Logger& logger = Logger::instance();
+
+    // 提取文件名（去掉路径，只保留 basename）和行号
+    QString location;
+    if (ctx.file && ctx.line > 0) {
+        QString file = QString::fromUtf8(ctx.file);
+        int slash = file.lastIndexOf('/');
+        if (slash < 0) slash = file.lastIndexOf('\\');
+        file = (slash >= 0) ? file.mid(slash + 1) : file;
+        location = QString(" (%1:%2)").arg(file).arg(ctx.line);
+    }
+    QString fullMsg = msg + location;
+
+    // qCDebug(lcSkf) 等带分类的消息以分类名作为来源
+    QString source;
+    if (ctx.category && qstrcmp(ctx.category, "default") != 0) {
+        source = QString::fromLatin1(ctx.category);
+    }
+
+    switch (type) {
+        case QtDebugMsg:    logger.logFiltered(LogLevel::Debug, fullMsg, source); break;
+        case QtInfoMsg:     logger.logFiltered(LogLevel::Info, fullMsg, source);  break;
+        case QtWarningMsg:  logger.logFiltered(LogLevel::Warn, fullMsg, source);  break;
+        case QtCriticalMsg: logger.logFiltered(LogLevel::Error, fullMsg, source); break;
+        case QtFatalMsg:
+            // qFatal 随后会 abort，先等写线程把已入队的日志写出
+            logger.logFiltered(LogLevel::Error, fullMsg, source);
+            logger.flush();
+            break;
+    }
+}
+
+void AppBootstrap::initLogging() {
+    const ConfigSnapshotPtr config = Config::instance().snapshot();
+    Logger& logger = Logger::instance();
+
+    // 设置日志级别和附加分类规则（同时决定 qCDebug 是否求值）
+    logger.setCategoryRules(config->logRules);
+    LogLevel level = stringToLogLevel(config->logLevel);
+    logger.setLevel(level);
+
+    // 设置日志输出路径
+    QString logPath = config->logPath;
+    if (!logPath.isEmpty()) {
+        QDir dir(logPath);
+        if (!dir.exists()) {
+            dir.mkpath(".");
+        }
+
+        QString logFile = logPath + "/wekey-skf.log";
+        logger.setOutputPath(logFile);
+    }
+
+    // 将所有 qDebug/qInfo/qWarning/qCritical 转发到 Logger 单例
+    qInstallMessageHandler(qtMessageHandler);
+
+    LOG_INFO(QString("日志系统初始化，级别: %1").arg(config->logLevel));
+}
+
+QMap<QString, QString> AppBootstrap::configuredPluginPaths() {
+    Config& config = Config::instance();
+    QJsonObject paths = config.modPaths();
+
+    // 策略：用户配置的模块优先，无配置时用内置模块兜底
+    if (paths.isEmpty()) {
+        LOG_INFO("用户未配置任何模块，尝试注册内置 SKF 库");
+        QString builtinPath = registerBuiltinModule();
+        if (!builtinPath.isEmpty()) {
+            paths = config.modPaths();
+        }
+    } else {
+        LOG_INFO(QString("从配置加载 %1 个用户模块").arg(paths.size()));
+    }
+
+    QMap<QString, QString> result;
+    for (auto it = paths.begin(); it != paths.end(); ++it) {
+        result.insert(it.key(), it.value().toString());
+    }
+    return result;
+}
+
+void AppBootstrap::loadPlugins() {
+    auto& pm = PluginManager::instance();
+    const auto paths = configuredPluginPaths();
+
+    for (auto it = paths.cbegin(); it != paths.cend(); ++it) {
+        auto result = pm.registerPlugin(it.key(), it.value());
+        if (result.isOk()) {
+            LOG_INFO(QString("已加载模块: %1 (%2)").arg(it.key(), it.value()));
+        } else {
+            LOG_ERROR(QString("加载模块失败: %1 (%2)").arg(it.key(), result.error().message()));
+        }
+    }
+
+    QString activeName = Config::instance().activedModName();
+    if (!activeName.isEmpty() && pm.listPlugins().contains(activeName)) {
+        pm.setActivePlugin(activeName);
+        LOG_INFO(QString("已激活模块: %1").arg(activeName));
+    }
+}
+
+void AppBootstrap::loadPluginsAsync() {
+    auto& pm = PluginManager::instance();
+    const auto paths = configuredPluginPaths();
+    const QString activeName = Config::instance().activedModName();
+
+    QObject::connect(&pm, &PluginManager::pluginsReady, &pm, [paths]() {
+        LOG_INFO(QString("模块加载完成: %1 个，激活: %2")
+                     .arg(paths.size())
+                     .arg(PluginManager::instance().activePluginName()));
+    }, Qt::SingleShotConnection);
+    pm.registerPluginsAsync(paths, activeName);
+}
+
+QString AppBootstrap::registerBuiltinModule() {
+    QString libPath = findBuiltinLibPath();
+    if (libPath.isEmpty()) {
+        LOG_INFO("未找到内置 SKF 库，跳过内置模块注册");
+        return {};
+    }
+
+    Config& config = Config::instance();
+    config.update([&](ConfigSnapshot& s) {
+        s.modPaths["gm3000"] = libPath;
+        s.activedModName = "gm3000";
+    });
+    config.save();
+
+    LOG_INFO(QString("已注册内置模块: gm3000 (%1)").arg(libPath));
+    return libPath;
+}
+
+QString AppBootstrap::findBuiltinLibPath() {
+    QString appDir = QCoreApplication::applicationDirPath();
+
+#ifdef Q_OS_MACOS
+    QString libName = "libgm3000.dylib";
+#elif defined(Q_OS_WIN)
+    QString libName = "mtoken_gm3000.dll";
+#else
+    QString libName = "libgm3000.so";
+#endif
+
+    // 按优先级搜索内置 SKF 库位置
+    QStringList searchPaths;
+
+#ifdef Q_OS_MACOS
+    // macOS 打包环境: wekey-skf.app/Contents/MacOS/../Frameworks/
+    searchPaths << appDir + "/../Frameworks/" + libName;
+#endif
+
+#ifdef Q_OS_WIN
+    // Windows 打包环境: exe 同目录
+    searchPaths << appDir + "/" + libName;
+#endif
+
+    // 开发环境: build/lib/ (CMake POST_BUILD 拷贝的位置)
+    // macOS .app bundle: appDir = build/src/app/wekey-skf.app/Contents/MacOS
+    //   -> ../../../../../lib = build/lib
+    // Linux/Windows 非 bundle: appDir = build/src/app
+    //   -> ../../lib = build/lib
+    searchPaths << appDir + "/../../../../../lib/" + libName;
+    searchPaths << appDir + "/../../lib/" + libName;
+
+    for (const auto& candidate : searchPaths) {
+        QString absPath = QDir(candidate).absolutePath();
+        // QDir::absolutePath 会规范化路径中的 .. 等
+        QFileInfo fi(absPath);
+        if (fi.exists() && fi.isFile()) {
+            LOG_INFO(QString("找到内置 SKF 库: %1").arg(absPath));
+            return absPath;
+        }
+        LOG_DEBUG(QString("内置 SKF 库候选路径不存在: %1").arg(absPath));
+    }
+
+    return {};
+}
+
+}  // namespace wekey
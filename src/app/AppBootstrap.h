@@ -0,0 +1,95 @@
+/**
+ * @file AppBootstrap.h
+ * @brief 应用启动公共流程
+ *
+ * GUI（wekey-skf）与无界面守护进程（wekey-skfd）共用的启动步骤：
+ * 单例锁、配置加载、日志初始化、插件恢复。仅依赖 QtCore。
+ */
+
+#pragma once
+
+#include <QLockFile>
+#include <QMap>
+#include <QString>
+#include <memory>
+
+namespace wekey {
+
+/**
+ * @brief 应用启动公共流程
+ */
+class AppBootstrap {
+public:
+    AppBootstrap() = default;
+    ~AppBootstrap();
+
+    AppBootstrap(const AppBootstrap&) = delete;
+    AppBootstrap& operator=(const AppBootstrap&) = delete;
+
+    /**
+     * @brief 尝试获取单例锁（GUI 与守护进程共用同一把锁，二者不能同时运行）
+     * @return 成功获取锁返回 true
+     */
+    bool acquireSingleInstanceLock();
+
+    /**
+     * @brief 释放单例锁
+     */
+    void releaseSingleInstanceLock();
+
+    /**
+     * @brief 是否持有单例锁
+     */
+    [[nodiscard]] bool isPrimaryInstance() const;
+
+    /**
+     * @brief 加载配置
+     * @return 成功返回 true
+     */
+    static bool loadConfig();
+
+    /**
+     * @brief 初始化日志系统，并将 qDebug 等转发到 Logger
+     */
+    static void initLogging();
+
+    /**
+     * @brief 从配置恢复已注册的插件
+     */
+    static void loadPlugins();
+
+    /**
+     * @brief 在后台线程恢复插件，完成时 PluginManager 发出 pluginsReady
+     */
+    static void loadPluginsAsync();
+
+private:
+    /**
+     * @brief 读取配置中的模块路径（无配置时注册内置模块）
+     * @return 插件名称 -> 库路径
+     */
+    static QMap<QString, QString> configuredPluginPaths();
+
+    /**
+     * @brief 注册内置 SKF 模块（仅在用户未配置任何模块时调用）
+     * @return 模块路径，未找到返回空字符串
+     */
+    static QString registerBuiltinModule();
+
+    /**
+     * @brief 搜索内置 SKF 库路径
+     *
+     * 按优先级搜索以下位置：
+     * - macOS 打包: Contents/Frameworks/libgm3000.dylib
+     * - Windows 打包: exe 同目录/mtoken_gm3000.dll
+     * - 开发环境: build/lib/ 下的库文件
+     *
+     * @return 找到的库路径，未找到返回空字符串
+     */
+    static QString findBuiltinLibPath();
+
+    std::unique_ptr<QLockFile> lockFile_;
+    bool isPrimary_{false};
+};
+
+}  // namespace wekey
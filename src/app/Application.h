@@ -8,9 +8,8 @@
 #pragma once
 
 #include <QApplication>
-#include <QLockFile>
-#include <QSharedMemory>
-#include <memory>
+
+#include "app/AppBootstrap.h"
 
 namespace wekey {
 
@@ -45,6 +44,7 @@ public:
      * 1. 检测单例实例
      * 2. 加载配置文件
      * 3. 初始化日志系统
+     * 4. 在后台线程恢复插件（完成时 PluginManager 发出 pluginsReady）
      *
      * @return 初始化成功返回 true
      */
@@ -70,48 +70,7 @@ signals:
     void secondInstanceStarted();
 
 private:
-    /**
-     * @brief 尝试获取单例锁
-     * @return 成功获取锁返回 true
-     */
-    bool acquireSingleInstanceLock();
-
-    /**
-     * @brief 加载配置
-     * @return 成功返回 true
-     */
-    bool loadConfig();
-
-    /**
-     * @brief 初始化日志系统
-     */
-    void initLogging();
-
-    /**
-     * @brief 从配置恢复已注册的插件
-     */
-    void loadPlugins();
-
-    /**
-     * @brief 注册内置 SKF 模块（仅在用户未配置任何模块时调用）
-     * @return 模块路径，未找到返回空字符串
-     */
-    QString registerBuiltinModule();
-
-    /**
-     * @brief 搜索内置 SKF 库路径
-     *
-     * 按优先级搜索以下位置：
-     * - macOS 打包: Contents/Frameworks/libgm3000.dylib
-     * - Windows 打包: exe 同目录/mtoken_gm3000.dll
-     * - 开发环境: build/lib/ 下的库文件
-     *
-     * @return 找到的库路径，未找到返回空字符串
-     */
-    QString findBuiltinLibPath() const;
-
-    std::unique_ptr<QLockFile> lockFile_;
-    bool isPrimary_{false};
+    AppBootstrap bootstrap_;
 };
 
 }  // namespace wekey
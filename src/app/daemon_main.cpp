@@ -0,0 +1,170 @@
+/**
+ * @file daemon_main.cpp
+ * @brief 无界面 API 守护进程入口（wekey-skfd）
+ *
+ * 基于 QCoreApplication，不依赖 Qt Widgets / ElaWidgetTools：
+ * 仅启动 HTTP API 和设备监控，收到 SIGTERM/SIGINT 后优雅退出。
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+#include "api/ApiRouter.h"
+#include "api/HttpServer.h"
+#include "api/handlers/PublicHandlers.h"
+#include "app/AppBootstrap.h"
+#include "common/StartupProfile.h"
+#include "config/Config.h"
+#include "core/device/DeviceService.h"
+#include "log/Logger.h"
+
+using namespace wekey;
+
+namespace {
+
+#ifdef Q_OS_UNIX
+// 信号处理函数中只能做异步信号安全的操作：写一个字节到 socketpair，
+// 由事件循环中的 QSocketNotifier 读取后再调用 quit()
+int signalFds[2] = {-1, -1};
+
+void onTerminateSignal(int /*signum*/) {
+    char c = 1;
+    if (::write(signalFds[0], &c, sizeof(c)) < 0) {
+        // 无法通知事件循环，忽略
+    }
+}
+
+void installSignalHandlers(QCoreApplication& app) {
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) != 0) {
+        LOG_WARN("创建信号通知管道失败，SIGTERM 将直接终止进程");
+        return;
+    }
+
+    auto* notifier = new QSocketNotifier(signalFds[1], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, [notifier]() {
+        notifier->setEnabled(false);
+        char c = 0;
+        if (::read(signalFds[1], &c, sizeof(c)) < 0) {
+            // 读取失败不影响退出
+        }
+        LOG_INFO("收到退出信号，正在关闭");
+        QCoreApplication::quit();
+    });
+
+    struct sigaction sa = {};
+    sa.sa_handler = onTerminateSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGTERM, &sa, nullptr);
+    sigaction(SIGINT, &sa, nullptr);
+}
+#elif defined(Q_OS_WIN)
+// 控制台事件在独立线程中回调，通过队列调用回到主线程
+BOOL WINAPI onConsoleCtrl(DWORD /*type*/) {
+    QMetaObject::invokeMethod(QCoreApplication::instance(), []() { QCoreApplication::quit(); },
+                              Qt::QueuedConnection);
+    return TRUE;
+}
+
+void installSignalHandlers(QCoreApplication& /*app*/) {
+    SetConsoleCtrlHandler(onConsoleCtrl, TRUE);
+}
+#else
+void installSignalHandlers(QCoreApplication& /*app*/) {}
+#endif
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QElapsedTimer startup;
+    startup.start();
+    StartupProfile::begin(argc, argv);
+
+    QCoreApplication app(argc, argv);
+    StartupProfile::mark("QCoreApplication constructed");
+    app.setApplicationName("wekey-skfd");
+    app.setApplicationVersion("1.0.0");
+    app.setOrganizationName("TrustAsia");
+    app.setOrganizationDomain("trustasia.com");
+
+    // 与 GUI 共用单例锁：二者操作同一批设备和端口，不能同时运行
+    AppBootstrap bootstrap;
+    if (!bootstrap.acquireSingleInstanceLock()) {
+        LOG_ERROR("wekey-skf 或 wekey-skfd 已在运行");
+        return 1;
+    }
+
+    if (!AppBootstrap::loadConfig()) {
+        LOG_ERROR("加载配置失败");
+        return 1;
+    }
+    StartupProfile::mark("config loaded");
+    AppBootstrap::initLogging();
+    StartupProfile::mark("logging ready");
+    // 无界面可绘制，插件同步加载，保证开始监听时模块已激活
+    AppBootstrap::loadPlugins();
+    StartupProfile::mark("plugins loaded");
+    installSignalHandlers(app);
+
+    LOG_INFO("wekey-skfd 启动");
+
+    // 声明顺序保证 httpServer 先于 router 析构（析构时等待在途请求）
+    auto* publicHandlers = new api::PublicHandlers(&app);
+    api::ApiRouter router;
+    router.setupRoutes(publicHandlers);
+
+    api::HttpServer httpServer;
+    httpServer.setRouter(&router);
+
+    QString portStr = Config::instance().listenPort();
+    portStr.remove(':');
+    int port = portStr.toInt();
+    if (port == 0) port = 9001;
+
+    auto result = httpServer.start(port);
+    if (result.isErr()) {
+        LOG_ERROR(QString("HTTP API 启动失败: %1").arg(result.error().message()));
+        return 1;
+    }
+    LOG_INFO(QString("HTTP API 已启动: :%1").arg(port));
+    StartupProfile::mark("HTTP API listening");
+
+    QString socketPath = Config::instance().listenSocket();
+    if (!socketPath.isEmpty()) {
+        auto localResult = httpServer.startLocal(socketPath);
+        if (localResult.isOk()) {
+            LOG_INFO(QString("HTTP API 本地套接字已启动: %1").arg(httpServer.localPath()));
+        } else {
+            LOG_ERROR(QString("HTTP API 本地套接字启动失败: %1").arg(localResult.error().message()));
+        }
+    }
+
+    DeviceService::instance().startDeviceMonitor();
+
+    QObject::connect(publicHandlers, &api::PublicHandlers::exitRequested, &app, &QCoreApplication::quit);
+
+    StartupProfile::mark("ready");
+    StartupProfile::print();
+    LOG_INFO(QString("wekey-skfd 就绪，启动耗时 %1 ms").arg(startup.elapsed()));
+    int exitCode = app.exec();
+
+    // 先停止接收新请求，再停止设备监控；在途请求由 HttpServer 析构等待完成
+    httpServer.stop();
+    DeviceService::instance().stopDeviceMonitor();
+    LOG_INFO("wekey-skfd 已退出");
+    // 写出队列中剩余的日志后再退出
+    Logger::instance().shutdown();
+    return exitCode;
+}
@@ -6,6 +6,8 @@
 #include <QMessageBox>
 #include <QTimer>
 
+#include <memory>
+
 #include <ElaApplication.h>
 #include <ElaMessageBar.h>
 
@@ -13,17 +15,24 @@
 #include "api/HttpServer.h"
 #include "api/handlers/PublicHandlers.h"
 #include "app/Application.h"
+#include "common/StartupProfile.h"
 #include "config/Config.h"
+#include "core/device/DeviceService.h"
 #include "gui/MainWindow.h"
 #include "log/Logger.h"
+#include "plugin/PluginManager.h"
 
 using namespace wekey;
 
 int main(int argc, char* argv[]) {
+    StartupProfile::begin(argc, argv);
+
     Application app(argc, argv);
+    StartupProfile::mark("QApplication constructed");
 
     // 初始化 ElaWidgetTools 主题引擎
     eApp->init();
+    StartupProfile::mark("theme initialized");
 
     if (!app.initialize()) {
         QMessageBox::critical(nullptr, "错误", "应用程序初始化失败");
@@ -39,9 +48,23 @@ int main(int argc, char* argv[]) {
 
     // 创建并显示主窗口
     MainWindow mainWindow;
+    StartupProfile::mark("main window constructed");
     mainWindow.show();
-
-    // 启动 HTTP API 服务器
+    StartupProfile::mark("main window shown");
+
+    // 启动时间线在首帧绘制和插件加载都完成后输出
+    auto pendingPhases = std::make_shared<int>(2);
+    auto phaseDone = [pendingPhases]() {
+        if (--*pendingPhases == 0) {
+            StartupProfile::print();
+        }
+    };
+    QTimer::singleShot(0, &mainWindow, [phaseDone]() {
+        StartupProfile::mark("first event loop turn");
+        phaseDone();
+    });
+
+    // 创建 HTTP API 服务器
     auto* publicHandlers = new api::PublicHandlers(&app);
     auto* router = new api::ApiRouter;
     router->setupRoutes(publicHandlers);
@@ -54,41 +77,74 @@ int main(int argc, char* argv[]) {
     int port = portStr.toInt();
     if (port == 0) port = 9001;
 
-    auto result = httpServer->start(port);
     MainWindow* mainWindowPtr = &mainWindow;
 
-    if (result.isOk()) {
-        LOG_INFO(QString("HTTP API 已启动: :%1").arg(port));
-        ElaMessageBar::success(ElaMessageBarType::TopRight, "HTTP API 已启动",
-            QString("监听端口: %1").arg(port), 3000, mainWindowPtr);
-
-        // 定期检查 HTTP 服务器状态，防止端口被其他程序占用
-        auto* statusChecker = new QTimer(&app);
-        QObject::connect(statusChecker, &QTimer::timeout, [httpServer, mainWindowPtr, port]() {
-            static bool wasListening = true;
-            if (wasListening && !httpServer->isListening()) {
-                wasListening = false;
-                LOG_ERROR(QString("HTTP API 已停止监听端口 %1，可能被其他程序占用").arg(port));
-                ElaMessageBar::error(ElaMessageBarType::TopRight, "HTTP API 异常",
-                    QString("端口 %1 已被其他程序占用，API 功能已失效").arg(port),
-                    10000, mainWindowPtr);
+    // 插件在后台加载，完成后再开始监听，避免早到的请求得到"驱动模块未激活"
+    auto startHttpApi = [&app, httpServer, mainWindowPtr, port, phaseDone]() {
+        StartupProfile::mark("plugins ready");
+        auto result = httpServer->start(port);
+
+        if (result.isOk()) {
+            LOG_INFO(QString("HTTP API 已启动: :%1").arg(port));
+            ElaMessageBar::success(ElaMessageBarType::TopRight, "HTTP API 已启动",
+                QString("监听端口: %1").arg(port), 3000, mainWindowPtr);
+
+            // 定期检查 HTTP 服务器状态，防止端口被其他程序占用
+            auto* statusChecker = new QTimer(&app);
+            QObject::connect(statusChecker, &QTimer::timeout, [httpServer, mainWindowPtr, port]() {
+                static bool wasListening = true;
+                if (wasListening && !httpServer->isListening()) {
+                    wasListening = false;
+                    LOG_ERROR(QString("HTTP API 已停止监听端口 %1，可能被其他程序占用").arg(port));
+                    ElaMessageBar::error(ElaMessageBarType::TopRight, "HTTP API 异常",
+                        QString("端口 %1 已被其他程序占用，API 功能已失效").arg(port),
+                        10000, mainWindowPtr);
+                }
+            });
+            // 每 30 秒检查一次
+            statusChecker->start(30000);
+        } else {
+            LOG_ERROR(QString("HTTP API 启动失败: %1").arg(result.error().message()));
+            ElaMessageBar::error(ElaMessageBarType::TopRight, "HTTP API 启动失败",
+                QString("端口 %1 可能已被占用，API 功能将不可用。\n%2")
+                    .arg(port)
+                    .arg(result.error().message()), 8000, mainWindowPtr);
+        }
+
+        // 可选：本地套接字监听（同机客户端）
+        QString socketPath = Config::instance().listenSocket();
+        if (!socketPath.isEmpty()) {
+            auto localResult = httpServer->startLocal(socketPath);
+            if (localResult.isOk()) {
+                LOG_INFO(QString("HTTP API 本地套接字已启动: %1").arg(httpServer->localPath()));
+            } else {
+                LOG_ERROR(QString("HTTP API 本地套接字启动失败: %1").arg(localResult.error().message()));
             }
-        });
-        // 每 30 秒检查一次
-        statusChecker->start(30000);
+        }
+
+        StartupProfile::mark("HTTP API listening");
+
+        // 插拔事件驱动设备页刷新和 /api/v1/events 推送；需要已激活的驱动插件
+        DeviceService::instance().startDeviceMonitor();
+        phaseDone();
+    };
+
+    if (PluginManager::instance().isReady()) {
+        startHttpApi();
     } else {
-        LOG_ERROR(QString("HTTP API 启动失败: %1").arg(result.error().message()));
-        ElaMessageBar::error(ElaMessageBarType::TopRight, "HTTP API 启动失败",
-            QString("端口 %1 可能已被占用，API 功能将不可用。\n%2")
-                .arg(port)
-                .arg(result.error().message()), 8000, mainWindowPtr);
+        QObject::connect(&PluginManager::instance(), &PluginManager::pluginsReady, &app, startHttpApi,
+                         Qt::SingleShotConnection);
     }
 
     QObject::connect(publicHandlers, &api::PublicHandlers::exitRequested, &app, &QApplication::quit);
 
     int exitCode = app.exec();
 
+    // 先停止接收新请求，再停止设备监控
     httpServer->stop();
+    DeviceService::instance().stopDeviceMonitor();
     app.shutdown();
+    // 写出队列中剩余的日志后再退出
+    Logger::instance().shutdown();
     return exitCode;
 }
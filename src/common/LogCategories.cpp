@@ -0,0 +1,14 @@
+/**
+ * @file LogCategories.cpp
+ * @brief 各子系统的 Qt 日志分类定义
+ */
+
+#include "LogCategories.h"
+
+namespace wekey {
+
+Q_LOGGING_CATEGORY(lcSkf, "wekey.skf")
+Q_LOGGING_CATEGORY(lcApi, "wekey.api")
+Q_LOGGING_CATEGORY(lcGui, "wekey.gui")
+
+}  // namespace wekey
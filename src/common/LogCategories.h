@@ -0,0 +1,20 @@
+/**
+ * @file LogCategories.h
+ * @brief 各子系统的 Qt 日志分类
+ *
+ * qCDebug(lcSkf) 等宏在分类未启用时不会求值参数，适合热路径上的十六进制转储等调试输出。
+ * 分类的启用状态由 Logger::setLevel() 和配置 logRules 统一设置，
+ * 也可通过环境变量 QT_LOGGING_RULES 临时覆盖，例如 "wekey.skf.debug=true"。
+ */
+
+#pragma once
+
+#include <QLoggingCategory>
+
+namespace wekey {
+
+Q_DECLARE_LOGGING_CATEGORY(lcSkf)  ///< wekey.skf：SKF 插件与驱动调用
+Q_DECLARE_LOGGING_CATEGORY(lcApi)  ///< wekey.api：HTTP API 处理
+Q_DECLARE_LOGGING_CATEGORY(lcGui)  ///< wekey.gui：界面交互
+
+}  // namespace wekey
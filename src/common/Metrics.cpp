@@ -0,0 +1,290 @@
+/**
+ * @file Metrics.cpp
+ * @brief 运行时指标注册表实现
+ */
+
+#include "Metrics.h"
+
+#include <QMutexLocker>
+
+namespace wekey {
+
+namespace {
+
+/// 转义 Prometheus 标签值中的反斜杠、双引号和换行
+QByteArray escapeLabel(const QString& value) {
+    QByteArray raw = value.toUtf8();
+    QByteArray out;
+    out.reserve(raw.size());
+    for (char c : raw) {
+        if (c == '\\' || c == '"') {
+            out.append('\\').append(c);
+        } else if (c == '\n') {
+            out.append("\\n");
+        } else {
+            out.append(c);
+        }
+    }
+    return out;
+}
+
+void appendHeader(QByteArray& out, const char* name, const char* type, const char* help) {
+    out.append("# HELP ").append(name).append(' ').append(help).append('\n');
+    out.append("# TYPE ").append(name).append(' ').append(type).append('\n');
+}
+
+void appendSample(QByteArray& out, const char* name, const QByteArray& labels, const QByteArray& value) {
+    out.append(name);
+    if (!labels.isEmpty()) {
+        out.append('{').append(labels).append('}');
+    }
+    out.append(' ').append(value).append('\n');
+}
+
+QByteArray microsToSeconds(uint64_t micros) {
+    return QByteArray::number(static_cast<double>(micros) / 1e6, 'g', 12);
+}
+
+constexpr const char* kLogLevelNames[] = {"debug", "info", "warn", "error"};
+constexpr const char* kCacheNames[] = {"device_info", "response", "key_pool", "public_key"};
+
+}  // namespace
+
+// ==============================================================================
+// LatencyHistogram
+// ==============================================================================
+
+void LatencyHistogram::observe(int64_t micros) {
+    if (micros < 0) {
+        micros = 0;
+    }
+    size_t idx = 0;
+    while (idx < kBoundsUs.size() && micros > kBoundsUs[idx]) {
+        ++idx;
+    }
+    buckets_[idx].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumUs_.fetch_add(static_cast<uint64_t>(micros), std::memory_order_relaxed);
+}
+
+void LatencyHistogram::render(QByteArray& out, const char* name, const QByteArray& labels) const {
+    const QByteArray bucketName = QByteArray(name) + "_bucket";
+    const QByteArray prefix = labels.isEmpty() ? QByteArray() : labels + ',';
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kBoundsUs.size(); ++i) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        appendSample(out, bucketName.constData(),
+                     prefix + "le=\"" + microsToSeconds(static_cast<uint64_t>(kBoundsUs[i])) + '"',
+                     QByteArray::number(cumulative));
+    }
+    cumulative += buckets_[kBoundsUs.size()].load(std::memory_order_relaxed);
+    appendSample(out, bucketName.constData(), prefix + "le=\"+Inf\"", QByteArray::number(cumulative));
+    appendSample(out, (QByteArray(name) + "_sum").constData(), labels,
+                 microsToSeconds(sumUs_.load(std::memory_order_relaxed)));
+    appendSample(out, (QByteArray(name) + "_count").constData(), labels, QByteArray::number(cumulative));
+}
+
+// ==============================================================================
+// Metrics
+// ==============================================================================
+
+Metrics& Metrics::instance() {
+    static Metrics instance;
+    return instance;
+}
+
+Metrics::Metrics() {
+    routes_[0].labels = "method=\"*\",route=\"unmatched\"";
+    routeCount_.store(1, std::memory_order_release);
+}
+
+int Metrics::registerRoute(const QString& method, const QString& route) {
+    QByteArray labels = "method=\"" + escapeLabel(method) + "\",route=\"" + escapeLabel(route) + '"';
+
+    QMutexLocker locker(&registerMutex_);
+    int count = routeCount_.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (routes_[i].labels == labels) {
+            return i;
+        }
+    }
+    if (count >= kMaxRoutes) {
+        return unmatchedRoute();
+    }
+    routes_[count].labels = labels;
+    routeCount_.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void Metrics::recordRequest(int routeId, int statusCode, int64_t micros) {
+    if (routeId < 0 || routeId >= routeCount_.load(std::memory_order_acquire)) {
+        routeId = unmatchedRoute();
+    }
+    auto& slot = routes_[routeId];
+
+    size_t statusIdx = kStatusCodes.size() - 1;  // 0 表示 "other"
+    for (size_t i = 0; i + 1 < kStatusCodes.size(); ++i) {
+        if (kStatusCodes[i] == statusCode) {
+            statusIdx = i;
+            break;
+        }
+    }
+    slot.byStatus[statusIdx].fetch_add(1, std::memory_order_relaxed);
+    slot.latency.observe(micros);
+}
+
+std::atomic<int64_t>* Metrics::deviceGauge(const QString& serialNumber) {
+    // 快路径：无锁查找已发布的槽位（槽位一经发布 serialNumber 不再修改）
+    int count = deviceCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        if (devices_[i].serialNumber == serialNumber) {
+            return &devices_[i].inflight;
+        }
+    }
+
+    QMutexLocker locker(&registerMutex_);
+    count = deviceCount_.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (devices_[i].serialNumber == serialNumber) {
+            return &devices_[i].inflight;
+        }
+    }
+    if (count >= kMaxDevices) {
+        return &deviceOverflow_;
+    }
+    devices_[count].serialNumber = serialNumber;
+    deviceCount_.store(count + 1, std::memory_order_release);
+    return &devices_[count].inflight;
+}
+
+Metrics::DeviceInflight::DeviceInflight(const QString& serialNumber)
+    : gauge_(Metrics::instance().deviceGauge(serialNumber)) {
+    gauge_->fetch_add(1, std::memory_order_relaxed);
+}
+
+Metrics::DeviceInflight::~DeviceInflight() {
+    gauge_->fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordLog(int level, int64_t bytes) {
+    if (level < 0 || level >= static_cast<int>(logLines_.size())) {
+        return;
+    }
+    logLines_[level].fetch_add(1, std::memory_order_relaxed);
+    logBytes_.fetch_add(static_cast<uint64_t>(bytes), std::memory_order_relaxed);
+}
+
+void Metrics::recordLogDropped(int level) {
+    if (level < 0 || level >= static_cast<int>(logDropped_.size())) {
+        return;
+    }
+    logDropped_[level].fetch_add(1, std::memory_order_relaxed);
+}
+
+QByteArray Metrics::renderPrometheus() const {
+    QByteArray out;
+    out.reserve(16 * 1024);
+
+    const int routeCount = routeCount_.load(std::memory_order_acquire);
+
+    // HTTP 请求计数
+    appendHeader(out, "wekey_http_requests_total", "counter", "HTTP requests by route and status.");
+    for (int r = 0; r < routeCount; ++r) {
+        const auto& slot = routes_[r];
+        for (size_t s = 0; s < kStatusCodes.size(); ++s) {
+            uint64_t n = slot.byStatus[s].load(std::memory_order_relaxed);
+            if (n == 0) {
+                continue;
+            }
+            QByteArray status = kStatusCodes[s] == 0 ? QByteArray("other") : QByteArray::number(kStatusCodes[s]);
+            appendSample(out, "wekey_http_requests_total", slot.labels + ",status=\"" + status + '"',
+                         QByteArray::number(n));
+        }
+    }
+
+    // HTTP 请求延迟
+    appendHeader(out, "wekey_http_request_duration_seconds", "histogram",
+                 "Time spent in ApiRouter::handleRequest.");
+    for (int r = 0; r < routeCount; ++r) {
+        if (routes_[r].latency.count() == 0) {
+            continue;
+        }
+        routes_[r].latency.render(out, "wekey_http_request_duration_seconds", routes_[r].labels);
+    }
+
+    // 线程池
+    appendHeader(out, "wekey_http_pool_queue_depth", "gauge", "Requests waiting for a worker thread.");
+    appendSample(out, "wekey_http_pool_queue_depth", {},
+                 QByteArray::number(static_cast<qlonglong>(poolQueued_.load(std::memory_order_relaxed))));
+    appendHeader(out, "wekey_http_pool_active_workers", "gauge", "Worker threads executing requests.");
+    appendSample(out, "wekey_http_pool_active_workers", {},
+                 QByteArray::number(static_cast<qlonglong>(poolActive_.load(std::memory_order_relaxed))));
+    appendHeader(out, "wekey_http_pool_rejected_total", "counter", "Requests rejected because the queue was full.");
+    appendSample(out, "wekey_http_pool_rejected_total", {},
+                 QByteArray::number(poolRejected_.load(std::memory_order_relaxed)));
+    appendHeader(out, "wekey_http_coalesced_total", "counter", "Requests served by joining an identical in-flight request.");
+    appendSample(out, "wekey_http_coalesced_total", {},
+                 QByteArray::number(coalesced_.load(std::memory_order_relaxed)));
+
+    // 事件流
+    appendHeader(out, "wekey_sse_subscribers", "gauge", "Open /api/v1/events streams.");
+    appendSample(out, "wekey_sse_subscribers", {},
+                 QByteArray::number(static_cast<qlonglong>(sseSubscribers_.load(std::memory_order_relaxed))));
+    appendHeader(out, "wekey_sse_dropped_events_total", "counter", "Events dropped from full subscriber buffers.");
+    appendSample(out, "wekey_sse_dropped_events_total", {},
+                 QByteArray::number(sseDropped_.load(std::memory_order_relaxed)));
+
+    // 设备在途请求
+    appendHeader(out, "wekey_device_inflight_requests", "gauge", "In-flight requests per device.");
+    const int deviceCount = deviceCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < deviceCount; ++i) {
+        appendSample(out, "wekey_device_inflight_requests",
+                     "serial=\"" + escapeLabel(devices_[i].serialNumber) + '"',
+                     QByteArray::number(static_cast<qlonglong>(devices_[i].inflight.load(std::memory_order_relaxed))));
+    }
+    if (deviceCount >= kMaxDevices) {
+        appendSample(out, "wekey_device_inflight_requests", "serial=\"other\"",
+                     QByteArray::number(static_cast<qlonglong>(deviceOverflow_.load(std::memory_order_relaxed))));
+    }
+
+    // 插件锁等待
+    appendHeader(out, "wekey_plugin_lock_wait_seconds", "histogram", "Time spent waiting for the driver plugin lock.");
+    pluginLockWait_.render(out, "wekey_plugin_lock_wait_seconds", {});
+
+    // 缓存
+    appendHeader(out, "wekey_cache_lookups_total", "counter", "Cache lookups by result.");
+    for (int c = 0; c < CacheCount; ++c) {
+        QByteArray label = QByteArray("cache=\"") + kCacheNames[c] + '"';
+        appendSample(out, "wekey_cache_lookups_total", label + ",result=\"hit\"",
+                     QByteArray::number(cacheHits_[c].load(std::memory_order_relaxed)));
+        appendSample(out, "wekey_cache_lookups_total", label + ",result=\"miss\"",
+                     QByteArray::number(cacheMisses_[c].load(std::memory_order_relaxed)));
+    }
+    appendHeader(out, "wekey_cache_hit_ratio", "gauge", "Cache hit ratio since start.");
+    for (int c = 0; c < CacheCount; ++c) {
+        uint64_t hits = cacheHits_[c].load(std::memory_order_relaxed);
+        uint64_t total = hits + cacheMisses_[c].load(std::memory_order_relaxed);
+        double ratio = total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        appendSample(out, "wekey_cache_hit_ratio", QByteArray("cache=\"") + kCacheNames[c] + '"',
+                     QByteArray::number(ratio, 'g', 6));
+    }
+
+    // 日志吞吐
+    appendHeader(out, "wekey_log_lines_total", "counter", "Log lines emitted by level.");
+    for (size_t i = 0; i < logLines_.size(); ++i) {
+        appendSample(out, "wekey_log_lines_total", QByteArray("level=\"") + kLogLevelNames[i] + '"',
+                     QByteArray::number(logLines_[i].load(std::memory_order_relaxed)));
+    }
+    appendHeader(out, "wekey_log_bytes_total", "counter", "Log message bytes emitted.");
+    appendSample(out, "wekey_log_bytes_total", {}, QByteArray::number(logBytes_.load(std::memory_order_relaxed)));
+    appendHeader(out, "wekey_log_dropped_total", "counter", "Log lines dropped because the write queue was full.");
+    for (size_t i = 0; i < logDropped_.size(); ++i) {
+        appendSample(out, "wekey_log_dropped_total", QByteArray("level=\"") + kLogLevelNames[i] + '"',
+                     QByteArray::number(logDropped_[i].load(std::memory_order_relaxed)));
+    }
+
+    return out;
+}
+
+}  // namespace wekey
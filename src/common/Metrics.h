@@ -0,0 +1,220 @@
+/**
+ * @file Metrics.h
+ * @brief 运行时指标注册表
+ *
+ * 汇总 HTTP 路由、线程池、设备并发、插件锁、缓存和日志等运行时指标，
+ * 以 Prometheus 文本格式导出。热路径上的计数全部为无锁原子操作。
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace wekey {
+
+/**
+ * @brief 固定分桶的延迟直方图（微秒）
+ *
+ * 分桶计数为非累积值，导出时再累加为 Prometheus 的 le 语义
+ */
+class LatencyHistogram {
+public:
+    static constexpr std::array<int64_t, 14> kBoundsUs = {
+        500, 1000, 2500, 5000, 10000, 25000, 50000,
+        100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000};
+
+    /**
+     * @brief 记录一次耗时
+     * @param micros 耗时（微秒）
+     */
+    void observe(int64_t micros);
+
+    /**
+     * @brief 以 Prometheus 格式追加直方图
+     * @param out 输出缓冲区
+     * @param name 指标名（不含 _bucket 等后缀）
+     * @param labels 标签串（不含花括号，可为空）
+     */
+    void render(QByteArray& out, const char* name, const QByteArray& labels) const;
+
+    [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<uint64_t>, kBoundsUs.size() + 1> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sumUs_{0};
+};
+
+/**
+ * @brief 运行时指标（单例）
+ *
+ * 标签集（路由、设备）在首次出现时登记到固定槽位，之后的计数只做原子自增；
+ * 登记本身极少发生，使用互斥锁串行化并以 release 语义发布槽位数。
+ */
+class Metrics {
+public:
+    static constexpr int kMaxRoutes = 64;
+    static constexpr int kMaxDevices = 32;
+
+    /**
+     * @brief 缓存种类
+     */
+    enum Cache { DeviceInfoCache = 0, ResponseCache, KeyPoolCache, PublicKeyCache, CacheCount };
+
+    static Metrics& instance();
+
+    //=== HTTP 路由 ===
+
+    /**
+     * @brief 登记路由标签
+     * @param method HTTP 方法
+     * @param route 路由模板
+     * @return 路由槽位 ID；槽位耗尽时返回 unmatchedRoute()
+     */
+    int registerRoute(const QString& method, const QString& route);
+
+    /**
+     * @brief 未匹配路由（404/405）使用的槽位 ID
+     */
+    static constexpr int unmatchedRoute() { return 0; }
+
+    /**
+     * @brief 记录一次请求
+     * @param routeId registerRoute 返回的 ID
+     * @param statusCode HTTP 状态码
+     * @param micros 处理耗时（微秒）
+     */
+    void recordRequest(int routeId, int statusCode, int64_t micros);
+
+    //=== 线程池 ===
+
+    void taskQueued() { poolQueued_.fetch_add(1, std::memory_order_relaxed); }
+    void taskStarted() {
+        poolQueued_.fetch_sub(1, std::memory_order_relaxed);
+        poolActive_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void taskFinished() { poolActive_.fetch_sub(1, std::memory_order_relaxed); }
+    void taskRejected() { poolRejected_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief 排队和执行中的 HTTP 请求数，0 表示接口空闲
+     */
+    [[nodiscard]] int64_t pendingTasks() const {
+        return poolQueued_.load(std::memory_order_relaxed) + poolActive_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 记录一次被合并（等待他人结果）的请求
+     */
+    void recordCoalesced() { coalesced_.fetch_add(1, std::memory_order_relaxed); }
+
+    //=== 事件流 ===
+
+    void sseSubscribed() { sseSubscribers_.fetch_add(1, std::memory_order_relaxed); }
+    void sseUnsubscribed() { sseSubscribers_.fetch_sub(1, std::memory_order_relaxed); }
+    void recordSseDropped(uint64_t count) { sseDropped_.fetch_add(count, std::memory_order_relaxed); }
+
+    //=== 设备并发 ===
+
+    /**
+     * @brief 设备在途请求计数守卫（RAII）
+     */
+    class DeviceInflight {
+    public:
+        explicit DeviceInflight(const QString& serialNumber);
+        ~DeviceInflight();
+        DeviceInflight(const DeviceInflight&) = delete;
+        DeviceInflight& operator=(const DeviceInflight&) = delete;
+
+    private:
+        std::atomic<int64_t>* gauge_ = nullptr;
+    };
+
+    //=== 插件锁 ===
+
+    void observePluginLockWait(int64_t micros) { pluginLockWait_.observe(micros); }
+
+    //=== 缓存 ===
+
+    void recordCache(Cache cache, bool hit) {
+        auto& slot = hit ? cacheHits_[cache] : cacheMisses_[cache];
+        slot.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //=== 日志 ===
+
+    /**
+     * @brief 记录一条已输出的日志
+     * @param level 日志级别序号（0=debug 1=info 2=warn 3=error）
+     * @param bytes 消息字节数
+     */
+    void recordLog(int level, int64_t bytes);
+
+    /**
+     * @brief 记录因日志队列已满而丢弃的日志
+     * @param level 日志级别序号
+     */
+    void recordLogDropped(int level);
+
+    //=== 导出 ===
+
+    /**
+     * @brief 生成 Prometheus 文本格式（text/plain; version=0.0.4）
+     */
+    [[nodiscard]] QByteArray renderPrometheus() const;
+
+private:
+    Metrics();
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    std::atomic<int64_t>* deviceGauge(const QString& serialNumber);
+
+    static constexpr std::array<int, 14> kStatusCodes = {
+        200, 202, 204, 400, 401, 403, 404, 405, 409, 413, 429, 500, 503, 0};
+
+    struct RouteSlot {
+        QByteArray labels;  ///< method="GET",route="/health"
+        std::array<std::atomic<uint64_t>, kStatusCodes.size()> byStatus{};
+        LatencyHistogram latency;
+    };
+
+    struct DeviceSlot {
+        QString serialNumber;
+        std::atomic<int64_t> inflight{0};
+    };
+
+    QMutex registerMutex_;
+
+    std::array<RouteSlot, kMaxRoutes> routes_;
+    std::atomic<int> routeCount_{0};
+
+    std::array<DeviceSlot, kMaxDevices> devices_;
+    std::atomic<int> deviceCount_{0};
+    std::atomic<int64_t> deviceOverflow_{0};
+
+    std::atomic<int64_t> poolQueued_{0};
+    std::atomic<int64_t> poolActive_{0};
+    std::atomic<uint64_t> poolRejected_{0};
+    std::atomic<uint64_t> coalesced_{0};
+
+    std::atomic<int64_t> sseSubscribers_{0};
+    std::atomic<uint64_t> sseDropped_{0};
+
+    LatencyHistogram pluginLockWait_;
+
+    std::array<std::atomic<uint64_t>, CacheCount> cacheHits_{};
+    std::array<std::atomic<uint64_t>, CacheCount> cacheMisses_{};
+
+    std::array<std::atomic<uint64_t>, 4> logLines_{};
+    std::atomic<uint64_t> logBytes_{0};
+    std::array<std::atomic<uint64_t>, 4> logDropped_{};
+};
+
+}  // namespace wekey
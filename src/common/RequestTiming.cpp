@@ -0,0 +1,55 @@
+/**
+ * @file RequestTiming.cpp
+ * @brief 单次请求分阶段计时实现
+ */
+
+#include "RequestTiming.h"
+
+#include <QStringList>
+
+namespace wekey {
+
+namespace {
+
+thread_local RequestTiming* tCurrent = nullptr;
+
+// Server-Timing 指标名（与 RequestTiming::Stage 顺序一致）
+constexpr const char* kStageNames[RequestTiming::StageCount] = {
+    "extract", "queue", "dispatch", "parse", "lock", "skf", "serialize", "write"};
+
+}  // namespace
+
+RequestTiming* RequestTiming::current() {
+    return tCurrent;
+}
+
+RequestTiming::Scope::Scope(RequestTiming* timing) : previous_(tCurrent) {
+    tCurrent = timing;
+}
+
+RequestTiming::Scope::~Scope() {
+    tCurrent = previous_;
+}
+
+QByteArray RequestTiming::serverTimingHeader() const {
+    QByteArray out;
+    out.reserve(160);
+    for (int i = 0; i < WriteBack; ++i) {
+        out.append(kStageNames[i]).append(";dur=");
+        out.append(QByteArray::number(static_cast<double>(stages_[i]) / 1000.0, 'f', 3));
+        out.append(", ");
+    }
+    out.append("total;dur=");
+    out.append(QByteArray::number(static_cast<double>(elapsedMicros()) / 1000.0, 'f', 3));
+    return out;
+}
+
+QString RequestTiming::summary() const {
+    QStringList parts;
+    for (int i = 0; i < StageCount; ++i) {
+        parts << QString("%1=%2ms").arg(kStageNames[i]).arg(static_cast<double>(stages_[i]) / 1000.0, 0, 'f', 3);
+    }
+    return parts.join(' ');
+}
+
+}  // namespace wekey
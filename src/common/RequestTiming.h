@@ -0,0 +1,121 @@
+/**
+ * @file RequestTiming.h
+ * @brief 单次请求分阶段计时
+ *
+ * 记录一次 HTTP 请求在各处理阶段的耗时，用于生成 Server-Timing 响应头和慢请求日志。
+ * 请求在主线程与工作线程之间接力处理，同一时刻只有一个线程写入，因此无需加锁。
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+
+#include <array>
+#include <cstdint>
+
+namespace wekey {
+
+/**
+ * @brief 请求分阶段计时
+ */
+class RequestTiming {
+public:
+    /**
+     * @brief 处理阶段
+     */
+    enum Stage {
+        Extract = 0,  ///< 主线程提取请求数据
+        QueueWait,    ///< 等待工作线程
+        Dispatch,     ///< 路由查找
+        Parse,        ///< JSON 解析与校验
+        PluginLock,   ///< 等待插件锁
+        Skf,          ///< 持有插件锁执行 SKF 调用
+        Serialize,    ///< 响应序列化
+        WriteBack,    ///< 回主线程写响应
+        StageCount
+    };
+
+    RequestTiming() { total_.start(); }
+
+    /**
+     * @brief 累加某阶段耗时
+     * @param stage 阶段
+     * @param micros 耗时（微秒）
+     */
+    void add(Stage stage, int64_t micros) { stages_[stage] += micros; }
+
+    /**
+     * @brief 某阶段累计耗时（微秒）
+     */
+    [[nodiscard]] int64_t stage(Stage stage) const { return stages_[stage]; }
+
+    /**
+     * @brief 自请求进入以来的总耗时（微秒）
+     */
+    [[nodiscard]] int64_t elapsedMicros() const { return total_.nsecsElapsed() / 1000; }
+
+    /**
+     * @brief 生成 Server-Timing 头的值
+     *
+     * 写回阶段发生在发送响应头之后，不包含在头中，仅出现在慢请求日志里
+     */
+    [[nodiscard]] QByteArray serverTimingHeader() const;
+
+    /**
+     * @brief 生成慢请求日志用的阶段明细
+     */
+    [[nodiscard]] QString summary() const;
+
+    /**
+     * @brief 当前线程正在处理的请求计时（可能为空）
+     */
+    static RequestTiming* current();
+
+    /**
+     * @brief 在作用域内将计时对象绑定到当前线程（RAII）
+     */
+    class Scope {
+    public:
+        explicit Scope(RequestTiming* timing);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        RequestTiming* previous_;
+    };
+
+    /**
+     * @brief 作用域计时器：析构时把耗时累加到当前线程请求的指定阶段
+     *
+     * 当前线程未绑定请求时不计时，开销仅为一次 thread_local 读取
+     */
+    class StageTimer {
+    public:
+        explicit StageTimer(Stage stage) : timing_(current()), stage_(stage) {
+            if (timing_) {
+                timer_.start();
+            }
+        }
+        ~StageTimer() {
+            if (timing_) {
+                timing_->add(stage_, timer_.nsecsElapsed() / 1000);
+            }
+        }
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+
+    private:
+        RequestTiming* timing_;
+        Stage stage_;
+        QElapsedTimer timer_;
+    };
+
+private:
+    std::array<int64_t, StageCount> stages_{};
+    QElapsedTimer total_;
+};
+
+}  // namespace wekey
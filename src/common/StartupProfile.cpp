@@ -0,0 +1,79 @@
+/**
+ * @file StartupProfile.cpp
+ * @brief 启动阶段计时实现
+ */
+
+#include "StartupProfile.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <cstdio>
+#include <cstring>
+
+namespace wekey {
+
+namespace {
+
+struct Mark {
+    QString phase;
+    qint64 nsecs;
+    bool mainThread;
+};
+
+std::atomic<bool> g_enabled{false};
+std::atomic<bool> g_printed{false};
+QElapsedTimer g_clock;
+QMutex g_mutex;
+QList<Mark> g_marks;
+
+}  // namespace
+
+void StartupProfile::begin(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--startup-profile") == 0) {
+            g_clock.start();
+            g_enabled.store(true, std::memory_order_release);
+            mark("main");
+            return;
+        }
+    }
+}
+
+bool StartupProfile::enabled() {
+    return g_enabled.load(std::memory_order_acquire);
+}
+
+void StartupProfile::mark(const QString& phase) {
+    if (!enabled()) {
+        return;
+    }
+    // QCoreApplication 构造前只可能在主线程
+    const QCoreApplication* app = QCoreApplication::instance();
+    bool onMain = app == nullptr || QThread::currentThread() == app->thread();
+
+    QMutexLocker locker(&g_mutex);
+    g_marks.append(Mark{phase, g_clock.nsecsElapsed(), onMain});
+}
+
+void StartupProfile::print() {
+    if (!enabled() || g_printed.exchange(true)) {
+        return;
+    }
+
+    QMutexLocker locker(&g_mutex);
+    std::fprintf(stderr, "[startup-profile] %10s %10s  %s\n", "at(ms)", "delta(ms)", "phase");
+    qint64 previous = 0;
+    for (const auto& m : g_marks) {
+        std::fprintf(stderr, "[startup-profile] %10.3f %10.3f  %s%s\n",
+                     static_cast<double>(m.nsecs) / 1e6,
+                     static_cast<double>(m.nsecs - previous) / 1e6,
+                     qPrintable(m.phase), m.mainThread ? "" : " [bg]");
+        previous = m.nsecs;
+    }
+    std::fflush(stderr);
+}
+
+}  // namespace wekey
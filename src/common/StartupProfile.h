@@ -0,0 +1,46 @@
+/**
+ * @file StartupProfile.h
+ * @brief 启动阶段计时
+ *
+ * 以 --startup-profile 启动时记录各启动阶段相对进程入口的时间点，
+ * 并在启动完成后向 stderr 输出时间线。未启用时 mark() 只做一次原子读。
+ */
+
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+
+namespace wekey {
+
+/**
+ * @brief 启动阶段计时（全部静态方法）
+ */
+class StartupProfile {
+public:
+    /**
+     * @brief 在 main() 开头调用：检查命令行是否带 --startup-profile 并开始计时
+     */
+    static void begin(int argc, char** argv);
+
+    /**
+     * @brief 是否已启用
+     */
+    static bool enabled();
+
+    /**
+     * @brief 记录一个阶段（可在任意线程调用）
+     * @param phase 阶段名
+     */
+    static void mark(const QString& phase);
+
+    /**
+     * @brief 输出时间线到 stderr（只输出一次）
+     */
+    static void print();
+};
+
+}  // namespace wekey
@@ -8,7 +8,9 @@
 #include <QDir>
 #include <QFile>
 #include <QJsonDocument>
+#include <QSaveFile>
 #include <QStandardPaths>
+#include <QThread>
 
 #include "config/Defaults.h"
 
@@ -19,26 +21,33 @@ Config& Config::instance() {
     return instance;
 }
 
-Config::Config() : QObject(nullptr), systrayDisabled_(false) {
-    initDefaults();
+Config::Config() : QObject(nullptr), current_(std::make_shared<const ConfigSnapshot>(defaultSnapshot())) {
+    qRegisterMetaType<ConfigSnapshotPtr>("wekey::ConfigSnapshotPtr");
 }
 
-void Config::initDefaults() {
-    listenPort_ = defaults::LISTEN_PORT;
-    logLevel_ = defaults::LOG_LEVEL;
-    errorMode_ = defaults::ERROR_MODE_SIMPLE;
-    systrayDisabled_ = false;
-    activedModName_.clear();
-    logPath_ = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-
-    modPaths_ = QJsonObject();
-
-    defaultAppName_ = defaults::APP_NAME;
-    defaultContainerName_ = defaults::CONTAINER_NAME;
-    defaultCommonName_ = defaults::COMMON_NAME;
-    defaultOrganization_ = defaults::ORGANIZATION;
-    defaultUnit_ = defaults::UNIT;
-    defaultRole_ = defaults::ROLE_USER;
+ConfigSnapshot Config::defaultSnapshot() {
+    ConfigSnapshot s;
+    s.listenPort = defaults::LISTEN_PORT;
+    s.listenSocket = defaults::LISTEN_SOCKET;
+    s.slowRequestMs = defaults::SLOW_REQUEST_MS;
+    s.httpMaxThreads = defaults::HTTP_MAX_THREADS;
+    s.httpMaxQueue = defaults::HTTP_MAX_QUEUE;
+    s.readCacheTtlMs = defaults::READ_CACHE_TTL_MS;
+    s.keyPoolDepth = defaults::KEY_POOL_DEPTH;
+    s.keyPoolKeyType = defaults::KEY_POOL_KEY_TYPE;
+    s.logLevel = defaults::LOG_LEVEL;
+    s.logRules = defaults::LOG_RULES;
+    s.errorMode = defaults::ERROR_MODE_SIMPLE;
+    s.systrayDisabled = false;
+    s.logPath = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+
+    s.defaultAppName = defaults::APP_NAME;
+    s.defaultContainerName = defaults::CONTAINER_NAME;
+    s.defaultCommonName = defaults::COMMON_NAME;
+    s.defaultOrganization = defaults::ORGANIZATION;
+    s.defaultUnit = defaults::UNIT;
+    s.defaultRole = defaults::ROLE_USER;
+    return s;
 }
 
 QString Config::configFilePath() const {
@@ -46,54 +55,144 @@ QString Config::configFilePath() const {
     return homeDir + "/" + defaults::CONFIG_FILENAME;
 }
 
+// ==================== 快照 ====================
+
+ConfigSnapshotPtr Config::snapshot() const {
+    return std::atomic_load(&current_);
+}
+
+ConfigSnapshotPtr Config::update(const std::function<void(ConfigSnapshot&)>& mutator) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto next = std::make_shared<ConfigSnapshot>(*std::atomic_load(&current_));
+    mutator(*next);
+    publish(next);
+    return next;
+}
+
+void Config::publish(ConfigSnapshotPtr next) {
+    std::atomic_store(&current_, std::move(next));
+}
+
 // ==================== 基本配置 Getter/Setter ====================
 
 QString Config::listenPort() const {
-    return listenPort_;
+    return snapshot()->listenPort;
 }
 
 void Config::setListenPort(const QString& port) {
-    listenPort_ = port;
+    update([&](ConfigSnapshot& s) { s.listenPort = port; });
+}
+
+QString Config::listenSocket() const {
+    return snapshot()->listenSocket;
+}
+
+void Config::setListenSocket(const QString& path) {
+    update([&](ConfigSnapshot& s) { s.listenSocket = path; });
+}
+
+int Config::slowRequestMs() const {
+    return snapshot()->slowRequestMs;
+}
+
+void Config::setSlowRequestMs(int ms) {
+    update([&](ConfigSnapshot& s) { s.slowRequestMs = ms; });
+}
+
+int Config::httpMaxThreads() const {
+    return snapshot()->httpMaxThreads;
+}
+
+void Config::setHttpMaxThreads(int count) {
+    update([&](ConfigSnapshot& s) { s.httpMaxThreads = count; });
+}
+
+int Config::httpMaxQueue() const {
+    return snapshot()->httpMaxQueue;
+}
+
+void Config::setHttpMaxQueue(int length) {
+    update([&](ConfigSnapshot& s) { s.httpMaxQueue = length; });
+}
+
+int Config::readCacheTtlMs() const {
+    return snapshot()->readCacheTtlMs;
+}
+
+void Config::setReadCacheTtlMs(int ms) {
+    update([&](ConfigSnapshot& s) { s.readCacheTtlMs = ms; });
+}
+
+int Config::keyPoolDepth() const {
+    return snapshot()->keyPoolDepth;
+}
+
+void Config::setKeyPoolDepth(int depth) {
+    update([&](ConfigSnapshot& s) { s.keyPoolDepth = depth; });
+}
+
+QString Config::keyPoolKeyType() const {
+    return snapshot()->keyPoolKeyType;
+}
+
+void Config::setKeyPoolKeyType(const QString& keyType) {
+    update([&](ConfigSnapshot& s) { s.keyPoolKeyType = keyType; });
+}
+
+bool Config::keyPoolUsed() const {
+    return snapshot()->keyPoolUsed;
+}
+
+void Config::setKeyPoolUsed(bool used) {
+    update([&](ConfigSnapshot& s) { s.keyPoolUsed = used; });
 }
 
 QString Config::logLevel() const {
-    return logLevel_;
+    return snapshot()->logLevel;
 }
 
 void Config::setLogLevel(const QString& level) {
-    logLevel_ = level;
+    update([&](ConfigSnapshot& s) { s.logLevel = level; });
+}
+
+QString Config::logRules() const {
+    return snapshot()->logRules;
+}
+
+void Config::setLogRules(const QString& rules) {
+    update([&](ConfigSnapshot& s) { s.logRules = rules; });
 }
 
 QString Config::errorMode() const {
-    return errorMode_;
+    return snapshot()->errorMode;
 }
 
 void Config::setErrorMode(const QString& mode) {
-    errorMode_ = mode;
+    update([&](ConfigSnapshot& s) { s.errorMode = mode; });
 }
 
 bool Config::systrayDisabled() const {
-    return systrayDisabled_;
+    return snapshot()->systrayDisabled;
 }
 
 void Config::setSystrayDisabled(bool disabled) {
-    systrayDisabled_ = disabled;
+    update([&](ConfigSnapshot& s) { s.systrayDisabled = disabled; });
 }
 
 QString Config::activedModName() const {
-    return activedModName_;
+    return snapshot()->activedModName;
 }
 
 void Config::setActivedModName(const QString& name) {
-    activedModName_ = name;
+    update([&](ConfigSnapshot& s) { s.activedModName = name; });
 }
 
 QString Config::logPath() const {
-    return logPath_;
+    return snapshot()->logPath;
 }
 
 void Config::setLogPath(const QString& path) {
-    logPath_ = path;
+    update([&](ConfigSnapshot& s) { s.logPath = path; });
 }
 
 QString Config::version() const {
@@ -103,63 +202,65 @@ QString Config::version() const {
 // ==================== 模块路径管理 ====================
 
 QJsonObject Config::modPaths() const {
-    return modPaths_;
+    return snapshot()->modPaths;
 }
 
 void Config::setModPath(const QString& name, const QString& path) {
-    modPaths_[name] = path;
+    update([&](ConfigSnapshot& s) { s.modPaths[name] = path; });
 }
 
 void Config::removeModPath(const QString& name) {
-    modPaths_.remove(name);
+    update([&](ConfigSnapshot& s) { s.modPaths.remove(name); });
 }
 
 // ==================== 默认应用配置 ====================
 
 QString Config::defaultAppName() const {
-    return defaultAppName_;
+    return snapshot()->defaultAppName;
 }
 
 QString Config::defaultContainerName() const {
-    return defaultContainerName_;
+    return snapshot()->defaultContainerName;
 }
 
 QString Config::defaultCommonName() const {
-    return defaultCommonName_;
+    return snapshot()->defaultCommonName;
 }
 
 QString Config::defaultOrganization() const {
-    return defaultOrganization_;
+    return snapshot()->defaultOrganization;
 }
 
 QString Config::defaultUnit() const {
-    return defaultUnit_;
+    return snapshot()->defaultUnit;
 }
 
 QString Config::defaultRole() const {
-    return defaultRole_;
+    return snapshot()->defaultRole;
 }
 
 int Config::defaultRandomLength() const {
-    return defaultRandomLength_;
+    return snapshot()->defaultRandomLength;
 }
 
 void Config::setDefault(const QString& key, const QString& value) {
-    if (key == "appName") {
-        defaultAppName_ = value;
-    } else if (key == "containerName") {
-        defaultContainerName_ = value;
-    } else if (key == "commonName") {
-        defaultCommonName_ = value;
-    } else if (key == "organization") {
-        defaultOrganization_ = value;
-    } else if (key == "unit") {
-        defaultUnit_ = value;
-    } else if (key == "role") {
-        defaultRole_ = value;
-    } else if (key == "randomLength") {
-        defaultRandomLength_ = value.toInt();
-    }
+    update([&](ConfigSnapshot& s) {
+        if (key == "appName") {
+            s.defaultAppName = value;
+        } else if (key == "containerName") {
+            s.defaultContainerName = value;
+        } else if (key == "commonName") {
+            s.defaultCommonName = value;
+        } else if (key == "organization") {
+            s.defaultOrganization = value;
+        } else if (key == "unit") {
+            s.defaultUnit = value;
+        } else if (key == "role") {
+            s.defaultRole = value;
+        } else if (key == "randomLength") {
+            s.defaultRandomLength = value.toInt();
+        }
+    });
 }
 
 // ==================== 文件操作 ====================
@@ -193,102 +294,154 @@ bool Config::load() {
 
     QJsonObject root = doc.object();
 
-    // 读取基本配置
-    if (root.contains("listenPort")) {
-        listenPort_ = root["listenPort"].toString();
-    }
-    if (root.contains("logLevel")) {
-        logLevel_ = root["logLevel"].toString();
-    }
-    if (root.contains("errorMode")) {
-        errorMode_ = root["errorMode"].toString();
-    }
-    if (root.contains("systrayDisabled")) {
-        systrayDisabled_ = root["systrayDisabled"].toBool();
-    }
-    if (root.contains("activedModName")) {
-        activedModName_ = root["activedModName"].toString();
-    }
-    if (root.contains("logPath")) {
-        logPath_ = root["logPath"].toString();
-    }
-
-    // 读取模块路径
-    if (root.contains("modPaths") && root["modPaths"].isObject()) {
-        modPaths_ = root["modPaths"].toObject();
-    }
-
-    // 读取默认应用配置
-    if (root.contains("defaults") && root["defaults"].isObject()) {
-        QJsonObject defaults = root["defaults"].toObject();
-        if (defaults.contains("appName")) {
-            defaultAppName_ = defaults["appName"].toString();
+    update([&](ConfigSnapshot& s) {
+        // 读取基本配置
+        if (root.contains("listenPort")) {
+            s.listenPort = root["listenPort"].toString();
         }
-        if (defaults.contains("containerName")) {
-            defaultContainerName_ = defaults["containerName"].toString();
+        if (root.contains("listenSocket")) {
+            s.listenSocket = root["listenSocket"].toString();
         }
-        if (defaults.contains("commonName")) {
-            defaultCommonName_ = defaults["commonName"].toString();
+        if (root.contains("slowRequestMs")) {
+            s.slowRequestMs = root["slowRequestMs"].toInt(defaults::SLOW_REQUEST_MS);
         }
-        if (defaults.contains("organization")) {
-            defaultOrganization_ = defaults["organization"].toString();
+        if (root.contains("httpMaxThreads")) {
+            s.httpMaxThreads = root["httpMaxThreads"].toInt(defaults::HTTP_MAX_THREADS);
         }
-        if (defaults.contains("unit")) {
-            defaultUnit_ = defaults["unit"].toString();
+        if (root.contains("httpMaxQueue")) {
+            s.httpMaxQueue = root["httpMaxQueue"].toInt(defaults::HTTP_MAX_QUEUE);
         }
-        if (defaults.contains("role")) {
-            defaultRole_ = defaults["role"].toString();
+        if (root.contains("readCacheTtlMs")) {
+            s.readCacheTtlMs = root["readCacheTtlMs"].toInt(defaults::READ_CACHE_TTL_MS);
+        }
+        if (root.contains("keyPoolDepth")) {
+            s.keyPoolDepth = root["keyPoolDepth"].toInt(defaults::KEY_POOL_DEPTH);
+        }
+        if (root.contains("keyPoolKeyType")) {
+            s.keyPoolKeyType = root["keyPoolKeyType"].toString(defaults::KEY_POOL_KEY_TYPE);
+        }
+        if (root.contains("keyPoolUsed")) {
+            s.keyPoolUsed = root["keyPoolUsed"].toBool();
+        }
+        if (root.contains("logLevel")) {
+            s.logLevel = root["logLevel"].toString();
+        }
+        if (root.contains("logRules")) {
+            s.logRules = root["logRules"].toString();
+        }
+        if (root.contains("errorMode")) {
+            s.errorMode = root["errorMode"].toString();
+        }
+        if (root.contains("systrayDisabled")) {
+            s.systrayDisabled = root["systrayDisabled"].toBool();
+        }
+        if (root.contains("activedModName")) {
+            s.activedModName = root["activedModName"].toString();
+        }
+        if (root.contains("logPath")) {
+            s.logPath = root["logPath"].toString();
+        }
+
+        // 读取模块路径
+        if (root.contains("modPaths") && root["modPaths"].isObject()) {
+            s.modPaths = root["modPaths"].toObject();
         }
-    }
+
+        // 读取默认应用配置
+        if (root.contains("defaults") && root["defaults"].isObject()) {
+            QJsonObject defaults = root["defaults"].toObject();
+            if (defaults.contains("appName")) {
+                s.defaultAppName = defaults["appName"].toString();
+            }
+            if (defaults.contains("containerName")) {
+                s.defaultContainerName = defaults["containerName"].toString();
+            }
+            if (defaults.contains("commonName")) {
+                s.defaultCommonName = defaults["commonName"].toString();
+            }
+            if (defaults.contains("organization")) {
+                s.defaultOrganization = defaults["organization"].toString();
+            }
+            if (defaults.contains("unit")) {
+                s.defaultUnit = defaults["unit"].toString();
+            }
+            if (defaults.contains("role")) {
+                s.defaultRole = defaults["role"].toString();
+            }
+        }
+    });
 
     return true;
 }
 
 bool Config::save() {
-    QString filePath = configFilePath();
-    QFile file(filePath);
+    // 工作线程（如 KeyPool）与 GUI 线程都可能保存：串行化写文件，快照在锁内读取，
+    // 保证最后落盘的是最新配置；QSaveFile 先写临时文件再替换，写到一半不会留下残缺文件
+    std::lock_guard<std::mutex> lock(saveMutex_);
 
+    QSaveFile file(configFilePath());
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         return false;
     }
 
+    const ConfigSnapshotPtr cfg = snapshot();
     QJsonObject root;
 
     // 写入版本
     root["version"] = defaults::CONFIG_VERSION;
 
     // 写入基本配置
-    root["listenPort"] = listenPort_;
-    root["logLevel"] = logLevel_;
-    root["errorMode"] = errorMode_;
-    root["systrayDisabled"] = systrayDisabled_;
-    root["activedModName"] = activedModName_;
-    root["logPath"] = logPath_;
+    root["listenPort"] = cfg->listenPort;
+    root["listenSocket"] = cfg->listenSocket;
+    root["slowRequestMs"] = cfg->slowRequestMs;
+    root["httpMaxThreads"] = cfg->httpMaxThreads;
+    root["httpMaxQueue"] = cfg->httpMaxQueue;
+    root["readCacheTtlMs"] = cfg->readCacheTtlMs;
+    root["keyPoolDepth"] = cfg->keyPoolDepth;
+    root["keyPoolKeyType"] = cfg->keyPoolKeyType;
+    root["keyPoolUsed"] = cfg->keyPoolUsed;
+    root["logLevel"] = cfg->logLevel;
+    root["logRules"] = cfg->logRules;
+    root["errorMode"] = cfg->errorMode;
+    root["systrayDisabled"] = cfg->systrayDisabled;
+    root["activedModName"] = cfg->activedModName;
+    root["logPath"] = cfg->logPath;
 
     // 写入模块路径
-    root["modPaths"] = modPaths_;
+    root["modPaths"] = cfg->modPaths;
 
     // 写入默认应用配置
     QJsonObject defaultsObj;
-    defaultsObj["appName"] = defaultAppName_;
-    defaultsObj["containerName"] = defaultContainerName_;
-    defaultsObj["commonName"] = defaultCommonName_;
-    defaultsObj["organization"] = defaultOrganization_;
-    defaultsObj["unit"] = defaultUnit_;
-    defaultsObj["role"] = defaultRole_;
+    defaultsObj["appName"] = cfg->defaultAppName;
+    defaultsObj["containerName"] = cfg->defaultContainerName;
+    defaultsObj["commonName"] = cfg->defaultCommonName;
+    defaultsObj["organization"] = cfg->defaultOrganization;
+    defaultsObj["unit"] = cfg->defaultUnit;
+    defaultsObj["role"] = cfg->defaultRole;
     root["defaults"] = defaultsObj;
 
     QJsonDocument doc(root);
     file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
+    if (!file.commit()) {
+        return false;
+    }
 
-    emit configChanged();
+    // 接收者按 Config 所在线程（主线程）处理变更，从其他线程保存时排队发出
+    if (QThread::currentThread() == thread()) {
+        emit configChanged(cfg);
+    } else {
+        QMetaObject::invokeMethod(this, [this, cfg]() { emit configChanged(cfg); }, Qt::QueuedConnection);
+    }
     return true;
 }
 
 void Config::reset() {
-    initDefaults();
-    emit configChanged();
+    auto next = std::make_shared<const ConfigSnapshot>(defaultSnapshot());
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        publish(next);
+    }
+    emit configChanged(next);
 }
 
 }  // namespace wekey
@@ -9,15 +9,61 @@
 #pragma once
 
 #include <QJsonObject>
+#include <QMetaType>
 #include <QObject>
 #include <QString>
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 namespace wekey {
 
+/**
+ * @brief 配置快照
+ *
+ * 发布后不再修改，可在任意线程无锁读取。字段含义与 Config 的同名 getter 一致。
+ */
+struct ConfigSnapshot {
+    // 基本配置
+    QString listenPort;
+    QString listenSocket;
+    int slowRequestMs = 0;
+    int httpMaxThreads = 0;
+    int httpMaxQueue = 0;
+    int readCacheTtlMs = 0;
+    int keyPoolDepth = 0;
+    QString keyPoolKeyType;
+    bool keyPoolUsed = false;
+    QString logLevel;
+    QString logRules;
+    QString errorMode;
+    bool systrayDisabled = false;
+    QString activedModName;
+    QString logPath;
+
+    // 模块路径
+    QJsonObject modPaths;
+
+    // 默认应用配置
+    QString defaultAppName;
+    QString defaultContainerName;
+    QString defaultCommonName;
+    QString defaultOrganization;
+    QString defaultUnit;
+    QString defaultRole;
+    int defaultRandomLength = 16;  // 默认随机数长度
+};
+
+using ConfigSnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
+
 /**
  * @brief 配置管理单例类
  *
- * 提供线程安全的配置访问，支持 JSON 格式的配置文件读写
+ * 当前配置保存为不可变快照，通过原子替换 shared_ptr 发布：
+ * 读者调用 snapshot() 取得引用后即可无锁访问所有字段，同一请求内应只取一次，
+ * 保证看到的配置彼此一致；写者复制当前快照、修改后整体发布，写者之间互斥。
+ * 单字段 getter/setter 保留为便捷封装，每次调用各自取一次快照。
  */
 class Config : public QObject {
     Q_OBJECT
@@ -35,6 +81,21 @@ public:
     Config(Config&&) = delete;
     Config& operator=(Config&&) = delete;
 
+    // ==================== 快照 ====================
+
+    /**
+     * @brief 获取当前配置快照（任意线程，无锁）
+     * @return 不可变快照，持有期间不受后续修改影响
+     */
+    ConfigSnapshotPtr snapshot() const;
+
+    /**
+     * @brief 修改配置：复制当前快照，由 mutator 修改后发布为新快照
+     * @param mutator 在写锁内执行，不应再调用 Config 的 setter
+     * @return 新发布的快照
+     */
+    ConfigSnapshotPtr update(const std::function<void(ConfigSnapshot&)>& mutator);
+
     // ==================== 基本配置 ====================
 
     /**
@@ -49,6 +110,98 @@ public:
      */
     void setListenPort(const QString& port);
 
+    /**
+     * @brief 获取本地套接字路径
+     * @return Unix 域套接字路径（Windows 为命名管道名），空表示不启用
+     */
+    QString listenSocket() const;
+
+    /**
+     * @brief 设置本地套接字路径
+     * @param path 套接字路径，空表示不启用
+     */
+    void setListenSocket(const QString& path);
+
+    /**
+     * @brief 获取慢请求日志阈值
+     * @return 毫秒数，0 表示关闭慢请求日志
+     */
+    int slowRequestMs() const;
+
+    /**
+     * @brief 设置慢请求日志阈值
+     * @param ms 毫秒数，0 表示关闭
+     */
+    void setSlowRequestMs(int ms);
+
+    /**
+     * @brief 获取 HTTP 工作线程上限
+     */
+    int httpMaxThreads() const;
+
+    /**
+     * @brief 设置 HTTP 工作线程上限
+     * @param count 线程数（>= 1）
+     */
+    void setHttpMaxThreads(int count);
+
+    /**
+     * @brief 获取 HTTP 等待队列上限
+     */
+    int httpMaxQueue() const;
+
+    /**
+     * @brief 设置 HTTP 等待队列上限
+     * @param length 队列长度（>= 0，0 表示不排队，线程全忙即拒绝）
+     */
+    void setHttpMaxQueue(int length);
+
+    /**
+     * @brief 获取只读接口结果缓存 TTL
+     * @return 毫秒数，0 表示不缓存
+     */
+    int readCacheTtlMs() const;
+
+    /**
+     * @brief 设置只读接口结果缓存 TTL
+     * @param ms 毫秒数，0 表示不缓存
+     */
+    void setReadCacheTtlMs(int ms);
+
+    /**
+     * @brief 获取密钥预生成深度
+     * @return 每个应用每种密钥的备用容器数，0 表示关闭预生成
+     */
+    int keyPoolDepth() const;
+
+    /**
+     * @brief 设置密钥预生成深度
+     * @param depth 备用容器数（>= 0）
+     */
+    void setKeyPoolDepth(int depth);
+
+    /**
+     * @brief 获取登录后预生成的密钥类型
+     * @return 与 CSR keyPairType 同格式，如 "RSA_2048"、"SM2_sm2p256v1"
+     */
+    QString keyPoolKeyType() const;
+
+    /**
+     * @brief 设置登录后预生成的密钥类型
+     */
+    void setKeyPoolKeyType(const QString& keyType);
+
+    /**
+     * @brief 是否用过密钥预生成（领取过备用容器或在设备上见过容器映射文件）
+     * @return 为 false 且预生成关闭时不读取设备上的映射文件
+     */
+    bool keyPoolUsed() const;
+
+    /**
+     * @brief 标记已用过密钥预生成
+     */
+    void setKeyPoolUsed(bool used);
+
     /**
      * @brief 获取日志级别
      * @return 日志级别字符串
@@ -61,6 +214,18 @@ public:
      */
     void setLogLevel(const QString& level);
 
+    /**
+     * @brief 获取附加日志分类规则
+     * @return 规则字符串（QLoggingCategory 语法，';' 分隔），空表示仅按日志级别过滤
+     */
+    QString logRules() const;
+
+    /**
+     * @brief 设置附加日志分类规则
+     * @param rules 规则字符串，如 "wekey.skf.debug=true;wekey.gui.debug=false"
+     */
+    void setLogRules(const QString& rules);
+
     /**
      * @brief 获取错误模式
      * @return "simple" 或 "detailed"
@@ -190,6 +355,8 @@ public:
 
     /**
      * @brief 保存配置到文件
+     *
+     * 线程安全：并发调用按顺序写入，文件整体替换；configChanged 总在 Config 所在线程发出。
      * @return 成功返回 true
      */
     bool save();
@@ -201,9 +368,10 @@ public:
 
 signals:
     /**
-     * @brief 配置变更信号
+     * @brief 配置变更信号（保存或重置后发出）
+     * @param snapshot 变更后的配置快照
      */
-    void configChanged();
+    void configChanged(wekey::ConfigSnapshotPtr snapshot);
 
 private:
     Config();
@@ -216,29 +384,20 @@ private:
     QString configFilePath() const;
 
     /**
-     * @brief 初始化默认值
+     * @brief 生成默认配置
      */
-    void initDefaults();
-
-    // 基本配置
-    QString listenPort_;
-    QString logLevel_;
-    QString errorMode_;
-    bool systrayDisabled_;
-    QString activedModName_;
-    QString logPath_;
+    static ConfigSnapshot defaultSnapshot();
 
-    // 模块路径
-    QJsonObject modPaths_;
+    /**
+     * @brief 发布新快照
+     */
+    void publish(ConfigSnapshotPtr next);
 
-    // 默认应用配置
-    QString defaultAppName_;
-    QString defaultContainerName_;
-    QString defaultCommonName_;
-    QString defaultOrganization_;
-    QString defaultUnit_;
-    QString defaultRole_;
-    int defaultRandomLength_ = 16;  // 默认随机数长度
+    ConfigSnapshotPtr current_;  ///< 只通过 std::atomic_load/atomic_store 访问
+    std::mutex writeMutex_;      ///< 串行化写者的“复制-修改-发布”
+    std::mutex saveMutex_;       ///< 串行化 save() 的文件写入
 };
 
 }  // namespace wekey
+
+Q_DECLARE_METATYPE(wekey::ConfigSnapshotPtr)
@@ -16,9 +16,59 @@ constexpr const char* CONFIG_VERSION = "1.0.0";
 
 // 网络
 constexpr const char* LISTEN_PORT = ":9001";
+constexpr const char* LISTEN_SOCKET = "";  // 本机 Unix 域套接字（Windows 为命名管道）路径，空表示不启用
+constexpr int LISTEN_SOCKET_PROBE_MS = 200;  // 启动时探测同名套接字是否仍有进程在监听的超时（毫秒）
+constexpr int SLOW_REQUEST_MS = 1000;  // 慢请求日志阈值（毫秒），0 表示关闭
+constexpr int HTTP_MAX_THREADS = 8;    // HTTP 工作线程上限
+constexpr int HTTP_MAX_QUEUE = 64;     // HTTP 等待队列上限，满时返回 503
+constexpr int HTTP_STREAM_CHUNK_BYTES = 64 * 1024;        // 流式响应每块大小
+constexpr int HTTP_STREAM_MAX_INFLIGHT = 4;               // 流式响应交给主线程、尚未写出的块数上限
+constexpr int HTTP_STREAM_HIGH_WATER_BYTES = 256 * 1024;  // 连接未发出的字节数超过该值时暂停生成
+constexpr int HTTP_STREAM_STALL_MS = 30000;               // 客户端长时间不读取时中止流式响应（毫秒）
+constexpr int READ_CACHE_TTL_MS = 0;   // 幂等只读接口结果缓存 TTL（毫秒），0 表示仅合并并发请求
+constexpr int READ_CACHE_MAX_ENTRIES = 256;  // 结果缓存条目上限（键含客户端查询参数，需防止无限增长）
+
+// 异步任务
+constexpr int JOB_MAX_QUEUED = 32;       // 排队任务上限
+constexpr int JOB_MAX_RETAINED = 256;    // 已结束任务保留数量上限
+constexpr int JOB_RETENTION_SEC = 600;   // 已结束任务保留时长（秒）
+constexpr int JOB_MAX_WAIT_MS = 30000;   // 长轮询最长等待（毫秒）
+constexpr int JOB_MAX_WAITERS = 2;       // 同时长轮询的请求上限（另受 HTTP 工作线程数的 1/4 限制，至少 1），超出时立即返回
+
+// 事件流（SSE）
+constexpr int SSE_MAX_SUBSCRIBERS = 32;    // 订阅者上限，超出时关闭最早的连接
+constexpr int SSE_BUFFER_EVENTS = 64;      // 每个订阅者待发送事件上限，超出时丢弃最旧的
+constexpr int SSE_FLUSH_BATCH = 16;        // 每次刷新每个订阅者最多发送的事件数
+constexpr int SSE_FLUSH_INTERVAL_MS = 50;  // 刷新间隔（毫秒）
+constexpr int SSE_HIGH_WATER_BYTES = 64 * 1024;  // 连接未发出的字节数达到该值时暂停写入，事件留在队列中
+constexpr int SSE_HISTORY_EVENTS = 256;    // 供 Last-Event-ID 断线续传的历史事件数
+constexpr int SSE_HEARTBEAT_SEC = 15;      // 心跳间隔（秒）
+constexpr int SSE_MAX_STREAM_SEC = 600;    // 单条连接最长时长（秒），到期后由客户端自动重连
+
+// 批量初始化
+constexpr int PROVISION_MAX_WORKERS = 8;  // 同时处理的设备数上限（驱动调用仍由插件全局锁串行）
+constexpr const char* PROVISION_CHECKPOINT_SUFFIX = ".progress.json";  // 默认检查点文件后缀（追加在计划文件名后）
+
+// 密钥预生成
+constexpr int KEY_POOL_DEPTH = 0;                              // 每个应用每种密钥的备用容器数，0 表示关闭
+constexpr const char* KEY_POOL_KEY_TYPE = "RSA_2048";          // 登录后预生成的密钥类型（同 CSR 的 keyPairType）
+constexpr int KEY_POOL_REFILL_INTERVAL_MS = 3000;              // 空闲检查间隔（毫秒），每次最多生成一个密钥
+constexpr const char* KEY_POOL_CONTAINER_PREFIX = "wkspare-";  // 备用容器名前缀
+constexpr const char* KEY_POOL_ALIAS_FILE = "wkalias";         // 应用内保存容器名映射的文件
+
+// 数字信封
+constexpr int ENVELOPE_MAX_BODY_BYTES = 64 * 1024 * 1024;  // 加解密请求体上限，超出时返回 413
 
 // 日志
 constexpr const char* LOG_LEVEL = "info";
+constexpr const char* LOG_RULES = "";       // 附加日志分类规则，如 "wekey.skf.debug=true"
+constexpr int LOG_QUEUE_CAPACITY = 8192;    // 待写日志队列容量（必须是 2 的幂）
+constexpr int LOG_DEBUG_DROP_PERCENT = 75;  // 队列占用超过该比例时丢弃 Debug 日志，为更高级别留出空间
+constexpr int LOG_WRITE_BATCH = 256;        // 写线程每批最多处理的条数
+constexpr int LOG_FLUSH_INTERVAL_MS = 200;  // 日志文件最长刷新间隔（毫秒）
+constexpr int LOG_GUI_FLUSH_INTERVAL_MS = 33;  // 日志查看器合并刷新间隔（毫秒）
+constexpr int LOG_GUI_MAX_BACKLOG = 10000;     // 日志查看器待刷新条目上限，超出时丢弃最旧的
+constexpr int LOG_SEARCH_DEBOUNCE_MS = 150;    // 日志搜索输入防抖（毫秒）
 
 // 错误模式
 constexpr const char* ERROR_MODE_SIMPLE = "simple";
@@ -5,7 +5,10 @@
 
 #include "AppService.h"
 
+#include "config/Defaults.h"
+#include "core/keypool/KeyPool.h"
 #include "plugin/PluginManager.h"
+#include "plugin/interface/AsyncDriverPlugin.h"
 
 namespace wekey {
 
@@ -53,6 +56,10 @@ Result<void> AppService::login(const QString& devName, const QString& appName, c
 
     auto result = plugin->openApp(devName, appName, role, pin);
     if (result.isOk()) {
+        // 用户登录态下才能在设备上生成密钥
+        if (role.compare(defaults::ROLE_USER, Qt::CaseInsensitive) == 0) {
+            KeyPool::instance().watch(devName, appName);
+        }
         if (emitSignals) {
             emit loginStateChanged(devName, appName, true);
         }
@@ -77,6 +84,7 @@ Result<void> AppService::logout(const QString& devName, const QString& appName,
         return Result<void>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "AppService::logout"));
     }
+    KeyPool::instance().unwatch(devName, appName);
     auto result = plugin->closeApp(devName, appName);
     if (result.isOk() && emitSignals) {
         emit loginStateChanged(devName, appName, false);
@@ -114,4 +122,58 @@ Result<int> AppService::getRetryCount(const QString& devName, const QString& app
     return plugin->getRetryCount(devName, appName, role, pin);
 }
 
+//=== 异步调用 ===
+
+QFuture<Result<QList<AppInfo>>> AppService::enumAppsAsync(const QString& devName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName]() { return enumApps(devName); });
+}
+
+QFuture<Result<void>> AppService::createAppAsync(const QString& devName, const QString& appName,
+                                                 const QVariantMap& args) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, args]() { return createApp(devName, appName, args); });
+}
+
+QFuture<Result<void>> AppService::deleteAppAsync(const QString& devName, const QString& appName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName]() { return deleteApp(devName, appName); });
+}
+
+QFuture<Result<void>> AppService::loginAsync(const QString& devName, const QString& appName, const QString& role,
+                                             const QString& pin, bool emitSignals) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, role, pin, emitSignals]() {
+                            return login(devName, appName, role, pin, emitSignals);
+                        });
+}
+
+QFuture<Result<void>> AppService::logoutAsync(const QString& devName, const QString& appName, bool emitSignals) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, emitSignals]() { return logout(devName, appName, emitSignals); });
+}
+
+QFuture<Result<void>> AppService::changePinAsync(const QString& devName, const QString& appName, const QString& role,
+                                                 const QString& oldPin, const QString& newPin) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, role, oldPin, newPin]() {
+                            return changePin(devName, appName, role, oldPin, newPin);
+                        });
+}
+
+QFuture<Result<void>> AppService::unlockPinAsync(const QString& devName, const QString& appName,
+                                                 const QString& adminPin, const QString& newUserPin,
+                                                 const QVariantMap& args) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, adminPin, newUserPin, args]() {
+                            return unlockPin(devName, appName, adminPin, newUserPin, args);
+                        });
+}
+
+QFuture<Result<int>> AppService::getRetryCountAsync(const QString& devName, const QString& appName, const QString& role,
+                                                    const QString& pin) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, role, pin]() { return getRetryCount(devName, appName, role, pin); });
+}
+
 }  // namespace wekey
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QObject>
 #include <QVariantMap>
 
@@ -37,6 +38,22 @@ public:
     Result<int> getRetryCount(const QString& devName, const QString& appName,
                                const QString& role, const QString& pin);
 
+    //=== 异步调用：在设备执行器上执行同名同步方法，立即返回 ===
+    // loginStateChanged 等信号随之在执行器线程发出，接收方按队列连接处理
+
+    QFuture<Result<QList<AppInfo>>> enumAppsAsync(const QString& devName);
+    QFuture<Result<void>> createAppAsync(const QString& devName, const QString& appName, const QVariantMap& args);
+    QFuture<Result<void>> deleteAppAsync(const QString& devName, const QString& appName);
+    QFuture<Result<void>> loginAsync(const QString& devName, const QString& appName, const QString& role,
+                                     const QString& pin, bool emitSignals = true);
+    QFuture<Result<void>> logoutAsync(const QString& devName, const QString& appName, bool emitSignals = true);
+    QFuture<Result<void>> changePinAsync(const QString& devName, const QString& appName, const QString& role,
+                                         const QString& oldPin, const QString& newPin);
+    QFuture<Result<void>> unlockPinAsync(const QString& devName, const QString& appName, const QString& adminPin,
+                                         const QString& newUserPin, const QVariantMap& args);
+    QFuture<Result<int>> getRetryCountAsync(const QString& devName, const QString& appName, const QString& role,
+                                            const QString& pin);
+
 signals:
     void loginStateChanged(const QString& devName, const QString& appName, bool loggedIn);
     void pinError(const QString& devName, const QString& appName, int retryCount);
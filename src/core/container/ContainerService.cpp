@@ -5,7 +5,9 @@
 
 #include "ContainerService.h"
 
+#include "core/keypool/KeyPool.h"
 #include "plugin/PluginManager.h"
+#include "plugin/interface/AsyncDriverPlugin.h"
 
 namespace wekey {
 
@@ -22,7 +24,20 @@ Result<QList<ContainerInfo>> ContainerService::enumContainers(const QString& dev
         return Result<QList<ContainerInfo>>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "ContainerService::enumContainers"));
     }
-    return plugin->enumContainers(devName, appName);
+    auto result = plugin->enumContainers(devName, appName);
+    if (result.isErr()) {
+        return result;
+    }
+
+    // 已领取的备用容器以逻辑名展示，未领取的备用容器不展示
+    QList<ContainerInfo> containers;
+    for (auto info : result.value()) {
+        info.containerName = KeyPool::instance().displayName(devName, appName, info.containerName);
+        if (!info.containerName.isEmpty()) {
+            containers.append(info);
+        }
+    }
+    return Result<QList<ContainerInfo>>::ok(containers);
 }
 
 Result<void> ContainerService::createContainer(const QString& devName, const QString& appName,
@@ -32,6 +47,10 @@ Result<void> ContainerService::createContainer(const QString& devName, const QSt
         return Result<void>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "ContainerService::createContainer"));
     }
+    if (KeyPool::instance().isMapped(devName, appName, containerName)) {
+        return Result<void>::err(
+            Error(Error::AlreadyExists, "容器已存在", "ContainerService::createContainer"));
+    }
     return plugin->createContainer(devName, appName, containerName);
 }
 
@@ -42,7 +61,36 @@ Result<void> ContainerService::deleteContainer(const QString& devName, const QSt
         return Result<void>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "ContainerService::deleteContainer"));
     }
-    return plugin->deleteContainer(devName, appName, containerName);
+    auto& keyPool = KeyPool::instance();
+    auto result = plugin->deleteContainer(devName, appName, keyPool.resolve(devName, appName, containerName));
+    if (result.isOk()) {
+        keyPool.forget(devName, appName, containerName);
+    }
+    return result;
+}
+
+//=== 异步调用 ===
+
+QFuture<Result<QList<ContainerInfo>>> ContainerService::enumContainersAsync(const QString& devName,
+                                                                            const QString& appName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName]() { return enumContainers(devName, appName); });
+}
+
+QFuture<Result<void>> ContainerService::createContainerAsync(const QString& devName, const QString& appName,
+                                                             const QString& containerName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName]() {
+                            return createContainer(devName, appName, containerName);
+                        });
+}
+
+QFuture<Result<void>> ContainerService::deleteContainerAsync(const QString& devName, const QString& appName,
+                                                             const QString& containerName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName]() {
+                            return deleteContainer(devName, appName, containerName);
+                        });
 }
 
 }  // namespace wekey
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QObject>
 
 #include "common/Result.h"
@@ -27,6 +28,14 @@ public:
     Result<void> createContainer(const QString& devName, const QString& appName, const QString& containerName);
     Result<void> deleteContainer(const QString& devName, const QString& appName, const QString& containerName);
 
+    //=== 异步调用：在设备执行器上执行同名同步方法，立即返回 ===
+
+    QFuture<Result<QList<ContainerInfo>>> enumContainersAsync(const QString& devName, const QString& appName);
+    QFuture<Result<void>> createContainerAsync(const QString& devName, const QString& appName,
+                                               const QString& containerName);
+    QFuture<Result<void>> deleteContainerAsync(const QString& devName, const QString& appName,
+                                               const QString& containerName);
+
 private:
     ContainerService();
     ~ContainerService() override = default;
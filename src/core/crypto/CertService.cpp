@@ -5,7 +5,9 @@
 
 #include "CertService.h"
 
+#include "core/keypool/KeyPool.h"
 #include "plugin/PluginManager.h"
+#include "plugin/interface/AsyncDriverPlugin.h"
 
 namespace wekey {
 
@@ -23,7 +25,8 @@ Result<QByteArray> CertService::generateKeyPair(const QString& devName, const QS
         return Result<QByteArray>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::generateKeyPair"));
     }
-    return plugin->generateKeyPair(devName, appName, containerName, keyType);
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    return plugin->generateKeyPair(devName, appName, physicalName, keyType);
 }
 
 Result<QByteArray> CertService::generateCsr(const QString& devName, const QString& appName,
@@ -33,7 +36,18 @@ Result<QByteArray> CertService::generateCsr(const QString& devName, const QStrin
         return Result<QByteArray>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::generateCsr"));
     }
-    return plugin->generateCsr(devName, appName, containerName, args);
+    auto& keyPool = KeyPool::instance();
+    QVariantMap effectiveArgs = args;
+    if (args.value("renewKey", false).toBool()) {
+        // 领取到预生成的备用容器时密钥已就绪，不再现场生成
+        const QString tag =
+            KeyPool::keyTag(args.value("keyType", "SM2").toString(), args.value("keySize", 2048).toInt());
+        if (keyPool.claim(devName, appName, containerName, tag).isOk()) {
+            effectiveArgs["renewKey"] = false;
+        }
+    }
+    const QString physicalName = keyPool.resolve(devName, appName, containerName);
+    return plugin->generateCsr(devName, appName, physicalName, effectiveArgs);
 }
 
 Result<void> CertService::importCert(const QString& devName, const QString& appName, const QString& containerName,
@@ -43,7 +57,13 @@ Result<void> CertService::importCert(const QString& devName, const QString& appN
         return Result<void>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::importCert"));
     }
-    return plugin->importCert(devName, appName, containerName, certData, isSignCert);
+    auto& keyPool = KeyPool::instance();
+    const QString physicalName = keyPool.resolve(devName, appName, containerName);
+    auto result = plugin->importCert(devName, appName, physicalName, certData, isSignCert);
+    if (result.isOk()) {
+        keyPool.finishRenewal(devName, appName, containerName);
+    }
+    return result;
 }
 
 Result<void> CertService::importKeyCert(const QString& devName, const QString& appName, const QString& containerName,
@@ -54,7 +74,13 @@ Result<void> CertService::importKeyCert(const QString& devName, const QString& a
         return Result<void>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::importKeyCert"));
     }
-    return plugin->importKeyCert(devName, appName, containerName, sigCert, encCert, encPrivate, nonGM);
+    auto& keyPool = KeyPool::instance();
+    const QString physicalName = keyPool.resolve(devName, appName, containerName);
+    auto result = plugin->importKeyCert(devName, appName, physicalName, sigCert, encCert, encPrivate, nonGM);
+    if (result.isOk()) {
+        keyPool.finishRenewal(devName, appName, containerName);
+    }
+    return result;
 }
 
 Result<QByteArray> CertService::exportCert(const QString& devName, const QString& appName,
@@ -64,7 +90,8 @@ Result<QByteArray> CertService::exportCert(const QString& devName, const QString
         return Result<QByteArray>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::exportCert"));
     }
-    return plugin->exportCert(devName, appName, containerName, isSignCert);
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    return plugin->exportCert(devName, appName, physicalName, isSignCert);
 }
 
 Result<CertInfo> CertService::getCertInfo(const QString& devName, const QString& appName,
@@ -74,7 +101,8 @@ Result<CertInfo> CertService::getCertInfo(const QString& devName, const QString&
         return Result<CertInfo>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::getCertInfo"));
     }
-    return plugin->getCertInfo(devName, appName, containerName, isSignCert);
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    return plugin->getCertInfo(devName, appName, physicalName, isSignCert);
 }
 
 Result<QByteArray> CertService::sign(const QString& devName, const QString& appName, const QString& containerName,
@@ -84,7 +112,8 @@ Result<QByteArray> CertService::sign(const QString& devName, const QString& appN
         return Result<QByteArray>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::sign"));
     }
-    return plugin->sign(devName, appName, containerName, data);
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    return plugin->sign(devName, appName, physicalName, data);
 }
 
 Result<bool> CertService::verify(const QString& devName, const QString& appName, const QString& containerName,
@@ -94,7 +123,78 @@ Result<bool> CertService::verify(const QString& devName, const QString& appName,
         return Result<bool>::err(
             Error(Error::NoActiveModule, "驱动模块未激活", "CertService::verify"));
     }
-    return plugin->verify(devName, appName, containerName, data, signature);
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    return plugin->verify(devName, appName, physicalName, data, signature);
+}
+
+//=== 异步调用 ===
+
+QFuture<Result<QByteArray>> CertService::generateKeyPairAsync(const QString& devName, const QString& appName,
+                                                              const QString& containerName, const QString& keyType) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, keyType]() {
+                            return generateKeyPair(devName, appName, containerName, keyType);
+                        });
+}
+
+QFuture<Result<QByteArray>> CertService::generateCsrAsync(const QString& devName, const QString& appName,
+                                                          const QString& containerName, const QVariantMap& args) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, args]() {
+                            return generateCsr(devName, appName, containerName, args);
+                        });
+}
+
+QFuture<Result<void>> CertService::importCertAsync(const QString& devName, const QString& appName,
+                                                   const QString& containerName, const QByteArray& certData,
+                                                   bool isSignCert) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, certData, isSignCert]() {
+                            return importCert(devName, appName, containerName, certData, isSignCert);
+                        });
+}
+
+QFuture<Result<void>> CertService::importKeyCertAsync(const QString& devName, const QString& appName,
+                                                      const QString& containerName, const QByteArray& sigCert,
+                                                      const QByteArray& encCert, const QByteArray& encPrivate,
+                                                      bool nonGM) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, sigCert, encCert, encPrivate, nonGM]() {
+                            return importKeyCert(devName, appName, containerName, sigCert, encCert, encPrivate, nonGM);
+                        });
+}
+
+QFuture<Result<QByteArray>> CertService::exportCertAsync(const QString& devName, const QString& appName,
+                                                         const QString& containerName, bool isSignCert) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, isSignCert]() {
+                            return exportCert(devName, appName, containerName, isSignCert);
+                        });
+}
+
+QFuture<Result<CertInfo>> CertService::getCertInfoAsync(const QString& devName, const QString& appName,
+                                                        const QString& containerName, bool isSignCert) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, isSignCert]() {
+                            return getCertInfo(devName, appName, containerName, isSignCert);
+                        });
+}
+
+QFuture<Result<QByteArray>> CertService::signAsync(const QString& devName, const QString& appName,
+                                                   const QString& containerName, const QByteArray& data) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, data]() {
+                            return sign(devName, appName, containerName, data);
+                        });
+}
+
+QFuture<Result<bool>> CertService::verifyAsync(const QString& devName, const QString& appName,
+                                               const QString& containerName, const QByteArray& data,
+                                               const QByteArray& signature) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, containerName, data, signature]() {
+                            return verify(devName, appName, containerName, data, signature);
+                        });
 }
 
 }  // namespace wekey
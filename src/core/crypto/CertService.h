@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QObject>
 
 #include "common/Result.h"
@@ -41,6 +42,26 @@ public:
     Result<bool> verify(const QString& devName, const QString& appName, const QString& containerName,
                         const QByteArray& data, const QByteArray& signature);
 
+    //=== 异步调用：在设备执行器上执行同名同步方法，立即返回 ===
+
+    QFuture<Result<QByteArray>> generateKeyPairAsync(const QString& devName, const QString& appName,
+                                                     const QString& containerName, const QString& keyType);
+    QFuture<Result<QByteArray>> generateCsrAsync(const QString& devName, const QString& appName,
+                                                 const QString& containerName, const QVariantMap& args);
+    QFuture<Result<void>> importCertAsync(const QString& devName, const QString& appName, const QString& containerName,
+                                          const QByteArray& certData, bool isSignCert);
+    QFuture<Result<void>> importKeyCertAsync(const QString& devName, const QString& appName,
+                                             const QString& containerName, const QByteArray& sigCert,
+                                             const QByteArray& encCert, const QByteArray& encPrivate, bool nonGM);
+    QFuture<Result<QByteArray>> exportCertAsync(const QString& devName, const QString& appName,
+                                                const QString& containerName, bool isSignCert);
+    QFuture<Result<CertInfo>> getCertInfoAsync(const QString& devName, const QString& appName,
+                                               const QString& containerName, bool isSignCert);
+    QFuture<Result<QByteArray>> signAsync(const QString& devName, const QString& appName, const QString& containerName,
+                                          const QByteArray& data);
+    QFuture<Result<bool>> verifyAsync(const QString& devName, const QString& appName, const QString& containerName,
+                                      const QByteArray& data, const QByteArray& signature);
+
 private:
     CertService();
     ~CertService() override = default;
@@ -0,0 +1,488 @@
+/**
+ * @file EnvelopeService.cpp
+ * @brief 数字信封加解密服务实现
+ */
+
+#include "EnvelopeService.h"
+
+#include <QBuffer>
+#include <QtEndian>
+
+#include <limits>
+#include <memory>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+#include "core/keypool/KeyPool.h"
+#include "plugin/PluginManager.h"
+
+namespace wekey {
+
+namespace {
+
+constexpr char kMagic[] = {'W', 'K', 'E', 'V'};
+constexpr char kVersion = 1;
+constexpr int kNoncePrefixLen = 7;
+constexpr int kTagLen = 16;
+/// 固定头部长度：magic(4) + version(1) + cipher(1) + chunkSize(4) + noncePrefix(7) + wrappedKeyLen(2)
+constexpr int kFixedHeaderLen = 19;
+/// 解密时按头部声明的块长分配缓冲区，限制上限防止构造的信封触发超大分配
+constexpr quint32 kMaxChunkSize = 1024 * 1024;
+
+/**
+ * @brief 对称算法
+ */
+struct CipherSpec {
+    quint8 id;         ///< 信封中的算法标识
+    const char* name;  ///< OpenSSL 算法名，同时是接口参数取值
+    int keyLen;        ///< 会话密钥长度
+};
+
+constexpr CipherSpec kCiphers[] = {
+    {1, "SM4-GCM", 16},
+    {2, "AES-256-GCM", 32},
+};
+
+const CipherSpec* cipherById(quint8 id) {
+    for (const auto& spec : kCiphers) {
+        if (spec.id == id) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+const CipherSpec* cipherByName(const QString& name) {
+    for (const auto& spec : kCiphers) {
+        if (name.compare(QLatin1String(spec.name), Qt::CaseInsensitive) == 0) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 链接的 OpenSSL 是否提供该算法（SM4-GCM 自 OpenSSL 3.2 起提供）
+ */
+bool cipherAvailable(const CipherSpec& spec) {
+    EVP_CIPHER* cipher = EVP_CIPHER_fetch(nullptr, spec.name, nullptr);
+    EVP_CIPHER_free(cipher);
+    return cipher != nullptr;
+}
+
+using EvpPKeyPtr = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+
+/**
+ * @brief 离开作用域时擦除会话密钥
+ */
+struct CleanseGuard {
+    QByteArray& bytes;
+    ~CleanseGuard() { OPENSSL_cleanse(bytes.data(), static_cast<size_t>(bytes.size())); }
+};
+
+/**
+ * @brief 分块 AEAD：整个信封共用一个上下文，每块只更换 nonce
+ */
+class ChunkCipher {
+public:
+    ChunkCipher() = default;
+    ~ChunkCipher() {
+        EVP_CIPHER_CTX_free(ctx_);
+        EVP_CIPHER_free(cipher_);
+    }
+
+    ChunkCipher(const ChunkCipher&) = delete;
+    ChunkCipher& operator=(const ChunkCipher&) = delete;
+
+    /**
+     * @param aad 每块的附加认证数据（信封头部）
+     */
+    Result<void> init(const CipherSpec& spec, const QByteArray& key, const QByteArray& aad, bool encrypt) {
+        cipher_ = EVP_CIPHER_fetch(nullptr, spec.name, nullptr);
+        if (!cipher_) {
+            return Result<void>::err(
+                Error(Error::Fail, QString("OpenSSL 不支持 %1").arg(QLatin1String(spec.name)), "EnvelopeService"));
+        }
+        ctx_ = EVP_CIPHER_CTX_new();
+        if (!ctx_ || EVP_CipherInit_ex2(ctx_, cipher_, reinterpret_cast<const unsigned char*>(key.constData()),
+                                        nullptr, encrypt ? 1 : 0, nullptr) != 1) {
+            return Result<void>::err(Error(Error::Fail, "对称密钥初始化失败", "EnvelopeService"));
+        }
+        aad_ = aad;
+        return Result<void>::ok();
+    }
+
+    /**
+     * @brief 加密一块，out = 密文 | tag
+     */
+    bool seal(const QByteArray& nonce, const QByteArray& plain, QByteArray& out) {
+        out.resize(plain.size() + kTagLen);
+        auto* dst = reinterpret_cast<unsigned char*>(out.data());
+        int len = 0;
+        int finalLen = 0;
+        if (!begin(nonce)) {
+            return false;
+        }
+        if (!plain.isEmpty() && EVP_CipherUpdate(ctx_, dst, &len,
+                                                 reinterpret_cast<const unsigned char*>(plain.constData()),
+                                                 static_cast<int>(plain.size())) != 1) {
+            return false;
+        }
+        return EVP_CipherFinal_ex(ctx_, dst + len, &finalLen) == 1 &&
+               EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_GET_TAG, kTagLen, dst + plain.size()) == 1;
+    }
+
+    /**
+     * @brief 解密一块（密文 | tag，长度不小于 kTagLen），认证失败返回 false
+     */
+    bool open(const QByteArray& nonce, const QByteArray& sealed, QByteArray& out) {
+        const int dataLen = static_cast<int>(sealed.size()) - kTagLen;
+        out.resize(dataLen);
+        auto* dst = reinterpret_cast<unsigned char*>(out.data());
+        const auto* src = reinterpret_cast<const unsigned char*>(sealed.constData());
+        int len = 0;
+        int finalLen = 0;
+        if (!begin(nonce)) {
+            return false;
+        }
+        if (dataLen > 0 && EVP_CipherUpdate(ctx_, dst, &len, src, dataLen) != 1) {
+            return false;
+        }
+        // 设置期望的 tag 后由 Final 完成校验
+        return EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_SET_TAG, kTagLen,
+                                   const_cast<unsigned char*>(src + dataLen)) == 1 &&
+               EVP_CipherFinal_ex(ctx_, dst + len, &finalLen) == 1;
+    }
+
+private:
+    bool begin(const QByteArray& nonce) {
+        int len = 0;
+        return EVP_CipherInit_ex2(ctx_, nullptr, nullptr, reinterpret_cast<const unsigned char*>(nonce.constData()),
+                                  -1, nullptr) == 1 &&
+               EVP_CipherUpdate(ctx_, nullptr, &len, reinterpret_cast<const unsigned char*>(aad_.constData()),
+                                static_cast<int>(aad_.size())) == 1;
+    }
+
+    EVP_CIPHER* cipher_ = nullptr;
+    EVP_CIPHER_CTX* ctx_ = nullptr;
+    QByteArray aad_;
+};
+
+/**
+ * @brief 第 index 块的 nonce：noncePrefix | index(4) | last(1)
+ */
+QByteArray chunkNonce(const QByteArray& prefix, quint32 index, bool last) {
+    QByteArray nonce = prefix;
+    char counter[4];
+    qToBigEndian(index, counter);
+    nonce.append(counter, sizeof(counter));
+    nonce.append(last ? '\x01' : '\x00');
+    return nonce;
+}
+
+/**
+ * @brief 读满 size 字节或读到输入结束
+ * @return 读取出错时返回 false
+ */
+bool readUpTo(QIODevice* in, qint64 size, QByteArray& out) {
+    out.resize(size);
+    qint64 got = 0;
+    while (got < size) {
+        qint64 n = in->read(out.data() + got, size - got);
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        got += n;
+    }
+    out.resize(got);
+    return true;
+}
+
+/**
+ * @brief 用加密公钥封装会话密钥（SM2 输出 GM/T 0009 DER 密文，RSA 使用 PKCS#1 v1.5 填充）
+ *
+ * RSA 不能改用 OAEP：解封由设备上的 SKF_RSADecrypt 完成，它固定按 PKCS#1 v1.5 去除填充，
+ * GM/T 0016 也没有可供主机自行解 OAEP 的原始私钥运算。
+ */
+Result<QByteArray> wrapSessionKey(EVP_PKEY* pkey, const QByteArray& sessionKey) {
+    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_from_pkey(nullptr, pkey, nullptr);
+    const auto* in = reinterpret_cast<const unsigned char*>(sessionKey.constData());
+    const auto inLen = static_cast<size_t>(sessionKey.size());
+    size_t outLen = 0;
+    bool ok = ctx && EVP_PKEY_encrypt_init(ctx) == 1 &&
+              (!EVP_PKEY_is_a(pkey, "RSA") || EVP_PKEY_CTX_set_rsa_padding(ctx, RSA_PKCS1_PADDING) == 1) &&
+              EVP_PKEY_encrypt(ctx, nullptr, &outLen, in, inLen) == 1;
+    QByteArray wrapped;
+    if (ok) {
+        wrapped.resize(static_cast<qsizetype>(outLen));
+        ok = EVP_PKEY_encrypt(ctx, reinterpret_cast<unsigned char*>(wrapped.data()), &outLen, in, inLen) == 1;
+        wrapped.resize(static_cast<qsizetype>(outLen));
+    }
+    EVP_PKEY_CTX_free(ctx);
+    if (!ok) {
+        return Result<QByteArray>::err(Error(Error::Fail, "会话密钥封装失败", "EnvelopeService::encrypt"));
+    }
+    return Result<QByteArray>::ok(wrapped);
+}
+
+Result<void> writeAll(QIODevice* out, const QByteArray& data, const char* context) {
+    if (out->write(data) != data.size()) {
+        return Result<void>::err(Error(Error::Fail, "写出数据失败: " + out->errorString(), context));
+    }
+    return Result<void>::ok();
+}
+
+}  // namespace
+
+EnvelopeService& EnvelopeService::instance() {
+    static EnvelopeService instance;
+    return instance;
+}
+
+EnvelopeService::EnvelopeService() : QObject(nullptr) {}
+
+Result<void> EnvelopeService::encrypt(const QString& devName, const QString& appName, const QString& containerName,
+                                      QIODevice* in, QIODevice* out, const QString& cipher) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin) {
+        return Result<void>::err(Error(Error::NoActiveModule, "驱动模块未激活", "EnvelopeService::encrypt"));
+    }
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    auto keyResult = plugin->exportPublicKey(devName, appName, physicalName, false);
+    if (keyResult.isErr()) {
+        return Result<void>::err(keyResult.error());
+    }
+
+    const QByteArray& spki = keyResult.value();
+    const auto* spkiPtr = reinterpret_cast<const unsigned char*>(spki.constData());
+    EvpPKeyPtr pkey(d2i_PUBKEY(nullptr, &spkiPtr, static_cast<long>(spki.size())), &EVP_PKEY_free);
+    if (!pkey) {
+        return Result<void>::err(Error(Error::Fail, "加密公钥无效", "EnvelopeService::encrypt"));
+    }
+
+    const CipherSpec* spec = cipherByName(cipher);
+    if (cipher.isEmpty()) {
+        // SM2 容器优先 SM4-GCM，OpenSSL 不支持时与 RSA 容器一样用 AES-256-GCM
+        spec = cipherByName("AES-256-GCM");
+        const CipherSpec* sm4 = cipherByName("SM4-GCM");
+        if (EVP_PKEY_is_a(pkey.get(), "SM2") == 1 && cipherAvailable(*sm4)) {
+            spec = sm4;
+        }
+    }
+    if (!spec) {
+        return Result<void>::err(
+            Error(Error::InvalidParam, QString("不支持的对称算法: %1").arg(cipher), "EnvelopeService::encrypt"));
+    }
+
+    QByteArray sessionKey(spec->keyLen, '\0');
+    CleanseGuard keyGuard{sessionKey};
+    QByteArray noncePrefix(kNoncePrefixLen, '\0');
+    if (RAND_bytes(reinterpret_cast<unsigned char*>(sessionKey.data()), spec->keyLen) != 1 ||
+        RAND_bytes(reinterpret_cast<unsigned char*>(noncePrefix.data()), kNoncePrefixLen) != 1) {
+        return Result<void>::err(Error(Error::Fail, "生成会话密钥失败", "EnvelopeService::encrypt"));
+    }
+
+    auto wrapResult = wrapSessionKey(pkey.get(), sessionKey);
+    if (wrapResult.isErr()) {
+        return Result<void>::err(wrapResult.error());
+    }
+    const QByteArray& wrapped = wrapResult.value();
+
+    // 头部
+    QByteArray header(kMagic, sizeof(kMagic));
+    char field[4];
+    header.append(kVersion);
+    header.append(static_cast<char>(spec->id));
+    qToBigEndian(static_cast<quint32>(kChunkSize), field);
+    header.append(field, 4);
+    header.append(noncePrefix);
+    qToBigEndian(static_cast<quint16>(wrapped.size()), field);
+    header.append(field, 2);
+    header.append(wrapped);
+
+    ChunkCipher chunkCipher;
+    auto initResult = chunkCipher.init(*spec, sessionKey, header, true);
+    if (initResult.isErr()) {
+        return initResult;
+    }
+    auto writeResult = writeAll(out, header, "EnvelopeService::encrypt");
+    if (writeResult.isErr()) {
+        return writeResult;
+    }
+
+    // 预读下一块以判断当前块是否为最后一块（最后一块可以正好是整块，也可以为空）
+    QByteArray current;
+    QByteArray next;
+    QByteArray sealed;
+    if (!readUpTo(in, kChunkSize, current)) {
+        return Result<void>::err(Error(Error::Fail, "读取输入失败: " + in->errorString(), "EnvelopeService::encrypt"));
+    }
+    for (quint32 index = 0;; ++index) {
+        next.clear();
+        if (current.size() == kChunkSize && !readUpTo(in, kChunkSize, next)) {
+            return Result<void>::err(
+                Error(Error::Fail, "读取输入失败: " + in->errorString(), "EnvelopeService::encrypt"));
+        }
+        const bool last = next.isEmpty();
+        if (!last && index == std::numeric_limits<quint32>::max()) {
+            return Result<void>::err(Error(Error::InvalidParam, "数据过大", "EnvelopeService::encrypt"));
+        }
+        if (!chunkCipher.seal(chunkNonce(noncePrefix, index, last), current, sealed)) {
+            return Result<void>::err(Error(Error::Fail, "数据加密失败", "EnvelopeService::encrypt"));
+        }
+        writeResult = writeAll(out, sealed, "EnvelopeService::encrypt");
+        if (writeResult.isErr()) {
+            return writeResult;
+        }
+        if (last) {
+            break;
+        }
+        current.swap(next);
+    }
+    return Result<void>::ok();
+}
+
+Result<void> EnvelopeService::decrypt(const QString& devName, const QString& appName, const QString& containerName,
+                                      QIODevice* in, QIODevice* out) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin) {
+        return Result<void>::err(Error(Error::NoActiveModule, "驱动模块未激活", "EnvelopeService::decrypt"));
+    }
+
+    auto readError = [in]() {
+        return Result<void>::err(Error(Error::Fail, "读取输入失败: " + in->errorString(), "EnvelopeService::decrypt"));
+    };
+    auto invalid = [](const QString& message) {
+        return Result<void>::err(Error(Error::InvalidParam, message, "EnvelopeService::decrypt"));
+    };
+
+    // 头部
+    QByteArray header;
+    if (!readUpTo(in, kFixedHeaderLen, header)) {
+        return readError();
+    }
+    if (header.size() != kFixedHeaderLen || !header.startsWith(QByteArray(kMagic, sizeof(kMagic))) ||
+        header.at(4) != kVersion) {
+        return invalid("不是有效的信封数据");
+    }
+    const CipherSpec* spec = cipherById(static_cast<quint8>(header.at(5)));
+    const auto chunkSize = qFromBigEndian<quint32>(header.constData() + 6);
+    const QByteArray noncePrefix = header.mid(10, kNoncePrefixLen);
+    const auto wrappedLen = qFromBigEndian<quint16>(header.constData() + 17);
+    if (!spec) {
+        return invalid("信封使用了不支持的对称算法");
+    }
+    if (chunkSize == 0 || chunkSize > kMaxChunkSize || wrappedLen == 0) {
+        return invalid("不是有效的信封数据");
+    }
+    QByteArray wrapped;
+    if (!readUpTo(in, wrappedLen, wrapped)) {
+        return readError();
+    }
+    if (wrapped.size() != wrappedLen) {
+        return invalid("信封数据不完整");
+    }
+    header.append(wrapped);
+
+    // 在设备上解开会话密钥
+    const QString physicalName = KeyPool::instance().resolve(devName, appName, containerName);
+    auto keyResult = plugin->privateDecrypt(devName, appName, physicalName, wrapped);
+    if (keyResult.isErr()) {
+        return Result<void>::err(keyResult.error());
+    }
+    QByteArray& sessionKey = keyResult.value();
+    CleanseGuard keyGuard{sessionKey};
+    if (sessionKey.size() != spec->keyLen) {
+        // 解出的不是本信封的会话密钥（如 RSA PKCS#1 v1.5 去填充得到错误长度）。不单独报错，
+        // 换成随机密钥继续，与密钥不匹配一样在首块校验时失败，不给去填充结果留下可区分的信号
+        OPENSSL_cleanse(sessionKey.data(), static_cast<size_t>(sessionKey.size()));
+        sessionKey.resize(spec->keyLen);
+        if (RAND_bytes(reinterpret_cast<unsigned char*>(sessionKey.data()), spec->keyLen) != 1) {
+            sessionKey.fill('\0');
+        }
+    }
+
+    ChunkCipher chunkCipher;
+    auto initResult = chunkCipher.init(*spec, sessionKey, header, false);
+    if (initResult.isErr()) {
+        return initResult;
+    }
+
+    const qint64 sealedSize = static_cast<qint64>(chunkSize) + kTagLen;
+    QByteArray current;
+    QByteArray next;
+    QByteArray plain;
+    if (!readUpTo(in, sealedSize, current)) {
+        return readError();
+    }
+    for (quint32 index = 0;; ++index) {
+        if (current.size() < kTagLen) {
+            return invalid("信封数据不完整");
+        }
+        next.clear();
+        if (current.size() == sealedSize && !readUpTo(in, sealedSize, next)) {
+            return readError();
+        }
+        const bool last = next.isEmpty();
+        if (!last && index == std::numeric_limits<quint32>::max()) {
+            return invalid("不是有效的信封数据");
+        }
+        if (!chunkCipher.open(chunkNonce(noncePrefix, index, last), current, plain)) {
+            return Result<void>::err(
+                Error(Error::Fail, "信封数据校验失败（数据被篡改或容器密钥不匹配）", "EnvelopeService::decrypt"));
+        }
+        auto writeResult = writeAll(out, plain, "EnvelopeService::decrypt");
+        if (writeResult.isErr()) {
+            return writeResult;
+        }
+        if (last) {
+            break;
+        }
+        current.swap(next);
+    }
+    return Result<void>::ok();
+}
+
+Result<QByteArray> EnvelopeService::encrypt(const QString& devName, const QString& appName,
+                                            const QString& containerName, const QByteArray& data,
+                                            const QString& cipher) {
+    QBuffer in;
+    in.setData(data);
+    in.open(QIODevice::ReadOnly);
+    QByteArray envelope;
+    QBuffer out(&envelope);
+    out.open(QIODevice::WriteOnly);
+
+    auto result = encrypt(devName, appName, containerName, &in, &out, cipher);
+    if (result.isErr()) {
+        return Result<QByteArray>::err(result.error());
+    }
+    out.close();
+    return Result<QByteArray>::ok(envelope);
+}
+
+Result<QByteArray> EnvelopeService::decrypt(const QString& devName, const QString& appName,
+                                            const QString& containerName, const QByteArray& envelope) {
+    QBuffer in;
+    in.setData(envelope);
+    in.open(QIODevice::ReadOnly);
+    QByteArray plain;
+    QBuffer out(&plain);
+    out.open(QIODevice::WriteOnly);
+
+    auto result = decrypt(devName, appName, containerName, &in, &out);
+    if (result.isErr()) {
+        return Result<QByteArray>::err(result.error());
+    }
+    out.close();
+    return Result<QByteArray>::ok(plain);
+}
+
+}  // namespace wekey
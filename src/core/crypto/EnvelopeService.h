@@ -0,0 +1,76 @@
+/**
+ * @file EnvelopeService.h
+ * @brief 数字信封加解密服务
+ *
+ * 数据在主机上用 OpenSSL 做对称加密，设备只负责解开会话密钥
+ */
+
+#pragma once
+
+#include <QObject>
+
+#include "common/Result.h"
+
+class QIODevice;
+
+namespace wekey {
+
+/**
+ * @brief 数字信封加解密服务（单例）
+ *
+ * 加密：生成随机会话密钥，用容器加密公钥（驱动插件缓存）在主机上封装，数据按块做 AEAD 加密。
+ * 解密：在设备上用容器加密私钥解开会话密钥，再在主机上逐块解密。
+ *
+ * 信封格式（整数均为大端）：
+ * @code
+ * "WKEV" | version(1) | cipher(1) | chunkSize(4) | noncePrefix(7) | wrappedKeyLen(2) | wrappedKey
+ * chunk* : ciphertext(chunkSize，最后一块 0..chunkSize) | tag(16)
+ * @endcode
+ * 第 i 块的 nonce 为 noncePrefix | i(4) | final(1)，附加数据为整个头部，
+ * 因此块的删除、重排和截断都会导致校验失败。数据按块流式处理，内存占用与输入大小无关。
+ *
+ * RSA 容器的会话密钥使用 PKCS#1 v1.5 封装而非 OAEP：设备端 SKF_RSADecrypt 只支持 v1.5 去填充，
+ * 标准接口中也没有原始 RSA 私钥运算。为减小填充预言攻击面，解出的会话密钥长度不符时不单独报错，
+ * 而是与数据校验失败返回同一错误；设备本身拒绝去填充时仍按 SKF 错误返回（解密需要用户登录）。
+ */
+class EnvelopeService : public QObject {
+    Q_OBJECT
+
+public:
+    /// 每块明文长度
+    static constexpr int kChunkSize = 64 * 1024;
+
+    static EnvelopeService& instance();
+
+    EnvelopeService(const EnvelopeService&) = delete;
+    EnvelopeService& operator=(const EnvelopeService&) = delete;
+
+    /**
+     * @brief 加密 in 中的全部数据，信封写入 out（不需要登录）
+     * @param cipher "SM4-GCM" / "AES-256-GCM"；为空时 SM2 容器用 SM4-GCM（OpenSSL 3.2 以下不支持，
+     *               改用 AES-256-GCM），RSA 容器用 AES-256-GCM
+     * @param in 明文输入（阻塞读取直到结束，如文件或缓冲区）
+     * @param out 信封输出
+     */
+    Result<void> encrypt(const QString& devName, const QString& appName, const QString& containerName,
+                         QIODevice* in, QIODevice* out, const QString& cipher = {});
+
+    /**
+     * @brief 解密 in 中的信封，明文写入 out（需要登录）
+     *
+     * 每块校验通过后才写出；失败时 out 中可能已有前面若干块的明文，调用方应丢弃。
+     */
+    Result<void> decrypt(const QString& devName, const QString& appName, const QString& containerName,
+                         QIODevice* in, QIODevice* out);
+
+    Result<QByteArray> encrypt(const QString& devName, const QString& appName, const QString& containerName,
+                               const QByteArray& data, const QString& cipher = {});
+    Result<QByteArray> decrypt(const QString& devName, const QString& appName, const QString& containerName,
+                               const QByteArray& envelope);
+
+private:
+    EnvelopeService();
+    ~EnvelopeService() override = default;
+};
+
+}  // namespace wekey
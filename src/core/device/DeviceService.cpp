@@ -5,6 +5,10 @@
 
 #include "DeviceService.h"
 
+#include <QDebug>
+
+#include <utility>
+
 #include "plugin/PluginManager.h"
 
 namespace wekey {
@@ -57,10 +61,12 @@ void DeviceService::startDeviceMonitor() {
     }
     monitoring_ = true;
 
-    QObject::connect(&monitorThread_, &QThread::started, [this]() {
-        monitorLoop();
-    });
-    monitorThread_.start();
+    const quint64 generation = ++monitorGeneration_;
+    monitorPlugin_ = PluginManager::instance().activePluginRef();
+    monitorThread_ = QThread::create(
+        [this, generation, plugin = monitorPlugin_]() { monitorLoop(generation, plugin); });
+    monitorThread_->setObjectName("DeviceMonitor");
+    monitorThread_->start();
 }
 
 void DeviceService::stopDeviceMonitor() {
@@ -68,23 +74,42 @@ void DeviceService::stopDeviceMonitor() {
         return;
     }
     monitoring_ = false;
-    monitorThread_.quit();
-    monitorThread_.wait();
+
+    // 监控线程阻塞在 waitForDeviceEvent 中，需先让其返回才能退出
+    const std::shared_ptr<IDriverPlugin> plugin = std::exchange(monitorPlugin_, nullptr);
+    if (plugin) {
+        auto result = plugin->cancelWaitForDeviceEvent();
+        if (result.isErr()) {
+            qWarning() << "[DeviceService] 无法取消设备事件等待:" << result.error().message();
+        }
+    }
+
+    QThread* thread = std::exchange(monitorThread_, nullptr);
+    if (!thread) {
+        return;
+    }
+    if (!thread->wait(kMonitorStopTimeoutMs)) {
+        // 线程仍阻塞在 SKF_WaitForDevEvent 中：不再等待，避免退出流程（包括 SIGTERM）无限期挂起。
+        // 线程对象不释放（析构运行中的 QThread 会中止进程）；线程持有插件的共享所有权，
+        // 即使插件随后被注销或 PluginManager 析构，SkfPlugin 及其动态库也保持加载到调用返回
+        qWarning() << "[DeviceService] 设备监控线程" << kMonitorStopTimeoutMs << "ms 内未退出，放弃等待";
+        return;
+    }
+    delete thread;
 }
 
 bool DeviceService::isMonitoring() const {
     return monitoring_;
 }
 
-void DeviceService::monitorLoop() {
-    auto* plugin = PluginManager::instance().activePlugin();
+void DeviceService::monitorLoop(quint64 generation, const std::shared_ptr<IDriverPlugin>& plugin) {
     if (!plugin) {
         return;
     }
 
-    while (monitoring_) {
+    while (monitoring_ && monitorGeneration_ == generation) {
         auto result = plugin->waitForDeviceEvent();
-        if (result.isErr()) {
+        if (result.isErr() || !monitoring_ || monitorGeneration_ != generation) {
             break;
         }
 
@@ -10,12 +10,15 @@
 #include <QObject>
 #include <QThread>
 #include <atomic>
+#include <memory>
 
 #include "common/Result.h"
 #include "plugin/interface/PluginTypes.h"
 
 namespace wekey {
 
+class IDriverPlugin;
+
 class DeviceService : public QObject {
     Q_OBJECT
 
@@ -42,10 +45,20 @@ private:
     DeviceService();
     ~DeviceService() override;
 
-    void monitorLoop();
+    /// 停止监控时等待监控线程退出的上限
+    static constexpr int kMonitorStopTimeoutMs = 3000;
+
+    /**
+     * @param generation 启动时的代次；停止后再启动会换代，旧线程即使稍后返回也不再处理事件
+     * @param plugin 监控线程持有插件的共享所有权：停止超时被放弃的线程仍可能阻塞在
+     *               SKF_WaitForDevEvent 中，插件及其动态库必须活到该调用返回
+     */
+    void monitorLoop(quint64 generation, const std::shared_ptr<IDriverPlugin>& plugin);
 
-    QThread monitorThread_;
+    QThread* monitorThread_ = nullptr;
+    std::shared_ptr<IDriverPlugin> monitorPlugin_;  ///< 用于取消等待，与监控线程持有的是同一个插件
     std::atomic<bool> monitoring_{false};
+    std::atomic<quint64> monitorGeneration_{0};
 };
 
 }  // namespace wekey
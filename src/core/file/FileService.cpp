@@ -6,6 +6,7 @@
 #include "FileService.h"
 
 #include "plugin/PluginManager.h"
+#include "plugin/interface/AsyncDriverPlugin.h"
 
 namespace wekey {
 
@@ -62,4 +63,37 @@ Result<QByteArray> FileService::generateRandom(const QString& devName, int count
     return plugin->generateRandom(devName, count);
 }
 
+//=== 异步调用 ===
+
+QFuture<Result<QStringList>> FileService::enumFilesAsync(const QString& devName, const QString& appName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName]() { return enumFiles(devName, appName); });
+}
+
+QFuture<Result<QByteArray>> FileService::readFileAsync(const QString& devName, const QString& appName,
+                                                       const QString& fileName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, fileName]() { return readFile(devName, appName, fileName); });
+}
+
+QFuture<Result<void>> FileService::writeFileAsync(const QString& devName, const QString& appName,
+                                                  const QString& fileName, const QByteArray& data, int readRights,
+                                                  int writeRights) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, fileName, data, readRights, writeRights]() {
+                            return writeFile(devName, appName, fileName, data, readRights, writeRights);
+                        });
+}
+
+QFuture<Result<void>> FileService::deleteFileAsync(const QString& devName, const QString& appName,
+                                                   const QString& fileName) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, appName, fileName]() { return deleteFile(devName, appName, fileName); });
+}
+
+QFuture<Result<QByteArray>> FileService::generateRandomAsync(const QString& devName, int count) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, count]() { return generateRandom(devName, count); });
+}
+
 }  // namespace wekey
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QObject>
 
 #include "common/Result.h"
@@ -29,6 +30,15 @@ public:
     Result<void> deleteFile(const QString& devName, const QString& appName, const QString& fileName);
     Result<QByteArray> generateRandom(const QString& devName, int count);
 
+    //=== 异步调用：在设备执行器上执行同名同步方法，立即返回 ===
+
+    QFuture<Result<QStringList>> enumFilesAsync(const QString& devName, const QString& appName);
+    QFuture<Result<QByteArray>> readFileAsync(const QString& devName, const QString& appName, const QString& fileName);
+    QFuture<Result<void>> writeFileAsync(const QString& devName, const QString& appName, const QString& fileName,
+                                         const QByteArray& data, int readRights = 0xFF, int writeRights = 0x01);
+    QFuture<Result<void>> deleteFileAsync(const QString& devName, const QString& appName, const QString& fileName);
+    QFuture<Result<QByteArray>> generateRandomAsync(const QString& devName, int count);
+
 private:
     FileService();
     ~FileService() override = default;
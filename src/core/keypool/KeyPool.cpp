@@ -0,0 +1,553 @@
+/**
+ * @file KeyPool.cpp
+ * @brief 密钥预生成池实现
+ */
+
+#include "KeyPool.h"
+
+#include <QCoreApplication>
+#include <QRandomGenerator>
+
+#include <algorithm>
+
+#include "common/Metrics.h"
+#include "config/Config.h"
+#include "config/Defaults.h"
+#include "core/device/DeviceService.h"
+#include "log/Logger.h"
+#include "plugin/PluginManager.h"
+
+namespace wekey {
+
+namespace {
+
+// SKF 文件权限（见 IDriverPlugin::writeFile）
+constexpr int kAnyoneAccount = 0xFF;
+constexpr int kUserAccount = 0x10;
+
+/**
+ * 映射文件格式：每行 "逻辑名\t备用容器名[\t退役容器名]"，以 '\0' 结尾（文件可能比内容长）。
+ * 退役容器名为空表示没有待删除的旧容器。
+ */
+void parseAliases(const QByteArray& data, QHash<QString, QString>& aliases, QHash<QString, QString>& retiring) {
+    aliases.clear();
+    retiring.clear();
+    const qsizetype end = data.indexOf('\0');
+    const QByteArray text = end >= 0 ? data.left(end) : data;
+    for (const QByteArray& line : text.split('\n')) {
+        const QList<QByteArray> fields = line.split('\t');
+        if (fields.size() < 2 || fields[0].isEmpty() || fields[1].isEmpty()) {
+            continue;
+        }
+        const QString name = QString::fromUtf8(fields[0]);
+        aliases.insert(name, QString::fromUtf8(fields[1]));
+        if (fields.size() > 2 && !fields[2].isEmpty()) {
+            retiring.insert(name, QString::fromUtf8(fields[2]));
+        }
+    }
+}
+
+QByteArray serializeAliases(const QHash<QString, QString>& aliases, const QHash<QString, QString>& retiring) {
+    QStringList names = aliases.keys();
+    std::sort(names.begin(), names.end());
+    QByteArray data;
+    for (const auto& name : names) {
+        data += name.toUtf8() + '\t' + aliases.value(name).toUtf8();
+        if (retiring.contains(name)) {
+            data += '\t' + retiring.value(name).toUtf8();
+        }
+        data += '\n';
+    }
+    data += '\0';
+    return data;
+}
+
+}  // namespace
+
+KeyPool& KeyPool::instance() {
+    static KeyPool instance;
+    return instance;
+}
+
+KeyPool::KeyPool() : QObject(nullptr) {
+    // 首次使用可能在 HTTP 工作线程，定时器和信号连接统一放到主线程
+    if (auto* app = QCoreApplication::instance()) {
+        moveToThread(app->thread());
+    }
+    refillTimer_.moveToThread(thread());
+    refillTimer_.setInterval(defaults::KEY_POOL_REFILL_INTERVAL_MS);
+    connect(&refillTimer_, &QTimer::timeout, this, &KeyPool::onRefillTimer);
+
+    // 设备拔出或切换驱动后缓存的映射和备用容器可能失效，下次访问时重新读取
+    connect(&DeviceService::instance(), &DeviceService::deviceRemoved, this, &KeyPool::clear);
+    connect(&PluginManager::instance(), &PluginManager::activePluginChanged, this, &KeyPool::clear);
+
+    pool_.setMaxThreadCount(1);
+}
+
+KeyPool::~KeyPool() {
+    pool_.waitForDone();
+}
+
+QString KeyPool::keyTag(const QString& keyType, int keySize) {
+    if (keyType.compare("SM2", Qt::CaseInsensitive) == 0) {
+        return "SM2";
+    }
+    return "RSA" + QString::number(keySize > 0 ? keySize : 2048);
+}
+
+QString KeyPool::keyTagFromPairType(const QString& keyPairType) {
+    if (!keyPairType.startsWith("RSA")) {
+        return "SM2";
+    }
+    if (keyPairType.contains("4096")) {
+        return keyTag("RSA", 4096);
+    }
+    if (keyPairType.contains("3072")) {
+        return keyTag("RSA", 3072);
+    }
+    return keyTag("RSA", 2048);
+}
+
+QString KeyPool::stateKey(const QString& devName, const QString& appName) {
+    return devName + '/' + appName;
+}
+
+QString KeyPool::tagOfSpare(const QString& containerName) {
+    // 备用容器名：<前缀><标签>-<随机串>
+    const QString prefix = defaults::KEY_POOL_CONTAINER_PREFIX;
+    if (!containerName.startsWith(prefix)) {
+        return {};
+    }
+    const qsizetype dash = containerName.indexOf('-', prefix.size());
+    return dash > prefix.size() ? containerName.mid(prefix.size(), dash - prefix.size()) : QString();
+}
+
+void KeyPool::watch(const QString& devName, const QString& appName) {
+    if (Config::instance().keyPoolDepth() <= 0) {
+        return;
+    }
+    {
+        QMutexLocker locker(&mutex_);
+        AppState& state = apps_[stateKey(devName, appName)];
+        state.watched = true;
+        state.targets.insert(keyTagFromPairType(Config::instance().keyPoolKeyType()));
+    }
+    QMetaObject::invokeMethod(&refillTimer_, qOverload<>(&QTimer::start), Qt::QueuedConnection);
+}
+
+void KeyPool::unwatch(const QString& devName, const QString& appName) {
+    QMutexLocker locker(&mutex_);
+    auto it = apps_.find(stateKey(devName, appName));
+    if (it != apps_.end()) {
+        it->watched = false;
+    }
+}
+
+Result<void> KeyPool::claim(const QString& devName, const QString& appName, const QString& containerName,
+                            const QString& keyTag) {
+    if (Config::instance().keyPoolDepth() <= 0) {
+        return Result<void>::err(Error(Error::NotFound, "密钥预生成未启用", "KeyPool::claim"));
+    }
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin) {
+        return Result<void>::err(Error(Error::NoActiveModule, "驱动模块未激活", "KeyPool::claim"));
+    }
+
+    QMutexLocker update(&updateMutex_);
+    const QString key = stateKey(devName, appName);
+    const quint64 epoch = currentEpoch();
+    load(plugin, devName, appName, true);
+
+    QString spare;
+    QString previous;
+    bool pendingRenewal = false;
+    QHash<QString, QString> aliases;
+    QHash<QString, QString> retiring;
+    {
+        QMutexLocker locker(&mutex_);
+        AppState& state = apps_[key];
+        // 请求过的密钥类型也作为补充目标，下一次续期可以直接领取
+        state.targets.insert(keyTag);
+
+        QStringList& ready = state.ready[keyTag];
+        if (ready.isEmpty()) {
+            locker.unlock();
+            Metrics::instance().recordCache(Metrics::KeyPoolCache, false);
+            return Result<void>::err(Error(Error::NotFound, "没有就绪的备用容器", "KeyPool::claim"));
+        }
+        spare = ready.takeFirst();
+        previous = state.aliases.value(containerName, containerName);
+        // 上一次续期尚未导入证书时，保留最初的旧容器（仍有有效证书），丢弃中间那个未用上的备用容器
+        pendingRenewal = state.retiring.contains(containerName);
+        aliases = state.aliases;
+        retiring = state.retiring;
+    }
+
+    aliases.insert(containerName, spare);
+    if (!pendingRenewal) {
+        retiring.insert(containerName, previous);
+    }
+    auto saved = saveAliases(plugin, devName, appName, aliases, retiring);
+    if (saved.isErr()) {
+        QMutexLocker locker(&mutex_);
+        if (epoch == epoch_) {
+            apps_[key].ready[keyTag].prepend(spare);
+        }
+        return saved;
+    }
+    publishAliases(key, epoch, aliases, retiring);
+    markUsed();
+
+    if (pendingRenewal) {
+        auto removed = plugin->deleteContainer(devName, appName, previous);
+        if (removed.isErr()) {
+            LOG_DEBUG(QString("[KeyPool] 删除未导入证书的备用容器 %1 失败: %2")
+                          .arg(previous, removed.error().message()));
+        }
+    }
+
+    Metrics::instance().recordCache(Metrics::KeyPoolCache, true);
+    LOG_INFO(QString("[KeyPool] %1/%2 容器 %3 领取备用容器 %4").arg(devName, appName, containerName, spare));
+    QMetaObject::invokeMethod(&refillTimer_, qOverload<>(&QTimer::start), Qt::QueuedConnection);
+    return Result<void>::ok();
+}
+
+void KeyPool::finishRenewal(const QString& devName, const QString& appName, const QString& containerName) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin || !mappingsEnabled()) {
+        return;
+    }
+
+    QMutexLocker update(&updateMutex_);
+    const quint64 epoch = currentEpoch();
+    const AppState state = load(plugin, devName, appName, false);
+    const QString previous = state.retiring.value(containerName);
+    if (previous.isEmpty()) {
+        return;
+    }
+    // 先删除旧容器再更新映射：中途失败时下次导入会重试，旧容器不会成为无人引用的孤儿
+    auto removed = plugin->deleteContainer(devName, appName, previous);
+    if (removed.isErr() && removed.error().code() != Error::NotFound) {
+        LOG_WARN(QString("[KeyPool] 删除退役容器 %1 失败: %2").arg(previous, removed.error().message()));
+        return;
+    }
+    QHash<QString, QString> retiring = state.retiring;
+    retiring.remove(containerName);
+    auto saved = saveAliases(plugin, devName, appName, state.aliases, retiring);
+    if (saved.isErr()) {
+        LOG_WARN(QString("[KeyPool] 更新容器映射失败: %1").arg(saved.error().message()));
+        return;
+    }
+    publishAliases(stateKey(devName, appName), epoch, state.aliases, retiring);
+    LOG_INFO(QString("[KeyPool] %1/%2 容器 %3 续期完成，已删除旧容器 %4")
+                 .arg(devName, appName, containerName, previous));
+}
+
+QString KeyPool::resolve(const QString& devName, const QString& appName, const QString& containerName) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin || !mappingsEnabled()) {
+        return containerName;
+    }
+    return load(plugin, devName, appName, false).aliases.value(containerName, containerName);
+}
+
+QString KeyPool::displayName(const QString& devName, const QString& appName, const QString& containerName) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin || !mappingsEnabled()) {
+        return containerName;
+    }
+    const AppState state = load(plugin, devName, appName, false);
+    for (auto it = state.aliases.cbegin(); it != state.aliases.cend(); ++it) {
+        if (it.value() == containerName) {
+            return it.key();
+        }
+    }
+    if (state.aliases.contains(containerName) || !tagOfSpare(containerName).isEmpty()) {
+        return {};
+    }
+    return containerName;
+}
+
+void KeyPool::forget(const QString& devName, const QString& appName, const QString& containerName) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin || !mappingsEnabled()) {
+        return;
+    }
+
+    QMutexLocker update(&updateMutex_);
+    const quint64 epoch = currentEpoch();
+    const AppState state = load(plugin, devName, appName, false);
+    if (!state.aliases.contains(containerName)) {
+        return;
+    }
+    // 逻辑容器已删除，等待续期的旧容器也不再需要
+    const QString previous = state.retiring.value(containerName);
+    if (!previous.isEmpty()) {
+        auto removed = plugin->deleteContainer(devName, appName, previous);
+        if (removed.isErr()) {
+            LOG_DEBUG(QString("[KeyPool] 删除退役容器 %1 失败: %2").arg(previous, removed.error().message()));
+        }
+    }
+    QHash<QString, QString> aliases = state.aliases;
+    QHash<QString, QString> retiring = state.retiring;
+    aliases.remove(containerName);
+    retiring.remove(containerName);
+    auto saved = saveAliases(plugin, devName, appName, aliases, retiring);
+    if (saved.isErr()) {
+        LOG_WARN(QString("[KeyPool] 更新容器映射失败: %1").arg(saved.error().message()));
+        return;
+    }
+    publishAliases(stateKey(devName, appName), epoch, aliases, retiring);
+}
+
+bool KeyPool::isMapped(const QString& devName, const QString& appName, const QString& containerName) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin || !mappingsEnabled()) {
+        return false;
+    }
+    return load(plugin, devName, appName, false).aliases.contains(containerName);
+}
+
+bool KeyPool::mappingsEnabled() {
+    const auto config = Config::instance().snapshot();
+    return config->keyPoolDepth > 0 || config->keyPoolUsed;
+}
+
+void KeyPool::markUsed() {
+    auto& config = Config::instance();
+    if (config.keyPoolUsed()) {
+        return;
+    }
+    // 持久化：之后关闭预生成，已领取的容器仍按映射访问
+    config.setKeyPoolUsed(true);
+    if (!config.save()) {
+        LOG_WARN("[KeyPool] 保存配置失败");
+    }
+}
+
+quint64 KeyPool::currentEpoch() {
+    QMutexLocker locker(&mutex_);
+    return epoch_;
+}
+
+KeyPool::AppState KeyPool::load(IDriverPlugin* plugin, const QString& devName, const QString& appName,
+                                bool withSpares) {
+    const QString key = stateKey(devName, appName);
+    quint64 epoch = 0;
+    bool needAliases = false;
+    {
+        QMutexLocker locker(&mutex_);
+        const AppState& state = apps_[key];
+        if (state.aliasesLoaded && (!withSpares || state.sparesLoaded)) {
+            return state;
+        }
+        needAliases = !state.aliasesLoaded;
+        epoch = epoch_;
+    }
+
+    // 读设备时不持锁；并发加载同一应用时各自读取，以先发布的为准
+    bool aliasesRead = false;
+    QHash<QString, QString> aliases;
+    QHash<QString, QString> retiring;
+    if (needAliases) {
+        auto data = plugin->readFile(devName, appName, defaults::KEY_POOL_ALIAS_FILE);
+        if (data.isOk()) {
+            parseAliases(data.value(), aliases, retiring);
+            aliasesRead = true;
+        } else {
+            // 读取失败时只有确认文件不存在才缓存为空，其余错误下次重试
+            auto files = plugin->enumFiles(devName, appName);
+            aliasesRead = files.isOk() && !files.value().contains(defaults::KEY_POOL_ALIAS_FILE);
+        }
+    }
+    QList<ContainerInfo> containers;
+    bool containersRead = false;
+    if (withSpares) {
+        auto result = plugin->enumContainers(devName, appName);
+        if (result.isOk()) {
+            containers = result.value();
+            containersRead = true;
+        }
+    }
+
+    QMutexLocker locker(&mutex_);
+    AppState& state = apps_[key];
+    if (epoch != epoch_) {
+        // 读取期间设备被拔出或驱动已切换，读到的内容作废
+        return state;
+    }
+    if (aliasesRead && !state.aliasesLoaded) {
+        state.aliases = aliases;
+        state.retiring = retiring;
+        state.aliasesLoaded = true;
+    }
+    if (containersRead && state.aliasesLoaded && !state.sparesLoaded) {
+        QSet<QString> claimed;
+        for (const auto& name : std::as_const(state.aliases)) {
+            claimed.insert(name);
+        }
+        for (const auto& name : std::as_const(state.retiring)) {
+            claimed.insert(name);
+        }
+        state.ready.clear();
+        state.pending.clear();
+        for (const auto& c : std::as_const(containers)) {
+            const QString tag = tagOfSpare(c.containerName);
+            if (tag.isEmpty() || claimed.contains(c.containerName)) {
+                continue;
+            }
+            (c.keyGenerated ? state.ready : state.pending)[tag].append(c.containerName);
+        }
+        state.sparesLoaded = true;
+    }
+    const AppState loaded = state;
+    locker.unlock();
+
+    if (!loaded.aliases.isEmpty()) {
+        markUsed();
+    }
+    return loaded;
+}
+
+void KeyPool::publishAliases(const QString& key, quint64 epoch, const QHash<QString, QString>& aliases,
+                             const QHash<QString, QString>& retiring) {
+    QMutexLocker locker(&mutex_);
+    if (epoch != epoch_) {
+        return;
+    }
+    AppState& state = apps_[key];
+    state.aliases = aliases;
+    state.retiring = retiring;
+}
+
+Result<void> KeyPool::saveAliases(IDriverPlugin* plugin, const QString& devName, const QString& appName,
+                                  const QHash<QString, QString>& aliases, const QHash<QString, QString>& retiring) {
+    const QString fileName = defaults::KEY_POOL_ALIAS_FILE;
+    if (aliases.isEmpty()) {
+        return plugin->deleteFile(devName, appName, fileName);
+    }
+
+    const QByteArray data = serializeAliases(aliases, retiring);
+    auto written = plugin->writeFile(devName, appName, fileName, data, kAnyoneAccount, kUserAccount);
+    if (written.isErr()) {
+        // 文件按首次写入的大小创建，内容变长后需要重建
+        plugin->deleteFile(devName, appName, fileName);
+        written = plugin->writeFile(devName, appName, fileName, data, kAnyoneAccount, kUserAccount);
+    }
+    return written;
+}
+
+void KeyPool::onRefillTimer() {
+    if (Config::instance().keyPoolDepth() <= 0) {
+        refillTimer_.stop();
+        return;
+    }
+    // 插件调用串行执行，有请求在处理时不占用设备
+    if (filling_.load() || Metrics::instance().pendingTasks() > 0) {
+        return;
+    }
+    filling_.store(true);
+    pool_.start([this]() {
+        refillOnce();
+        filling_.store(false);
+    });
+}
+
+void KeyPool::refillOnce() {
+    auto* plugin = PluginManager::instance().activePlugin();
+    const int depth = Config::instance().keyPoolDepth();
+    if (!plugin || depth <= 0) {
+        return;
+    }
+
+    QStringList keys;
+    {
+        QMutexLocker locker(&mutex_);
+        for (auto it = apps_.cbegin(); it != apps_.cend(); ++it) {
+            if (it->watched) {
+                keys.append(it.key());
+            }
+        }
+    }
+    for (const auto& key : std::as_const(keys)) {
+        const qsizetype slash = key.indexOf('/');
+        load(plugin, key.left(slash), key.mid(slash + 1), true);
+    }
+
+    QString devName;
+    QString appName;
+    QString tag;
+    QString spare;
+    bool reuse = false;
+    {
+        QMutexLocker locker(&mutex_);
+        for (const auto& key : std::as_const(keys)) {
+            auto it = apps_.find(key);
+            if (it == apps_.end() || !it->watched || !it->sparesLoaded) {
+                continue;
+            }
+            AppState& state = *it;
+            const qsizetype slash = key.indexOf('/');
+            const QString dev = key.left(slash);
+            const QString app = key.mid(slash + 1);
+            for (const auto& t : std::as_const(state.targets)) {
+                if (state.ready.value(t).size() >= depth) {
+                    continue;
+                }
+                devName = dev;
+                appName = app;
+                tag = t;
+                // 优先补完上次中断的备用容器
+                QStringList& pending = state.pending[t];
+                reuse = !pending.isEmpty();
+                spare = reuse ? pending.takeFirst()
+                              : QString("%1%2-%3")
+                                    .arg(QString(defaults::KEY_POOL_CONTAINER_PREFIX), t)
+                                    .arg(QRandomGenerator::global()->generate(), 8, 16, QChar('0'));
+                break;
+            }
+            if (!spare.isEmpty()) {
+                break;
+            }
+        }
+    }
+    if (spare.isEmpty()) {
+        QMetaObject::invokeMethod(&refillTimer_, qOverload<>(&QTimer::stop), Qt::QueuedConnection);
+        return;
+    }
+
+    if (!reuse) {
+        auto created = plugin->createContainer(devName, appName, spare);
+        if (created.isErr()) {
+            LOG_DEBUG(QString("[KeyPool] %1/%2 创建备用容器失败: %3")
+                          .arg(devName, appName, created.error().message()));
+            // 多半是登录态已失效，停止为该应用补充，重新登录后恢复
+            unwatch(devName, appName);
+            return;
+        }
+    }
+
+    auto generated = plugin->generateKeyPair(devName, appName, spare, tag);
+    QMutexLocker locker(&mutex_);
+    AppState& state = apps_[stateKey(devName, appName)];
+    if (generated.isErr()) {
+        LOG_DEBUG(QString("[KeyPool] %1/%2 预生成 %3 密钥失败: %4")
+                      .arg(devName, appName, tag, generated.error().message()));
+        state.pending[tag].append(spare);
+        state.watched = false;
+        return;
+    }
+    state.ready[tag].append(spare);
+    LOG_DEBUG(QString("[KeyPool] %1/%2 预生成 %3 密钥完成，就绪 %4 个")
+                  .arg(devName, appName, tag)
+                  .arg(state.ready.value(tag).size()));
+}
+
+void KeyPool::clear() {
+    QMutexLocker locker(&mutex_);
+    apps_.clear();
+    ++epoch_;
+}
+
+}  // namespace wekey
@@ -0,0 +1,172 @@
+/**
+ * @file KeyPool.h
+ * @brief 密钥预生成池
+ *
+ * 在接口空闲时为已登录的应用预先创建备用容器并生成密钥对（RSA 密钥在设备上生成需要数秒）。
+ * 带 renew 的 CSR 领取一个就绪的备用容器，映射为请求的容器名后直接生成 CSR。
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <atomic>
+
+#include "common/Result.h"
+
+namespace wekey {
+
+class IDriverPlugin;
+
+/**
+ * @brief 密钥预生成池（单例）
+ *
+ * SKF 不支持容器改名，领取时改为记录"逻辑容器名 → 备用容器名"的映射，保存在应用内的
+ * 映射文件中（随设备携带）。ContainerService / CertService 通过 resolve() 把逻辑名换成
+ * 实际容器名，通过 displayName() 在枚举结果中还原逻辑名并隐藏未领取的备用容器。
+ * 续期前的旧容器在领取时只记为"退役"，新证书导入成功（finishRenewal()）后才删除，
+ * 续期中途失败时旧证书仍在设备上。
+ *
+ * 预生成只在配置 keyPoolDepth > 0 时进行；领取过备用容器或在设备上见过映射文件后会记入配置
+ * （keyPoolUsed），此后映射始终生效，关闭预生成后已领取的容器仍可访问。两者都不满足时不读取映射文件，
+ * 逻辑名原样使用。
+ *
+ * 内部锁只保护内存状态，不在持锁时访问设备；映射文件的读-改-写由另一把锁串行化。
+ */
+class KeyPool : public QObject {
+    Q_OBJECT
+
+public:
+    static KeyPool& instance();
+
+    KeyPool(const KeyPool&) = delete;
+    KeyPool& operator=(const KeyPool&) = delete;
+
+    /**
+     * @brief 由 CSR 参数得到密钥标签（"SM2"、"RSA2048" 等），备用容器按标签分组
+     * @param keyType "SM2" / "RSA"
+     * @param keySize RSA 模长
+     */
+    static QString keyTag(const QString& keyType, int keySize);
+
+    /**
+     * @brief 由 keyPairType（如 "RSA_2048"、"SM2_sm2p256v1"）得到密钥标签
+     */
+    static QString keyTagFromPairType(const QString& keyPairType);
+
+    /**
+     * @brief 应用登录成功：按配置的密钥类型登记为补充目标
+     */
+    void watch(const QString& devName, const QString& appName);
+
+    /**
+     * @brief 应用登出：停止为其补充（生成密钥需要登录态）
+     */
+    void unwatch(const QString& devName, const QString& appName);
+
+    /**
+     * @brief 领取一个已生成密钥的备用容器，映射为 containerName
+     *
+     * 映射前 containerName 指向的旧容器（续期前的密钥和证书）记为退役，由 finishRenewal() 删除。
+     * @return 预生成关闭或没有就绪容器时返回 NotFound，调用方应回退为现场生成
+     */
+    Result<void> claim(const QString& devName, const QString& appName, const QString& containerName,
+                       const QString& keyTag);
+
+    /**
+     * @brief containerName 已导入新证书：删除领取时退役的旧容器（没有退役容器时不做任何事）
+     */
+    void finishRenewal(const QString& devName, const QString& appName, const QString& containerName);
+
+    /**
+     * @brief 逻辑容器名 → 实际容器名（无映射时原样返回）
+     */
+    QString resolve(const QString& devName, const QString& appName, const QString& containerName);
+
+    /**
+     * @brief 实际容器名 → 枚举时展示的名称
+     * @return 已映射容器返回逻辑名；未领取的备用容器和被映射遮蔽的同名容器返回空（不展示）
+     */
+    QString displayName(const QString& devName, const QString& appName, const QString& containerName);
+
+    /**
+     * @brief 容器已删除：移除以 containerName 为逻辑名的映射
+     */
+    void forget(const QString& devName, const QString& appName, const QString& containerName);
+
+    /**
+     * @brief containerName 是否已作为逻辑名映射到备用容器
+     */
+    bool isMapped(const QString& devName, const QString& appName, const QString& containerName);
+
+private:
+    KeyPool();
+    ~KeyPool() override;
+
+    struct AppState {
+        bool aliasesLoaded = false;
+        bool sparesLoaded = false;
+        bool watched = false;
+        QHash<QString, QString> aliases;      ///< 逻辑名 → 备用容器名
+        QHash<QString, QString> retiring;     ///< 逻辑名 → 续期前的旧容器（等待新证书导入后删除）
+        QHash<QString, QStringList> ready;    ///< 标签 → 已生成密钥、未领取的备用容器
+        QHash<QString, QStringList> pending;  ///< 标签 → 已创建但密钥未生成完的备用容器
+        QSet<QString> targets;                ///< 需要补充的标签
+    };
+
+    static QString stateKey(const QString& devName, const QString& appName);
+    static QString tagOfSpare(const QString& containerName);
+
+    /**
+     * @brief 是否需要查询映射：预生成已开启或用过
+     */
+    static bool mappingsEnabled();
+
+    /**
+     * @brief 记录已用过预生成（持久化到配置）
+     */
+    static void markUsed();
+
+    quint64 currentEpoch();
+
+    /**
+     * @brief 返回应用状态的副本，未缓存时在锁外从设备读取映射文件（withSpares 时还枚举备用容器）
+     */
+    AppState load(IDriverPlugin* plugin, const QString& devName, const QString& appName, bool withSpares);
+
+    /**
+     * @brief 映射文件写入成功后更新缓存；期间缓存被清空（epoch 变化）时丢弃
+     */
+    void publishAliases(const QString& key, quint64 epoch, const QHash<QString, QString>& aliases,
+                        const QHash<QString, QString>& retiring);
+    Result<void> saveAliases(IDriverPlugin* plugin, const QString& devName, const QString& appName,
+                             const QHash<QString, QString>& aliases, const QHash<QString, QString>& retiring);
+
+    /**
+     * @brief 定时检查：接口空闲且无生成任务时提交一次补充
+     */
+    void onRefillTimer();
+
+    /**
+     * @brief 为第一个不足深度的目标生成一个密钥（工作线程）
+     */
+    void refillOnce();
+
+    void clear();
+
+    QMutex mutex_;        ///< 保护 apps_ / epoch_，持有期间不调用插件
+    QMutex updateMutex_;  ///< 串行化映射文件的读-改-写（claim / finishRenewal / forget）
+    QHash<QString, AppState> apps_;
+    quint64 epoch_ = 0;   ///< clear() 时递增，使进行中的读取结果作废
+    QTimer refillTimer_;
+    QThreadPool pool_;
+    std::atomic<bool> filling_{false};
+};
+
+}  // namespace wekey
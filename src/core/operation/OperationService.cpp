@@ -0,0 +1,84 @@
+/**
+ * @file OperationService.cpp
+ * @brief 批量操作服务实现
+ */
+
+#include "OperationService.h"
+
+#include "config/Defaults.h"
+#include "core/keypool/KeyPool.h"
+#include "plugin/PluginManager.h"
+#include "plugin/interface/AsyncDriverPlugin.h"
+
+namespace wekey {
+
+OperationService& OperationService::instance() {
+    static OperationService instance;
+    return instance;
+}
+
+OperationService::OperationService() : QObject(nullptr) {}
+
+Result<QList<OperationResult>> OperationService::execute(const QString& devName, const OperationList& operations) {
+    auto* plugin = PluginManager::instance().activePlugin();
+    if (!plugin) {
+        return Result<QList<OperationResult>>::err(
+            Error(Error::NoActiveModule, "驱动模块未激活", "OperationService::execute"));
+    }
+
+    // 逻辑容器名 → 实际容器名（引用前序输出的参数在插件中替换，不做映射）
+    auto& keyPool = KeyPool::instance();
+    OperationList resolved = operations;
+    for (auto& operation : resolved) {
+        const QVariant value = operation.params.value("containerName");
+        if (value.typeId() != QMetaType::QString || value.toString().startsWith("${")) {
+            continue;
+        }
+        const QString appName = operation.params.value("appName").toString();
+        const QString containerName = value.toString();
+        if (operation.op == "createContainer") {
+            if (keyPool.isMapped(devName, appName, containerName)) {
+                return Result<QList<OperationResult>>::err(
+                    Error(Error::AlreadyExists, QString("容器已存在：%1").arg(containerName),
+                          "OperationService::execute"));
+            }
+            continue;
+        }
+        operation.params["containerName"] = keyPool.resolve(devName, appName, containerName);
+    }
+
+    auto result = plugin->execute(devName, resolved);
+    if (result.isErr()) {
+        return result;
+    }
+
+    for (int i = 0; i < operations.size(); ++i) {
+        if (result.value()[i].status != OperationResult::Status::Succeeded) {
+            continue;
+        }
+        const auto& operation = operations[i];
+        const QString appName = operation.params.value("appName").toString();
+        if (operation.op == "deleteContainer") {
+            keyPool.forget(devName, appName, operation.params.value("containerName").toString());
+        } else if (operation.op == "importCert" || operation.op == "importKeyCert") {
+            keyPool.finishRenewal(devName, appName, operation.params.value("containerName").toString());
+        } else if (operation.op == "openApp") {
+            // 用户登录态下才能在设备上生成密钥
+            const QString role = operation.params.value("role").toString();
+            if (role.compare(defaults::ROLE_USER, Qt::CaseInsensitive) == 0) {
+                keyPool.watch(devName, appName);
+            }
+        } else if (operation.op == "closeApp") {
+            keyPool.unwatch(devName, appName);
+        }
+    }
+    return result;
+}
+
+QFuture<Result<QList<OperationResult>>> OperationService::executeAsync(const QString& devName,
+                                                                       const OperationList& operations) {
+    return postToDevice(PluginManager::instance().activePlugin(), devName,
+                        [this, devName, operations]() { return execute(devName, operations); });
+}
+
+}  // namespace wekey
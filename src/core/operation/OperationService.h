@@ -0,0 +1,43 @@
+/**
+ * @file OperationService.h
+ * @brief 批量操作服务
+ *
+ * 把同一设备上的多步操作（登录 → 签名 → 登出等）交给驱动插件在一个会话中执行
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QObject>
+
+#include "common/Result.h"
+#include "plugin/interface/PluginTypes.h"
+
+namespace wekey {
+
+class OperationService : public QObject {
+    Q_OBJECT
+
+public:
+    static OperationService& instance();
+
+    OperationService(const OperationService&) = delete;
+    OperationService& operator=(const OperationService&) = delete;
+
+    /**
+     * @brief 执行操作列表，语义见 IDriverPlugin::execute
+     *
+     * 与单步服务保持一致：containerName 经密钥池映射为实际容器名，已映射的名称不能再创建；
+     * 成功的 deleteContainer 移除映射，用户角色的 openApp / closeApp 登记或注销密钥池补充。
+     * 带 renewKey 的 generateCsr 在设备上现场生成密钥，不领取备用容器。
+     */
+    Result<QList<OperationResult>> execute(const QString& devName, const OperationList& operations);
+
+    QFuture<Result<QList<OperationResult>>> executeAsync(const QString& devName, const OperationList& operations);
+
+private:
+    OperationService();
+    ~OperationService() override = default;
+};
+
+}  // namespace wekey
@@ -0,0 +1,549 @@
+/**
+ * @file ProvisionService.cpp
+ * @brief 批量初始化服务实现
+ */
+
+#include "ProvisionService.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <utility>
+
+#include "config/Config.h"
+#include "config/Defaults.h"
+#include "core/application/AppService.h"
+#include "core/container/ContainerService.h"
+#include "core/crypto/CertService.h"
+#include "core/device/DeviceService.h"
+#include "log/Logger.h"
+
+namespace wekey {
+
+namespace {
+
+constexpr ProvisionStep kSteps[] = {ProvisionStep::CreateApp,       ProvisionStep::Login,
+                                    ProvisionStep::CreateContainer, ProvisionStep::GenerateCsr,
+                                    ProvisionStep::ImportCert,      ProvisionStep::Done};
+
+constexpr ProvisionState kStates[] = {ProvisionState::Pending,     ProvisionState::Running,
+                                      ProvisionState::WaitingCert, ProvisionState::Succeeded,
+                                      ProvisionState::Failed,      ProvisionState::Cancelled};
+
+ProvisionStep nextStep(ProvisionStep step) {
+    return step == ProvisionStep::Done ? step : static_cast<ProvisionStep>(static_cast<int>(step) + 1);
+}
+
+ProvisionStep stepFromString(const QString& text) {
+    for (ProvisionStep step : kSteps) {
+        if (provisionStepToString(step) == text) {
+            return step;
+        }
+    }
+    return ProvisionStep::CreateApp;
+}
+
+ProvisionState stateFromString(const QString& text) {
+    for (ProvisionState state : kStates) {
+        if (provisionStateToString(state) == text) {
+            return state;
+        }
+    }
+    return ProvisionState::Pending;
+}
+
+/// 相对路径按计划文件所在目录解析
+QString resolvePath(const QDir& base, const QString& path) {
+    return path.isEmpty() ? QString() : QDir::cleanPath(base.absoluteFilePath(path));
+}
+
+/// PEM 或纯 Base64 DER → 二进制
+QByteArray decodePem(const QByteArray& text) {
+    QByteArray base64;
+    for (const QByteArray& line : text.split('\n')) {
+        QByteArray trimmed = line.trimmed();
+        if (!trimmed.startsWith("-----")) {
+            base64 += trimmed;
+        }
+    }
+    return QByteArray::fromBase64(base64);
+}
+
+/// 读取可选文件；不存在时返回空
+Result<QByteArray> readOptional(const QString& path) {
+    QFile file(path);
+    if (!file.exists()) {
+        return Result<QByteArray>::ok(QByteArray());
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        return Result<QByteArray>::err(
+            Error(Error::Fail, QString("无法读取文件: %1").arg(path), "ProvisionService::importCert"));
+    }
+    return Result<QByteArray>::ok(file.readAll());
+}
+
+}  // namespace
+
+QString provisionStepToString(ProvisionStep step) {
+    switch (step) {
+        case ProvisionStep::CreateApp:
+            return "create-app";
+        case ProvisionStep::Login:
+            return "login";
+        case ProvisionStep::CreateContainer:
+            return "create-container";
+        case ProvisionStep::GenerateCsr:
+            return "generate-csr";
+        case ProvisionStep::ImportCert:
+            return "import-cert";
+        case ProvisionStep::Done:
+            return "done";
+    }
+    return "create-app";
+}
+
+QString provisionStateToString(ProvisionState state) {
+    switch (state) {
+        case ProvisionState::Pending:
+            return "pending";
+        case ProvisionState::Running:
+            return "running";
+        case ProvisionState::WaitingCert:
+            return "waiting-cert";
+        case ProvisionState::Succeeded:
+            return "succeeded";
+        case ProvisionState::Failed:
+            return "failed";
+        case ProvisionState::Cancelled:
+            return "cancelled";
+    }
+    return "pending";
+}
+
+Result<ProvisionPlan> ProvisionPlan::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return Result<ProvisionPlan>::err(
+            Error(Error::NotFound, QString("无法打开计划文件: %1").arg(path), "ProvisionPlan::load"));
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        return Result<ProvisionPlan>::err(Error(Error::InvalidParam,
+                                                QString("计划文件格式错误: %1").arg(parseError.errorString()),
+                                                "ProvisionPlan::load"));
+    }
+    QJsonObject obj = doc.object();
+
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
+    ProvisionPlan plan;
+    plan.appName = obj.value("appName").toString(cfg->defaultAppName);
+    plan.containerName = obj.value("containerName").toString(cfg->defaultContainerName);
+    plan.adminPin = obj.value("adminPin").toString();
+    plan.userPin = obj.value("userPin").toString();
+    plan.adminRetry = obj.value("adminRetry").toInt(defaults::ADMIN_PIN_RETRY_COUNT);
+    plan.userRetry = obj.value("userRetry").toInt(defaults::USER_PIN_RETRY_COUNT);
+    plan.keyPairType = obj.value("keyPairType").toString(plan.keyPairType);
+    plan.cname = obj.value("cname").toString(cfg->defaultCommonName);
+    plan.org = obj.value("org").toString(cfg->defaultOrganization);
+    plan.unit = obj.value("unit").toString(cfg->defaultUnit);
+    plan.nonGM = obj.value("nonGM").toBool(false);
+    for (const auto& value : obj.value("devices").toArray()) {
+        if (!value.toString().isEmpty()) {
+            plan.devices.append(value.toString());
+        }
+    }
+
+    if (plan.adminPin.isEmpty() || plan.userPin.isEmpty()) {
+        return Result<ProvisionPlan>::err(
+            Error(Error::InvalidParam, "计划文件缺少 adminPin 或 userPin", "ProvisionPlan::load"));
+    }
+    if (plan.appName.isEmpty() || plan.containerName.isEmpty()) {
+        return Result<ProvisionPlan>::err(
+            Error(Error::InvalidParam, "计划文件缺少 appName 或 containerName", "ProvisionPlan::load"));
+    }
+
+    // 目录默认都放在计划文件旁边
+    QFileInfo info(path);
+    QDir base = info.absoluteDir();
+    plan.csrDir = resolvePath(base, obj.value("csrDir").toString("."));
+    plan.certDir = resolvePath(base, obj.value("certDir").toString(plan.csrDir));
+    plan.checkpoint = resolvePath(
+        base, obj.value("checkpoint").toString(info.fileName() + defaults::PROVISION_CHECKPOINT_SUFFIX));
+    return Result<ProvisionPlan>::ok(std::move(plan));
+}
+
+ProvisionService& ProvisionService::instance() {
+    static ProvisionService instance;
+    return instance;
+}
+
+ProvisionService::ProvisionService() : QObject(nullptr) {}
+
+ProvisionService::~ProvisionService() {
+    cancel();
+    pool_.waitForDone();
+}
+
+Result<void> ProvisionService::start(const QString& planPath, bool fresh) {
+    QMutexLocker locker(&mutex_);
+    if (running_) {
+        return Result<void>::err(Error(Error::AlreadyExists, "批量初始化正在进行", "ProvisionService::start"));
+    }
+
+    auto planResult = ProvisionPlan::load(planPath);
+    if (planResult.isErr()) {
+        return Result<void>::err(planResult.error());
+    }
+    auto devResult = DeviceService::instance().enumDevices(false, false);
+    if (devResult.isErr()) {
+        return Result<void>::err(devResult.error());
+    }
+    QStringList attached;
+    for (const auto& dev : devResult.value()) {
+        attached.append(dev.serialNumber);
+    }
+
+    plan_ = planResult.value();
+    planPath_ = QFileInfo(planPath).absoluteFilePath();
+    progress_.clear();
+    if (!fresh) {
+        loadCheckpointLocked();
+    }
+
+    const QStringList& targets = plan_.devices.isEmpty() ? attached : plan_.devices;
+    QStringList runnable;
+    for (const auto& sn : targets) {
+        DeviceProgress& p = progress_[sn];
+        p.serialNumber = sn;
+        if (p.step == ProvisionStep::Done) {
+            continue;
+        }
+        p.updatedAt = QDateTime::currentDateTime();
+        if (!attached.contains(sn)) {
+            p.state = ProvisionState::Failed;
+            p.message = "设备未连接";
+            continue;
+        }
+        p.state = ProvisionState::Pending;
+        p.message.clear();
+        runnable.append(sn);
+    }
+    saveCheckpointLocked();
+
+    if (runnable.isEmpty()) {
+        return Result<void>::err(
+            Error(Error::NotFound, "没有需要初始化的设备（均已完成或未连接）", "ProvisionService::start"));
+    }
+
+    running_ = true;
+    remaining_ = static_cast<int>(runnable.size());
+    cancelled_.store(false);
+    // 驱动调用在插件内全局串行，多个工作任务只重叠主机侧的文件读写
+    pool_.setMaxThreadCount(std::min(remaining_, defaults::PROVISION_MAX_WORKERS));
+    for (const auto& sn : runnable) {
+        pool_.start([this, sn]() { runDevice(sn); });
+    }
+
+    LOG_INFO(QString("[Provision] 开始批量初始化 %1 台设备，计划: %2").arg(runnable.size()).arg(planPath_));
+    return Result<void>::ok();
+}
+
+void ProvisionService::cancel() {
+    cancelled_.store(true);
+}
+
+bool ProvisionService::isRunning() const {
+    QMutexLocker locker(&mutex_);
+    return running_;
+}
+
+ProvisionStatus ProvisionService::status() const {
+    QMutexLocker locker(&mutex_);
+    ProvisionStatus status;
+    status.running = running_;
+    status.planPath = planPath_;
+    status.checkpoint = plan_.checkpoint;
+    status.devices = progress_.values();
+    std::sort(status.devices.begin(), status.devices.end(),
+              [](const DeviceProgress& a, const DeviceProgress& b) { return a.serialNumber < b.serialNumber; });
+    return status;
+}
+
+void ProvisionService::runDevice(const QString& serialNumber) {
+    ProvisionStep step;
+    {
+        QMutexLocker locker(&mutex_);
+        step = progress_.value(serialNumber).step;
+    }
+    update(serialNumber, step, ProvisionState::Running);
+
+    // 登录状态不写入检查点，从登录之后的步骤继续时需要先补登录
+    bool loggedIn = false;
+    if (step > ProvisionStep::Login) {
+        bool waiting = false;
+        auto login = runStep(serialNumber, ProvisionStep::Login, waiting);
+        if (login.isErr()) {
+            update(serialNumber, step, ProvisionState::Failed, login.error().toString());
+            finishDevice();
+            return;
+        }
+        loggedIn = true;
+    }
+
+    while (step != ProvisionStep::Done) {
+        if (cancelled_.load()) {
+            update(serialNumber, step, ProvisionState::Cancelled);
+            break;
+        }
+
+        bool waiting = false;
+        auto result = runStep(serialNumber, step, waiting);
+        if (result.isErr()) {
+            LOG_WARN(QString("[Provision] %1 在 %2 失败: %3")
+                         .arg(serialNumber, provisionStepToString(step), result.error().toString(true)));
+            update(serialNumber, step, ProvisionState::Failed, result.error().toString());
+            break;
+        }
+        if (waiting) {
+            update(serialNumber, step, ProvisionState::WaitingCert, "等待签发证书");
+            break;
+        }
+
+        loggedIn = loggedIn || step == ProvisionStep::Login;
+        step = nextStep(step);
+        update(serialNumber, step,
+               step == ProvisionStep::Done ? ProvisionState::Succeeded : ProvisionState::Running);
+    }
+
+    if (loggedIn) {
+        AppService::instance().logout(serialNumber, plan_.appName, false);
+    }
+    finishDevice();
+}
+
+Result<void> ProvisionService::runStep(const QString& serialNumber, ProvisionStep step, bool& waiting) {
+    switch (step) {
+        case ProvisionStep::CreateApp:
+            return createApp(serialNumber);
+        case ProvisionStep::Login:
+            return AppService::instance().login(serialNumber, plan_.appName, defaults::ROLE_USER, plan_.userPin,
+                                                false);
+        case ProvisionStep::CreateContainer:
+            return createContainer(serialNumber);
+        case ProvisionStep::GenerateCsr:
+            return generateCsr(serialNumber);
+        case ProvisionStep::ImportCert:
+            return importCert(serialNumber, waiting);
+        case ProvisionStep::Done:
+            break;
+    }
+    return Result<void>::ok();
+}
+
+Result<void> ProvisionService::createApp(const QString& serialNumber) {
+    // 应用已存在（如检查点丢失后重跑）视为完成，PIN 不符会在登录步骤报错
+    auto apps = AppService::instance().enumApps(serialNumber);
+    if (apps.isErr()) {
+        return Result<void>::err(apps.error());
+    }
+    for (const auto& app : apps.value()) {
+        if (app.appName == plan_.appName) {
+            return Result<void>::ok();
+        }
+    }
+
+    QVariantMap args;
+    args["adminPin"] = plan_.adminPin;
+    args["userPin"] = plan_.userPin;
+    args["adminRetry"] = plan_.adminRetry;
+    args["userRetry"] = plan_.userRetry;
+    return AppService::instance().createApp(serialNumber, plan_.appName, args);
+}
+
+Result<void> ProvisionService::createContainer(const QString& serialNumber) {
+    auto containers = ContainerService::instance().enumContainers(serialNumber, plan_.appName);
+    if (containers.isErr()) {
+        return Result<void>::err(containers.error());
+    }
+    for (const auto& c : containers.value()) {
+        if (c.containerName == plan_.containerName) {
+            return Result<void>::ok();
+        }
+    }
+    return ContainerService::instance().createContainer(serialNumber, plan_.appName, plan_.containerName);
+}
+
+Result<void> ProvisionService::generateCsr(const QString& serialNumber) {
+    // 新容器没有密钥，总是重新生成；CSR 写出后检查点前进到导入证书，继续时不会再次生成
+    QVariantMap args;
+    args["renewKey"] = true;
+    args["cname"] = plan_.cname;
+    args["org"] = plan_.org;
+    args["unit"] = plan_.unit;
+    if (plan_.keyPairType.startsWith("RSA")) {
+        args["keyType"] = "RSA";
+        if (plan_.keyPairType.contains("4096")) {
+            args["keySize"] = 4096;
+        } else if (plan_.keyPairType.contains("3072")) {
+            args["keySize"] = 3072;
+        } else {
+            args["keySize"] = 2048;
+        }
+    } else {
+        args["keyType"] = "SM2";
+    }
+
+    auto result = CertService::instance().generateCsr(serialNumber, plan_.appName, plan_.containerName, args);
+    if (result.isErr()) {
+        return Result<void>::err(result.error());
+    }
+
+    QByteArray pem = "-----BEGIN CERTIFICATE REQUEST-----\n";
+    const QByteArray base64 = result.value().toBase64();
+    for (qsizetype i = 0; i < base64.size(); i += 64) {
+        pem += base64.mid(i, 64) + '\n';
+    }
+    pem += "-----END CERTIFICATE REQUEST-----\n";
+
+    const QString csrPath = QDir(plan_.csrDir).filePath(serialNumber + ".csr");
+    QDir().mkpath(plan_.csrDir);
+    QSaveFile file(csrPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(pem) != pem.size() || !file.commit()) {
+        return Result<void>::err(
+            Error(Error::Fail, QString("无法写入 CSR 文件: %1").arg(csrPath), "ProvisionService::generateCsr"));
+    }
+
+    QMutexLocker locker(&mutex_);
+    progress_[serialNumber].csrPath = csrPath;
+    return Result<void>::ok();
+}
+
+Result<void> ProvisionService::importCert(const QString& serialNumber, bool& waiting) {
+    const QDir certDir(plan_.certDir);
+    auto sigCert = readOptional(certDir.filePath(serialNumber + ".sig.pem"));
+    if (sigCert.isErr()) {
+        return Result<void>::err(sigCert.error());
+    }
+    if (sigCert.value().isEmpty()) {
+        waiting = true;
+        return Result<void>::ok();
+    }
+    auto encCert = readOptional(certDir.filePath(serialNumber + ".enc.pem"));
+    if (encCert.isErr()) {
+        return Result<void>::err(encCert.error());
+    }
+    auto encPrivate = readOptional(certDir.filePath(serialNumber + ".enc.key"));
+    if (encPrivate.isErr()) {
+        return Result<void>::err(encPrivate.error());
+    }
+
+    QByteArray sigCertBytes = decodePem(sigCert.value());
+    if (sigCertBytes.isEmpty()) {
+        return Result<void>::err(Error(Error::InvalidParam, "签名证书解码失败", "ProvisionService::importCert"));
+    }
+    QByteArray encCertBytes = decodePem(encCert.value());
+    QByteArray encPrivateBytes = QByteArray::fromBase64(encPrivate.value().trimmed());
+
+    return CertService::instance().importKeyCert(serialNumber, plan_.appName, plan_.containerName, sigCertBytes,
+                                                 encCertBytes, encPrivateBytes, plan_.nonGM);
+}
+
+void ProvisionService::update(const QString& serialNumber, ProvisionStep step, ProvisionState state,
+                              const QString& message) {
+    {
+        QMutexLocker locker(&mutex_);
+        DeviceProgress& p = progress_[serialNumber];
+        p.serialNumber = serialNumber;
+        p.step = step;
+        p.state = state;
+        p.message = message;
+        p.updatedAt = QDateTime::currentDateTime();
+        saveCheckpointLocked();
+    }
+    emit deviceProgress(serialNumber, provisionStepToString(step), provisionStateToString(state), message);
+}
+
+void ProvisionService::finishDevice() {
+    int succeeded = 0;
+    int waiting = 0;
+    int failed = 0;
+    {
+        QMutexLocker locker(&mutex_);
+        if (--remaining_ > 0) {
+            return;
+        }
+        running_ = false;
+        for (const auto& p : std::as_const(progress_)) {
+            if (p.state == ProvisionState::Succeeded) {
+                ++succeeded;
+            } else if (p.state == ProvisionState::WaitingCert) {
+                ++waiting;
+            } else if (p.state == ProvisionState::Failed || p.state == ProvisionState::Cancelled) {
+                ++failed;
+            }
+        }
+    }
+    LOG_INFO(QString("[Provision] 批量初始化结束：完成 %1，等待证书 %2，失败 %3").arg(succeeded).arg(waiting).arg(failed));
+    emit runFinished(succeeded, waiting, failed);
+}
+
+void ProvisionService::loadCheckpointLocked() {
+    QFile file(plan_.checkpoint);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    for (const auto& value : doc.object().value("devices").toArray()) {
+        QJsonObject obj = value.toObject();
+        DeviceProgress p;
+        p.serialNumber = obj.value("serialNumber").toString();
+        if (p.serialNumber.isEmpty()) {
+            continue;
+        }
+        p.step = stepFromString(obj.value("step").toString());
+        p.state = stateFromString(obj.value("state").toString());
+        p.message = obj.value("message").toString();
+        p.csrPath = obj.value("csrPath").toString();
+        p.updatedAt = QDateTime::fromString(obj.value("updatedAt").toString(), Qt::ISODateWithMs);
+        progress_.insert(p.serialNumber, p);
+    }
+    LOG_INFO(QString("[Provision] 从检查点恢复 %1 台设备的进度: %2").arg(progress_.size()).arg(plan_.checkpoint));
+}
+
+void ProvisionService::saveCheckpointLocked() const {
+    QJsonArray devices;
+    for (const auto& p : progress_) {
+        QJsonObject obj;
+        obj["serialNumber"] = p.serialNumber;
+        obj["step"] = provisionStepToString(p.step);
+        obj["state"] = provisionStateToString(p.state);
+        obj["message"] = p.message;
+        obj["csrPath"] = p.csrPath;
+        obj["updatedAt"] = p.updatedAt.toString(Qt::ISODateWithMs);
+        devices.append(obj);
+    }
+    QJsonObject root;
+    root["plan"] = planPath_;
+    root["devices"] = devices;
+
+    // 原子替换，进程中途退出也不会留下半截的检查点
+    QSaveFile file(plan_.checkpoint);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_WARN(QString("[Provision] 无法写入检查点: %1").arg(plan_.checkpoint));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson());
+    if (!file.commit()) {
+        LOG_WARN(QString("[Provision] 无法写入检查点: %1").arg(plan_.checkpoint));
+    }
+}
+
+}  // namespace wekey
@@ -0,0 +1,188 @@
+/**
+ * @file ProvisionService.h
+ * @brief 批量初始化服务
+ *
+ * 按计划文件对所有已连接设备执行 创建应用 → 登录 → 创建容器 → 生成密钥与 CSR → 导入证书，
+ * 每台设备一个工作任务。进度写入检查点文件，失败或等待签发证书的设备可从中断的步骤继续。
+ *
+ * 注意：设备操作实际上是串行的。SKF 插件以一把全局锁串行化所有驱动调用（厂商 SKF 库普遍不可重入），
+ * 多个工作任务只能并行处理主机侧的工作（读写检查点、CSR 与证书文件），耗时的密钥生成仍逐台进行，
+ * 总耗时约为各设备耗时之和。
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+
+#include "common/Result.h"
+
+namespace wekey {
+
+/**
+ * @brief 初始化步骤（按执行顺序）
+ */
+enum class ProvisionStep { CreateApp, Login, CreateContainer, GenerateCsr, ImportCert, Done };
+
+/**
+ * @brief 步骤转字符串（create-app / login / create-container / generate-csr / import-cert / done）
+ */
+QString provisionStepToString(ProvisionStep step);
+
+/**
+ * @brief 设备状态
+ *
+ * WaitingCert 表示 CSR 已写出、签发的证书尚未放入证书目录，再次启动时从导入证书继续。
+ */
+enum class ProvisionState { Pending, Running, WaitingCert, Succeeded, Failed, Cancelled };
+
+/**
+ * @brief 状态转字符串（pending / running / waiting-cert / succeeded / failed / cancelled）
+ */
+QString provisionStateToString(ProvisionState state);
+
+/**
+ * @brief 初始化计划
+ *
+ * 计划文件为 JSON 对象，字段同名；未填写的应用/容器/证书主题取配置中的默认值。
+ * csrDir、certDir、checkpoint 为相对路径时相对于计划文件所在目录。
+ * 证书目录中按序列号查找 <sn>.sig.pem（必需）、<sn>.enc.pem 和 <sn>.enc.key（Base64，可选）。
+ */
+struct ProvisionPlan {
+    QString appName;
+    QString containerName;
+    QString adminPin;
+    QString userPin;
+    int adminRetry = 6;
+    int userRetry = 6;
+    QString keyPairType = "SM2_sm2p256v1";
+    QString cname;
+    QString org;
+    QString unit;
+    bool nonGM = false;
+    QStringList devices;  ///< 限定的设备序列号，空表示所有已连接设备
+    QString csrDir;       ///< CSR 输出目录，文件名为 <sn>.csr
+    QString certDir;      ///< 签发证书目录
+    QString checkpoint;   ///< 检查点文件，默认为 <计划文件>.progress.json
+
+    /**
+     * @brief 读取并校验计划文件
+     * @param path 计划文件路径
+     */
+    static Result<ProvisionPlan> load(const QString& path);
+};
+
+/**
+ * @brief 单台设备的进度
+ */
+struct DeviceProgress {
+    QString serialNumber;
+    ProvisionStep step = ProvisionStep::CreateApp;  ///< 下一个待执行的步骤
+    ProvisionState state = ProvisionState::Pending;
+    QString message;  ///< 最近一次失败或等待的原因
+    QString csrPath;
+    QDateTime updatedAt;
+};
+
+/**
+ * @brief 批量初始化状态快照
+ */
+struct ProvisionStatus {
+    bool running = false;
+    QString planPath;
+    QString checkpoint;
+    QList<DeviceProgress> devices;  ///< 按序列号排序
+};
+
+/**
+ * @brief 批量初始化服务（单例）
+ *
+ * 同一时刻只运行一个计划。进度信号从工作线程发出，接收方按队列连接处理。
+ * 设备操作经插件全局锁串行执行，见文件说明。
+ */
+class ProvisionService : public QObject {
+    Q_OBJECT
+
+public:
+    static ProvisionService& instance();
+
+    ProvisionService(const ProvisionService&) = delete;
+    ProvisionService& operator=(const ProvisionService&) = delete;
+
+    /**
+     * @brief 按计划文件启动批量初始化
+     * @param planPath 计划文件路径
+     * @param fresh 为 true 时忽略已有检查点，所有设备从头开始
+     * @return 已有计划在运行、计划无效或没有可处理的设备时返回错误
+     */
+    Result<void> start(const QString& planPath, bool fresh = false);
+
+    /**
+     * @brief 请求取消：各设备完成当前步骤后停止，检查点保留以便继续
+     */
+    void cancel();
+
+    /**
+     * @brief 是否有计划在运行
+     */
+    [[nodiscard]] bool isRunning() const;
+
+    /**
+     * @brief 当前（或最近一次）计划的状态
+     */
+    [[nodiscard]] ProvisionStatus status() const;
+
+signals:
+    /**
+     * @brief 设备进度变化
+     * @param serialNumber 设备序列号
+     * @param step 下一个待执行的步骤
+     * @param state 设备状态
+     * @param message 失败或等待的原因
+     */
+    void deviceProgress(const QString& serialNumber, const QString& step, const QString& state,
+                        const QString& message);
+
+    /**
+     * @brief 计划运行结束（全部设备停止）
+     */
+    void runFinished(int succeeded, int waiting, int failed);
+
+private:
+    ProvisionService();
+    ~ProvisionService() override;
+
+    void runDevice(const QString& serialNumber);
+    Result<void> runStep(const QString& serialNumber, ProvisionStep step, bool& waiting);
+    Result<void> createApp(const QString& serialNumber);
+    Result<void> createContainer(const QString& serialNumber);
+    Result<void> generateCsr(const QString& serialNumber);
+    Result<void> importCert(const QString& serialNumber, bool& waiting);
+
+    /**
+     * @brief 更新设备进度，写检查点并发出 deviceProgress
+     */
+    void update(const QString& serialNumber, ProvisionStep step, ProvisionState state,
+                const QString& message = {});
+
+    void loadCheckpointLocked();
+    void saveCheckpointLocked() const;
+    void finishDevice();
+
+    mutable QMutex mutex_;
+    ProvisionPlan plan_;  ///< 运行期间只读
+    QString planPath_;
+    QHash<QString, DeviceProgress> progress_;
+    int remaining_ = 0;
+    bool running_ = false;
+    std::atomic<bool> cancelled_{false};
+    QThreadPool pool_;
+};
+
+}  // namespace wekey
@@ -0,0 +1,34 @@
+/**
+ * @file LazyPage.cpp
+ * @brief 延迟构造的页面容器实现
+ */
+
+#include "LazyPage.h"
+
+#include <QVBoxLayout>
+
+#include "common/StartupProfile.h"
+
+namespace wekey {
+
+LazyPage::LazyPage(Factory factory, QWidget* parent) : QWidget(parent), factory_(std::move(factory)) {
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
+}
+
+QWidget* LazyPage::page() const {
+    return page_;
+}
+
+void LazyPage::showEvent(QShowEvent* event) {
+    if (!page_ && factory_) {
+        page_ = factory_();
+        factory_ = nullptr;
+        layout()->addWidget(page_);
+        StartupProfile::mark("page constructed: " + page_->windowTitle());
+    }
+    QWidget::showEvent(event);
+}
+
+}  // namespace wekey
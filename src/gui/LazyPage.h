@@ -0,0 +1,42 @@
+/**
+ * @file LazyPage.h
+ * @brief 延迟构造的页面容器
+ *
+ * 导航栏需要在启动时拿到页面控件，但页面本身（及其构造时的设备枚举等操作）
+ * 可以推迟到首次切换过去时再创建。
+ */
+
+#pragma once
+
+#include <QWidget>
+#include <functional>
+
+namespace wekey {
+
+/**
+ * @brief 延迟构造的页面容器
+ *
+ * 首次显示时调用工厂函数创建真实页面并填满自身。
+ */
+class LazyPage : public QWidget {
+    Q_OBJECT
+
+public:
+    using Factory = std::function<QWidget*()>;
+
+    explicit LazyPage(Factory factory, QWidget* parent = nullptr);
+
+    /**
+     * @brief 真实页面，未构造时为 nullptr
+     */
+    [[nodiscard]] QWidget* page() const;
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
+private:
+    Factory factory_;
+    QWidget* page_ = nullptr;
+};
+
+}  // namespace wekey
@@ -21,12 +21,14 @@
 #include <ElaText.h>
 #include <ElaTheme.h>
 
+#include "LazyPage.h"
 #include "SystemTray.h"
 #include "config/Config.h"
 #include "pages/ConfigPage.h"
 #include "pages/DevicePage.h"
 #include "pages/LogPage.h"
 #include "pages/ModulePage.h"
+#include "pages/ProvisionPage.h"
 
 namespace wekey {
 
@@ -159,9 +161,12 @@ bool MainWindow::nativeEvent(const QByteArray& eventType, void* message, qintptr
 void MainWindow::setupNavigation() {
     // 使用 ElaWindow 内置导航栏添加页面节点
     // ElaIconType 图标替代原有 SVG 图标
-    addPageNode("模块管理", new ModulePage, ElaIconType::Puzzle);
-    addPageNode("设备管理", new DevicePage, ElaIconType::MicrochipAi);
-    addPageNode("配置管理", new ConfigPage, ElaIconType::Gears);
+    // 页面在首次切换时才构造（DevicePage 构造时会枚举设备）；
+    // LogPage 需要从启动起接收日志，保持立即构造
+    addPageNode("模块管理", new LazyPage([] { return new ModulePage; }), ElaIconType::Puzzle);
+    addPageNode("设备管理", new LazyPage([] { return new DevicePage; }), ElaIconType::MicrochipAi);
+    addPageNode("批量初始化", new LazyPage([] { return new ProvisionPage; }), ElaIconType::ListCheck);
+    addPageNode("配置管理", new LazyPage([] { return new ConfigPage; }), ElaIconType::Gears);
     addPageNode("日志查看", new LogPage, ElaIconType::ClipboardList);
 
     // 底部导航节点：配置和日志
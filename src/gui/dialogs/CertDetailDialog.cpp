@@ -17,6 +17,7 @@
 
 #include <ElaPushButton.h>
 
+#include "common/LogCategories.h"
 #include "core/crypto/CertService.h"
 #include "gui/UiHelper.h"
 
@@ -54,19 +55,19 @@ void CertDetailDialog::setupUi(const QString& containerName) {
     // 尝试获取签名证书信息
     auto signResult = CertService::instance().getCertInfo(devName_, appName_, containerName_, true);
     if (signResult.isOk()) {
-        qDebug() << "[CertDetailDialog] 签名证书获取成功, SN:" << signResult.value().serialNumber;
+        qCDebug(lcGui) << "[CertDetailDialog] 签名证书获取成功, SN:" << signResult.value().serialNumber;
         addCertSection(contentLayout, signResult.value(), true);
     } else {
-        qDebug() << "[CertDetailDialog] 签名证书获取失败:" << signResult.error().message();
+        qCDebug(lcGui) << "[CertDetailDialog] 签名证书获取失败:" << signResult.error().message();
     }
 
     // 尝试获取加密证书信息
     auto encResult = CertService::instance().getCertInfo(devName_, appName_, containerName_, false);
     if (encResult.isOk()) {
-        qDebug() << "[CertDetailDialog] 加密证书获取成功, SN:" << encResult.value().serialNumber;
+        qCDebug(lcGui) << "[CertDetailDialog] 加密证书获取成功, SN:" << encResult.value().serialNumber;
         addCertSection(contentLayout, encResult.value(), false);
     } else {
-        qDebug() << "[CertDetailDialog] 加密证书获取失败:" << encResult.error().message();
+        qCDebug(lcGui) << "[CertDetailDialog] 加密证书获取失败:" << encResult.error().message();
     }
 
     // 如果两个证书都没有
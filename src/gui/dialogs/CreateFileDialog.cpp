@@ -19,6 +19,7 @@
 #include <ElaLineEdit.h>
 #include <ElaPushButton.h>
 
+#include "common/LogCategories.h"
 #include "gui/UiHelper.h"
 
 namespace wekey {
@@ -213,7 +214,7 @@ void CreateFileDialog::onFilePathChanged() {
     file.close();
 
     sizeLabel_->setText(QString("%1  字节").arg(fileData_.size()));
-    qDebug() << "[CreateFileDialog] 文件已加载, path:" << path << "size:" << fileData_.size();
+    qCDebug(lcGui) << "[CreateFileDialog] 文件已加载, path:" << path << "size:" << fileData_.size();
     validate();
 }
 
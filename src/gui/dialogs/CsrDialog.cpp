@@ -22,6 +22,7 @@
 #include <ElaRadioButton.h>
 #include <ElaToggleSwitch.h>
 
+#include "common/LogCategories.h"
 #include "config/Config.h"
 #include "core/crypto/CertService.h"
 #include "gui/UiHelper.h"
@@ -69,7 +70,7 @@ void CsrDialog::validate() {
 }
 
 void CsrDialog::onGenerate() {
-    qDebug() << "[CsrDialog] 开始生成 CSR, container:" << containerName_;
+    qCDebug(lcGui) << "[CsrDialog] 开始生成 CSR, container:" << containerName_;
 
     // 禁用确定按钮，防止重复点击
     okButton_->setEnabled(false);
@@ -78,7 +79,7 @@ void CsrDialog::onGenerate() {
     // 调用 CertService::generateCsr
     auto result = CertService::instance().generateCsr(devName_, appName_, containerName_, toArgs());
     if (!result.isOk()) {
-        qWarning() << "[CsrDialog] 生成 CSR 失败:" << result.error().message();
+        qCWarning(lcGui) << "[CsrDialog] 生成 CSR 失败:" << result.error().message();
         okButton_->setText("确定");
         okButton_->setEnabled(true);
 
@@ -100,7 +101,7 @@ void CsrDialog::onGenerate() {
     }
     QString csrPem = "-----BEGIN CERTIFICATE REQUEST-----\n" + formattedPem + "-----END CERTIFICATE REQUEST-----";
 
-    qDebug() << "[CsrDialog] CSR 生成成功";
+    qCDebug(lcGui) << "[CsrDialog] CSR 生成成功";
 
     // 标记已生成
     generated_ = true;
@@ -131,7 +132,7 @@ void CsrDialog::onGenerate() {
 void CsrDialog::onCopy() {
     QClipboard* clipboard = QApplication::clipboard();
     clipboard->setText(resultEdit_->toPlainText());
-    qDebug() << "[CsrDialog] CSR PEM 已复制到剪贴板";
+    qCDebug(lcGui) << "[CsrDialog] CSR PEM 已复制到剪贴板";
 
     // 短暂提示已复制
     copyButton_->setText("已复制 ✓");
@@ -19,6 +19,7 @@
 #include <ElaPushButton.h>
 #include <ElaToggleSwitch.h>
 
+#include "common/LogCategories.h"
 #include "gui/UiHelper.h"
 
 namespace wekey {
@@ -48,10 +49,10 @@ void ImportCertDialog::onBrowseSigCert() {
     sigCertData_ = readCertFile(filePath);
     if (!sigCertData_.isEmpty()) {
         sigCertPath_->setText(QFileInfo(filePath).fileName());
-        qDebug() << "[ImportCertDialog] 签名证书已加载, size:" << sigCertData_.size();
+        qCDebug(lcGui) << "[ImportCertDialog] 签名证书已加载, size:" << sigCertData_.size();
     } else {
         sigCertPath_->setText("");
-        qWarning() << "[ImportCertDialog] 签名证书文件读取失败:" << filePath;
+        qCWarning(lcGui) << "[ImportCertDialog] 签名证书文件读取失败:" << filePath;
     }
     validate();
 }
@@ -65,10 +66,10 @@ void ImportCertDialog::onBrowseEncCert() {
     encCertData_ = readCertFile(filePath);
     if (!encCertData_.isEmpty()) {
         encCertPath_->setText(QFileInfo(filePath).fileName());
-        qDebug() << "[ImportCertDialog] 加密证书已加载, size:" << encCertData_.size();
+        qCDebug(lcGui) << "[ImportCertDialog] 加密证书已加载, size:" << encCertData_.size();
     } else {
         encCertPath_->setText("");
-        qWarning() << "[ImportCertDialog] 加密证书文件读取失败:" << filePath;
+        qCWarning(lcGui) << "[ImportCertDialog] 加密证书文件读取失败:" << filePath;
     }
     validate();
 }
@@ -82,10 +83,10 @@ void ImportCertDialog::onBrowseEncPrivate() {
     encPrivateData_ = readKeyFile(filePath);
     if (!encPrivateData_.isEmpty()) {
         encPrivatePath_->setText(QFileInfo(filePath).fileName());
-        qDebug() << "[ImportCertDialog] 加密私钥已加载, size:" << encPrivateData_.size();
+        qCDebug(lcGui) << "[ImportCertDialog] 加密私钥已加载, size:" << encPrivateData_.size();
     } else {
         encPrivatePath_->setText("");
-        qWarning() << "[ImportCertDialog] 加密私钥文件读取失败:" << filePath;
+        qCWarning(lcGui) << "[ImportCertDialog] 加密私钥文件读取失败:" << filePath;
     }
     validate();
 }
@@ -231,13 +232,13 @@ QByteArray ImportCertDialog::readCertFile(const QString& filePath) {
             base64 += trimmed;
         }
         QByteArray decoded = QByteArray::fromBase64(base64.toLatin1());
-        qDebug() << "[ImportCertDialog] PEM 证书解码, base64 size:" << base64.size()
+        qCDebug(lcGui) << "[ImportCertDialog] PEM 证书解码, base64 size:" << base64.size()
                  << "DER size:" << decoded.size();
         return decoded;
     }
 
     // DER 格式，直接返回
-    qDebug() << "[ImportCertDialog] DER 证书, size:" << raw.size();
+    qCDebug(lcGui) << "[ImportCertDialog] DER 证书, size:" << raw.size();
     return raw;
 }
 
@@ -263,19 +264,19 @@ QByteArray ImportCertDialog::readKeyFile(const QString& filePath) {
             base64 += trimmed;
         }
         QByteArray decoded = QByteArray::fromBase64(base64.toLatin1());
-        qDebug() << "[ImportCertDialog] PEM 私钥解码, DER size:" << decoded.size();
+        qCDebug(lcGui) << "[ImportCertDialog] PEM 私钥解码, DER size:" << decoded.size();
         return decoded;
     }
 
     // 纯 base64 文本
     QByteArray decoded = QByteArray::fromBase64(text.toLatin1());
     if (!decoded.isEmpty()) {
-        qDebug() << "[ImportCertDialog] base64 私钥解码, size:" << decoded.size();
+        qCDebug(lcGui) << "[ImportCertDialog] base64 私钥解码, size:" << decoded.size();
         return decoded;
     }
 
     // 二进制文件，直接返回
-    qDebug() << "[ImportCertDialog] 二进制私钥, size:" << raw.size();
+    qCDebug(lcGui) << "[ImportCertDialog] 二进制私钥, size:" << raw.size();
     return raw;
 }
 
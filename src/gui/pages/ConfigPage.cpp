@@ -155,17 +155,20 @@ void ConfigPage::setupUi() {
     addCentralWidget(centralWidget, true, true, 0);
 
     connect(saveButton_, &ElaPushButton::clicked, this, [this]() {
-        auto& cfg = Config::instance();
-        cfg.setDefault("appName", appNameEdit_->text());
-        cfg.setDefault("containerName", containerNameEdit_->text());
-        cfg.setDefault("commonName", commonNameEdit_->text());
-        cfg.setDefault("organization", organizationEdit_->text());
-        cfg.setDefault("unit", unitEdit_->text());
-        cfg.setDefault("role", roleUserRadio_->isChecked() ? "user" : "admin");
-        cfg.setListenPort(":" + QString::number(portSpin_->value()));
-        cfg.setErrorMode(errorSimpleRadio_->isChecked() ? "simple" : "detailed");
         QString logLevel = logLevelCombo_->currentData().toString();
-        cfg.setLogLevel(logLevel);
+        // 一次发布全部修改，API 线程不会看到只改了一半的配置
+        auto& cfg = Config::instance();
+        cfg.update([&](ConfigSnapshot& s) {
+            s.defaultAppName = appNameEdit_->text();
+            s.defaultContainerName = containerNameEdit_->text();
+            s.defaultCommonName = commonNameEdit_->text();
+            s.defaultOrganization = organizationEdit_->text();
+            s.defaultUnit = unitEdit_->text();
+            s.defaultRole = roleUserRadio_->isChecked() ? "user" : "admin";
+            s.listenPort = ":" + QString::number(portSpin_->value());
+            s.errorMode = errorSimpleRadio_->isChecked() ? "simple" : "detailed";
+            s.logLevel = logLevel;
+        });
         // 立即更新 Logger 运行时级别，无需重启
         Logger::instance().setLevel(stringToLogLevel(logLevel));
         cfg.save();
@@ -178,29 +181,29 @@ void ConfigPage::setupUi() {
 }
 
 void ConfigPage::loadFromConfig() {
-    auto& cfg = Config::instance();
-    appNameEdit_->setText(cfg.defaultAppName());
-    containerNameEdit_->setText(cfg.defaultContainerName());
-    commonNameEdit_->setText(cfg.defaultCommonName());
-    organizationEdit_->setText(cfg.defaultOrganization());
-    unitEdit_->setText(cfg.defaultUnit());
-
-    if (cfg.defaultRole() == "admin") {
+    const ConfigSnapshotPtr cfg = Config::instance().snapshot();
+    appNameEdit_->setText(cfg->defaultAppName);
+    containerNameEdit_->setText(cfg->defaultContainerName);
+    commonNameEdit_->setText(cfg->defaultCommonName);
+    organizationEdit_->setText(cfg->defaultOrganization);
+    unitEdit_->setText(cfg->defaultUnit);
+
+    if (cfg->defaultRole == "admin") {
         roleAdminRadio_->setChecked(true);
     } else {
         roleUserRadio_->setChecked(true);
     }
 
-    QString portStr = cfg.listenPort();
+    QString portStr = cfg->listenPort;
     portStr.remove(':');
     portSpin_->setValue(portStr.toInt());
 
     // 日志级别
-    QString level = cfg.logLevel().toLower();
+    QString level = cfg->logLevel.toLower();
     int levelIdx = logLevelCombo_->findData(level);
     logLevelCombo_->setCurrentIndex(levelIdx >= 0 ? levelIdx : 0);
 
-    if (cfg.errorMode() == "detailed") {
+    if (cfg->errorMode == "detailed") {
         errorDetailedRadio_->setChecked(true);
     } else {
         errorSimpleRadio_->setChecked(true);
@@ -20,6 +20,7 @@
 #include <ElaScrollPageArea.h>
 #include <ElaText.h>
 
+#include "common/LogCategories.h"
 #include "gui/UiHelper.h"
 #include "gui/views/AppListView.h"
 #include "gui/views/AppDetailView.h"
@@ -315,19 +316,19 @@ void DevicePage::onChangeAuth(const QString& devName) {
 }
 
 void DevicePage::navigateToAppList(const QString& devName) {
-    qDebug() << "[DevicePage] navigateToAppList:" << devName;
+    qCDebug(lcGui) << "[DevicePage] navigateToAppList:" << devName;
     appListView_->setDevice(devName);
     stack_->setCurrentIndex(1);
 }
 
 void DevicePage::navigateToAppDetail(const QString& devName, const QString& appName) {
-    qDebug() << "[DevicePage] navigateToAppDetail:" << devName << appName;
+    qCDebug(lcGui) << "[DevicePage] navigateToAppDetail:" << devName << appName;
     appDetailView_->setContext(devName, appName);
     stack_->setCurrentIndex(2);
 }
 
 void DevicePage::navigateToDeviceList() {
-    qDebug() << "[DevicePage] navigateToDeviceList";
+    qCDebug(lcGui) << "[DevicePage] navigateToDeviceList";
     stack_->setCurrentIndex(0);
     refreshTable();
 }
@@ -5,6 +5,8 @@
 
 #include "LogPage.h"
 
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QLabel>
@@ -16,8 +18,11 @@
 #include <ElaScrollPageArea.h>
 #include <ElaTableView.h>
 #include <ElaText.h>
+#include <ElaToggleSwitch.h>
 
+#include "config/Config.h"
 #include "gui/UiHelper.h"
+#include "gui/dialogs/MessageBox.h"
 
 namespace wekey {
 
@@ -29,6 +34,10 @@ LogPage::LogPage(QWidget* parent) : ElaScrollPage(parent) {
 
 ElaLineEdit* LogPage::searchEdit() const { return searchEdit_; }
 
+ElaToggleSwitch* LogPage::regexSwitch() const { return regexSwitch_; }
+
+ElaLineEdit* LogPage::sourceEdit() const { return sourceEdit_; }
+
 ElaComboBox* LogPage::levelCombo() const { return levelCombo_; }
 
 ElaPushButton* LogPage::clearButton() const { return clearButton_; }
@@ -37,6 +46,8 @@ ElaTableView* LogPage::tableView() const { return tableView_; }
 
 LogModel* LogPage::logModel() const { return logModel_; }
 
+LogFileModel* LogPage::fileModel() const { return fileModel_; }
+
 void LogPage::setupUi() {
     // 筛选区域
     auto* filterArea = new ElaScrollPageArea(this);
@@ -49,6 +60,20 @@ void LogPage::setupUi() {
     UiHelper::styleLineEdit(searchEdit_);
     searchEdit_->setPlaceholderText("搜索日志...");
     filterLayout->addWidget(searchEdit_, 1);
+    auto* regexLabel = new ElaText("正则:", this);
+    regexLabel->setTextStyle(ElaTextType::Body);
+    filterLayout->addWidget(regexLabel);
+    regexSwitch_ = new ElaToggleSwitch(this);
+    regexSwitch_->setIsToggled(false);
+    filterLayout->addWidget(regexSwitch_);
+    auto* sourceLabel = new ElaText("来源:", this);
+    sourceLabel->setTextStyle(ElaTextType::Body);
+    filterLayout->addWidget(sourceLabel);
+    sourceEdit_ = new ElaLineEdit(this);
+    UiHelper::styleLineEdit(sourceEdit_);
+    sourceEdit_->setPlaceholderText("如 wekey.skf");
+    sourceEdit_->setFixedWidth(140);
+    filterLayout->addWidget(sourceEdit_);
     auto* levelLabel = new ElaText("级别:", this);
     levelLabel->setTextStyle(ElaTextType::Body);
     filterLayout->addWidget(levelLabel);
@@ -60,21 +85,47 @@ void LogPage::setupUi() {
     UiHelper::styleDangerButton(clearButton_);
     filterLayout->addWidget(clearButton_);
 
+    // 文件浏览区域
+    auto* fileArea = new ElaScrollPageArea(this);
+    UiHelper::styleCard(fileArea);
+    auto* fileLayout = new QHBoxLayout(fileArea);
+    openFileButton_ = new ElaPushButton("打开日志文件", this);
+    UiHelper::styleDefaultButton(openFileButton_);
+    fileLayout->addWidget(openFileButton_);
+    liveButton_ = new ElaPushButton("返回实时日志", this);
+    UiHelper::styleDefaultButton(liveButton_);
+    liveButton_->setEnabled(false);
+    fileLayout->addWidget(liveButton_);
+    auto* fromLabel = new ElaText("起始:", this);
+    fromLabel->setTextStyle(ElaTextType::Body);
+    fileLayout->addWidget(fromLabel);
+    fromEdit_ = new ElaLineEdit(this);
+    UiHelper::styleLineEdit(fromEdit_);
+    fromEdit_->setPlaceholderText("yyyy-MM-dd hh:mm:ss");
+    fromEdit_->setFixedWidth(180);
+    fileLayout->addWidget(fromEdit_);
+    auto* toLabel = new ElaText("结束:", this);
+    toLabel->setTextStyle(ElaTextType::Body);
+    fileLayout->addWidget(toLabel);
+    toEdit_ = new ElaLineEdit(this);
+    UiHelper::styleLineEdit(toEdit_);
+    toEdit_->setPlaceholderText("yyyy-MM-dd hh:mm:ss");
+    toEdit_->setFixedWidth(180);
+    fileLayout->addWidget(toEdit_);
+    fileStatus_ = new ElaText(this);
+    fileStatus_->setTextStyle(ElaTextType::Body);
+    fileLayout->addWidget(fileStatus_, 1);
+    fromEdit_->setEnabled(false);
+    toEdit_->setEnabled(false);
+
     // 日志表格
     logModel_ = new LogModel(this);
     logModel_->connectToLogger();
 
     tableView_ = new ElaTableView(this);
-    tableView_->setModel(logModel_);
     tableView_->verticalHeader()->setVisible(false);
     tableView_->verticalHeader()->setDefaultSectionSize(36);
-    tableView_->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed);    // 时间
-    tableView_->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Fixed);    // 级别
-    tableView_->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Fixed);    // 来源
-    tableView_->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);  // 消息
-    tableView_->setColumnWidth(0, 200);  // yyyy-MM-dd hh:mm:ss.zzz
-    tableView_->setColumnWidth(1, 60);   // DEBUG/INFO
-    tableView_->setColumnWidth(2, 140);  // 来源
+    setTableModel(logModel_);
     tableView_->horizontalHeader()->setStretchLastSection(true);
     tableView_->setSelectionBehavior(QAbstractItemView::SelectRows);
     tableView_->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -85,24 +136,110 @@ void LogPage::setupUi() {
     centerLayout->setContentsMargins(0, 0, 0, 0);
     centerLayout->setSpacing(UiHelper::kSpaceMD);
     centerLayout->addWidget(filterArea);
+    centerLayout->addWidget(fileArea);
     centerLayout->addWidget(tableView_, 1);
     addCentralWidget(centralWidget, true, true, 0);
 
+    // 过滤在模型的后台线程执行，文本输入由模型防抖
     connect(searchEdit_, &ElaLineEdit::textChanged, logModel_, &LogModel::setSearchText);
+    connect(sourceEdit_, &ElaLineEdit::textChanged, logModel_, &LogModel::setSourceFilter);
+    connect(regexSwitch_, &ElaToggleSwitch::toggled, logModel_, &LogModel::setRegexEnabled);
 
-    connect(levelCombo_, &ElaComboBox::currentIndexChanged, this, [this](int index) {
-        LogLevel level = LogLevel::Debug;
-        switch (index) {
-            case 1: level = LogLevel::Debug; break;
-            case 2: level = LogLevel::Info; break;
-            case 3: level = LogLevel::Warn; break;
-            case 4: level = LogLevel::Error; break;
-            default: level = LogLevel::Debug; break;
-        }
-        logModel_->setFilterLevel(level);
+    connect(levelCombo_, &ElaComboBox::currentIndexChanged, this, [this](int /*index*/) {
+        logModel_->setFilterLevel(selectedLevel());
+        applyFileFilter();
     });
 
     connect(clearButton_, &ElaPushButton::clicked, logModel_, &LogModel::clear);
+
+    // 文件浏览：按需创建模型
+    connect(openFileButton_, &ElaPushButton::clicked, this, &LogPage::openLogFile);
+    connect(liveButton_, &ElaPushButton::clicked, this, &LogPage::showLiveLog);
+    connect(fromEdit_, &ElaLineEdit::editingFinished, this, &LogPage::applyFileFilter);
+    connect(toEdit_, &ElaLineEdit::editingFinished, this, &LogPage::applyFileFilter);
+}
+
+void LogPage::setTableModel(QAbstractItemModel* model) {
+    // 更换模型后表头分区重建，需重新设置列宽
+    tableView_->setModel(model);
+    tableView_->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed);    // 时间
+    tableView_->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Fixed);    // 级别
+    tableView_->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Fixed);    // 来源
+    tableView_->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);  // 消息
+    tableView_->setColumnWidth(0, 200);  // yyyy-MM-dd hh:mm:ss.zzz
+    tableView_->setColumnWidth(1, 60);   // DEBUG/INFO
+    tableView_->setColumnWidth(2, 140);  // 来源
+}
+
+LogLevel LogPage::selectedLevel() const {
+    switch (levelCombo_->currentIndex()) {
+        case 2: return LogLevel::Info;
+        case 3: return LogLevel::Warn;
+        case 4: return LogLevel::Error;
+        default: return LogLevel::Debug;
+    }
+}
+
+void LogPage::openLogFile() {
+    QString filePath = QFileDialog::getOpenFileName(
+        this, "选择日志文件", Config::instance().logPath(),
+        "日志文件 (*.log);;所有文件 (*)");
+    if (filePath.isEmpty()) return;
+
+    if (!fileModel_) {
+        fileModel_ = new LogFileModel(this);
+        connect(fileModel_, &LogFileModel::indexProgress, this, [this](qint64 indexed, qint64 total) {
+            int percent = total > 0 ? static_cast<int>(indexed * 100 / total) : 100;
+            fileStatus_->setText(QString("正在索引 %1%").arg(percent));
+        });
+        connect(fileModel_, &LogFileModel::indexFinished, this, [this](quint64 lineCount) {
+            fileStatus_->setText(QString("%1（%2 行）").arg(QFileInfo(fileModel_->path()).fileName()).arg(lineCount));
+        });
+    }
+
+    auto result = fileModel_->open(filePath);
+    if (result.isErr()) {
+        MessageBox::error(this, "打开日志文件失败", result.error());
+        return;
+    }
+
+    applyFileFilter();
+    setTableModel(fileModel_);
+
+    // 搜索和清空只作用于实时日志
+    searchEdit_->setEnabled(false);
+    regexSwitch_->setEnabled(false);
+    sourceEdit_->setEnabled(false);
+    clearButton_->setEnabled(false);
+    fromEdit_->setEnabled(true);
+    toEdit_->setEnabled(true);
+    liveButton_->setEnabled(true);
+}
+
+void LogPage::showLiveLog() {
+    setTableModel(logModel_);
+    if (fileModel_) {
+        fileModel_->close();
+    }
+
+    searchEdit_->setEnabled(true);
+    regexSwitch_->setEnabled(true);
+    sourceEdit_->setEnabled(true);
+    clearButton_->setEnabled(true);
+    fromEdit_->setEnabled(false);
+    toEdit_->setEnabled(false);
+    liveButton_->setEnabled(false);
+    fileStatus_->clear();
+}
+
+void LogPage::applyFileFilter() {
+    if (!fileModel_) return;
+
+    LogFileFilter filter;
+    filter.minLevel = selectedLevel();
+    filter.from = fromEdit_->text().trimmed().toUtf8();
+    filter.to = toEdit_->text().trimmed().toUtf8();
+    fileModel_->setFilter(filter);
 }
 
 }  // namespace wekey
@@ -10,9 +10,13 @@
 #include <ElaPushButton.h>
 #include <ElaScrollPage.h>
 #include <ElaTableView.h>
+#include <ElaToggleSwitch.h>
 
+#include "log/LogFileModel.h"
 #include "log/LogModel.h"
 
+class ElaText;
+
 namespace wekey {
 
 class LogPage : public ElaScrollPage {
@@ -22,19 +26,57 @@ public:
     explicit LogPage(QWidget* parent = nullptr);
 
     ElaLineEdit* searchEdit() const;
+    ElaToggleSwitch* regexSwitch() const;
+    ElaLineEdit* sourceEdit() const;
     ElaComboBox* levelCombo() const;
     ElaPushButton* clearButton() const;
     ElaTableView* tableView() const;
     LogModel* logModel() const;
+    LogFileModel* fileModel() const;
 
 private:
     void setupUi();
 
+    /**
+     * @brief 选择并以浏览模式打开日志文件
+     */
+    void openLogFile();
+
+    /**
+     * @brief 关闭文件浏览，返回实时日志
+     */
+    void showLiveLog();
+
+    /**
+     * @brief 将级别和时间范围应用到文件浏览模型
+     */
+    void applyFileFilter();
+
+    /**
+     * @brief 切换表格模型并设置列宽
+     */
+    void setTableModel(QAbstractItemModel* model);
+
+    /**
+     * @brief 级别下拉框当前选择的级别
+     */
+    LogLevel selectedLevel() const;
+
     ElaLineEdit* searchEdit_ = nullptr;
+    ElaToggleSwitch* regexSwitch_ = nullptr;  ///< 搜索文本按正则匹配
+    ElaLineEdit* sourceEdit_ = nullptr;       ///< 来源过滤
     ElaComboBox* levelCombo_ = nullptr;
     ElaPushButton* clearButton_ = nullptr;
     ElaTableView* tableView_ = nullptr;
     LogModel* logModel_ = nullptr;
+
+    // 文件浏览模式
+    ElaPushButton* openFileButton_ = nullptr;
+    ElaPushButton* liveButton_ = nullptr;
+    ElaLineEdit* fromEdit_ = nullptr;  ///< 起始时间前缀
+    ElaLineEdit* toEdit_ = nullptr;    ///< 结束时间前缀
+    ElaText* fileStatus_ = nullptr;
+    LogFileModel* fileModel_ = nullptr;
 };
 
 }  // namespace wekey
@@ -150,10 +150,12 @@ void ModulePage::onDeleteModule(const QString& name) {
         MessageBox::error(this, "删除模块失败", result.error());
     } else {
         auto& config = Config::instance();
-        config.removeModPath(name);
-        if (config.activedModName() == name) {
-            config.setActivedModName(QString());
-        }
+        config.update([&](ConfigSnapshot& s) {
+            s.modPaths.remove(name);
+            if (s.activedModName == name) {
+                s.activedModName.clear();
+            }
+        });
         config.save();
     }
 }
@@ -0,0 +1,204 @@
+/**
+ * @file ProvisionPage.cpp
+ * @brief 批量初始化页实现
+ */
+
+#include "ProvisionPage.h"
+
+#include <QFileDialog>
+#include <QHash>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+#include <ElaScrollPageArea.h>
+#include <ElaText.h>
+
+#include "core/provision/ProvisionService.h"
+#include "gui/UiHelper.h"
+#include "gui/dialogs/MessageBox.h"
+
+namespace wekey {
+
+namespace {
+
+constexpr int kColSerial = 0;
+constexpr int kColStep = 1;
+constexpr int kColState = 2;
+constexpr int kColMessage = 3;
+
+QString stepLabel(const QString& step) {
+    static const QHash<QString, QString> labels = {
+        {"create-app", "创建应用"},
+        {"login", "登录"},
+        {"create-container", "创建容器"},
+        {"generate-csr", "生成密钥与 CSR"},
+        {"import-cert", "导入证书"},
+        {"done", "完成"},
+    };
+    return labels.value(step, step);
+}
+
+QWidget* stateTag(const QString& state) {
+    if (state == "succeeded") {
+        return UiHelper::createSuccessTag("已完成");
+    }
+    if (state == "running") {
+        return UiHelper::createInfoTag("进行中");
+    }
+    if (state == "waiting-cert") {
+        return UiHelper::createWarningTag("等待证书");
+    }
+    if (state == "failed") {
+        return UiHelper::createTagWidget("失败", "#fff2f0", "#ff4d4f", "#ffccc7");
+    }
+    if (state == "cancelled") {
+        return UiHelper::createDefaultTag("已取消");
+    }
+    return UiHelper::createDefaultTag("排队中");
+}
+
+}  // namespace
+
+ProvisionPage::ProvisionPage(QWidget* parent) : ElaScrollPage(parent) {
+    setWindowTitle("批量初始化");
+    setTitleVisible(false);
+    setupUi();
+    connectSignals();
+    refreshTable();
+}
+
+QTableWidget* ProvisionPage::table() const { return table_; }
+
+void ProvisionPage::setupUi() {
+    // 计划文件与操作按钮
+    auto* planArea = new ElaScrollPageArea(this);
+    UiHelper::styleCard(planArea);
+    auto* planLayout = new QHBoxLayout(planArea);
+    auto* planLabel = new ElaText("计划文件:", this);
+    planLabel->setTextStyle(ElaTextType::Body);
+    planLayout->addWidget(planLabel);
+    planEdit_ = new ElaLineEdit(this);
+    planEdit_->setPlaceholderText("JSON 计划文件路径");
+    UiHelper::styleLineEdit(planEdit_);
+    planLayout->addWidget(planEdit_, 1);
+    browseButton_ = new ElaPushButton("选择", this);
+    UiHelper::styleDefaultButton(browseButton_);
+    planLayout->addWidget(browseButton_);
+    auto* freshLabel = new ElaText("从头开始:", this);
+    freshLabel->setTextStyle(ElaTextType::Body);
+    planLayout->addWidget(freshLabel);
+    freshSwitch_ = new ElaToggleSwitch(this);
+    freshSwitch_->setIsToggled(false);
+    planLayout->addWidget(freshSwitch_);
+    startButton_ = new ElaPushButton("开始", this);
+    UiHelper::stylePrimaryButton(startButton_);
+    planLayout->addWidget(startButton_);
+    cancelButton_ = new ElaPushButton("取消", this);
+    UiHelper::styleDangerButton(cancelButton_);
+    planLayout->addWidget(cancelButton_);
+
+    summaryText_ = new ElaText(this);
+    summaryText_->setTextStyle(ElaTextType::Body);
+    summaryText_->setWordWrap(true);
+
+    // 设备进度表格
+    table_ = new QTableWidget(0, 4, this);
+    table_->setHorizontalHeaderLabels({"序列号", "当前步骤", "状态", "说明"});
+    table_->horizontalHeader()->setSectionResizeMode(kColSerial, QHeaderView::ResizeToContents);
+    table_->horizontalHeader()->setSectionResizeMode(kColStep, QHeaderView::ResizeToContents);
+    table_->horizontalHeader()->setSectionResizeMode(kColState, QHeaderView::Fixed);
+    table_->horizontalHeader()->resizeSection(kColState, 110);
+    table_->horizontalHeader()->setSectionResizeMode(kColMessage, QHeaderView::Stretch);
+    UiHelper::styleTable(table_);
+
+    auto* centralWidget = new QWidget(this);
+    auto* centerLayout = new QVBoxLayout(centralWidget);
+    centerLayout->setContentsMargins(0, 0, 0, 0);
+    centerLayout->setSpacing(UiHelper::kSpaceMD);
+    centerLayout->addWidget(planArea);
+    centerLayout->addWidget(summaryText_);
+    centerLayout->addWidget(table_, 1);
+    addCentralWidget(centralWidget, true, true, 0);
+}
+
+void ProvisionPage::connectSignals() {
+    auto& service = ProvisionService::instance();
+    connect(browseButton_, &ElaPushButton::clicked, this, &ProvisionPage::onBrowsePlan);
+    connect(startButton_, &ElaPushButton::clicked, this, &ProvisionPage::onStart);
+    connect(cancelButton_, &ElaPushButton::clicked, this, &ProvisionPage::onCancel);
+    connect(&service, &ProvisionService::deviceProgress, this, &ProvisionPage::updateRow);
+    connect(&service, &ProvisionService::runFinished, this, [this](int succeeded, int waiting, int failed) {
+        updateButtons(false);
+        summaryText_->setText(
+            QString("已结束：完成 %1 台，等待证书 %2 台，失败 %3 台").arg(succeeded).arg(waiting).arg(failed));
+    });
+}
+
+void ProvisionPage::onBrowsePlan() {
+    QString filePath = QFileDialog::getOpenFileName(this, "选择计划文件", planEdit_->text(),
+                                                    "计划文件 (*.json);;所有文件 (*)");
+    if (!filePath.isEmpty()) {
+        planEdit_->setText(filePath);
+    }
+}
+
+void ProvisionPage::onStart() {
+    QString planPath = planEdit_->text().trimmed();
+    if (planPath.isEmpty()) {
+        MessageBox::error(this, "批量初始化", "请先选择计划文件");
+        return;
+    }
+
+    auto result = ProvisionService::instance().start(planPath, freshSwitch_->getIsToggled());
+    if (result.isErr()) {
+        MessageBox::error(this, "批量初始化失败", result.error());
+    }
+    refreshTable();
+}
+
+void ProvisionPage::onCancel() {
+    ProvisionService::instance().cancel();
+    cancelButton_->setEnabled(false);
+    summaryText_->setText("正在取消，各设备完成当前步骤后停止");
+}
+
+void ProvisionPage::refreshTable() {
+    const ProvisionStatus status = ProvisionService::instance().status();
+    if (planEdit_->text().isEmpty()) {
+        planEdit_->setText(status.planPath);
+    }
+
+    table_->setRowCount(0);
+    for (const auto& p : status.devices) {
+        updateRow(p.serialNumber, provisionStepToString(p.step), provisionStateToString(p.state), p.message);
+    }
+    updateButtons(status.running);
+    summaryText_->setText(status.checkpoint.isEmpty() ? QString()
+                                                      : QString("检查点: %1").arg(status.checkpoint));
+}
+
+void ProvisionPage::updateRow(const QString& serialNumber, const QString& step, const QString& state,
+                              const QString& message) {
+    int row = 0;
+    while (row < table_->rowCount() && table_->item(row, kColSerial)->text() != serialNumber) {
+        ++row;
+    }
+    if (row == table_->rowCount()) {
+        table_->insertRow(row);
+        table_->setItem(row, kColSerial, new QTableWidgetItem(serialNumber));
+    }
+    table_->setItem(row, kColStep, new QTableWidgetItem(stepLabel(step)));
+    table_->setCellWidget(row, kColState, stateTag(state));
+    table_->setItem(row, kColMessage, new QTableWidgetItem(message));
+}
+
+void ProvisionPage::updateButtons(bool running) {
+    planEdit_->setEnabled(!running);
+    browseButton_->setEnabled(!running);
+    freshSwitch_->setEnabled(!running);
+    startButton_->setEnabled(!running);
+    cancelButton_->setEnabled(running);
+}
+
+}  // namespace wekey
@@ -0,0 +1,61 @@
+/**
+ * @file ProvisionPage.h
+ * @brief 批量初始化页
+ */
+
+#pragma once
+
+#include <QTableWidget>
+
+#include <ElaLineEdit.h>
+#include <ElaPushButton.h>
+#include <ElaScrollPage.h>
+#include <ElaToggleSwitch.h>
+
+class ElaText;
+
+namespace wekey {
+
+/**
+ * @brief 批量初始化页
+ *
+ * 选择计划文件后启动 ProvisionService，表格按设备显示当前步骤和状态，
+ * 随 deviceProgress 信号逐行更新。
+ */
+class ProvisionPage : public ElaScrollPage {
+    Q_OBJECT
+
+public:
+    explicit ProvisionPage(QWidget* parent = nullptr);
+
+    QTableWidget* table() const;
+
+private:
+    void setupUi();
+    void connectSignals();
+    void onBrowsePlan();
+    void onStart();
+    void onCancel();
+
+    /**
+     * @brief 按 ProvisionService::status() 重建表格
+     */
+    void refreshTable();
+
+    /**
+     * @brief 更新（或追加）一台设备所在行
+     */
+    void updateRow(const QString& serialNumber, const QString& step, const QString& state, const QString& message);
+
+    void updateButtons(bool running);
+
+    ElaLineEdit* planEdit_ = nullptr;
+    ElaPushButton* browseButton_ = nullptr;
+    ElaToggleSwitch* freshSwitch_ = nullptr;
+    ElaPushButton* startButton_ = nullptr;
+    ElaPushButton* cancelButton_ = nullptr;
+    ElaText* summaryText_ = nullptr;
+    QTableWidget* table_ = nullptr;
+};
+
+}  // namespace wekey
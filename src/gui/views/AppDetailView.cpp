@@ -22,6 +22,7 @@
 #include <ElaPushButton.h>
 #include <ElaText.h>
 
+#include "common/LogCategories.h"
 #include "gui/UiHelper.h"
 #include "core/container/ContainerService.h"
 #include "core/crypto/CertService.h"
@@ -43,6 +44,7 @@ void AppDetailView::setContext(const QString& devName, const QString& appName) {
     devName_ = devName;
     appName_ = appName;
     titleText_->setText(QString("应用详情: %1").arg(appName_));
+    // 上一个应用的枚举可能仍在进行，其结果会因代次不符被丢弃
     refreshContainers();
     refreshFiles();
 }
@@ -173,18 +175,27 @@ void AppDetailView::connectSignals() {
 // ============================================================
 
 void AppDetailView::refreshContainers() {
-    if (refreshingContainers_ || devName_.isEmpty() || appName_.isEmpty()) return;
-    refreshingContainers_ = true;
+    if (devName_.isEmpty() || appName_.isEmpty()) return;
 
     containerTable_->setRowCount(0);
 
-    auto result = ContainerService::instance().enumContainers(devName_, appName_);
-    if (!result.isOk()) {
-        refreshingContainers_ = false;
-        return;
-    }
+    // 枚举在设备执行器上进行，界面线程不等待 USB 交互。不拦截重复刷新：
+    // 新请求换代，先提交的枚举结果到达时被丢弃，表格以最后一次刷新为准
+    const quint64 generation = ++containerGeneration_;
+    ContainerService::instance().enumContainersAsync(devName_, appName_)
+        .then(this, [this, generation](const Result<QList<ContainerInfo>>& result) {
+            // 等待期间切换了设备或应用，结果已过期
+            if (generation != containerGeneration_ || !result.isOk()) {
+                return;
+            }
+            fillContainers(result.value());
+        });
+}
 
-    for (const auto& c : result.value()) {
+void AppDetailView::fillContainers(const QList<ContainerInfo>& containers) {
+    containerTable_->setRowCount(0);
+
+    for (const auto& c : containers) {
         int row = containerTable_->rowCount();
         containerTable_->insertRow(row);
 
@@ -244,8 +255,6 @@ void AppDetailView::refreshContainers() {
         actionLayout->addStretch();
         containerTable_->setCellWidget(row, 4, actionWidget);
     }
-
-    refreshingContainers_ = false;
 }
 
 void AppDetailView::onCreateContainer() {
@@ -383,10 +392,10 @@ void AppDetailView::onImportCert(const QString& containerName) {
         devName_, appName_, containerName,
         dialog.sigCertData(), dialog.encCertData(), dialog.encPrivateData(), dialog.isNonGM());
     if (!result.isOk()) {
-        qWarning() << "[onImportCert] 导入失败:" << result.error().message();
+        qCWarning(lcGui) << "[onImportCert] 导入失败:" << result.error().message();
         MessageBox::error(this, "导入证书失败", result.error());
     } else {
-        qDebug() << "[onImportCert] 导入成功, container:" << containerName;
+        qCDebug(lcGui) << "[onImportCert] 导入成功, container:" << containerName;
         MessageBox::info(this, "成功", "证书和密钥已导入");
         refreshContainers();
     }
@@ -406,32 +415,43 @@ void AppDetailView::refreshFiles() {
 
     fileTable_->setRowCount(0);
 
-    auto result = FileService::instance().enumFiles(devName_, appName_);
-    if (result.isErr()) {
-        return;
-    }
+    const quint64 generation = ++fileGeneration_;
+    FileService::instance().enumFilesAsync(devName_, appName_)
+        .then(this, [this, generation](const Result<QStringList>& result) {
+            if (generation != fileGeneration_ || result.isErr()) {
+                return;
+            }
+            fillFiles(result.value(), generation);
+        });
+}
 
-    auto files = result.value();
+void AppDetailView::fillFiles(const QStringList& files, quint64 generation) {
     fileTable_->setRowCount(files.size());
 
     for (int i = 0; i < files.size(); ++i) {
         // 文件名
         fileTable_->setItem(i, 0, new QTableWidgetItem(files[i]));
 
-        // 大小：读取文件数据获取实际大小
-        QString sizeText = "--";
-        auto readResult = FileService::instance().readFile(devName_, appName_, files[i]);
-        if (readResult.isOk()) {
-            qint64 sz = readResult.value().size();
-            if (sz < 1024) {
-                sizeText = QString("%1 B").arg(sz);
-            } else {
-                sizeText = QString("%1 KB").arg(QString::number(sz / 1024.0, 'f', 1));
-            }
-        }
-        auto* sizeItem = new QTableWidgetItem(sizeText);
+        // 大小：读取文件数据获取实际大小。各文件的读取依次排在设备执行器上，先显示占位，逐行回填
+        auto* sizeItem = new QTableWidgetItem("--");
         sizeItem->setTextAlignment(Qt::AlignCenter);
         fileTable_->setItem(i, 1, sizeItem);
+        FileService::instance().readFileAsync(devName_, appName_, files[i])
+            .then(this, [this, generation, i](const Result<QByteArray>& readResult) {
+                if (generation != fileGeneration_ || readResult.isErr() || i >= fileTable_->rowCount()) {
+                    return;
+                }
+                qint64 sz = readResult.value().size();
+                QString sizeText;
+                if (sz < 1024) {
+                    sizeText = QString("%1 B").arg(sz);
+                } else {
+                    sizeText = QString("%1 KB").arg(QString::number(sz / 1024.0, 'f', 1));
+                }
+                if (auto* item = fileTable_->item(i, 1)) {
+                    item->setText(sizeText);
+                }
+            });
 
         // 操作链接（纯文字带颜色，无按钮边框）
         auto* buttonWidget = new QWidget(this);
@@ -461,7 +481,7 @@ void AppDetailView::onCreateFile() {
     auto fileName = dialog.fileName();
     auto fileData = dialog.fileData();
 
-    qDebug() << "[onCreateFile] fileName:" << fileName << "dataSize:" << fileData.size()
+    qCDebug(lcGui) << "[onCreateFile] fileName:" << fileName << "dataSize:" << fileData.size()
              << "readRights:" << Qt::hex << dialog.readRights()
              << "writeRights:" << Qt::hex << dialog.writeRights();
 
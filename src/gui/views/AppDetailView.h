@@ -12,6 +12,8 @@
 #include <QTabWidget>
 #include <QWidget>
 
+#include "plugin/interface/PluginTypes.h"
+
 class ElaPushButton;
 class ElaText;
 
@@ -57,6 +59,10 @@ private:
     void onReadFile(const QString& fileName);
     void onDeleteFile(const QString& fileName);
 
+    // 异步结果回填
+    void fillContainers(const QList<ContainerInfo>& containers);
+    void fillFiles(const QStringList& files, quint64 generation);
+
     QString devName_;
     QString appName_;
 
@@ -70,12 +76,15 @@ private:
     QTableWidget* containerTable_ = nullptr;
     ElaPushButton* createContainerBtn_ = nullptr;
     ElaPushButton* refreshContainerBtn_ = nullptr;
-    bool refreshingContainers_ = false;
 
     // 文件 Tab
     QTableWidget* fileTable_ = nullptr;
     ElaPushButton* createFileBtn_ = nullptr;
     ElaPushButton* refreshFileBtn_ = nullptr;
+
+    /// 每次发起刷新递增，异步结果返回时据此丢弃过期的回填
+    quint64 containerGeneration_ = 0;
+    quint64 fileGeneration_ = 0;
 };
 
 }  // namespace wekey
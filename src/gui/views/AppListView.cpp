@@ -22,6 +22,7 @@
 #include <ElaRadioButton.h>
 #include <ElaText.h>
 
+#include "common/LogCategories.h"
 #include "gui/UiHelper.h"
 #include "core/application/AppService.h"
 #include "gui/dialogs/CreateAppDialog.h"
@@ -173,7 +174,7 @@ void AppListView::onCreateApp() {
 
     QString appName = dialog.appName();
     QVariantMap args = dialog.toArgs();
-    qDebug() << "[AppListView] 创建应用:" << appName << "args:" << args;
+    qCDebug(lcGui) << "[AppListView] 创建应用:" << appName << "args:" << args;
 
     auto result = AppService::instance().createApp(devName_, appName, args);
     if (!result.isOk()) {
@@ -240,11 +241,11 @@ void AppListView::onLogin(const QString& appName) {
 
     QString selectedRole = dialog.role();
     QString inputPin = dialog.pin();
-    qDebug() << "[onLogin] 尝试登录, app:" << appName << "role:" << selectedRole;
+    qCDebug(lcGui) << "[onLogin] 尝试登录, app:" << appName << "role:" << selectedRole;
 
     auto result = AppService::instance().login(devName_, appName, selectedRole, inputPin);
     if (result.isOk()) {
-        qDebug() << "[onLogin] 登录成功";
+        qCDebug(lcGui) << "[onLogin] 登录成功";
         refreshApps();
         return;
     }
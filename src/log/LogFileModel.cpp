@@ -0,0 +1,402 @@
+/**
+ * @file LogFileModel.cpp
+ * @brief 日志文件浏览模型实现
+ */
+
+#include "log/LogFileModel.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "log/LogModel.h"
+
+namespace wekey {
+
+namespace {
+
+// 每个索引块覆盖的字节数，也是进度信号和行追加的粒度
+constexpr qint64 kChunkBytes = 4 * 1024 * 1024;
+
+// 不以时间戳和级别开头的行（多行消息的后续行）
+constexpr quint8 kContinuation = 0xff;
+
+// 时间戳 "yyyy-MM-dd hh:mm:ss.zzz" 的长度
+constexpr int kTimestampLen = 23;
+
+// 解析 "yyyy-MM-dd hh:mm:ss.zzz [LEVEL] ..." 中的级别
+quint8 parseLevel(const uchar* p, qint64 len) {
+    if (len < kTimestampLen + 3 || p[4] != '-' || p[10] != ' ' || p[kTimestampLen] != ' ' ||
+        p[kTimestampLen + 1] != '[') {
+        return kContinuation;
+    }
+
+    const char* tag = reinterpret_cast<const char*>(p + kTimestampLen + 2);
+    const qint64 rest = len - (kTimestampLen + 2);
+    auto is = [&](const char* name, qint64 n) { return rest > n && std::memcmp(tag, name, n) == 0 && tag[n] == ']'; };
+    if (is("DEBUG", 5)) return static_cast<quint8>(LogLevel::Debug);
+    if (is("INFO", 4)) return static_cast<quint8>(LogLevel::Info);
+    if (is("WARN", 4)) return static_cast<quint8>(LogLevel::Warn);
+    if (is("ERROR", 5)) return static_cast<quint8>(LogLevel::Error);
+    return kContinuation;
+}
+
+}  // namespace
+
+/**
+ * @brief 行偏移索引块（生成后不再修改，可在线程间共享）
+ */
+struct LogFileModel::IndexChunk {
+    quint64 firstLine = 0;
+    std::vector<qint64> starts;  ///< 每行起始偏移
+    std::vector<quint8> levels;  ///< 每行级别，续行为 kContinuation
+    qint64 end = 0;              ///< 最后一行结束后的偏移
+};
+
+LogFileModel::LogFileModel(QObject* parent) : QAbstractTableModel(parent) {
+    // 索引和过滤各占一个线程，过滤不必等待索引完成
+    pool_.setMaxThreadCount(2);
+    pool_.setObjectName("LogFileIndex");
+}
+
+LogFileModel::~LogFileModel() {
+    close();
+}
+
+int LogFileModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(filter_.isActive() ? filteredLines_.size() : lineCount_);
+}
+
+int LogFileModel::columnCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(LogModel::Column::ColumnCount);
+}
+
+QVariant LogFileModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount() || role != Qt::DisplayRole) {
+        return {};
+    }
+
+    const quint64 line =
+        filter_.isActive() ? filteredLines_[static_cast<size_t>(index.row())] : static_cast<quint64>(index.row());
+    quint8 level = kContinuation;
+    QString text = QString::fromUtf8(lineBytes(line, &level));
+    auto column = static_cast<LogModel::Column>(index.column());
+
+    // 续行只有消息列
+    if (level == kContinuation) {
+        return column == LogModel::Column::Message ? QVariant(text) : QVariant();
+    }
+
+    // 级别之后：可选的 "[来源] "，其余为消息
+    QString rest = text.mid(text.indexOf(']', kTimestampLen) + 1);
+    if (rest.startsWith(' ')) rest = rest.mid(1);
+    QString source;
+    if (rest.startsWith('[')) {
+        int end = rest.indexOf(']');
+        if (end > 1) {
+            source = rest.mid(1, end - 1);
+            rest = rest.mid(end + 1);
+            if (rest.startsWith(' ')) rest = rest.mid(1);
+        }
+    }
+
+    switch (column) {
+        case LogModel::Column::Timestamp:
+            return text.left(kTimestampLen);
+        case LogModel::Column::Level:
+            return logLevelToString(static_cast<LogLevel>(level));
+        case LogModel::Column::Source:
+            return source.isEmpty() ? QVariant() : QVariant(source);
+        case LogModel::Column::Message:
+            return rest;
+        default:
+            return {};
+    }
+}
+
+QVariant LogFileModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+
+    switch (static_cast<LogModel::Column>(section)) {
+        case LogModel::Column::Timestamp:
+            return tr("时间");
+        case LogModel::Column::Level:
+            return tr("级别");
+        case LogModel::Column::Source:
+            return tr("来源");
+        case LogModel::Column::Message:
+            return tr("消息");
+        default:
+            return {};
+    }
+}
+
+Result<void> LogFileModel::open(const QString& path) {
+    close();
+
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        return Result<void>::err(
+            Error(Error::Fail, QString("无法打开日志文件: %1").arg(file_.errorString()), "LogFileModel::open"));
+    }
+
+    // 只映射打开时的大小；之后追加的内容需重新打开才能看到
+    size_ = file_.size();
+    if (size_ > 0) {
+        data_ = file_.map(0, size_);
+        if (!data_) {
+            QString message = file_.errorString();
+            file_.close();
+            size_ = 0;
+            return Result<void>::err(
+                Error(Error::Fail, QString("无法映射日志文件: %1").arg(message), "LogFileModel::open"));
+        }
+    }
+
+    const quint64 generation = ++openGeneration_;
+    indexing_ = size_ > 0;
+    if (indexing_) {
+        pool_.start([this, generation]() { runIndex(generation); });
+    } else {
+        emit indexFinished(0);
+    }
+    return Result<void>::ok();
+}
+
+void LogFileModel::close() {
+    ++openGeneration_;
+    ++filterGeneration_;
+    pool_.waitForDone();
+
+    beginResetModel();
+    chunks_.clear();
+    lineCount_ = 0;
+    filteredLines_.clear();
+    filterPending_ = false;
+    filterCarry_ = false;
+    indexing_ = false;
+    endResetModel();
+
+    if (data_) {
+        file_.unmap(data_);
+        data_ = nullptr;
+    }
+    if (file_.isOpen()) {
+        file_.close();
+    }
+    size_ = 0;
+}
+
+QString LogFileModel::path() const {
+    return file_.isOpen() ? file_.fileName() : QString();
+}
+
+bool LogFileModel::isIndexing() const {
+    return indexing_;
+}
+
+void LogFileModel::setFilter(const LogFileFilter& filter) {
+    LogFileFilter normalized = filter;
+    normalized.from.truncate(kTimestampLen);
+    normalized.to.truncate(kTimestampLen);
+
+    const bool wasActive = filter_.isActive();
+    filter_ = normalized;
+    if (wasActive && filter_.isActive()) {
+        startFilter();
+        return;
+    }
+
+    // 切换过滤/不过滤模式时行号映射整体改变
+    beginResetModel();
+    filteredLines_.clear();
+    filterCarry_ = false;
+    endResetModel();
+    startFilter();
+}
+
+void LogFileModel::runIndex(quint64 generation) {
+    const uchar* data = data_;
+    const qint64 size = size_;
+    qint64 pos = 0;
+    quint64 line = 0;
+
+    while (pos < size) {
+        if (openGeneration_.load(std::memory_order_relaxed) != generation) {
+            return;
+        }
+
+        auto chunk = std::make_shared<IndexChunk>();
+        chunk->firstLine = line;
+        const qint64 limit = qMin(size, pos + kChunkBytes);
+        while (pos < limit) {
+            const auto* newline =
+                static_cast<const uchar*>(std::memchr(data + pos, '\n', static_cast<size_t>(size - pos)));
+            const qint64 lineEnd = newline ? newline - data : size;
+            chunk->starts.push_back(pos);
+            chunk->levels.push_back(parseLevel(data + pos, lineEnd - pos));
+            pos = newline ? lineEnd + 1 : size;
+        }
+        chunk->end = pos;
+        line += chunk->starts.size();
+
+        std::shared_ptr<const IndexChunk> done = std::move(chunk);
+        QMetaObject::invokeMethod(
+            this, [this, generation, done]() { appendChunk(generation, done); }, Qt::QueuedConnection);
+    }
+
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation]() {
+            if (generation != openGeneration_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            indexing_ = false;
+            emit indexFinished(lineCount_);
+        },
+        Qt::QueuedConnection);
+}
+
+void LogFileModel::appendChunk(quint64 generation, const std::shared_ptr<const IndexChunk>& chunk) {
+    if (generation != openGeneration_.load(std::memory_order_relaxed) || chunk->starts.empty()) {
+        return;
+    }
+
+    chunks_.push_back(chunk);
+    const quint64 count = chunk->starts.size();
+
+    if (!filter_.isActive()) {
+        beginInsertRows({}, static_cast<int>(lineCount_), static_cast<int>(lineCount_ + count - 1));
+        lineCount_ += count;
+        endInsertRows();
+    } else {
+        lineCount_ += count;
+        // 后台过滤返回时会补齐快照之后的块
+        if (!filterPending_) {
+            std::vector<quint64> matches;
+            collectMatches(*chunk, matches);
+            if (!matches.empty()) {
+                int firstRow = static_cast<int>(filteredLines_.size());
+                beginInsertRows({}, firstRow, firstRow + static_cast<int>(matches.size()) - 1);
+                filteredLines_.insert(filteredLines_.end(), matches.begin(), matches.end());
+                endInsertRows();
+            }
+        }
+    }
+
+    emit indexProgress(chunk->end, size_);
+}
+
+void LogFileModel::startFilter() {
+    const quint64 generation = ++filterGeneration_;
+    if (!filter_.isActive()) {
+        filterPending_ = false;
+        return;
+    }
+
+    filterPending_ = true;
+    ChunkList chunks = chunks_;
+    const quint64 snapshotLines = lineCount_;
+    const LogFileFilter filter = filter_;
+    const uchar* data = data_;
+
+    pool_.start([this, generation, chunks, snapshotLines, filter, data]() {
+        std::vector<quint64> lines;
+        bool carry = false;
+        quint64 checked = 0;
+        for (const auto& chunk : chunks) {
+            for (size_t i = 0; i < chunk->starts.size(); ++i) {
+                if ((++checked & 0xfff) == 0 && filterGeneration_.load(std::memory_order_relaxed) != generation) {
+                    return;
+                }
+                if (evaluate(data, *chunk, i, filter, carry)) {
+                    lines.push_back(chunk->firstLine + i);
+                }
+            }
+        }
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, snapshotLines, carry, lines = std::move(lines)]() mutable {
+                applyFilterResult(generation, snapshotLines, carry, std::move(lines));
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void LogFileModel::applyFilterResult(quint64 generation, quint64 snapshotLines, bool carry,
+                                     std::vector<quint64> lines) {
+    if (generation != filterGeneration_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    beginResetModel();
+    filteredLines_ = std::move(lines);
+    filterCarry_ = carry;
+    filterPending_ = false;
+    // 过滤期间新到达的块在本线程补齐
+    for (const auto& chunk : chunks_) {
+        if (chunk->firstLine >= snapshotLines) {
+            collectMatches(*chunk, filteredLines_);
+        }
+    }
+    endResetModel();
+}
+
+void LogFileModel::collectMatches(const IndexChunk& chunk, std::vector<quint64>& out) {
+    for (size_t i = 0; i < chunk.starts.size(); ++i) {
+        if (evaluate(data_, chunk, i, filter_, filterCarry_)) {
+            out.push_back(chunk.firstLine + i);
+        }
+    }
+}
+
+bool LogFileModel::evaluate(const uchar* data, const IndexChunk& chunk, size_t i, const LogFileFilter& filter,
+                            bool& carry) {
+    const quint8 level = chunk.levels[i];
+    if (level == kContinuation) {
+        return carry;
+    }
+
+    // 带级别的行至少有完整时间戳，可直接按前缀比较
+    const char* timestamp = reinterpret_cast<const char*>(data + chunk.starts[i]);
+    bool pass = level >= static_cast<quint8>(filter.minLevel);
+    if (pass && !filter.from.isEmpty()) {
+        pass = std::memcmp(timestamp, filter.from.constData(), static_cast<size_t>(filter.from.size())) >= 0;
+    }
+    if (pass && !filter.to.isEmpty()) {
+        pass = std::memcmp(timestamp, filter.to.constData(), static_cast<size_t>(filter.to.size())) <= 0;
+    }
+    carry = pass;
+    return pass;
+}
+
+QByteArray LogFileModel::lineBytes(quint64 line, quint8* level) const {
+    auto it = std::upper_bound(chunks_.begin(), chunks_.end(), line,
+                               [](quint64 value, const auto& chunk) { return value < chunk->firstLine; });
+    if (it == chunks_.begin()) {
+        return {};
+    }
+    const IndexChunk& chunk = **(--it);
+    const auto i = static_cast<size_t>(line - chunk.firstLine);
+    if (i >= chunk.starts.size()) {
+        return {};
+    }
+
+    const qint64 start = chunk.starts[i];
+    qint64 end = i + 1 < chunk.starts.size() ? chunk.starts[i + 1] : chunk.end;
+    while (end > start && (data_[end - 1] == '\n' || data_[end - 1] == '\r')) {
+        --end;
+    }
+    *level = chunk.levels[i];
+    return QByteArray(reinterpret_cast<const char*>(data_ + start), end - start);
+}
+
+}  // namespace wekey
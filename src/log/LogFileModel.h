@@ -0,0 +1,142 @@
+/**
+ * @file LogFileModel.h
+ * @brief 日志文件浏览模型
+ *
+ * 以内存映射方式打开 Logger 写出的日志文件，在后台建立行偏移索引，
+ * 按需解码可见行。适合浏览上百 MB 的历史日志，不会把整个文件读入堆内存。
+ */
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QByteArray>
+#include <QFile>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/Result.h"
+#include "log/Logger.h"
+
+namespace wekey {
+
+/**
+ * @brief 日志文件过滤条件
+ *
+ * 时间范围按 "yyyy-MM-dd hh:mm:ss.zzz" 前缀比较：from/to 可以只写到小时或分钟，
+ * 如 from="2026-10-18 14" 表示 14 点之后，to="2026-10-18 15" 表示 15 点 59 分之前（含）。
+ */
+struct LogFileFilter {
+    LogLevel minLevel = LogLevel::Debug;
+    QByteArray from;  ///< 起始时间前缀，空表示不限
+    QByteArray to;    ///< 结束时间前缀（含），空表示不限
+
+    [[nodiscard]] bool isActive() const { return minLevel > LogLevel::Debug || !from.isEmpty() || !to.isEmpty(); }
+};
+
+/**
+ * @brief 日志文件浏览模型
+ *
+ * 列与 LogModel 相同。索引按块在后台生成并逐块追加为行，浏览可在索引完成前开始。
+ * 索引每行只保存起始偏移和级别；启用过滤时在后台线程扫描索引和映射内存得到行号列表。
+ * 不带时间戳的行（多行消息的后续行）随前一行一起显示或隐藏。
+ */
+class LogFileModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit LogFileModel(QObject* parent = nullptr);
+    ~LogFileModel() override;
+
+    // QAbstractTableModel 接口
+    int rowCount(const QModelIndex& parent = {}) const override;
+    int columnCount(const QModelIndex& parent = {}) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief 打开日志文件并开始后台索引（会先关闭当前文件）
+     * @param path 文件路径
+     */
+    Result<void> open(const QString& path);
+
+    /**
+     * @brief 关闭文件，取消后台任务并解除映射
+     */
+    void close();
+
+    /**
+     * @brief 当前文件路径，未打开时为空
+     */
+    [[nodiscard]] QString path() const;
+
+    /**
+     * @brief 后台索引是否仍在进行
+     */
+    [[nodiscard]] bool isIndexing() const;
+
+    /**
+     * @brief 设置过滤条件（在后台线程重新过滤）
+     */
+    void setFilter(const LogFileFilter& filter);
+
+signals:
+    /**
+     * @brief 索引进度
+     * @param indexedBytes 已索引字节数
+     * @param totalBytes 文件总字节数（打开时的大小）
+     */
+    void indexProgress(qint64 indexedBytes, qint64 totalBytes);
+
+    /**
+     * @brief 索引完成
+     * @param lineCount 总行数
+     */
+    void indexFinished(quint64 lineCount);
+
+private:
+    struct IndexChunk;
+    using ChunkList = std::vector<std::shared_ptr<const IndexChunk>>;
+
+    void runIndex(quint64 generation);
+    void appendChunk(quint64 generation, const std::shared_ptr<const IndexChunk>& chunk);
+    void startFilter();
+    void applyFilterResult(quint64 generation, quint64 snapshotLines, bool carry, std::vector<quint64> lines);
+
+    /**
+     * @brief 在本线程按 filter_ 过滤一个块，通过的行号追加到 out
+     */
+    void collectMatches(const IndexChunk& chunk, std::vector<quint64>& out);
+
+    /**
+     * @brief 判断块内第 i 行是否通过过滤（carry 为上一行的结果，续行沿用）
+     */
+    static bool evaluate(const uchar* data, const IndexChunk& chunk, size_t i, const LogFileFilter& filter,
+                         bool& carry);
+
+    /**
+     * @brief 取第 line 行的原始字节（不含行尾换行）
+     */
+    [[nodiscard]] QByteArray lineBytes(quint64 line, quint8* level) const;
+
+    QFile file_;
+    uchar* data_ = nullptr;  ///< 映射基址，后台任务运行期间保持有效
+    qint64 size_ = 0;        ///< 打开时的文件大小
+
+    ChunkList chunks_;
+    quint64 lineCount_ = 0;
+    bool indexing_ = false;
+
+    LogFileFilter filter_;
+    std::vector<quint64> filteredLines_;  ///< 过滤模式下可见行的行号
+    bool filterPending_ = false;          ///< 后台过滤尚未返回，新块暂不追加行
+    bool filterCarry_ = false;            ///< 最后一行的过滤结果，供下一块的续行沿用
+
+    QThreadPool pool_;
+    std::atomic<quint64> openGeneration_{0};
+    std::atomic<quint64> filterGeneration_{0};
+};
+
+}  // namespace wekey
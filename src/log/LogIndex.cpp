@@ -0,0 +1,110 @@
+/**
+ * @file LogIndex.cpp
+ * @brief 日志三元组倒排索引实现
+ */
+
+#include "log/LogIndex.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace wekey {
+
+namespace {
+
+// 每淘汰这么多条目压缩一次倒排表，均摊到每条日志为常数开销
+constexpr quint64 kCompactStride = 4096;
+
+}  // namespace
+
+void LogIndex::collectKeys(const QString& folded, std::vector<quint64>& keys) {
+    for (qsizetype i = 0; i + 2 < folded.size(); ++i) {
+        keys.push_back((static_cast<quint64>(folded.at(i).unicode()) << 32) |
+                       (static_cast<quint64>(folded.at(i + 1).unicode()) << 16) |
+                       static_cast<quint64>(folded.at(i + 2).unicode()));
+    }
+}
+
+void LogIndex::add(quint64 seq, const LogEntry& entry) {
+    std::vector<quint64> keys;
+    keys.reserve(static_cast<size_t>(entry.message.size() + entry.source.size()));
+    // 与 QString::contains(Qt::CaseInsensitive) 一致，使用大小写折叠
+    collectKeys(entry.message.toCaseFolded(), keys);
+    collectKeys(entry.source.toCaseFolded(), keys);
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (quint64 key : keys) {
+        postings_[key].push_back(seq);
+    }
+}
+
+void LogIndex::evictBefore(quint64 firstSeq) {
+    if (firstSeq - compactedBefore_ < kCompactStride) {
+        return;
+    }
+
+    for (auto it = postings_.begin(); it != postings_.end();) {
+        Postings& list = it->second;
+        list.erase(list.begin(), std::lower_bound(list.begin(), list.end(), firstSeq));
+        if (list.empty()) {
+            it = postings_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    compactedBefore_ = firstSeq;
+}
+
+void LogIndex::clear() {
+    postings_.clear();
+    compactedBefore_ = 0;
+}
+
+std::optional<std::vector<LogIndex::Postings>> LogIndex::lookup(const QString& text) const {
+    std::vector<quint64> keys;
+    collectKeys(text.toCaseFolded(), keys);
+    if (keys.empty()) {
+        return std::nullopt;
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<Postings> lists;
+    lists.reserve(keys.size());
+    for (quint64 key : keys) {
+        auto it = postings_.find(key);
+        if (it == postings_.end()) {
+            return std::vector<Postings>{Postings()};
+        }
+        lists.push_back(it->second);
+    }
+    return lists;
+}
+
+LogIndex::Postings LogIndex::intersect(std::vector<Postings> lists, quint64 from, quint64 to) {
+    if (lists.empty()) {
+        return {};
+    }
+
+    // 从最短的表开始，结果只会越来越小
+    std::sort(lists.begin(), lists.end(),
+              [](const Postings& a, const Postings& b) { return a.size() < b.size(); });
+
+    Postings result;
+    const Postings& first = lists.front();
+    for (auto it = std::lower_bound(first.begin(), first.end(), from); it != first.end() && *it < to; ++it) {
+        result.push_back(*it);
+    }
+
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        Postings next;
+        std::set_intersection(result.begin(), result.end(), lists[i].begin(), lists[i].end(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+    return result;
+}
+
+}  // namespace wekey
@@ -0,0 +1,66 @@
+/**
+ * @file LogIndex.h
+ * @brief 日志三元组倒排索引
+ *
+ * 为 LogModel 中保存的条目建立 trigram -> 序号 的倒排表，子串搜索时只需验证
+ * 同时包含查询全部三元组的候选条目。索引只在模型所在线程访问。
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "log/Logger.h"
+
+namespace wekey {
+
+/**
+ * @brief 日志三元组倒排索引
+ *
+ * 键为大小写折叠后的连续三个字符，倒排表中的序号严格递增。
+ * 淘汰的序号不会立即删除，而是每淘汰一定数量后统一压缩。
+ */
+class LogIndex {
+public:
+    using Postings = std::vector<quint64>;
+
+    /**
+     * @brief 索引一条新条目（序号必须大于之前加入的所有序号）
+     */
+    void add(quint64 seq, const LogEntry& entry);
+
+    /**
+     * @brief 通知最旧的有效序号，必要时压缩倒排表
+     */
+    void evictBefore(quint64 firstSeq);
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+    /**
+     * @brief 取出查询文本各三元组的倒排表副本
+     * @param text 查询文本（子串语义）
+     * @return 查询不足三个字符时无法使用索引，返回 std::nullopt；
+     *         某个三元组不存在时返回的列表中包含一个空表
+     */
+    [[nodiscard]] std::optional<std::vector<Postings>> lookup(const QString& text) const;
+
+    /**
+     * @brief 求多个倒排表的交集，只保留 [from, to) 内的序号
+     */
+    static Postings intersect(std::vector<Postings> lists, quint64 from, quint64 to);
+
+private:
+    static void collectKeys(const QString& folded, std::vector<quint64>& keys);
+
+    std::unordered_map<quint64, Postings> postings_;
+    quint64 compactedBefore_{0};  ///< 上次压缩时的最旧序号
+};
+
+}  // namespace wekey
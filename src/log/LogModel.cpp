@@ -5,15 +5,112 @@
 
 #include "log/LogModel.h"
 
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
+#include <iterator>
+
+#include "config/Defaults.h"
+
 namespace wekey {
 
-LogModel::LogModel(QObject* parent) : QAbstractTableModel(parent), filterLevel_(LogLevel::Debug) {}
+namespace {
+
+// source 有值时直接用；为空时尝试从消息 [xxx] 前缀解析
+QString displaySource(const LogEntry& entry) {
+    if (!entry.source.isEmpty()) return entry.source;
+    if (entry.message.startsWith('[')) {
+        int end = entry.message.indexOf(']');
+        if (end > 1) return entry.message.mid(1, end - 1);
+    }
+    return {};
+}
+
+}  // namespace
+
+void LogFilter::compile() {
+    pattern = regex ? QRegularExpression(text, QRegularExpression::CaseInsensitiveOption) : QRegularExpression();
+}
+
+bool LogFilter::matches(const LogEntry& entry) const {
+    // 级别过滤
+    if (entry.level < minLevel) {
+        return false;
+    }
+
+    // 来源过滤
+    if (!source.isEmpty() && !displaySource(entry).contains(source, Qt::CaseInsensitive)) {
+        return false;
+    }
+
+    // 搜索文本过滤
+    if (text.isEmpty()) {
+        return true;
+    }
+    if (regex) {
+        return pattern.isValid() && (pattern.match(entry.message).hasMatch() || pattern.match(entry.source).hasMatch());
+    }
+    return entry.message.contains(text, Qt::CaseInsensitive) || entry.source.contains(text, Qt::CaseInsensitive);
+}
+
+/**
+ * @brief 后台过滤任务
+ *
+ * entries 是启动时 [from, to) 范围内条目的快照（QString 隐式共享，复制开销很小）。
+ */
+struct LogModel::SearchJob {
+    quint64 generation = 0;
+    LogFilter filter;
+    quint64 from = 0;
+    quint64 to = 0;
+    std::vector<LogEntry> entries;
+    std::optional<std::vector<LogIndex::Postings>> postings;  ///< 无法使用索引时为空
+};
+
+/**
+ * @brief 跨线程暂存区
+ *
+ * 由发出日志的线程写入，模型所在线程取走。target 在模型析构时置空，
+ * 此后仍在途的回调只会访问暂存区本身。
+ */
+struct LogModel::Staging {
+    QMutex mutex;
+    std::deque<LogEntry> pending;
+    LogModel* target = nullptr;
+    bool scheduled = false;  ///< 已安排刷新，后续日志只需追加
+};
+
+LogModel::LogModel(QObject* parent)
+    : QAbstractTableModel(parent), staging_(std::make_shared<Staging>()) {
+    ring_.resize(static_cast<size_t>(maxEntries_));
+
+    // 单次定时器：第一条暂存日志到达时启动，到期后一次性刷新这段时间内的全部日志
+    flushTimer_.setSingleShot(true);
+    flushTimer_.setInterval(defaults::LOG_GUI_FLUSH_INTERVAL_MS);
+    connect(&flushTimer_, &QTimer::timeout, this, &LogModel::flushStaged);
+
+    searchDebounce_.setSingleShot(true);
+    searchDebounce_.setInterval(defaults::LOG_SEARCH_DEBOUNCE_MS);
+    connect(&searchDebounce_, &QTimer::timeout, this, &LogModel::startSearch);
+
+    // 单线程即可：新查询会使旧查询尽快退出
+    searchPool_.setMaxThreadCount(1);
+    searchPool_.setObjectName("LogSearch");
+}
+
+LogModel::~LogModel() {
+    ++searchGeneration_;
+    searchPool_.waitForDone();
+    disconnect(loggerConnection_);
+    QMutexLocker locker(&staging_->mutex);
+    staging_->target = nullptr;
+}
 
 int LogModel::rowCount(const QModelIndex& parent) const {
     if (parent.isValid()) {
         return 0;
     }
-    return filteredIndices_.size();
+    return static_cast<int>(filteredSeqs_.size());
 }
 
 int LogModel::columnCount(const QModelIndex& parent) const {
@@ -24,7 +121,7 @@ int LogModel::columnCount(const QModelIndex& parent) const {
 }
 
 QVariant LogModel::data(const QModelIndex& index, int role) const {
-    if (!index.isValid() || index.row() >= filteredIndices_.size()) {
+    if (!index.isValid() || index.row() >= static_cast<int>(filteredSeqs_.size())) {
         return {};
     }
 
@@ -32,8 +129,7 @@ QVariant LogModel::data(const QModelIndex& index, int role) const {
         return {};
     }
 
-    int realIndex = filteredIndices_.at(index.row());
-    const LogEntry& entry = entries_.at(realIndex);
+    const LogEntry& entry = entryAt(filteredSeqs_[static_cast<size_t>(index.row())]);
 
     switch (static_cast<Column>(index.column())) {
         case Column::Timestamp:
@@ -41,13 +137,8 @@ QVariant LogModel::data(const QModelIndex& index, int role) const {
         case Column::Level:
             return logLevelToString(entry.level);
         case Column::Source: {
-            // source 有值时直接用；为空时尝试从消息 [xxx] 前缀解析
-            if (!entry.source.isEmpty()) return entry.source;
-            if (entry.message.startsWith('[')) {
-                int end = entry.message.indexOf(']');
-                if (end > 1) return entry.message.mid(1, end - 1);
-            }
-            return {};
+            QString source = displaySource(entry);
+            return source.isEmpty() ? QVariant() : QVariant(source);
         }
         case Column::Message: {
             // source 为空且消息有 [xxx] 前缀时，消息列去掉该前缀
@@ -86,103 +177,259 @@ QVariant LogModel::headerData(int section, Qt::Orientation orientation, int role
 }
 
 void LogModel::addEntry(const LogEntry& entry) {
-    // 检查是否超过最大条目数
-    while (entries_.size() >= maxEntries_) {
-        // 删除最旧的条目
-        entries_.removeFirst();
+    addEntries({entry});
+}
+
+void LogModel::addEntries(std::vector<LogEntry> entries) {
+    if (entries.empty()) {
+        return;
+    }
+
+    // 超出容量的部分加入后也会立即被淘汰，直接跳过
+    const size_t capacity = ring_.size();
+    const size_t skip = entries.size() > capacity ? entries.size() - capacity : 0;
+    const quint64 incoming = entries.size() - skip;
+
+    // 淘汰最旧的条目，其中可见的部分恰好是过滤结果的前若干行
+    const quint64 used = nextSeq_ - firstSeq_;
+    if (used + incoming > capacity) {
+        const quint64 newFirst = firstSeq_ + (used + incoming - capacity);
+        size_t removeRows = 0;
+        while (removeRows < filteredSeqs_.size() && filteredSeqs_[removeRows] < newFirst) {
+            ++removeRows;
+        }
+        if (removeRows > 0) {
+            beginRemoveRows({}, 0, static_cast<int>(removeRows) - 1);
+            filteredSeqs_.erase(filteredSeqs_.begin(), filteredSeqs_.begin() + static_cast<std::ptrdiff_t>(removeRows));
+            endRemoveRows();
+        }
+        for (quint64 seq = firstSeq_; seq < newFirst; ++seq) {
+            ring_[static_cast<size_t>(seq % capacity)] = LogEntry();
+        }
+        firstSeq_ = newFirst;
+        index_.evictBefore(firstSeq_);
     }
 
-    // 添加新条目
-    entries_.append(entry);
+    // 写入新条目，通过过滤的部分作为一段连续行插入
+    std::vector<quint64> accepted;
+    accepted.reserve(static_cast<size_t>(incoming));
+    for (size_t i = skip; i < entries.size(); ++i) {
+        const quint64 seq = nextSeq_++;
+        LogEntry& slot = ring_[static_cast<size_t>(seq % capacity)];
+        slot = std::move(entries[i]);
+        index_.add(seq, slot);
+        if (passesFilter(slot)) {
+            accepted.push_back(seq);
+        }
+    }
 
-    // 检查是否通过过滤
-    if (passesFilter(entry)) {
-        int newRow = filteredIndices_.size();
-        beginInsertRows({}, newRow, newRow);
-        filteredIndices_.append(entries_.size() - 1);
+    if (!accepted.empty()) {
+        int firstRow = static_cast<int>(filteredSeqs_.size());
+        beginInsertRows({}, firstRow, firstRow + static_cast<int>(accepted.size()) - 1);
+        filteredSeqs_.insert(filteredSeqs_.end(), accepted.begin(), accepted.end());
         endInsertRows();
     }
+}
 
-    // 如果删除了旧条目，需要更新过滤索引
-    if (entries_.size() == maxEntries_) {
-        rebuildFilteredIndices();
+void LogModel::flushStaged() {
+    std::deque<LogEntry> pending;
+    {
+        QMutexLocker locker(&staging_->mutex);
+        pending.swap(staging_->pending);
+        staging_->scheduled = false;
     }
+    addEntries(std::vector<LogEntry>(std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end())));
 }
 
 void LogModel::clear() {
     beginResetModel();
-    entries_.clear();
-    filteredIndices_.clear();
+    std::fill(ring_.begin(), ring_.end(), LogEntry());
+    firstSeq_ = nextSeq_;
+    filteredSeqs_.clear();
+    index_.clear();
     endResetModel();
 }
 
 void LogModel::setMaxEntries(int max) {
-    maxEntries_ = max;
+    max = qMax(1, max);
+    if (max == maxEntries_) {
+        return;
+    }
 
-    // 如果当前条目超过新限制，删除旧条目
-    while (entries_.size() > maxEntries_) {
-        entries_.removeFirst();
+    // 保留最新的 max 条，按序号重新排布到新缓冲区
+    std::vector<LogEntry> resized(static_cast<size_t>(max));
+    const auto capacity = static_cast<quint64>(max);
+    const quint64 keepFrom = qMax(firstSeq_, nextSeq_ >= capacity ? nextSeq_ - capacity : quint64{0});
+    for (quint64 seq = keepFrom; seq < nextSeq_; ++seq) {
+        resized[static_cast<size_t>(seq % resized.size())] = std::move(ring_[static_cast<size_t>(seq % ring_.size())]);
     }
 
+    ring_ = std::move(resized);
+    firstSeq_ = keepFrom;
+    maxEntries_ = max;
+
     rebuildFilteredIndices();
 }
 
 void LogModel::setFilterLevel(LogLevel level) {
-    if (filterLevel_ == level) {
+    if (pendingFilter_.minLevel == level) {
         return;
     }
 
-    filterLevel_ = level;
-    rebuildFilteredIndices();
+    pendingFilter_.minLevel = level;
+    startSearch();
 }
 
 void LogModel::setSearchText(const QString& text) {
-    if (searchText_ == text) {
+    if (pendingFilter_.text == text) {
         return;
     }
 
-    searchText_ = text;
-    rebuildFilteredIndices();
+    pendingFilter_.text = text;
+    searchDebounce_.start();
 }
 
-void LogModel::connectToLogger() {
-    connect(&Logger::instance(), &Logger::logAdded, this, &LogModel::addEntry);
+void LogModel::setRegexEnabled(bool enabled) {
+    if (pendingFilter_.regex == enabled) {
+        return;
+    }
+
+    pendingFilter_.regex = enabled;
+    startSearch();
 }
 
-const LogEntry& LogModel::entry(int row) const {
-    int realIndex = filteredIndices_.at(row);
-    return entries_.at(realIndex);
+void LogModel::setSourceFilter(const QString& source) {
+    if (pendingFilter_.source == source) {
+        return;
+    }
+
+    pendingFilter_.source = source;
+    searchDebounce_.start();
 }
 
-void LogModel::rebuildFilteredIndices() {
-    beginResetModel();
-    filteredIndices_.clear();
+void LogModel::startSearch() {
+    searchDebounce_.stop();
+
+    // 新条件立即用于增量过滤，存量条目交给后台任务
+    filter_ = pendingFilter_;
+    filter_.compile();
+
+    auto job = std::make_shared<SearchJob>();
+    job->generation = ++searchGeneration_;
+    job->filter = filter_;
+    job->from = firstSeq_;
+    job->to = nextSeq_;
+    job->entries.reserve(static_cast<size_t>(nextSeq_ - firstSeq_));
+    for (quint64 seq = firstSeq_; seq < nextSeq_; ++seq) {
+        job->entries.push_back(entryAt(seq));
+    }
+    if (!filter_.regex && !filter_.text.isEmpty()) {
+        job->postings = index_.lookup(filter_.text);
+    }
+
+    searchPool_.start([this, job]() { runSearch(job); });
+}
+
+void LogModel::runSearch(const std::shared_ptr<SearchJob>& job) {
+    std::vector<quint64> matches;
+    auto stale = [this, &job]() { return searchGeneration_.load(std::memory_order_relaxed) != job->generation; };
+    auto check = [&](quint64 seq) {
+        if (job->filter.matches(job->entries[static_cast<size_t>(seq - job->from)])) {
+            matches.push_back(seq);
+        }
+    };
 
-    for (int i = 0; i < entries_.size(); ++i) {
-        if (passesFilter(entries_.at(i))) {
-            filteredIndices_.append(i);
+    if (job->postings) {
+        LogIndex::Postings candidates = LogIndex::intersect(std::move(*job->postings), job->from, job->to);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if ((i & 0xff) == 0 && stale()) return;
+            check(candidates[i]);
+        }
+    } else {
+        for (quint64 seq = job->from; seq < job->to; ++seq) {
+            if (((seq - job->from) & 0xff) == 0 && stale()) return;
+            check(seq);
         }
     }
 
+    if (stale()) {
+        return;
+    }
+    QMetaObject::invokeMethod(
+        this, [this, job, matches = std::move(matches)]() mutable { applySearchResult(job, std::move(matches)); },
+        Qt::QueuedConnection);
+}
+
+void LogModel::applySearchResult(const std::shared_ptr<SearchJob>& job, std::vector<quint64> matches) {
+    if (job->generation != searchGeneration_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    beginResetModel();
+    filteredSeqs_.clear();
+    // 搜索期间可能有条目被淘汰或新增：丢弃已淘汰的结果，新增部分按当前条件补齐
+    for (quint64 seq : matches) {
+        if (seq >= firstSeq_) {
+            filteredSeqs_.push_back(seq);
+        }
+    }
+    for (quint64 seq = qMax(job->to, firstSeq_); seq < nextSeq_; ++seq) {
+        if (passesFilter(entryAt(seq))) {
+            filteredSeqs_.push_back(seq);
+        }
+    }
     endResetModel();
 }
 
-bool LogModel::passesFilter(const LogEntry& entry) const {
-    // 级别过滤
-    if (entry.level < filterLevel_) {
-        return false;
+void LogModel::connectToLogger() {
+    if (loggerConnection_) {
+        return;
     }
 
-    // 搜索文本过滤
-    if (!searchText_.isEmpty()) {
-        bool found = entry.message.contains(searchText_, Qt::CaseInsensitive) ||
-                     entry.source.contains(searchText_, Qt::CaseInsensitive);
-        if (!found) {
-            return false;
+    {
+        QMutexLocker locker(&staging_->mutex);
+        staging_->target = this;
+    }
+
+    // 直接连接：在发出日志的线程写入暂存区，每个刷新周期只向本线程投递一次事件
+    auto staging = staging_;
+    loggerConnection_ = connect(&Logger::instance(), &Logger::logAdded, [staging](const LogEntry& entry) {
+        QMutexLocker locker(&staging->mutex);
+        if (!staging->target) {
+            return;
+        }
+        if (static_cast<int>(staging->pending.size()) >= defaults::LOG_GUI_MAX_BACKLOG) {
+            staging->pending.pop_front();
+        }
+        staging->pending.push_back(entry);
+
+        if (!staging->scheduled) {
+            staging->scheduled = true;
+            LogModel* target = staging->target;
+            QMetaObject::invokeMethod(target, [target]() { target->flushTimer_.start(); }, Qt::QueuedConnection);
+        }
+    });
+}
+
+const LogEntry& LogModel::entry(int row) const {
+    return entryAt(filteredSeqs_.at(static_cast<size_t>(row)));
+}
+
+void LogModel::rebuildFilteredIndices() {
+    beginResetModel();
+    filteredSeqs_.clear();
+
+    for (quint64 seq = firstSeq_; seq < nextSeq_; ++seq) {
+        if (passesFilter(entryAt(seq))) {
+            filteredSeqs_.push_back(seq);
         }
     }
 
-    return true;
+    endResetModel();
+}
+
+bool LogModel::passesFilter(const LogEntry& entry) const {
+    return filter_.matches(entry);
 }
 
 }  // namespace wekey
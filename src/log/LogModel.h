@@ -8,16 +8,55 @@
 #pragma once
 
 #include <QAbstractTableModel>
-#include <QList>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QTimer>
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "log/LogIndex.h"
 #include "log/Logger.h"
 
 namespace wekey {
 
+/**
+ * @brief 日志过滤条件（级别 + 来源 + 文本/正则，条件之间为“与”）
+ */
+struct LogFilter {
+    LogLevel minLevel = LogLevel::Debug;
+    QString source;              ///< 来源包含该文本（不区分大小写），空表示不限
+    QString text;                ///< 消息或来源包含该文本，空表示不限
+    bool regex = false;          ///< text 按正则表达式匹配
+    QRegularExpression pattern;  ///< regex 为 true 时由 compile() 生成
+
+    /**
+     * @brief 编译正则表达式（regex 为 false 时无操作）
+     */
+    void compile();
+
+    /**
+     * @brief 条目是否满足条件（可在任意线程调用）
+     */
+    [[nodiscard]] bool matches(const LogEntry& entry) const;
+};
+
 /**
  * @brief 日志数据模型
  *
- * 将日志条目以表格形式呈现，支持过滤和搜索功能
+ * 将日志条目以表格形式呈现，支持过滤和搜索功能。
+ *
+ * 条目保存在固定容量的环形缓冲区中，每条日志分配递增序号，位于 ring_[seq % 容量]。
+ * 过滤结果按序号升序保存；新增和淘汰只影响两端，各用一次 beginInsertRows / beginRemoveRows，
+ * 单条日志的开销与已保存条目数无关。只有修改过滤条件或容量时才整体重建。
+ *
+ * connectToLogger() 之后，日志在发出线程写入线程安全的暂存区，
+ * 由本对象所在线程按固定间隔一次性批量插入，避免每条日志一个跨线程事件。
+ *
+ * 修改过滤条件时，全量重新过滤在后台线程执行：文本输入经过防抖，新查询使旧查询作废；
+ * 子串查询先用三元组索引缩小候选范围，再逐条验证。
  */
 class LogModel : public QAbstractTableModel {
     Q_OBJECT
@@ -33,6 +72,7 @@ public:
      * @param parent 父对象
      */
     explicit LogModel(QObject* parent = nullptr);
+    ~LogModel() override;
 
     // QAbstractTableModel 接口
     int rowCount(const QModelIndex& parent = {}) const override;
@@ -46,6 +86,12 @@ public:
      */
     void addEntry(const LogEntry& entry);
 
+    /**
+     * @brief 批量添加日志条目（一次移除、一次插入）
+     * @param entries 按时间顺序排列的日志条目
+     */
+    void addEntries(std::vector<LogEntry> entries);
+
     /**
      * @brief 清空所有日志
      */
@@ -58,21 +104,34 @@ public:
     void setMaxEntries(int max);
 
     /**
-     * @brief 设置日志级别过滤器
+     * @brief 设置日志级别过滤器（立即开始后台过滤）
      * @param level 最低显示级别
      */
     void setFilterLevel(LogLevel level);
 
     /**
-     * @brief 设置搜索文本过滤器
+     * @brief 设置搜索文本过滤器（防抖后开始后台过滤）
      * @param text 搜索文本，空字符串表示不过滤
      */
     void setSearchText(const QString& text);
 
+    /**
+     * @brief 搜索文本是否按正则表达式匹配（立即开始后台过滤）
+     *
+     * 无效的正则表达式不匹配任何条目。
+     */
+    void setRegexEnabled(bool enabled);
+
+    /**
+     * @brief 设置来源过滤器（防抖后开始后台过滤）
+     * @param source 来源包含的文本，空字符串表示不过滤
+     */
+    void setSourceFilter(const QString& source);
+
     /**
      * @brief 连接到 Logger 单例
      *
-     * 自动接收 Logger 发出的日志
+     * 自动接收 Logger 发出的日志，每 LOG_GUI_FLUSH_INTERVAL_MS 最多刷新一次
      */
     void connectToLogger();
 
@@ -84,11 +143,39 @@ public:
     const LogEntry& entry(int row) const;
 
 private:
+    struct Staging;
+    struct SearchJob;
+
+    /**
+     * @brief 以 pendingFilter_ 为新条件，在后台线程重新过滤全部条目
+     */
+    void startSearch();
+
+    /**
+     * @brief 后台线程执行过滤
+     */
+    void runSearch(const std::shared_ptr<SearchJob>& job);
+
+    /**
+     * @brief 应用后台过滤结果（作废的结果直接丢弃）
+     */
+    void applySearchResult(const std::shared_ptr<SearchJob>& job, std::vector<quint64> matches);
+
+    /**
+     * @brief 将暂存区中的日志批量加入模型
+     */
+    void flushStaged();
+
     /**
      * @brief 重建过滤后的索引列表
      */
     void rebuildFilteredIndices();
 
+    /**
+     * @brief 按序号取条目（序号必须仍在缓冲区内）
+     */
+    const LogEntry& entryAt(quint64 seq) const { return ring_[static_cast<size_t>(seq % ring_.size())]; }
+
     /**
      * @brief 检查条目是否通过过滤
      * @param entry 日志条目
@@ -96,11 +183,22 @@ private:
      */
     bool passesFilter(const LogEntry& entry) const;
 
-    QList<LogEntry> entries_;
-    QList<int> filteredIndices_;
+    std::vector<LogEntry> ring_;          ///< 环形缓冲区，大小即 maxEntries_
+    quint64 firstSeq_{0};                 ///< 最旧条目的序号
+    quint64 nextSeq_{0};                  ///< 下一条目的序号
+    std::deque<quint64> filteredSeqs_;    ///< 通过过滤的条目序号（升序），下标即行号
     int maxEntries_{10000};
-    LogLevel filterLevel_{LogLevel::Debug};
-    QString searchText_;
+
+    LogFilter filter_;         ///< 当前生效的条件，新增条目按它增量过滤
+    LogFilter pendingFilter_;  ///< 界面输入的条件，防抖后生效
+    LogIndex index_;
+    QTimer searchDebounce_;
+    QThreadPool searchPool_;
+    std::atomic<quint64> searchGeneration_{0};  ///< 每次新查询递增，后台任务据此判断是否作废
+
+    std::shared_ptr<Staging> staging_;  ///< 与 Logger 连接共享，模型析构后仍可安全访问
+    QMetaObject::Connection loggerConnection_;
+    QTimer flushTimer_;
 };
 
 }  // namespace wekey
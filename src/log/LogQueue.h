@@ -0,0 +1,105 @@
+/**
+ * @file LogQueue.h
+ * @brief 有界多生产者单消费者日志队列
+ *
+ * 基于序号槽位的环形缓冲区（Vyukov bounded queue）：生产者只做一次 CAS
+ * 抢占槽位，不加锁；唯一的消费者是 Logger 的写线程。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "log/Logger.h"
+
+namespace wekey {
+
+/**
+ * @brief 有界 MPSC 日志队列
+ *
+ * tryPush() 可在任意线程调用；tryPop() 只能由单一消费者线程调用。
+ */
+class LogQueue {
+public:
+    /**
+     * @param capacity 容量，必须是 2 的幂
+     */
+    explicit LogQueue(size_t capacity) : mask_(capacity - 1), cells_(new Cell[capacity]) {
+        Q_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+        for (size_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    /**
+     * @brief 入队
+     * @return 队列已满返回 false，entry 保持不变
+     */
+    bool tryPush(LogEntry& entry) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->entry = std::move(entry);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队（仅消费者线程）
+     * @return 队列为空返回 false
+     */
+    bool tryPop(LogEntry& out) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell = &cells_[pos & mask_];
+        if (cell->sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        out = std::move(cell->entry);
+        cell->entry = LogEntry();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 当前占用（近似值，仅用于溢出策略）
+     */
+    [[nodiscard]] size_t approxSize() const {
+        size_t head = dequeuePos_.load(std::memory_order_relaxed);
+        size_t tail = enqueuePos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogEntry entry;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+};
+
+}  // namespace wekey
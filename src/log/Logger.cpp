@@ -5,11 +5,18 @@
 
 #include "log/Logger.h"
 
+#include <QDeadlineTimer>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
 #include <QMutexLocker>
-#include <QTextStream>
+#include <algorithm>
 #include <cstdio>
 
+#include "common/Metrics.h"
+#include "config/Defaults.h"
+#include "log/LogQueue.h"
+
 namespace wekey {
 
 QString logLevelToString(LogLevel level) {
@@ -45,43 +52,87 @@ Logger& Logger::instance() {
     return instance;
 }
 
-Logger::Logger() : QObject(nullptr), level_(LogLevel::Debug) {
+Logger::Logger()
+    : QObject(nullptr), queue_(std::make_unique<LogQueue>(defaults::LOG_QUEUE_CAPACITY)) {
     qRegisterMetaType<LogEntry>("LogEntry");
+    // 先构造 Metrics，保证其析构晚于 Logger（析构时写线程仍会记录指标）
+    Metrics::instance();
+
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread(&Logger::writerLoop, this);
 }
 
 Logger::~Logger() {
+    shutdown();
     if (file_.isOpen()) {
         file_.close();
     }
 }
 
 void Logger::setLevel(LogLevel level) {
-    level_ = level;
+    level_.store(level, std::memory_order_relaxed);
+    applyCategoryFilter();
 }
 
 LogLevel Logger::level() const {
-    return level_;
+    return level_.load(std::memory_order_relaxed);
 }
 
-void Logger::setOutputPath(const QString& path) {
-    QMutexLocker locker(&mutex_);
-
-    if (file_.isOpen()) {
-        file_.close();
+void Logger::setCategoryRules(const QString& rules) {
+    {
+        QMutexLocker locker(&mutex_);
+        categoryRules_ = rules;
+        categoryRules_.replace(';', '\n');
     }
+    applyCategoryFilter();
+}
 
-    if (path.isEmpty()) {
-        return;
+void Logger::applyCategoryFilter() {
+    // 全局级别转换为分类规则：被关闭的级别在 qCDebug 等宏处直接跳过，不再格式化后经消息处理器丢弃。
+    // 消息处理器因此不再按级别过滤，附加规则可以覆盖这里的任意一条
+    const LogLevel level = level_.load(std::memory_order_relaxed);
+    QString rules = level <= LogLevel::Debug ? QString("default.debug=true\nwekey.*.debug=true")
+                                             : QString("*.debug=false");
+    if (level > LogLevel::Info) {
+        rules += "\n*.info=false";
+    }
+    if (level > LogLevel::Warn) {
+        rules += "\n*.warning=false";
     }
+    {
+        QMutexLocker locker(&mutex_);
+        if (!categoryRules_.isEmpty()) {
+            rules += '\n' + categoryRules_;
+        }
+    }
+    QLoggingCategory::setFilterRules(rules);
+}
+
+void Logger::setOutputPath(const QString& path) {
+    bool opened = true;
+    {
+        QMutexLocker locker(&mutex_);
+
+        if (file_.isOpen()) {
+            file_.close();
+        }
 
-    // 确保目录存在
-    QDir dir = QFileInfo(path).absoluteDir();
-    if (!dir.exists()) {
-        dir.mkpath(".");
+        if (path.isEmpty()) {
+            return;
+        }
+
+        // 确保目录存在
+        QDir dir = QFileInfo(path).absoluteDir();
+        if (!dir.exists()) {
+            dir.mkpath(".");
+        }
+
+        file_.setFileName(path);
+        opened = file_.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
     }
 
-    file_.setFileName(path);
-    if (!file_.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+    // 锁外告警：qWarning 可能经消息处理器重新进入 Logger
+    if (!opened) {
         qWarning("Logger: Failed to open log file: %s", qPrintable(path));
     }
 }
@@ -102,11 +153,18 @@ void Logger::error(const QString& message, const QString& source) {
     log(LogLevel::Error, message, source);
 }
 
+void Logger::logFiltered(LogLevel level, const QString& message, const QString& source) {
+    append(level, message, source);
+}
+
 void Logger::log(LogLevel level, const QString& message, const QString& source) {
-    if (level < level_) {
+    if (level < level_.load(std::memory_order_relaxed)) {
         return;
     }
+    append(level, message, source);
+}
 
+void Logger::append(LogLevel level, const QString& message, const QString& source) {
     // 递归保护：避免 qtMessageHandler → Logger::log → qDebug → qtMessageHandler 死循环
     thread_local bool inLog = false;
     if (inLog) return;
@@ -118,49 +176,219 @@ void Logger::log(LogLevel level, const QString& message, const QString& source)
     entry.message = message;
     entry.source = source;
 
-    // 直接用 fprintf(stderr) 输出到控制台，避免调用 qDebug/qWarning 触发消息处理器
+    // 写线程已停止（shutdown 之后）：在调用线程同步输出
+    if (!running_.load(std::memory_order_acquire)) {
+        writeBatch({entry});
+        flushFile();
+        inLog = false;
+        return;
+    }
+
+    // 溢出策略：队列占用超过阈值后不再接收 Debug，剩余空间留给 Info 及以上
+    const size_t debugLimit = queue_->capacity() * defaults::LOG_DEBUG_DROP_PERCENT / 100;
+    bool accepted = !(level == LogLevel::Debug && queue_->approxSize() >= debugLimit) && queue_->tryPush(entry);
+    if (!accepted) {
+        dropped_[static_cast<int>(level)].fetch_add(1, std::memory_order_relaxed);
+        Metrics::instance().recordLogDropped(static_cast<int>(level));
+    } else {
+        // 与 writerLoop 中的栅栏配对：要么写线程看到新日志，要么这里看到它已空闲
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerIdle_.load(std::memory_order_relaxed)) {
+            QMutexLocker locker(&wakeMutex_);
+            wakeCond_.wakeOne();
+        }
+    }
+
+    inLog = false;
+}
+
+void Logger::flush(int timeoutMs) {
+    if (!running_.load(std::memory_order_acquire)) {
+        flushFile();
+        return;
+    }
+    if (std::this_thread::get_id() == writer_.get_id()) {
+        return;  // 写线程自身无法等待自己
+    }
+
+    QMutexLocker locker(&wakeMutex_);
+    flushRequested_ = true;
+    wakeCond_.wakeOne();
+    QDeadlineTimer deadline(timeoutMs);
+    while (flushRequested_ && !deadline.hasExpired()) {
+        drainedCond_.wait(&wakeMutex_, deadline);
+    }
+}
+
+void Logger::shutdown() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&wakeMutex_);
+        stopping_.store(true, std::memory_order_release);
+        wakeCond_.wakeAll();
+    }
+    writer_.join();
+
+    // 写线程退出后本线程是唯一消费者，补写停止前最后入队的日志
+    std::vector<LogEntry> rest;
+    reportDropped(rest);
+    LogEntry entry;
+    while (queue_->tryPop(entry)) {
+        rest.push_back(std::move(entry));
+    }
+    if (!rest.empty()) {
+        writeBatch(rest);
+    }
+    flushFile();
+}
+
+void Logger::writerLoop() {
+    const auto batchLimit = static_cast<size_t>(defaults::LOG_WRITE_BATCH);
+    std::vector<LogEntry> batch;
+    batch.reserve(batchLimit);
+
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    bool dirty = false;
+
+    for (;;) {
+        batch.clear();
+        reportDropped(batch);
+        LogEntry entry;
+        while (batch.size() < batchLimit && queue_->tryPop(entry)) {
+            batch.push_back(std::move(entry));
+        }
+
+        if (!batch.empty()) {
+            writeBatch(batch);
+            dirty = true;
+            // Error 立即落盘，其余按间隔刷新
+            bool hasError = std::any_of(batch.begin(), batch.end(),
+                                        [](const LogEntry& e) { return e.level == LogLevel::Error; });
+            if (hasError || sinceFlush.elapsed() >= defaults::LOG_FLUSH_INTERVAL_MS) {
+                flushFile();
+                dirty = false;
+                sinceFlush.restart();
+            }
+            continue;
+        }
+
+        // 队列已空
+        if (dirty && sinceFlush.elapsed() >= defaults::LOG_FLUSH_INTERVAL_MS) {
+            flushFile();
+            dirty = false;
+            sinceFlush.restart();
+        }
+
+        QMutexLocker locker(&wakeMutex_);
+        if (flushRequested_) {
+            flushFile();
+            dirty = false;
+            sinceFlush.restart();
+            flushRequested_ = false;
+            drainedCond_.wakeAll();
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        writerIdle_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queue_->approxSize() == 0) {
+            // 定时醒来：既作为文件刷新时钟，也兜底极端情况下错过的唤醒
+            wakeCond_.wait(&wakeMutex_, QDeadlineTimer(defaults::LOG_FLUSH_INTERVAL_MS));
+        }
+        writerIdle_.store(false, std::memory_order_relaxed);
+    }
+
+    flushFile();
+}
+
+void Logger::reportDropped(std::vector<LogEntry>& batch) {
+    quint64 counts[4];
+    quint64 total = 0;
+    for (size_t i = 0; i < dropped_.size(); ++i) {
+        counts[i] = dropped_[i].exchange(0, std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return;
+    }
+
+    LogEntry entry;
+    entry.timestamp = QDateTime::currentDateTime();
+    entry.level = LogLevel::Warn;
+    entry.source = "Logger";
+    entry.message = QString("日志队列已满，丢弃 %1 条日志（DEBUG %2, INFO %3, WARN %4, ERROR %5）")
+                        .arg(total)
+                        .arg(counts[0])
+                        .arg(counts[1])
+                        .arg(counts[2])
+                        .arg(counts[3]);
+    batch.push_back(std::move(entry));
+}
+
+void Logger::writeBatch(const std::vector<LogEntry>& batch) {
+    // 直接用 fwrite(stderr) 输出到控制台，避免调用 qDebug/qWarning 触发消息处理器
     // 格式：时间戳 [级别] 消息，ANSI 颜色区分级别
     static const char* kReset   = "\033[0m";
     static const char* kGray    = "\033[90m";   // Debug
     static const char* kGreen   = "\033[32m";   // Info
     static const char* kYellow  = "\033[33m";   // Warn
     static const char* kRed     = "\033[31m";   // Error
-    const char* color = kReset;
-    switch (level) {
-        case LogLevel::Debug: color = kGray;   break;
-        case LogLevel::Info:  color = kGreen;  break;
-        case LogLevel::Warn:  color = kYellow; break;
-        case LogLevel::Error: color = kRed;    break;
-    }
-    QString timeStr = entry.timestamp.toString("yyyy-MM-dd hh:mm:ss.zzz");
-    QString logLine = source.isEmpty()
-        ? QString("%1 [%2] %3").arg(timeStr, logLevelToString(level), message)
-        : QString("%1 [%2] [%3] %4").arg(timeStr, logLevelToString(level), source, message);
-    fprintf(stderr, "%s%s%s\n", color, qPrintable(logLine), kReset);
-    fflush(stderr);
 
-    writeToFile(entry);
-    emit logAdded(entry);
+    QByteArray console;
+    QByteArray fileData;
+    console.reserve(static_cast<qsizetype>(batch.size()) * 128);
+    fileData.reserve(static_cast<qsizetype>(batch.size()) * 128);
 
-    inLog = false;
-}
+    for (const auto& entry : batch) {
+        const char* color = kReset;
+        switch (entry.level) {
+            case LogLevel::Debug: color = kGray;   break;
+            case LogLevel::Info:  color = kGreen;  break;
+            case LogLevel::Warn:  color = kYellow; break;
+            case LogLevel::Error: color = kRed;    break;
+        }
+        QString timeStr = entry.timestamp.toString("yyyy-MM-dd hh:mm:ss.zzz");
+        QString levelStr = logLevelToString(entry.level);
+        QString logLine = entry.source.isEmpty()
+            ? QString("%1 [%2] %3").arg(timeStr, levelStr, entry.message)
+            : QString("%1 [%2] [%3] %4").arg(timeStr, levelStr, entry.source, entry.message);
+        QByteArray lineBytes = logLine.toLocal8Bit();
+        console += color;
+        console += lineBytes;
+        console += kReset;
+        console += '\n';
+        fileData += logLine.toUtf8();
+        fileData += '\n';
+        Metrics::instance().recordLog(static_cast<int>(entry.level), lineBytes.size());
+    }
 
-void Logger::writeToFile(const LogEntry& entry) {
-    QMutexLocker locker(&mutex_);
+    fwrite(console.constData(), 1, static_cast<size_t>(console.size()), stderr);
+    fflush(stderr);
 
-    if (!file_.isOpen()) {
-        return;
+    {
+        QMutexLocker locker(&mutex_);
+        if (file_.isOpen()) {
+            file_.write(fileData);
+        }
     }
 
-    QTextStream stream(&file_);
-    stream << entry.timestamp.toString("yyyy-MM-dd hh:mm:ss.zzz") << " [" << logLevelToString(entry.level) << "] ";
-
-    if (!entry.source.isEmpty()) {
-        stream << "[" << entry.source << "] ";
+    for (const auto& entry : batch) {
+        emit logAdded(entry);
     }
+}
 
-    stream << entry.message << "\n";
-    stream.flush();
+void Logger::flushFile() {
+    QMutexLocker locker(&mutex_);
+    if (file_.isOpen()) {
+        file_.flush();
+    }
 }
 
 }  // namespace wekey
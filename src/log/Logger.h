@@ -2,7 +2,8 @@
  * @file Logger.h
  * @brief 日志记录器单例类
  *
- * 提供多级别日志输出，支持文件和信号两种输出方式
+ * 提供多级别日志输出，支持文件和信号两种输出方式。
+ * 调用线程只负责入队，格式化、控制台/文件写入和 logAdded 信号都在独立的写线程完成。
  */
 
 #pragma once
@@ -12,9 +13,18 @@
 #include <QMutex>
 #include <QObject>
 #include <QString>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace wekey {
 
+class LogQueue;
+
 /**
  * @brief 日志级别枚举
  */
@@ -47,7 +57,10 @@ LogLevel stringToLogLevel(const QString& str);
 /**
  * @brief 日志记录器单例类
  *
- * 线程安全的日志记录器，支持多级别日志和文件输出
+ * 线程安全的日志记录器，支持多级别日志和文件输出。
+ *
+ * 日志先进入有界无锁队列，由写线程批量输出并定期刷新文件。
+ * 队列接近满时优先丢弃 Debug 日志；丢弃数量会在恢复后以一条 WARN 日志报告。
  */
 class Logger : public QObject {
     Q_OBJECT
@@ -67,6 +80,8 @@ public:
 
     /**
      * @brief 设置日志级别
+     *
+     * 同时更新 wekey.* 日志分类的 debug 开关，使 qCDebug 在级别高于 Debug 时不再求值参数。
      * @param level 最低输出级别
      */
     void setLevel(LogLevel level);
@@ -77,6 +92,21 @@ public:
      */
     LogLevel level() const;
 
+    /**
+     * @brief 指定级别的日志是否会被输出（LOG_* 宏在求值消息前调用）
+     */
+    bool isEnabled(LogLevel level) const { return level >= level_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 设置附加的日志分类规则
+     *
+     * 规则语法同 QLoggingCategory::setFilterRules，多条规则以 ';' 或换行分隔，
+     * 例如 "wekey.skf.debug=true;wekey.gui.debug=false"。在级别规则之后应用，可覆盖之：
+     * 既能关闭某个分类，也能在全局级别更高时单独打开某个分类的 debug/info。
+     * @param rules 规则字符串，空字符串表示清除
+     */
+    void setCategoryRules(const QString& rules);
+
     /**
      * @brief 设置日志文件输出路径
      * @param path 文件路径，空字符串表示关闭文件输出
@@ -111,6 +141,29 @@ public:
      */
     void error(const QString& message, const QString& source = {});
 
+    /**
+     * @brief 输出已通过日志分类过滤的 Qt 消息（消息处理器调用）
+     *
+     * 分类规则已包含全局级别和 logRules，这里不再检查级别，否则规则只能关闭、不能打开。
+     * @param level 日志级别
+     * @param message 日志消息
+     * @param source 日志来源（分类名）
+     */
+    void logFiltered(LogLevel level, const QString& message, const QString& source = {});
+
+    /**
+     * @brief 等待已入队的日志全部写出并刷新文件（用于崩溃前等场景）
+     * @param timeoutMs 最长等待时间（毫秒）
+     */
+    void flush(int timeoutMs = 2000);
+
+    /**
+     * @brief 写出所有剩余日志并停止写线程
+     *
+     * 之后的日志在调用线程同步输出。应在退出 main() 前调用。
+     */
+    void shutdown();
+
 signals:
     /**
      * @brief 日志添加信号
@@ -128,20 +181,78 @@ private:
     void log(LogLevel level, const QString& message, const QString& source);
 
     /**
-     * @brief 写入日志文件
+     * @brief 入队（不检查级别）
      */
-    void writeToFile(const LogEntry& entry);
+    void append(LogLevel level, const QString& message, const QString& source);
 
-    LogLevel level_{LogLevel::Debug};
+    /**
+     * @brief 按当前级别和附加规则重新设置 Qt 日志分类过滤
+     */
+    void applyCategoryFilter();
+
+    /**
+     * @brief 写线程主循环
+     */
+    void writerLoop();
+
+    /**
+     * @brief 批量输出到控制台和文件，并发出 logAdded
+     */
+    void writeBatch(const std::vector<LogEntry>& batch);
+
+    /**
+     * @brief 刷新日志文件缓冲
+     */
+    void flushFile();
+
+    /**
+     * @brief 报告自上次以来因队列已满而丢弃的日志
+     */
+    void reportDropped(std::vector<LogEntry>& batch);
+
+    std::atomic<LogLevel> level_{LogLevel::Debug};
     QFile file_;
-    QMutex mutex_;
+    QMutex mutex_;  ///< 保护 file_ 和 categoryRules_
+    QString categoryRules_;
+
+    std::unique_ptr<LogQueue> queue_;
+    std::array<std::atomic<quint64>, 4> dropped_{};
+    std::thread writer_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+
+    // 写线程空闲时在 wakeCond_ 上等待；生产者仅在其空闲时唤醒，避免每条日志都加锁
+    QMutex wakeMutex_;
+    QWaitCondition wakeCond_;
+    QWaitCondition drainedCond_;
+    std::atomic<bool> writerIdle_{false};
+    bool flushRequested_{false};  ///< 受 wakeMutex_ 保护
 };
 
-// 便捷宏
-#define LOG_DEBUG(msg) wekey::Logger::instance().debug(msg, __FUNCTION__)
-#define LOG_INFO(msg) wekey::Logger::instance().info(msg, __FUNCTION__)
-#define LOG_WARN(msg) wekey::Logger::instance().warn(msg, __FUNCTION__)
-#define LOG_ERROR(msg) wekey::Logger::instance().error(msg, __FUNCTION__)
+// 便捷宏：先检查级别再求值 msg，被过滤的日志不会构造 QString
+#define WEKEY_LOG_AT(lvl, fn, msg)                                  \
+    do {                                                            \
+        wekey::Logger& wekeyLogger_ = wekey::Logger::instance();    \
+        if (wekeyLogger_.isEnabled(wekey::LogLevel::lvl)) {         \
+            wekeyLogger_.fn(msg, __FUNCTION__);                     \
+        }                                                           \
+    } while (0)
+
+// 定义 WEKEY_NO_DEBUG_LOG（CMake 选项 STRIP_DEBUG_LOGS）时 Debug 日志在编译期移除，
+// 保留 if (false) 分支使 msg 中引用的变量仍视为已使用
+#ifdef WEKEY_NO_DEBUG_LOG
+#define LOG_DEBUG(msg)                                              \
+    do {                                                            \
+        if (false) {                                                \
+            wekey::Logger::instance().debug(msg, __FUNCTION__);     \
+        }                                                           \
+    } while (0)
+#else
+#define LOG_DEBUG(msg) WEKEY_LOG_AT(Debug, debug, msg)
+#endif
+#define LOG_INFO(msg) WEKEY_LOG_AT(Info, info, msg)
+#define LOG_WARN(msg) WEKEY_LOG_AT(Warn, warn, msg)
+#define LOG_ERROR(msg) WEKEY_LOG_AT(Error, error, msg)
 
 }  // namespace wekey
 
@@ -5,6 +5,10 @@
 
 #include "PluginManager.h"
 
+#include <QList>
+#include <QThread>
+
+#include "common/StartupProfile.h"
 #include "plugin/skf/SkfPlugin.h"
 
 namespace wekey {
@@ -43,6 +47,45 @@ Result<void> PluginManager::registerPlugin(const QString& name, const QString& l
     return Result<void>::ok();
 }
 
+void PluginManager::registerPluginsAsync(const QMap<QString, QString>& libPaths, const QString& activeName) {
+    ready_ = false;
+
+    QThread* ownerThread = thread();
+    QThread* loader = QThread::create([this, libPaths, activeName, ownerThread]() {
+        QList<QPair<QString, PluginEntry>> loaded;
+        for (auto it = libPaths.cbegin(); it != libPaths.cend(); ++it) {
+            auto plugin = std::make_shared<SkfPlugin>();
+            plugin->initialize(it.value());
+            // 在创建线程内移交线程归属，之后由 ownerThread 使用
+            plugin->moveToThread(ownerThread);
+            loaded.append(qMakePair(it.key(), PluginEntry{it.value(), plugin}));
+            StartupProfile::mark("plugin loaded: " + it.key());
+        }
+
+        QMetaObject::invokeMethod(this, [this, loaded, activeName]() {
+            for (const auto& [name, entry] : loaded) {
+                if (plugins_.contains(name)) {
+                    continue;  // 加载期间已被手动注册
+                }
+                plugins_.insert(name, entry);
+                emit pluginRegistered(name);
+            }
+            if (!activeName.isEmpty() && plugins_.contains(activeName) && activePluginName_.isEmpty()) {
+                setActivePlugin(activeName);
+            }
+            ready_ = true;
+            emit pluginsReady();
+        }, Qt::QueuedConnection);
+    });
+    loader->setObjectName("PluginLoader");
+    connect(loader, &QThread::finished, loader, &QObject::deleteLater);
+    loader->start();
+}
+
+bool PluginManager::isReady() const {
+    return ready_;
+}
+
 Result<void> PluginManager::registerPluginInstance(const QString& name, std::shared_ptr<IDriverPlugin> plugin) {
     if (name.isEmpty() || !plugin) {
         return Result<void>::err(
@@ -107,6 +150,14 @@ IDriverPlugin* PluginManager::activePlugin() const {
     return getPlugin(activePluginName_);
 }
 
+std::shared_ptr<IDriverPlugin> PluginManager::activePluginRef() const {
+    auto it = plugins_.find(activePluginName_);
+    if (activePluginName_.isEmpty() || it == plugins_.end()) {
+        return nullptr;
+    }
+    return it->plugin;
+}
+
 QString PluginManager::activePluginName() const {
     return activePluginName_;
 }
@@ -11,6 +11,7 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <atomic>
 #include <memory>
 
 #include "common/Result.h"
@@ -47,6 +48,21 @@ public:
      */
     Result<void> registerPlugin(const QString& name, const QString& libPath, bool emitSignals = true);
 
+    /**
+     * @brief 在后台线程加载插件库，完成后回到本对象所在线程注册并发出 pluginsReady
+     *
+     * 库加载和符号解析（QLibrary::load）放到后台，避免阻塞启动；
+     * plugins_ 只在本对象线程修改，读者无需额外同步。
+     * @param libPaths 插件名称 -> SKF 库路径
+     * @param activeName 加载完成后激活的插件（为空或不存在时不激活）
+     */
+    void registerPluginsAsync(const QMap<QString, QString>& libPaths, const QString& activeName);
+
+    /**
+     * @brief 启动时的插件加载是否已完成（未调用 registerPluginsAsync 时为 true）
+     */
+    [[nodiscard]] bool isReady() const;
+
     /**
      * @brief 注册已有插件实例（用于测试注入）
      * @param name 插件名称
@@ -83,6 +99,15 @@ public:
      */
     IDriverPlugin* activePlugin() const;
 
+    /**
+     * @brief 获取当前激活插件的共享所有权
+     *
+     * 供长时间阻塞在插件调用中的线程（如设备监控）使用：插件被注销后，
+     * 实例和动态库仍保留到持有者释放为止。
+     * @return 插件实例（无激活返回 nullptr）
+     */
+    std::shared_ptr<IDriverPlugin> activePluginRef() const;
+
     /**
      * @brief 获取当前激活的插件名称
      * @return 插件名称（无激活返回空字符串）
@@ -108,6 +133,11 @@ signals:
     void pluginUnregistered(const QString& name);
     void activePluginChanged(const QString& name);
 
+    /**
+     * @brief registerPluginsAsync 完成
+     */
+    void pluginsReady();
+
 private:
     PluginManager();
     ~PluginManager() override = default;
@@ -119,6 +149,7 @@ private:
 
     QMap<QString, PluginEntry> plugins_;
     QString activePluginName_;
+    std::atomic<bool> ready_{true};
 };
 
 }  // namespace wekey
@@ -0,0 +1,266 @@
+/**
+ * @file AsyncDriverPlugin.h
+ * @brief 驱动插件异步调用接口
+ *
+ * 在 IDriverPlugin 的设备执行器上执行同步接口方法，以 QFuture 返回结果
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QPromise>
+
+#include <memory>
+#include <type_traits>
+
+#include "plugin/interface/IDriverPlugin.h"
+
+namespace wekey {
+
+/**
+ * @brief 在设备执行器上执行 fn，返回其结果的 QFuture
+ *
+ * plugin 为空时在调用线程上直接执行（fn 自行返回“模块未激活”等错误）。
+ * 插件卸载时尚未执行的任务被丢弃，对应的 QFuture 处于取消状态。
+ * 续体可用 QFuture::then(context, ...) 回到 context 所在线程。
+ * @param plugin 驱动插件
+ * @param devName 设备名称
+ * @param fn 无参可调用对象，返回 Result<T>
+ */
+template <typename F>
+QFuture<std::invoke_result_t<F>> postToDevice(IDriverPlugin* plugin, const QString& devName, F fn) {
+    using R = std::invoke_result_t<F>;
+    // std::function 要求可复制，QPromise 只能移动，因此放在 shared_ptr 中
+    auto promise = std::make_shared<QPromise<R>>();
+    QFuture<R> future = promise->future();
+    promise->start();
+
+    auto task = [promise, fn = std::move(fn)]() mutable {
+        promise->addResult(fn());
+        promise->finish();
+    };
+    if (plugin) {
+        plugin->post(devName, std::move(task));
+    } else {
+        task();
+    }
+    return future;
+}
+
+/**
+ * @brief 驱动插件异步调用接口
+ *
+ * 与 IDriverPlugin 一一对应（设备事件等待除外，它由 DeviceService 的监听线程独占），
+ * 每个方法投递到所属设备的执行器后立即返回。同一设备上的调用按提交顺序执行，
+ * 因此“先登录再读文件”这类依赖可以连续提交而无需等待前一个完成。
+ *
+ * 对象只保存插件指针，可按值复制；调用方负责保证插件在 QFuture 完成前有效。
+ *
+ * 目前只有 GUI 使用异步接口。HTTP 处理器仍调用同步接口，每个在途设备请求占用一个
+ * HTTP 工作线程直到 USB 交互结束（并发上限即 httpMaxThreads）；把处理器改为提交
+ * *Async 调用、在续体中完成响应不在本接口的范围内。
+ */
+class AsyncDriverPlugin {
+public:
+    explicit AsyncDriverPlugin(IDriverPlugin* plugin) : plugin_(plugin) {}
+
+    [[nodiscard]] IDriverPlugin* plugin() const { return plugin_; }
+
+    //=== 设备管理 ===
+
+    QFuture<Result<QList<DeviceInfo>>> enumDevices(bool login = false) {
+        return post({}, [login](IDriverPlugin* p) { return p->enumDevices(login); });
+    }
+
+    QFuture<Result<void>> changeDeviceAuth(const QString& devName, const QString& oldPin, const QString& newPin) {
+        return post(devName, [=](IDriverPlugin* p) { return p->changeDeviceAuth(devName, oldPin, newPin); });
+    }
+
+    QFuture<Result<void>> setDeviceLabel(const QString& devName, const QString& label) {
+        return post(devName, [=](IDriverPlugin* p) { return p->setDeviceLabel(devName, label); });
+    }
+
+    //=== 应用管理 ===
+
+    QFuture<Result<QList<AppInfo>>> enumApps(const QString& devName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->enumApps(devName); });
+    }
+
+    QFuture<Result<void>> createApp(const QString& devName, const QString& appName, const QVariantMap& args) {
+        return post(devName, [=](IDriverPlugin* p) { return p->createApp(devName, appName, args); });
+    }
+
+    QFuture<Result<void>> deleteApp(const QString& devName, const QString& appName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->deleteApp(devName, appName); });
+    }
+
+    QFuture<Result<void>> openApp(const QString& devName, const QString& appName, const QString& role,
+                                  const QString& pin) {
+        return post(devName, [=](IDriverPlugin* p) { return p->openApp(devName, appName, role, pin); });
+    }
+
+    QFuture<Result<void>> closeApp(const QString& devName, const QString& appName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->closeApp(devName, appName); });
+    }
+
+    QFuture<Result<void>> changePin(const QString& devName, const QString& appName, const QString& role,
+                                    const QString& oldPin, const QString& newPin) {
+        return post(devName,
+                    [=](IDriverPlugin* p) { return p->changePin(devName, appName, role, oldPin, newPin); });
+    }
+
+    QFuture<Result<void>> unlockPin(const QString& devName, const QString& appName, const QString& adminPin,
+                                    const QString& newUserPin, const QVariantMap& args) {
+        return post(devName,
+                    [=](IDriverPlugin* p) { return p->unlockPin(devName, appName, adminPin, newUserPin, args); });
+    }
+
+    QFuture<Result<int>> getRetryCount(const QString& devName, const QString& appName, const QString& role,
+                                       const QString& pin) {
+        return post(devName, [=](IDriverPlugin* p) { return p->getRetryCount(devName, appName, role, pin); });
+    }
+
+    //=== 容器管理 ===
+
+    QFuture<Result<QList<ContainerInfo>>> enumContainers(const QString& devName, const QString& appName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->enumContainers(devName, appName); });
+    }
+
+    QFuture<Result<void>> createContainer(const QString& devName, const QString& appName,
+                                          const QString& containerName) {
+        return post(devName,
+                    [=](IDriverPlugin* p) { return p->createContainer(devName, appName, containerName); });
+    }
+
+    QFuture<Result<void>> deleteContainer(const QString& devName, const QString& appName,
+                                          const QString& containerName) {
+        return post(devName,
+                    [=](IDriverPlugin* p) { return p->deleteContainer(devName, appName, containerName); });
+    }
+
+    //=== 密钥操作 ===
+
+    QFuture<Result<QByteArray>> generateKeyPair(const QString& devName, const QString& appName,
+                                                const QString& containerName, const QString& keyType) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->generateKeyPair(devName, appName, containerName, keyType);
+        });
+    }
+
+    QFuture<Result<QByteArray>> generateCsr(const QString& devName, const QString& appName,
+                                            const QString& containerName, const QVariantMap& args) {
+        return post(devName,
+                    [=](IDriverPlugin* p) { return p->generateCsr(devName, appName, containerName, args); });
+    }
+
+    //=== 证书管理 ===
+
+    QFuture<Result<void>> importCert(const QString& devName, const QString& appName, const QString& containerName,
+                                     const QByteArray& certData, bool isSignCert) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->importCert(devName, appName, containerName, certData, isSignCert);
+        });
+    }
+
+    QFuture<Result<void>> importKeyCert(const QString& devName, const QString& appName,
+                                        const QString& containerName, const QByteArray& sigCert,
+                                        const QByteArray& encCert, const QByteArray& encPrivate, bool nonGM) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->importKeyCert(devName, appName, containerName, sigCert, encCert, encPrivate, nonGM);
+        });
+    }
+
+    QFuture<Result<QByteArray>> exportCert(const QString& devName, const QString& appName,
+                                           const QString& containerName, bool isSignCert) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->exportCert(devName, appName, containerName, isSignCert);
+        });
+    }
+
+    QFuture<Result<CertInfo>> getCertInfo(const QString& devName, const QString& appName,
+                                          const QString& containerName, bool isSignCert) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->getCertInfo(devName, appName, containerName, isSignCert);
+        });
+    }
+
+    //=== 签名验签 ===
+
+    QFuture<Result<QByteArray>> sign(const QString& devName, const QString& appName, const QString& containerName,
+                                     const QByteArray& data) {
+        return post(devName, [=](IDriverPlugin* p) { return p->sign(devName, appName, containerName, data); });
+    }
+
+    QFuture<Result<bool>> verify(const QString& devName, const QString& appName, const QString& containerName,
+                                 const QByteArray& data, const QByteArray& signature) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->verify(devName, appName, containerName, data, signature);
+        });
+    }
+
+    //=== 非对称加解密 ===
+
+    QFuture<Result<QByteArray>> exportPublicKey(const QString& devName, const QString& appName,
+                                                const QString& containerName, bool isSignKey) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->exportPublicKey(devName, appName, containerName, isSignKey);
+        });
+    }
+
+    QFuture<Result<QByteArray>> privateDecrypt(const QString& devName, const QString& appName,
+                                               const QString& containerName, const QByteArray& cipherText) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->privateDecrypt(devName, appName, containerName, cipherText);
+        });
+    }
+
+    //=== 文件操作 ===
+
+    QFuture<Result<QStringList>> enumFiles(const QString& devName, const QString& appName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->enumFiles(devName, appName); });
+    }
+
+    QFuture<Result<QByteArray>> readFile(const QString& devName, const QString& appName, const QString& fileName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->readFile(devName, appName, fileName); });
+    }
+
+    QFuture<Result<void>> writeFile(const QString& devName, const QString& appName, const QString& fileName,
+                                    const QByteArray& data, int readRights = 0xFF, int writeRights = 0x01) {
+        return post(devName, [=](IDriverPlugin* p) {
+            return p->writeFile(devName, appName, fileName, data, readRights, writeRights);
+        });
+    }
+
+    QFuture<Result<void>> deleteFile(const QString& devName, const QString& appName, const QString& fileName) {
+        return post(devName, [=](IDriverPlugin* p) { return p->deleteFile(devName, appName, fileName); });
+    }
+
+    //=== 其他 ===
+
+    QFuture<Result<QByteArray>> generateRandom(const QString& devName, int count) {
+        return post(devName, [=](IDriverPlugin* p) { return p->generateRandom(devName, count); });
+    }
+
+    //=== 批量执行 ===
+
+    QFuture<Result<QList<OperationResult>>> execute(const QString& devName, const OperationList& operations) {
+        return post(devName, [=](IDriverPlugin* p) { return p->execute(devName, operations); });
+    }
+
+private:
+    template <typename F>
+    auto post(const QString& devName, F call) {
+        using R = std::invoke_result_t<F, IDriverPlugin*>;
+        IDriverPlugin* plugin = plugin_;
+        return postToDevice(plugin, devName, [plugin, call = std::move(call)]() -> R {
+            if (!plugin) {
+                return R::err(Error(Error::NoActiveModule, "驱动模块未激活", "AsyncDriverPlugin"));
+            }
+            return call(plugin);
+        });
+    }
+
+    IDriverPlugin* plugin_;
+};
+
+}  // namespace wekey
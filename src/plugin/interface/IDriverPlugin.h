@@ -12,6 +12,8 @@
 #include <QVariantMap>
 #include <QtPlugin>
 
+#include <functional>
+
 #include "common/Result.h"
 #include "plugin/interface/PluginTypes.h"
 
@@ -20,12 +22,27 @@ namespace wekey {
 /**
  * @brief 驱动插件接口
  *
- * 所有设备驱动插件必须实现此接口
+ * 所有设备驱动插件必须实现此接口。接口方法均为同步调用，异步调用见 AsyncDriverPlugin
  */
 class IDriverPlugin {
 public:
     virtual ~IDriverPlugin() = default;
 
+    //=== 执行器 ===
+
+    /**
+     * @brief 把一次调用投递到设备的执行器
+     *
+     * 同一设备的任务按提交顺序串行执行。默认实现在调用线程上直接执行，
+     * 插件可覆盖为在自己的工作线程上执行，使调用方不必为等待 USB 交互占用线程。
+     * @param devName 设备名称（空表示与具体设备无关的调用，如枚举设备）
+     * @param task 任务
+     */
+    virtual void post(const QString& devName, std::function<void()> task) {
+        Q_UNUSED(devName);
+        task();
+    }
+
     //=== 设备管理 ===
 
     /**
@@ -58,6 +75,11 @@ public:
      */
     virtual Result<int> waitForDeviceEvent() = 0;
 
+    /**
+     * @brief 取消阻塞中的 waitForDeviceEvent（可从其他线程调用）
+     */
+    virtual Result<void> cancelWaitForDeviceEvent() = 0;
+
     //=== 应用管理 ===
 
     /**
@@ -278,6 +300,34 @@ public:
     virtual Result<bool> verify(const QString& devName, const QString& appName, const QString& containerName,
                                 const QByteArray& data, const QByteArray& signature) = 0;
 
+    //=== 非对称加解密 ===
+
+    /**
+     * @brief 导出容器公钥
+     *
+     * 结果按容器缓存，容器内密钥变化（生成、导入、删除容器）或设备移除时失效。
+     * @param devName 设备名称
+     * @param appName 应用名称
+     * @param containerName 容器名称
+     * @param isSignKey true 为签名公钥，false 为加密公钥
+     * @return DER 编码的 SubjectPublicKeyInfo
+     */
+    virtual Result<QByteArray> exportPublicKey(const QString& devName, const QString& appName,
+                                               const QString& containerName, bool isSignKey) = 0;
+
+    /**
+     * @brief 用容器加密私钥解密（需登录）
+     *
+     * 只用于解开对称会话密钥等短数据。
+     * @param devName 设备名称
+     * @param appName 应用名称
+     * @param containerName 容器名称
+     * @param cipherText SM2 为 GM/T 0009 DER 编码的 SM2Cipher；RSA 为 PKCS#1 v1.5 加密结果
+     * @return 明文
+     */
+    virtual Result<QByteArray> privateDecrypt(const QString& devName, const QString& appName,
+                                              const QString& containerName, const QByteArray& cipherText) = 0;
+
     //=== 文件操作 ===
 
     /**
@@ -336,9 +386,23 @@ public:
      * @return 随机数据
      */
     virtual Result<QByteArray> generateRandom(const QString& devName, int count) = 0;
+
+    //=== 批量执行 ===
+
+    /**
+     * @brief 在一个会话中按顺序执行同一设备上的多个操作
+     *
+     * 整个列表在一次持锁内完成，期间应用句柄保持打开、已验证的 PIN 不再重复验证。
+     * 某一步失败时，continueOnError 为 false 则后续步骤全部跳过。
+     * @param devName 设备名称
+     * @param operations 操作列表
+     * @return 每个操作的结果（与 operations 一一对应）；列表本身无效（未知操作、缺少参数、
+     *         引用不存在或靠后的步骤）时返回错误且不执行任何操作
+     */
+    virtual Result<QList<OperationResult>> execute(const QString& devName, const OperationList& operations) = 0;
 };
 
 }  // namespace wekey
 
-#define IDriverPlugin_iid "com.trustasia.wekey.IDriverPlugin/1.0"
+#define IDriverPlugin_iid "com.trustasia.wekey.IDriverPlugin/1.3"
 Q_DECLARE_INTERFACE(wekey::IDriverPlugin, IDriverPlugin_iid)
@@ -9,8 +9,13 @@
 
 #include <QByteArray>
 #include <QDateTime>
+#include <QList>
 #include <QMetaType>
 #include <QString>
+#include <QVariant>
+#include <QVariantMap>
+
+#include "common/Error.h"
 
 namespace wekey {
 
@@ -76,6 +81,35 @@ enum class DeviceEvent {
     Removed = 2   ///< 设备移除
 };
 
+/**
+ * @brief 批量执行中的单个操作
+ *
+ * op 为 IDriverPlugin 的方法名，参数按同名键放在 params 中，设备名由 execute() 统一给出。
+ * 二进制参数（data、signature、certData 等）取 QByteArray，字符串按 Base64 解码。
+ * 整个值为 "${id}" 的字符串参数引用前序步骤 id 的输出，如把 generateCsr 的结果交给后续步骤。
+ */
+struct Operation {
+    QString id;                    ///< 步骤标识，供后续步骤引用（可空）
+    QString op;                    ///< 操作名，如 "openApp"、"generateCsr"
+    QVariantMap params;            ///< 参数
+    bool continueOnError = false;  ///< 失败后是否继续执行后续步骤
+};
+
+using OperationList = QList<Operation>;
+
+/**
+ * @brief 单个操作的执行结果
+ */
+struct OperationResult {
+    enum class Status { Succeeded, Failed, Skipped };
+
+    QString id;
+    QString op;
+    Status status = Status::Skipped;
+    QVariant output;  ///< 成功时的输出（QByteArray / QStringList / bool / int），无输出时为空
+    Error error;      ///< 失败原因
+};
+
 }  // namespace wekey
 
 Q_DECLARE_METATYPE(wekey::DeviceInfo)
@@ -0,0 +1,92 @@
+/**
+ * @file DeviceExecutor.cpp
+ * @brief 按设备串行的任务执行器实现
+ */
+
+#include "DeviceExecutor.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <iterator>
+
+namespace wekey {
+
+DeviceExecutor::DeviceExecutor(int maxThreads) {
+    pool_.setObjectName("DeviceExecutor");
+    pool_.setMaxThreadCount(maxThreads);
+}
+
+DeviceExecutor::~DeviceExecutor() {
+    shutdown();
+}
+
+void DeviceExecutor::post(const QString& key, std::function<void()> task) {
+    QMutexLocker locker(&mutex_);
+    if (stopped_) {
+        return;
+    }
+
+    auto& queue = queues_[key];
+    queue.tasks.push_back(std::move(task));
+    ++pending_;
+    if (queue.scheduled) {
+        return;
+    }
+    queue.scheduled = true;
+    pool_.start([this, key]() { runNext(key); });
+}
+
+void DeviceExecutor::runNext(const QString& key) {
+    std::function<void()> task;
+    {
+        QMutexLocker locker(&mutex_);
+        auto it = queues_.find(key);
+        if (it == queues_.end() || it->tasks.empty()) {
+            queues_.remove(key);
+            return;
+        }
+        task = std::move(it->tasks.front());
+        it->tasks.pop_front();
+    }
+
+    task();
+    // 任务持有的 QPromise 等资源在重新调度前释放
+    task = nullptr;
+
+    QMutexLocker locker(&mutex_);
+    --pending_;
+    auto it = queues_.find(key);
+    if (it == queues_.end()) {
+        return;
+    }
+    if (it->tasks.empty() || stopped_) {
+        queues_.erase(it);
+        return;
+    }
+    pool_.start([this, key]() { runNext(key); });
+}
+
+void DeviceExecutor::shutdown() {
+    std::deque<std::function<void()>> dropped;
+    {
+        QMutexLocker locker(&mutex_);
+        stopped_ = true;
+        for (auto it = queues_.begin(); it != queues_.end(); ++it) {
+            pending_ -= static_cast<int>(it->tasks.size());
+            std::move(it->tasks.begin(), it->tasks.end(), std::back_inserter(dropped));
+            it->tasks.clear();
+        }
+    }
+    // 被丢弃任务中的 QPromise 析构时会把对应的 QFuture 标记为取消，可能同步触发续体，
+    // 因此在锁外释放
+    dropped.clear();
+    pool_.waitForDone();
+}
+
+int DeviceExecutor::pendingCount() const {
+    QMutexLocker locker(&mutex_);
+    return pending_;
+}
+
+}  // namespace wekey
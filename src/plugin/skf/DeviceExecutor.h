@@ -0,0 +1,72 @@
+/**
+ * @file DeviceExecutor.h
+ * @brief 按设备串行的任务执行器
+ *
+ * 每台设备一个任务队列，同一设备的任务按提交顺序逐个执行，不同设备的队列共享少量工作线程。
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include <deque>
+#include <functional>
+
+namespace wekey {
+
+/**
+ * @brief 按设备串行的任务执行器
+ *
+ * 队列中的任务不占用线程，只有正在执行的任务占用一个工作线程；每执行完一个任务，
+ * 该设备的队列重新排到线程池末尾，避免一台设备的长队列饿死其他设备。
+ */
+class DeviceExecutor {
+public:
+    /**
+     * @param maxThreads 工作线程数上限
+     */
+    explicit DeviceExecutor(int maxThreads);
+    ~DeviceExecutor();
+
+    DeviceExecutor(const DeviceExecutor&) = delete;
+    DeviceExecutor& operator=(const DeviceExecutor&) = delete;
+
+    /**
+     * @brief 提交任务
+     * @param key 队列键（设备名，空为与设备无关的调用）
+     * @param task 任务
+     */
+    void post(const QString& key, std::function<void()> task);
+
+    /**
+     * @brief 丢弃尚未开始的任务并等待执行中的任务结束，之后提交的任务被直接丢弃
+     */
+    void shutdown();
+
+    /**
+     * @brief 已提交未完成的任务数（排队 + 执行中）
+     */
+    [[nodiscard]] int pendingCount() const;
+
+private:
+    struct Queue {
+        std::deque<std::function<void()>> tasks;
+        bool scheduled = false;  ///< 已有工作线程负责该队列
+    };
+
+    /**
+     * @brief 执行队列中的下一个任务（工作线程）
+     */
+    void runNext(const QString& key);
+
+    mutable QMutex mutex_;
+    QHash<QString, Queue> queues_;
+    int pending_ = 0;
+    bool stopped_ = false;
+    QThreadPool pool_;
+};
+
+}  // namespace wekey
@@ -129,6 +129,11 @@ using PFN_SKF_ChangeDevAuthKey = ULONG(SKF_API*)(DEVHANDLE hDev, BYTE* pbAuthDat
  */
 using PFN_SKF_WaitForDevEvent = ULONG(SKF_API*)(LPSTR szDevName, PULONG pulDevNameLen, PULONG pulEvent);
 
+/**
+ * @brief 取消等待设备事件（使阻塞中的 SKF_WaitForDevEvent 返回）
+ */
+using PFN_SKF_CancelWaitForDevEvent = ULONG(SKF_API*)();
+
 //=== 应用管理函数指针类型 ===
 
 /**
@@ -451,6 +456,29 @@ using PFN_SKF_RSAVerify = ULONG(SKF_API*)(DEVHANDLE hDev, RSAPUBLICKEYBLOB* pRSA
                                           BYTE* pbData, ULONG ulDataLen,
                                           BYTE* pbSignature, ULONG ulSignLen);
 
+//=== 非对称解密函数指针类型（厂商扩展，GM/T 0016 未定义，库中可能不存在） ===
+
+/**
+ * @brief 用容器内的 ECC 加密私钥解密
+ * @param hContainer 容器句柄
+ * @param pCipherText 密文
+ * @param pbPlainText 明文缓冲区
+ * @param pulPlainTextLen 输入：缓冲区大小；输出：明文长度
+ */
+using PFN_SKF_ECCDecrypt = ULONG(SKF_API*)(HCONTAINER hContainer, ECCCIPHERBLOB* pCipherText,
+                                           BYTE* pbPlainText, PULONG pulPlainTextLen);
+
+/**
+ * @brief 用容器内的 RSA 加密私钥解密（PKCS#1 v1.5 填充，由设备去除）
+ * @param hContainer 容器句柄
+ * @param pbIn 密文
+ * @param ulInLen 密文长度（等于模长）
+ * @param pbOut 明文缓冲区
+ * @param pulOutLen 输入：缓冲区大小；输出：明文长度
+ */
+using PFN_SKF_RSADecrypt = ULONG(SKF_API*)(HCONTAINER hContainer, BYTE* pbIn, ULONG ulInLen,
+                                           BYTE* pbOut, PULONG pulOutLen);
+
 //=== 文件操作函数指针类型 ===
 
 /**
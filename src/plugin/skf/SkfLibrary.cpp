@@ -39,6 +39,7 @@ void SkfLibrary::loadSymbols() {
     DevAuth = loadSymbol<skf::PFN_SKF_DevAuth>("SKF_DevAuth");
     ChangeDevAuthKey = loadSymbol<skf::PFN_SKF_ChangeDevAuthKey>("SKF_ChangeDevAuthKey");
     WaitForDevEvent = loadSymbol<skf::PFN_SKF_WaitForDevEvent>("SKF_WaitForDevEvent");
+    CancelWaitForDevEvent = loadSymbol<skf::PFN_SKF_CancelWaitForDevEvent>("SKF_CancelWaitForDevEvent");
 
     // 应用管理函数 (8 个)
     EnumApplication = loadSymbol<skf::PFN_SKF_EnumApplication>("SKF_EnumApplication");
@@ -87,6 +88,10 @@ void SkfLibrary::loadSymbols() {
     RSASignData = loadSymbol<skf::PFN_SKF_RSASignData>("SKF_RSASignData");
     RSAVerify = loadSymbol<skf::PFN_SKF_RSAVerify>("SKF_RSAVerify");
 
+    // 非对称解密函数 (2 个，厂商扩展)
+    ECCDecrypt = loadSymbol<skf::PFN_SKF_ECCDecrypt>("SKF_ECCDecrypt");
+    RSADecrypt = loadSymbol<skf::PFN_SKF_RSADecrypt>("SKF_RSADecrypt");
+
     // 文件操作函数 (5 个)
     CreateFile = loadSymbol<skf::PFN_SKF_CreateFile>("SKF_CreateFile");
     DeleteFile = loadSymbol<skf::PFN_SKF_DeleteFile>("SKF_DeleteFile");
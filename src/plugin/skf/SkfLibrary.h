@@ -73,6 +73,7 @@ public:
     skf::PFN_SKF_DevAuth DevAuth = nullptr;
     skf::PFN_SKF_ChangeDevAuthKey ChangeDevAuthKey = nullptr;
     skf::PFN_SKF_WaitForDevEvent WaitForDevEvent = nullptr;
+    skf::PFN_SKF_CancelWaitForDevEvent CancelWaitForDevEvent = nullptr;  ///< 部分厂商库未导出
 
     //=== 应用管理函数指针 (8 个) ===
 
@@ -128,6 +129,11 @@ public:
     skf::PFN_SKF_RSASignData RSASignData = nullptr;
     skf::PFN_SKF_RSAVerify RSAVerify = nullptr;
 
+    //=== 非对称解密函数指针 (2 个，厂商扩展) ===
+
+    skf::PFN_SKF_ECCDecrypt ECCDecrypt = nullptr;
+    skf::PFN_SKF_RSADecrypt RSADecrypt = nullptr;
+
     //=== 文件操作函数指针 (5 个) ===
 
     skf::PFN_SKF_CreateFile CreateFile = nullptr;
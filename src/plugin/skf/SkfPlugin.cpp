@@ -8,10 +8,14 @@
 #include "SkfPlugin.h"
 
 #include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMutexLocker>
 #include <QTimeZone>
+#include <cstddef>
 #include <cstring>
 
+#include <algorithm>
 #include <vector>
 
 #include <openssl/x509.h>
@@ -23,11 +27,70 @@
 #include <openssl/core_names.h>
 #include <openssl/param_build.h>
 
+#include "common/LogCategories.h"
+#include "common/Metrics.h"
+#include "common/RequestTiming.h"
+
 namespace wekey {
 
-SkfPlugin::SkfPlugin(QObject* parent) : QObject(parent) {}
+namespace {
+
+/**
+ * @brief 带等待计时的互斥锁守卫
+ *
+ * 无竞争时 tryLock 直接成功；有竞争时记录阻塞等待时长到 Metrics。
+ * 等待时长和持锁时长（即 SKF 调用耗时）同时计入当前请求的 RequestTiming。
+ * 批量执行的外层守卫不计持锁时长（recordHeld = false），由各步骤重入时分别计入，避免重复
+ */
+class TimedMutexLocker {
+public:
+    explicit TimedMutexLocker(QRecursiveMutex* mutex, bool recordHeld = true)
+        : mutex_(mutex), timing_(recordHeld ? RequestTiming::current() : nullptr) {
+        int64_t waitUs = 0;
+        if (!mutex_->tryLock()) {
+            QElapsedTimer timer;
+            timer.start();
+            mutex_->lock();
+            waitUs = timer.nsecsElapsed() / 1000;
+        }
+        Metrics::instance().observePluginLockWait(waitUs);
+        if (auto* timing = RequestTiming::current()) {
+            timing->add(RequestTiming::PluginLock, waitUs);
+        }
+        held_.start();
+    }
+    ~TimedMutexLocker() {
+        if (timing_) {
+            timing_->add(RequestTiming::Skf, held_.nsecsElapsed() / 1000);
+        }
+        mutex_->unlock();
+    }
+
+    TimedMutexLocker(const TimedMutexLocker&) = delete;
+    TimedMutexLocker& operator=(const TimedMutexLocker&) = delete;
+
+private:
+    QRecursiveMutex* mutex_;
+    RequestTiming* timing_;
+    QElapsedTimer held_;
+};
+
+/// 异步调用执行器的工作线程数，排队中的调用不占用线程
+constexpr int kExecutorThreads = 4;
+
+/// 批量执行会话中已验证 PIN 的键
+QString pinSessionKey(const QString& devName, const QString& appName, skf::ULONG pinType) {
+    return devName + "/" + appName + "#" + QString::number(pinType);
+}
+
+}  // namespace
+
+SkfPlugin::SkfPlugin(QObject* parent) : QObject(parent), executor_(kExecutorThreads) {}
 
 SkfPlugin::~SkfPlugin() {
+    // 先停止执行器：丢弃排队的异步调用，等待执行中的调用结束后再关闭句柄
+    executor_.shutdown();
+
     QMutexLocker locker(&mutex_);
 
     // 关闭所有打开的句柄（逆序：容器 -> 应用 -> 设备）
@@ -59,6 +122,23 @@ Result<void> SkfPlugin::initialize(const QString& libPath) {
     return Result<void>::ok();
 }
 
+void SkfPlugin::post(const QString& devName, std::function<void()> task) {
+    executor_.post(devName, std::move(task));
+}
+
+skf::ULONG SkfPlugin::verifyCachedPin(const QString& devName, const QString& appName, skf::HAPPLICATION appHandle,
+                                      skf::ULONG pinType, const QByteArray& pin, skf::ULONG* retryCount) {
+    const QString key = pinSessionKey(devName, appName, pinType);
+    if (session_.active && session_.verified.contains(key)) {
+        return skf::SAR_OK;
+    }
+    skf::ULONG ret = lib_->VerifyPIN(appHandle, pinType, pin.constData(), retryCount);
+    if (ret == skf::SAR_OK && session_.active) {
+        session_.verified.insert(key);
+    }
+    return ret;
+}
+
 //=== 辅助方法 ===
 
 QString SkfPlugin::makeKey(const QString& dev, const QString& app, const QString& container) const {
@@ -71,6 +151,18 @@ QString SkfPlugin::makeKey(const QString& dev, const QString& app, const QString
     return dev;
 }
 
+void SkfPlugin::forgetPublicKeys(const QString& devName, const QString& appName, const QString& containerName) {
+    const QString prefix = (containerName.isEmpty() ? makeKey(devName, appName) + "/"
+                                                    : makeKey(devName, appName, containerName) + "#");
+    for (auto it = publicKeyCache_.begin(); it != publicKeyCache_.end();) {
+        if (it.key().startsWith(prefix)) {
+            it = publicKeyCache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 QStringList SkfPlugin::parseNameList(const char* buffer, size_t size) const {
     QStringList result;
     if (!buffer || size == 0) {
@@ -285,7 +377,16 @@ void SkfPlugin::closeAppHandle(const QString& devName, const QString& appName) {
 
     // 已登录时保留应用句柄，避免丢失 PIN 认证状态
     if (isLoggedIn) {
-        qDebug() << "[closeAppHandle] 应用已登录，保留句柄:" << appKey;
+        qCDebug(lcSkf) << "[closeAppHandle] 应用已登录，保留句柄:" << appKey;
+        return;
+    }
+
+    // 批量执行期间后续步骤还要用，会话结束时再关闭
+    if (session_.active) {
+        const auto app = qMakePair(devName, appName);
+        if (!session_.deferredApps.contains(app)) {
+            session_.deferredApps.append(app);
+        }
         return;
     }
 
@@ -353,7 +454,7 @@ void SkfPlugin::closeContainerHandle(const QString& devName, const QString& appN
 //=== 设备管理 ===
 
 Result<QList<DeviceInfo>> SkfPlugin::enumDevices(bool /*login*/) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     if (!lib_ || !lib_->EnumDev) {
         return Result<QList<DeviceInfo>>::err(
@@ -373,6 +474,7 @@ Result<QList<DeviceInfo>> SkfPlugin::enumDevices(bool /*login*/) {
         }
         if (size == 0) {
             devInfoCache_.clear();
+            publicKeyCache_.clear();
             return Result<QList<DeviceInfo>>::ok({});
         }
         buffer.resize(static_cast<int>(size));
@@ -385,6 +487,7 @@ Result<QList<DeviceInfo>> SkfPlugin::enumDevices(bool /*login*/) {
 
     if (size == 0) {
         devInfoCache_.clear();
+        publicKeyCache_.clear();
         return Result<QList<DeviceInfo>>::ok({});
     }
 
@@ -399,12 +502,20 @@ Result<QList<DeviceInfo>> SkfPlugin::enumDevices(bool /*login*/) {
             ++it;
         }
     }
+    for (auto it = publicKeyCache_.begin(); it != publicKeyCache_.end(); ) {
+        if (!currentDevs.contains(it.key().section('/', 0, 0))) {
+            it = publicKeyCache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
     QList<DeviceInfo> devices;
 
     for (const auto& name : devNames) {
         // 优先使用缓存的设备信息，避免重复 ConnectDev/DisConnectDev
         if (devInfoCache_.contains(name)) {
+            Metrics::instance().recordCache(Metrics::DeviceInfoCache, true);
             DeviceInfo info = devInfoCache_[name];
             // 刷新登录状态（可能在两次枚举之间变化）
             info.isLoggedIn = false;
@@ -420,6 +531,7 @@ Result<QList<DeviceInfo>> SkfPlugin::enumDevices(bool /*login*/) {
             continue;
         }
 
+        Metrics::instance().recordCache(Metrics::DeviceInfoCache, false);
         DeviceInfo info;
         info.deviceName = name;
 
@@ -465,7 +577,7 @@ Result<QList<DeviceInfo>> SkfPlugin::enumDevices(bool /*login*/) {
 }
 
 Result<void> SkfPlugin::changeDeviceAuth(const QString& devName, const QString& oldPin, const QString& newPin) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto devResult = openDevice(devName);
     if (devResult.isErr()) {
@@ -500,7 +612,7 @@ Result<void> SkfPlugin::changeDeviceAuth(const QString& devName, const QString&
 }
 
 Result<void> SkfPlugin::setDeviceLabel(const QString& devName, const QString& label) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto devResult = openDevice(devName);
     if (devResult.isErr()) {
@@ -547,14 +659,28 @@ Result<int> SkfPlugin::waitForDeviceEvent() {
         return Result<int>::err(Error::fromSkf(ret, "SKF_WaitForDevEvent"));
     }
 
-    qDebug() << "[waitForDeviceEvent] 设备事件:" << event << "devName:" << devName;
+    qCDebug(lcSkf) << "[waitForDeviceEvent] 设备事件:" << event << "devName:" << devName;
     return Result<int>::ok(static_cast<int>(event));
 }
 
+Result<void> SkfPlugin::cancelWaitForDeviceEvent() {
+    // 同 waitForDeviceEvent，不加 mutex_ 锁
+    if (!lib_ || !lib_->CancelWaitForDevEvent) {
+        return Result<void>::err(
+            Error(Error::SkfNotSupported, "SKF 库不支持取消等待设备事件", "SkfPlugin::cancelWaitForDeviceEvent"));
+    }
+
+    skf::ULONG ret = lib_->CancelWaitForDevEvent();
+    if (ret != skf::SAR_OK) {
+        return Result<void>::err(Error::fromSkf(ret, "SKF_CancelWaitForDevEvent"));
+    }
+    return Result<void>::ok();
+}
+
 //=== 应用管理 ===
 
 Result<QList<AppInfo>> SkfPlugin::enumApps(const QString& devName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto devResult = openDevice(devName);
     if (devResult.isErr()) {
@@ -596,7 +722,7 @@ Result<QList<AppInfo>> SkfPlugin::enumApps(const QString& devName) {
         // 从登录缓存检查应用是否已登录
         QString loginKey = devName + "/" + name;
         info.isLoggedIn = loginCache_.contains(loginKey);
-        qDebug() << "[enumApps] app:" << name << "isLoggedIn:" << info.isLoggedIn;
+        qCDebug(lcSkf) << "[enumApps] app:" << name << "isLoggedIn:" << info.isLoggedIn;
         apps.append(info);
     }
 
@@ -604,7 +730,7 @@ Result<QList<AppInfo>> SkfPlugin::enumApps(const QString& devName) {
 }
 
 Result<void> SkfPlugin::createApp(const QString& devName, const QString& appName, const QVariantMap& args) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto devResult = openDevice(devName);
     if (devResult.isErr()) {
@@ -620,14 +746,14 @@ Result<void> SkfPlugin::createApp(const QString& devName, const QString& appName
     int fileRights = args.value("fileRights", 255).toInt();
 
     // 步骤1：设备认证
-    qDebug() << "[createApp] 开始设备认证, devName:" << devName;
+    qCDebug(lcSkf) << "[createApp] 开始设备认证, devName:" << devName;
     auto authResult = performDeviceAuth(devResult.value(), authPin);
     if (authResult.isErr()) {
         closeDevice(devName);
-        qWarning() << "[createApp] 设备认证失败:" << authResult.error().message();
+        qCWarning(lcSkf) << "[createApp] 设备认证失败:" << authResult.error().message();
         return Result<void>::err(authResult.error());
     }
-    qDebug() << "[createApp] 设备认证成功";
+    qCDebug(lcSkf) << "[createApp] 设备认证成功";
 
     // 步骤2：创建应用
     if (!lib_->CreateApplication) {
@@ -641,7 +767,7 @@ Result<void> SkfPlugin::createApp(const QString& devName, const QString& appName
     QByteArray userPinBytes = userPin.toLocal8Bit();
 
     skf::HAPPLICATION hApp = nullptr;
-    qDebug() << "[createApp] 创建应用:" << appName
+    qCDebug(lcSkf) << "[createApp] 创建应用:" << appName
              << "adminRetry:" << adminRetry << "userRetry:" << userRetry
              << "fileRights:" << fileRights;
     skf::ULONG ret = lib_->CreateApplication(devResult.value(), appBytes.constData(), adminPinBytes.constData(),
@@ -655,16 +781,16 @@ Result<void> SkfPlugin::createApp(const QString& devName, const QString& appName
     closeDevice(devName);
 
     if (ret != skf::SAR_OK) {
-        qWarning() << "[createApp] 创建应用失败, ret:" << QString::number(ret, 16);
+        qCWarning(lcSkf) << "[createApp] 创建应用失败, ret:" << QString::number(ret, 16);
         return Result<void>::err(Error::fromSkf(ret, "SKF_CreateApplication"));
     }
 
-    qDebug() << "[createApp] 创建应用成功:" << appName;
+    qCDebug(lcSkf) << "[createApp] 创建应用成功:" << appName;
     return Result<void>::ok();
 }
 
 Result<void> SkfPlugin::deleteApp(const QString& devName, const QString& appName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     // 步骤1：先关闭该应用的句柄（如果已打开）
     // SKF 规范要求：删除应用前必须先关闭应用句柄
@@ -698,16 +824,17 @@ Result<void> SkfPlugin::deleteApp(const QString& devName, const QString& appName
         return Result<void>::err(Error::fromSkf(ret, "SKF_DeleteApplication"));
     }
 
-    // 步骤5：清理登录缓存
+    // 步骤5：清理登录缓存和公钥缓存
     QString loginKey = devName + "/" + appName;
     loginCache_.remove(loginKey);
+    forgetPublicKeys(devName, appName);
 
     return Result<void>::ok();
 }
 
 Result<void> SkfPlugin::openApp(const QString& devName, const QString& appName, const QString& role,
                                  const QString& pin) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -729,6 +856,9 @@ Result<void> SkfPlugin::openApp(const QString& devName, const QString& appName,
         closeAppHandle(devName, appName);
         return Result<void>::err(Error::fromSkf(ret, "SKF_VerifyPIN"));
     }
+    if (session_.active) {
+        session_.verified.insert(pinSessionKey(devName, appName, pinType));
+    }
 
     // 写入登录缓存（保存 PIN 和角色，供后续操作验证使用）
     LoginInfo loginInfo;
@@ -740,10 +870,12 @@ Result<void> SkfPlugin::openApp(const QString& devName, const QString& appName,
 }
 
 Result<void> SkfPlugin::closeApp(const QString& devName, const QString& appName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     // 从登录缓存中删除
     loginCache_.remove(devName + "/" + appName);
+    session_.verified.remove(pinSessionKey(devName, appName, 0));
+    session_.verified.remove(pinSessionKey(devName, appName, 1));
 
     closeAppHandle(devName, appName);
     return Result<void>::ok();
@@ -751,7 +883,7 @@ Result<void> SkfPlugin::closeApp(const QString& devName, const QString& appName)
 
 Result<void> SkfPlugin::changePin(const QString& devName, const QString& appName, const QString& role,
                                    const QString& oldPin, const QString& newPin) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -782,7 +914,7 @@ Result<void> SkfPlugin::changePin(const QString& devName, const QString& appName
 
 Result<void> SkfPlugin::unlockPin(const QString& devName, const QString& appName, const QString& adminPin,
                                    const QString& newUserPin, const QVariantMap& /*args*/) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -812,7 +944,7 @@ Result<void> SkfPlugin::unlockPin(const QString& devName, const QString& appName
 
 Result<int> SkfPlugin::getRetryCount(const QString& devName, const QString& appName,
                                       const QString& role, const QString& pin) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -831,7 +963,7 @@ Result<int> SkfPlugin::getRetryCount(const QString& devName, const QString& appN
     // 用传入的 PIN 调用 VerifyPIN 获取剩余次数（会失败但返回 retryCount）
     QByteArray pinBytes = pin.toLocal8Bit();
     lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
-    qDebug() << "[getRetryCount] role:" << role << "retryCount:" << retryCount;
+    qCDebug(lcSkf) << "[getRetryCount] role:" << role << "retryCount:" << retryCount;
     closeAppHandle(devName, appName);
 
     return Result<int>::ok(static_cast<int>(retryCount));
@@ -840,7 +972,7 @@ Result<int> SkfPlugin::getRetryCount(const QString& devName, const QString& appN
 //=== 容器管理 ===
 
 Result<QList<ContainerInfo>> SkfPlugin::enumContainers(const QString& devName, const QString& appName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -924,15 +1056,15 @@ Result<QList<ContainerInfo>> SkfPlugin::enumContainers(const QString& devName, c
 
 Result<void> SkfPlugin::createContainer(const QString& devName, const QString& appName,
                                          const QString& containerName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
-    qDebug() << "[createContainer] 开始创建容器, devName:" << devName
+    qCDebug(lcSkf) << "[createContainer] 开始创建容器, devName:" << devName
              << "appName:" << appName << "containerName:" << containerName;
 
     // 步骤1：检查登录状态（创建容器需要先登录应用验证PIN）
     QString loginKey = devName + "/" + appName;
     if (!loginCache_.contains(loginKey)) {
-        qWarning() << "[createContainer] 应用未登录, devName:" << devName << "appName:" << appName;
+        qCWarning(lcSkf) << "[createContainer] 应用未登录, devName:" << devName << "appName:" << appName;
         return Result<void>::err(
             Error(Error::NotLoggedIn, "应用未登录，请先登录应用", "SkfPlugin::createContainer"));
     }
@@ -940,7 +1072,7 @@ Result<void> SkfPlugin::createContainer(const QString& devName, const QString& a
     // 步骤2：打开应用句柄
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
-        qWarning() << "[createContainer] 打开应用失败:" << appResult.error().message();
+        qCWarning(lcSkf) << "[createContainer] 打开应用失败:" << appResult.error().message();
         return Result<void>::err(appResult.error());
     }
 
@@ -954,13 +1086,13 @@ Result<void> SkfPlugin::createContainer(const QString& devName, const QString& a
     skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
     QByteArray pinBytes = cached.pin.toLocal8Bit();
     skf::ULONG retryCount = 0;
-    skf::ULONG verifyRet = lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
+    skf::ULONG verifyRet = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
     if (verifyRet != skf::SAR_OK) {
-        qWarning() << "[createContainer] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
+        qCWarning(lcSkf) << "[createContainer] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
         closeAppHandle(devName, appName);
         return Result<void>::err(Error::fromSkf(verifyRet, "SKF_VerifyPIN"));
     }
-    qDebug() << "[createContainer] VerifyPIN 成功, role:" << cached.role;
+    qCDebug(lcSkf) << "[createContainer] VerifyPIN 成功, role:" << cached.role;
 
     if (!lib_->CreateContainer) {
         closeAppHandle(devName, appName);
@@ -975,31 +1107,31 @@ Result<void> SkfPlugin::createContainer(const QString& devName, const QString& a
 
     // 关闭容器句柄（创建后不需要保持打开）
     if (hContainer && lib_->CloseContainer) {
-        qDebug() << "[createContainer] 关闭容器句柄";
+        qCDebug(lcSkf) << "[createContainer] 关闭容器句柄";
         lib_->CloseContainer(hContainer);
     }
     closeAppHandle(devName, appName);
 
     if (ret != skf::SAR_OK) {
-        qWarning() << "[createContainer] SKF_CreateContainer 失败, ret:" << QString::number(ret, 16);
+        qCWarning(lcSkf) << "[createContainer] SKF_CreateContainer 失败, ret:" << QString::number(ret, 16);
         return Result<void>::err(Error::fromSkf(ret, "SKF_CreateContainer"));
     }
 
-    qDebug() << "[createContainer] 创建容器成功:" << containerName;
+    qCDebug(lcSkf) << "[createContainer] 创建容器成功:" << containerName;
     return Result<void>::ok();
 }
 
 Result<void> SkfPlugin::deleteContainer(const QString& devName, const QString& appName,
                                          const QString& containerName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
-    qDebug() << "[deleteContainer] 开始删除容器, devName:" << devName
+    qCDebug(lcSkf) << "[deleteContainer] 开始删除容器, devName:" << devName
              << "appName:" << appName << "containerName:" << containerName;
 
     // 步骤1：检查登录状态（删除容器需要先登录应用验证PIN）
     QString loginKey = devName + "/" + appName;
     if (!loginCache_.contains(loginKey)) {
-        qWarning() << "[deleteContainer] 应用未登录, devName:" << devName << "appName:" << appName;
+        qCWarning(lcSkf) << "[deleteContainer] 应用未登录, devName:" << devName << "appName:" << appName;
         return Result<void>::err(
             Error(Error::NotLoggedIn, "应用未登录，请先登录应用", "SkfPlugin::deleteContainer"));
     }
@@ -1009,7 +1141,7 @@ Result<void> SkfPlugin::deleteContainer(const QString& devName, const QString& a
     if (handles_.contains(containerKey)) {
         auto& info = handles_[containerKey];
         if (info.containerHandle && lib_ && lib_->CloseContainer) {
-            qDebug() << "[deleteContainer] 关闭容器句柄:" << containerKey;
+            qCDebug(lcSkf) << "[deleteContainer] 关闭容器句柄:" << containerKey;
             lib_->CloseContainer(info.containerHandle);
         }
         handles_.remove(containerKey);
@@ -1018,7 +1150,7 @@ Result<void> SkfPlugin::deleteContainer(const QString& devName, const QString& a
     // 步骤3：打开应用句柄
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
-        qWarning() << "[deleteContainer] 打开应用失败:" << appResult.error().message();
+        qCWarning(lcSkf) << "[deleteContainer] 打开应用失败:" << appResult.error().message();
         return Result<void>::err(appResult.error());
     }
 
@@ -1032,13 +1164,13 @@ Result<void> SkfPlugin::deleteContainer(const QString& devName, const QString& a
     skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
     QByteArray pinBytes = cached.pin.toLocal8Bit();
     skf::ULONG retryCount = 0;
-    skf::ULONG verifyRet = lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
+    skf::ULONG verifyRet = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
     if (verifyRet != skf::SAR_OK) {
-        qWarning() << "[deleteContainer] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
+        qCWarning(lcSkf) << "[deleteContainer] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
         closeAppHandle(devName, appName);
         return Result<void>::err(Error::fromSkf(verifyRet, "SKF_VerifyPIN"));
     }
-    qDebug() << "[deleteContainer] VerifyPIN 成功, role:" << cached.role;
+    qCDebug(lcSkf) << "[deleteContainer] VerifyPIN 成功, role:" << cached.role;
 
     if (!lib_->DeleteContainer) {
         closeAppHandle(devName, appName);
@@ -1052,11 +1184,12 @@ Result<void> SkfPlugin::deleteContainer(const QString& devName, const QString& a
     closeAppHandle(devName, appName);
 
     if (ret != skf::SAR_OK) {
-        qWarning() << "[deleteContainer] SKF_DeleteContainer 失败, ret:" << QString::number(ret, 16);
+        qCWarning(lcSkf) << "[deleteContainer] SKF_DeleteContainer 失败, ret:" << QString::number(ret, 16);
         return Result<void>::err(Error::fromSkf(ret, "SKF_DeleteContainer"));
     }
 
-    qDebug() << "[deleteContainer] 删除容器成功:" << containerName;
+    forgetPublicKeys(devName, appName, containerName);
+    qCDebug(lcSkf) << "[deleteContainer] 删除容器成功:" << containerName;
     return Result<void>::ok();
 }
 
@@ -1064,7 +1197,8 @@ Result<void> SkfPlugin::deleteContainer(const QString& devName, const QString& a
 
 Result<QByteArray> SkfPlugin::generateKeyPair(const QString& devName, const QString& appName,
                                                const QString& containerName, const QString& keyType) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
+    forgetPublicKeys(devName, appName, containerName);
 
     auto containerResult = openContainerHandle(devName, appName, containerName);
     if (containerResult.isErr()) {
@@ -1138,7 +1272,7 @@ struct EvpPKeyGuard {
  * 使用 EVP_PKEY_fromdata (OpenSSL 3.0+) 避免弃用警告
  */
 EVP_PKEY* createSm2EvpPKey(const skf::ECCPUBLICKEYBLOB& blob) {
-    qDebug() << "[createSm2EvpPKey] bitLen:" << blob.bitLen;
+    qCDebug(lcSkf) << "[createSm2EvpPKey] bitLen:" << blob.bitLen;
 
     // 构建 SM2 SubjectPublicKeyInfo DER 编码，使用 d2i_PUBKEY 解析
     // 格式: SEQUENCE { SEQUENCE { OID ecPublicKey, OID SM2 }, BIT STRING { 04 || x || y } }
@@ -1158,21 +1292,21 @@ EVP_PKEY* createSm2EvpPKey(const skf::ECCPUBLICKEYBLOB& blob) {
     std::memcpy(spki + 27, blob.xCoordinate + 32, 32);  // x 坐标
     std::memcpy(spki + 59, blob.yCoordinate + 32, 32);  // y 坐标
 
-    qDebug() << "[createSm2EvpPKey] SPKI(hex):"
+    qCDebug(lcSkf) << "[createSm2EvpPKey] SPKI(hex):"
              << QByteArray(reinterpret_cast<const char*>(spki), 91).toHex();
 
     const unsigned char* p = spki;
     EVP_PKEY* pkey = d2i_PUBKEY(nullptr, &p, sizeof(spki));
     if (!pkey) {
-        qWarning() << "[createSm2EvpPKey] d2i_PUBKEY failed:";
+        qCWarning(lcSkf) << "[createSm2EvpPKey] d2i_PUBKEY failed:";
         unsigned long err;
         while ((err = ERR_get_error()) != 0) {
-            qWarning() << "  OpenSSL error:" << ERR_error_string(err, nullptr);
+            qCWarning(lcSkf) << "  OpenSSL error:" << ERR_error_string(err, nullptr);
         }
         return nullptr;
     }
 
-    qDebug() << "[createSm2EvpPKey] EVP_PKEY created successfully, type:" << EVP_PKEY_id(pkey);
+    qCDebug(lcSkf) << "[createSm2EvpPKey] EVP_PKEY created successfully, type:" << EVP_PKEY_id(pkey);
     return pkey;
 }
 
@@ -1183,7 +1317,7 @@ EVP_PKEY* createSm2EvpPKey(const skf::ECCPUBLICKEYBLOB& blob) {
 EVP_PKEY* createRsaEvpPKey(const skf::RSAPUBLICKEYBLOB& blob) {
 
     if (blob.bitLen == 0 || blob.bitLen > 4096) {
-        qWarning() << "[createRsaEvpPKey] 非法 BitLen:" << blob.bitLen;
+        qCWarning(lcSkf) << "[createRsaEvpPKey] 非法 BitLen:" << blob.bitLen;
         return nullptr;
     }
 
@@ -1221,7 +1355,7 @@ EVP_PKEY* createRsaEvpPKey(const skf::RSAPUBLICKEYBLOB& blob) {
     BN_free(bn_n);
     BN_free(bn_e);
 
-    qDebug() << "[createRsaEvpPKey] modulus(BE) 首字节:" << QString::number(nBuf[0], 16)
+    qCDebug(lcSkf) << "[createRsaEvpPKey] modulus(BE) 首字节:" << QString::number(nBuf[0], 16)
              << "末字节:" << QString::number(nBuf[nLen-1], 16)
              << "exponent:" << QByteArray(reinterpret_cast<const char*>(eBuf.data()), eLen).toHex();
     // 期望输出：首字节=cf，末字节=b5（奇数），exponent=010001
@@ -1377,10 +1511,13 @@ QByteArray assembleCsrDer(const QByteArray& tbsDer, const QByteArray& signatureV
 
 Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString& appName,
                                             const QString& containerName, const QVariantMap& args) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     // 解析参数
     bool renewKey = args.value("renewKey", false).toBool();
+    if (renewKey) {
+        forgetPublicKeys(devName, appName, containerName);
+    }
     QString keyType = args.value("keyType", "SM2").toString().toUpper();
     int keySize = args.value("keySize", 2048).toInt();
     QString cname = args.value("cname", "SKFTool").toString();
@@ -1392,7 +1529,7 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
     // 检查登录状态（密钥生成和签名操作需要先登录应用）
     QString loginKey = devName + "/" + appName;
     if (!loginCache_.contains(loginKey)) {
-        qWarning() << "[generateCsr] 应用未登录, devName:" << devName << "appName:" << appName;
+        qCWarning(lcSkf) << "[generateCsr] 应用未登录, devName:" << devName << "appName:" << appName;
         return Result<QByteArray>::err(
             Error(Error::NotLoggedIn, "应用未登录，请先登录", "SkfPlugin::generateCsr"));
     }
@@ -1400,7 +1537,7 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
     // 使用缓存的凭据验证 PIN（每次操作前重新验证）
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
-        qWarning() << "[generateCsr] 打开应用失败:" << appResult.error().message();
+        qCWarning(lcSkf) << "[generateCsr] 打开应用失败:" << appResult.error().message();
         return Result<QByteArray>::err(appResult.error());
     }
     const LoginInfo& cached = loginCache_[loginKey];
@@ -1412,13 +1549,13 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
     skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
     QByteArray pinBytes = cached.pin.toLocal8Bit();
     skf::ULONG retryCount = 0;
-    skf::ULONG verifyRet = lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
+    skf::ULONG verifyRet = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
     if (verifyRet != skf::SAR_OK) {
-        qWarning() << "[generateCsr] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
+        qCWarning(lcSkf) << "[generateCsr] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
         closeAppHandle(devName, appName);
         return Result<QByteArray>::err(Error::fromSkf(verifyRet, "SKF_VerifyPIN"));
     }
-    qDebug() << "[generateCsr] VerifyPIN 成功, role:" << cached.role;
+    qCDebug(lcSkf) << "[generateCsr] VerifyPIN 成功, role:" << cached.role;
 
     // 打开容器
     auto containerResult = openContainerHandle(devName, appName, containerName);
@@ -1598,7 +1735,7 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
         EVP_MD_CTX_free(mdCtx);
 
         QByteArray digest(reinterpret_cast<const char*>(sha256Hash), static_cast<int>(sha256Len));
-        qDebug() << "[generateCsr] RSA SHA-256 digest(hex):" << digest.toHex();
+        qCDebug(lcSkf) << "[generateCsr] RSA SHA-256 digest(hex):" << digest.toHex();
 
         // 构建 PKCS#1 v1.5 DigestInfo（使用与 sign 方法和 Java 端相同的硬编码前缀）
         // DigestInfo ::= SEQUENCE { AlgorithmIdentifier { OID sha256, NULL }, OCTET STRING hash }
@@ -1616,7 +1753,7 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
                          sizeof(SHA256_DIGEST_INFO_PREFIX));
         digestInfo.append(digest);
 
-        qDebug() << "[generateCsr] RSA DigestInfo length:" << digestInfo.size();
+        qCDebug(lcSkf) << "[generateCsr] RSA DigestInfo length:" << digestInfo.size();
 
         // RSA 硬件签名
         // 第一次：获取签名长度
@@ -1626,16 +1763,16 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
             static_cast<skf::ULONG>(digestInfo.size()),
             nullptr, &rsaSigLen);
         if (ret != skf::SAR_OK) {
-            qWarning() << "[generateCsr] RSASignData get length failed, ret:" << QString::number(ret, 16);
+            qCWarning(lcSkf) << "[generateCsr] RSASignData get length failed, ret:" << QString::number(ret, 16);
             closeContainerHandle(devName, appName, containerName);
             return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_RSASignData(getLen)"));
         }
         if (rsaSigLen == 0) {
-            qWarning() << "[generateCsr] RSASignData returned zero length";
+            qCWarning(lcSkf) << "[generateCsr] RSASignData returned zero length";
             closeContainerHandle(devName, appName, containerName);
             return Result<QByteArray>::err(Error(Error::Fail, "RSASignData 返回长度为零", "generateCsr"));
         }
-        qDebug() << "[generateCsr] RSA expected sig length:" << rsaSigLen;
+        qCDebug(lcSkf) << "[generateCsr] RSA expected sig length:" << rsaSigLen;
 
         // 第二次：真正签名
         QByteArray rsaSig(static_cast<int>(rsaSigLen), 0);
@@ -1644,16 +1781,16 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
             static_cast<skf::ULONG>(digestInfo.size()),
             reinterpret_cast<skf::BYTE*>(rsaSig.data()), &rsaSigLen);
         if (ret != skf::SAR_OK) {
-            qWarning() << "[generateCsr] RSASignData sign failed, ret:" << QString::number(ret, 16);
+            qCWarning(lcSkf) << "[generateCsr] RSASignData sign failed, ret:" << QString::number(ret, 16);
             closeContainerHandle(devName, appName, containerName);
             return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_RSASignData(sign)"));
         }
         rsaSig.resize(static_cast<int>(rsaSigLen));
         signatureValue = rsaSig;
-        qDebug() << "[generateCsr] RSA signature length:" << signatureValue.size();
-        qDebug() << "[generateCsr] RSA signature(hex):" << signatureValue.toHex();
+        qCDebug(lcSkf) << "[generateCsr] RSA signature length:" << signatureValue.size();
+        qCDebug(lcSkf) << "[generateCsr] RSA signature(hex):" << signatureValue.toHex();
 
-        qDebug() << "[generateCsr] RSA signature length:" << signatureValue.size();
+        qCDebug(lcSkf) << "[generateCsr] RSA signature length:" << signatureValue.size();
 
     }
 
@@ -1668,7 +1805,7 @@ Result<QByteArray> SkfPlugin::generateCsr(const QString& devName, const QString&
 
 Result<void> SkfPlugin::importCert(const QString& devName, const QString& appName, const QString& containerName,
                                     const QByteArray& certData, bool isSignCert) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto containerResult = openContainerHandle(devName, appName, containerName);
     if (containerResult.isErr()) {
@@ -1794,7 +1931,7 @@ static Result<QByteArray> parseGmt0009ToEnvelopedKeyBlob(const QByteArray& keyDa
     }
     QByteArray cipherTxt(reinterpret_cast<const char*>(p), static_cast<int>(objLen));
 
-    qDebug() << "[parseGmt0009ToEnvelopedKeyBlob] ASN.1 parsed:"
+    qCDebug(lcSkf) << "[parseGmt0009ToEnvelopedKeyBlob] ASN.1 parsed:"
              << "cipherEncPriv:" << cipherEncPriv.size()
              << "pubLen:" << pubLen
              << "x:" << xLen << "y:" << yLen
@@ -1854,9 +1991,10 @@ static Result<QByteArray> parseGmt0009ToEnvelopedKeyBlob(const QByteArray& keyDa
 Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& appName, const QString& containerName,
                                        const QByteArray& sigCert, const QByteArray& encCert,
                                        const QByteArray& encPrivate, bool nonGM) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
+    forgetPublicKeys(devName, appName, containerName);
 
-    qDebug() << "[importKeyCert] devName:" << devName << "appName:" << appName
+    qCDebug(lcSkf) << "[importKeyCert] devName:" << devName << "appName:" << appName
              << "containerName:" << containerName << "nonGM:" << nonGM
              << "sigCert size:" << sigCert.size()
              << "encCert size:" << encCert.size()
@@ -1865,13 +2003,13 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
     // PIN 验证（ImportECCKeyPair/ImportRSAKeyPair 需要先验证 PIN）
     QString loginKey = devName + "/" + appName;
     if (!loginCache_.contains(loginKey)) {
-        qWarning() << "[importKeyCert] 应用未登录, devName:" << devName << "appName:" << appName;
+        qCWarning(lcSkf) << "[importKeyCert] 应用未登录, devName:" << devName << "appName:" << appName;
         return Result<void>::err(
             Error(Error::NotLoggedIn, "应用未登录，请先登录", "SkfPlugin::importKeyCert"));
     }
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
-        qWarning() << "[importKeyCert] 打开应用失败:" << appResult.error().message();
+        qCWarning(lcSkf) << "[importKeyCert] 打开应用失败:" << appResult.error().message();
         return Result<void>::err(appResult.error());
     }
     const LoginInfo& cached = loginCache_[loginKey];
@@ -1879,12 +2017,12 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
         skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
         QByteArray pinBytes = cached.pin.toLocal8Bit();
         skf::ULONG retryCount = 0;
-        skf::ULONG verifyRet = lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
+        skf::ULONG verifyRet = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
         if (verifyRet != skf::SAR_OK) {
-            qWarning() << "[importKeyCert] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
+            qCWarning(lcSkf) << "[importKeyCert] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
             return Result<void>::err(Error::fromSkf(verifyRet, "SKF_VerifyPIN"));
         }
-        qDebug() << "[importKeyCert] VerifyPIN 成功, role:" << cached.role;
+        qCDebug(lcSkf) << "[importKeyCert] VerifyPIN 成功, role:" << cached.role;
     }
 
     // 打开容器（内部会打开设备和应用）
@@ -1900,15 +2038,15 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
     if (lib_->GetContainerType) {
         skf::ULONG ret = lib_->GetContainerType(hContainer, &containerType);
         if (ret != skf::SAR_OK) {
-            qWarning() << "[importKeyCert] GetContainerType failed, ret:" << QString::number(ret, 16);
+            qCWarning(lcSkf) << "[importKeyCert] GetContainerType failed, ret:" << QString::number(ret, 16);
             // 获取失败不阻塞，使用请求参数的 nonGM
         } else {
-            qDebug() << "[importKeyCert] containerType:" << containerType << "(1=RSA, 2=SM2)";
+            qCDebug(lcSkf) << "[importKeyCert] containerType:" << containerType << "(1=RSA, 2=SM2)";
             // Go: nonGM = nonGM || keyType == 2  (注意：Go 里 keyType==2 对应非国密/RSA)
             nonGM = nonGM || (containerType == 1);
         }
     }
-    qDebug() << "[importKeyCert] final nonGM:" << nonGM;
+    qCDebug(lcSkf) << "[importKeyCert] final nonGM:" << nonGM;
 
     // === 导入签名证书 ===
     if (!sigCert.isEmpty()) {
@@ -1922,11 +2060,11 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
             const_cast<skf::BYTE*>(reinterpret_cast<const skf::BYTE*>(sigCert.constData())),
             static_cast<skf::ULONG>(sigCert.size()));
         if (ret != skf::SAR_OK) {
-            qWarning() << "[importKeyCert] import sigCert failed, ret:" << QString::number(ret, 16);
+            qCWarning(lcSkf) << "[importKeyCert] import sigCert failed, ret:" << QString::number(ret, 16);
             closeContainerHandle(devName, appName, containerName);
             return Result<void>::err(Error::fromSkf(ret, "SKF_ImportCertificate(sigCert)"));
         }
-        qDebug() << "[importKeyCert] sigCert imported successfully";
+        qCDebug(lcSkf) << "[importKeyCert] sigCert imported successfully";
     }
 
     // === 导入加密证书 ===
@@ -1941,11 +2079,11 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
             const_cast<skf::BYTE*>(reinterpret_cast<const skf::BYTE*>(encCert.constData())),
             static_cast<skf::ULONG>(encCert.size()));
         if (ret != skf::SAR_OK) {
-            qWarning() << "[importKeyCert] import encCert failed, ret:" << QString::number(ret, 16);
+            qCWarning(lcSkf) << "[importKeyCert] import encCert failed, ret:" << QString::number(ret, 16);
             closeContainerHandle(devName, appName, containerName);
             return Result<void>::err(Error::fromSkf(ret, "SKF_ImportCertificate(encCert)"));
         }
-        qDebug() << "[importKeyCert] encCert imported successfully";
+        qCDebug(lcSkf) << "[importKeyCert] encCert imported successfully";
     }
 
     // === 导入加密私钥 ===
@@ -1981,7 +2119,7 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
             skf::ULONG encDataLen = static_cast<skf::ULONG>(encPrivate.size()) - 8 - wrappedKeyLen;
             skf::BYTE* pbEncData = const_cast<skf::BYTE*>(raw + 8 + wrappedKeyLen);
 
-            qDebug() << "[importKeyCert] RSA symAlgId:" << symAlgId
+            qCDebug(lcSkf) << "[importKeyCert] RSA symAlgId:" << symAlgId
                      << "wrappedKeyLen:" << wrappedKeyLen
                      << "encDataLen:" << encDataLen;
 
@@ -1990,11 +2128,11 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
                 pbWrappedKey, wrappedKeyLen,
                 pbEncData, encDataLen);
             if (ret != skf::SAR_OK) {
-                qWarning() << "[importKeyCert] SKF_ImportRSAKeyPair failed, ret:" << QString::number(ret, 16);
+                qCWarning(lcSkf) << "[importKeyCert] SKF_ImportRSAKeyPair failed, ret:" << QString::number(ret, 16);
                 closeContainerHandle(devName, appName, containerName);
                 return Result<void>::err(Error::fromSkf(ret, "SKF_ImportRSAKeyPair"));
             }
-            qDebug() << "[importKeyCert] RSA key pair imported successfully";
+            qCDebug(lcSkf) << "[importKeyCert] RSA key pair imported successfully";
         } else {
             // --- SM2 密钥对导入 ---
             // Go: 先尝试 ASN.1 解码 (GMT-0009)，再尝试直接 GMT-0016 小端格式
@@ -2015,12 +2153,12 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
 
             if (isGmt0016) {
                 // 直接使用 GMT-0016 格式，复制一份可写副本避免 const_cast 问题
-                qDebug() << "[importKeyCert] SM2 key: GMT-0016 format detected, data size:" << encPrivate.size();
+                qCDebug(lcSkf) << "[importKeyCert] SM2 key: GMT-0016 format detected, data size:" << encPrivate.size();
                 evpKeyBuf = encPrivate;
                 pEvpKey = reinterpret_cast<skf::ENVELOPEDKEYBLOB*>(evpKeyBuf.data());
             } else {
                 // GMT-0009 ASN.1 → GMT-0016 ENVELOPEDKEYBLOB 转换
-                qDebug() << "[importKeyCert] SM2 key: trying ASN.1 (GMT-0009) decode";
+                qCDebug(lcSkf) << "[importKeyCert] SM2 key: trying ASN.1 (GMT-0009) decode";
                 auto blobResult = parseGmt0009ToEnvelopedKeyBlob(encPrivate);
                 if (blobResult.isErr()) {
                     closeContainerHandle(devName, appName, containerName);
@@ -2030,7 +2168,7 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
                 pEvpKey = reinterpret_cast<skf::ENVELOPEDKEYBLOB*>(evpKeyBuf.data());
             }
 
-            qDebug() << "[importKeyCert] SM2 ENVELOPEDKEYBLOB version:" << pEvpKey->version
+            qCDebug(lcSkf) << "[importKeyCert] SM2 ENVELOPEDKEYBLOB version:" << pEvpKey->version
                      << "symAlgId:" << pEvpKey->ulSymAlgId
                      << "bits:" << pEvpKey->ulBits
                      << "pubKey.bitLen:" << pEvpKey->pubKey.bitLen
@@ -2038,11 +2176,11 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
 
             skf::ULONG ret = lib_->ImportECCKeyPair(hContainer, pEvpKey);
             if (ret != skf::SAR_OK) {
-                qWarning() << "[importKeyCert] SKF_ImportECCKeyPair failed, ret:" << QString::number(ret, 16);
+                qCWarning(lcSkf) << "[importKeyCert] SKF_ImportECCKeyPair failed, ret:" << QString::number(ret, 16);
                 closeContainerHandle(devName, appName, containerName);
                 return Result<void>::err(Error::fromSkf(ret, "SKF_ImportECCKeyPair"));
             }
-            qDebug() << "[importKeyCert] SM2 key pair imported successfully";
+            qCDebug(lcSkf) << "[importKeyCert] SM2 key pair imported successfully";
         }
     }
 
@@ -2052,7 +2190,7 @@ Result<void> SkfPlugin::importKeyCert(const QString& devName, const QString& app
 
 Result<QByteArray> SkfPlugin::exportCert(const QString& devName, const QString& appName,
                                           const QString& containerName, bool isSignCert) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto containerResult = openContainerHandle(devName, appName, containerName);
     if (containerResult.isErr()) {
@@ -2147,7 +2285,7 @@ Result<CertInfo> SkfPlugin::getCertInfo(const QString& devName, const QString& a
 Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appName, const QString& containerName,
                                     const QByteArray& data) {
 
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto devResult = openDevice(devName);
     if (devResult.isErr()) {
@@ -2157,7 +2295,7 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
     // 检查登录状态（签名操作需要先登录应用）
     QString loginKey = devName + "/" + appName;
     if (!loginCache_.contains(loginKey)) {
-        qWarning() << "[sign] 应用未登录, devName:" << devName << "appName:" << appName;
+        qCWarning(lcSkf) << "[sign] 应用未登录, devName:" << devName << "appName:" << appName;
         return Result<QByteArray>::err(
             Error(Error::NotLoggedIn, "应用未登录，请先登录", "SkfPlugin::sign"));
     }
@@ -2165,7 +2303,7 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
     // 使用缓存的凭据验证 PIN（每次操作前重新验证）
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
-        qWarning() << "[sign] 打开应用失败:" << appResult.error().message();
+        qCWarning(lcSkf) << "[sign] 打开应用失败:" << appResult.error().message();
         return Result<QByteArray>::err(appResult.error());
     }
     const LoginInfo& cached = loginCache_[loginKey];
@@ -2177,13 +2315,13 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
     skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
     QByteArray pinBytes = cached.pin.toLocal8Bit();
     skf::ULONG retryCount = 0;
-    skf::ULONG verifyRet = lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
+    skf::ULONG verifyRet = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
     if (verifyRet != skf::SAR_OK) {
-        qWarning() << "[sign] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
+        qCWarning(lcSkf) << "[sign] VerifyPIN 失败, ret:" << QString::number(verifyRet, 16);
         closeAppHandle(devName, appName);
         return Result<QByteArray>::err(Error::fromSkf(verifyRet, "SKF_VerifyPIN"));
     }
-    qDebug() << "[sign] VerifyPIN 成功, role:" << cached.role;
+    qCDebug(lcSkf) << "[sign] VerifyPIN 成功, role:" << cached.role;
 
     // 打开容器（内部会打开设备和应用）
     auto containerResult = openContainerHandle(devName, appName, containerName);
@@ -2196,7 +2334,7 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
     if (lib_->GetContainerType) {
         skf::ULONG ret = lib_->GetContainerType(containerResult.value(), &containerType);
         if (ret != skf::SAR_OK) {
-            qWarning() << "[sign] GetContainerType failed, ret:" << ret;
+            qCWarning(lcSkf) << "[sign] GetContainerType failed, ret:" << ret;
             closeContainerHandle(devName, appName, containerName);
             return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_GetContainerType"));
         }
@@ -2206,7 +2344,7 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
             Error(Error::PluginLoadFailed, "SKF_GetContainerType 函数不可用", "SkfPlugin::sign"));
     }
 
-    qDebug() << "[sign] containerType:" << containerType << "(1=RSA, 2=SM2)";
+    qCDebug(lcSkf) << "[sign] containerType:" << containerType << "(1=RSA, 2=SM2)";
 
     bool isSm2 = (containerType == 2);
 
@@ -2316,7 +2454,7 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
         }
         digest.resize(static_cast<int>(digestLen));
 
-        qDebug() << "[sign] RSA SHA-256 digest(hex):" << digest.toHex();
+        qCDebug(lcSkf) << "[sign] RSA SHA-256 digest(hex):" << digest.toHex();
 
         // 构建 PKCS#1 v1.5 DigestInfo
         // DigestInfo ::= SEQUENCE { AlgorithmIdentifier { OID sha256, NULL }, OCTET STRING hash }
@@ -2334,7 +2472,7 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
                          sizeof(SHA256_DIGEST_INFO_PREFIX));
         digestInfo.append(digest);
 
-        qDebug() << "[sign] RSA DigestInfo length:" << digestInfo.size();
+        qCDebug(lcSkf) << "[sign] RSA DigestInfo length:" << digestInfo.size();
 
         // RSA 硬件签名
         QByteArray rsaSig(512, 0);  // 最大 4096 位
@@ -2350,14 +2488,14 @@ Result<QByteArray> SkfPlugin::sign(const QString& devName, const QString& appNam
         }
         rsaSig.resize(static_cast<int>(rsaSigLen));
 
-        qDebug() << "[sign] RSA signature length:" << rsaSigLen;
+        qCDebug(lcSkf) << "[sign] RSA signature length:" << rsaSigLen;
         return Result<QByteArray>::ok(rsaSig);
     }
 }
 
 Result<bool> SkfPlugin::verify(const QString& devName, const QString& appName, const QString& containerName,
                                 const QByteArray& data, const QByteArray& signature) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     // 需要导出公钥来验签
     auto containerResult = openContainerHandle(devName, appName, containerName);
@@ -2404,10 +2542,243 @@ Result<bool> SkfPlugin::verify(const QString& devName, const QString& appName, c
     return Result<bool>::ok(true);
 }
 
+//=== 非对称加解密 ===
+
+namespace {
+
+/**
+ * @brief 将 GM/T 0009 DER 编码的 SM2 密文转换为 ECCCIPHERBLOB
+ *
+ * SM2Cipher ::= SEQUENCE { x INTEGER, y INTEGER, hash OCTET STRING, cipherText OCTET STRING }
+ * @return 长度为 offsetof(ECCCIPHERBLOB, cipherData) + 密文长度的缓冲区
+ */
+Result<QByteArray> sm2CipherToBlob(const QByteArray& der) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(der.constData());
+    const unsigned char* end = p + der.size();
+    long objLen = 0;
+    int tag = 0, cls = 0;
+    // 读取下一个 TLV 头，要求标签匹配且值不越界；成功后 p 指向值
+    auto next = [&](int expectedTag) {
+        if (p >= end) {
+            return false;
+        }
+        int ret = ASN1_get_object(&p, &objLen, &tag, &cls, end - p);
+        return (ret & 0x80) == 0 && tag == expectedTag && objLen <= end - p;
+    };
+    auto invalid = [](const char* message) {
+        return Result<QByteArray>::err(Error(Error::InvalidParam, message, "sm2CipherToBlob"));
+    };
+
+    if (!next(V_ASN1_SEQUENCE)) {
+        return invalid("SM2 密文：外层 SEQUENCE 无效");
+    }
+    end = p + objLen;
+
+    const unsigned char* coords[2] = {};
+    long coordLens[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        if (!next(V_ASN1_INTEGER)) {
+            return invalid("SM2 密文：坐标不是 INTEGER");
+        }
+        coords[i] = p;
+        coordLens[i] = objLen;
+        while (coordLens[i] > 0 && *coords[i] == 0x00) {  // 跳过前导 0x00
+            ++coords[i];
+            --coordLens[i];
+        }
+        if (coordLens[i] > 32) {
+            return invalid("SM2 密文：坐标超过 32 字节");
+        }
+        p += objLen;
+    }
+
+    if (!next(V_ASN1_OCTET_STRING) || objLen != 32) {
+        return invalid("SM2 密文：hash 不是 32 字节 OCTET STRING");
+    }
+    const unsigned char* hash = p;
+    p += objLen;
+
+    if (!next(V_ASN1_OCTET_STRING) || objLen == 0) {
+        return invalid("SM2 密文：cipherText 无效");
+    }
+
+    QByteArray blob(static_cast<int>(offsetof(skf::ECCCIPHERBLOB, cipherData) + objLen), '\0');
+    auto* cipher = reinterpret_cast<skf::ECCCIPHERBLOB*>(blob.data());
+    // 坐标在 64 字节数组中右对齐
+    std::memcpy(cipher->xCoordinate + 64 - coordLens[0], coords[0], static_cast<size_t>(coordLens[0]));
+    std::memcpy(cipher->yCoordinate + 64 - coordLens[1], coords[1], static_cast<size_t>(coordLens[1]));
+    std::memcpy(cipher->hash, hash, 32);
+    cipher->cipherLen = static_cast<skf::ULONG>(objLen);
+    std::memcpy(cipher->cipherData, p, static_cast<size_t>(objLen));
+    return Result<QByteArray>::ok(blob);
+}
+
+}  // namespace
+
+Result<QByteArray> SkfPlugin::exportPublicKey(const QString& devName, const QString& appName,
+                                               const QString& containerName, bool isSignKey) {
+    TimedMutexLocker locker(&mutex_);
+
+    const QString cacheKey = makeKey(devName, appName, containerName) + (isSignKey ? "#sign" : "#enc");
+    auto cached = publicKeyCache_.constFind(cacheKey);
+    if (cached != publicKeyCache_.constEnd()) {
+        Metrics::instance().recordCache(Metrics::PublicKeyCache, true);
+        return Result<QByteArray>::ok(cached.value());
+    }
+    Metrics::instance().recordCache(Metrics::PublicKeyCache, false);
+
+    if (!lib_->ExportPublicKey || !lib_->GetContainerType) {
+        return Result<QByteArray>::err(
+            Error(Error::PluginLoadFailed, "SKF_ExportPublicKey/GetContainerType 函数不可用",
+                  "SkfPlugin::exportPublicKey"));
+    }
+
+    auto containerResult = openContainerHandle(devName, appName, containerName);
+    if (containerResult.isErr()) {
+        return Result<QByteArray>::err(containerResult.error());
+    }
+
+    // 获取容器类型：1=RSA, 2=SM2
+    skf::ULONG containerType = 0;
+    skf::ULONG ret = lib_->GetContainerType(containerResult.value(), &containerType);
+    if (ret != skf::SAR_OK) {
+        closeContainerHandle(devName, appName, containerName);
+        return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_GetContainerType"));
+    }
+    if (containerType != 1 && containerType != 2) {
+        closeContainerHandle(devName, appName, containerName);
+        return Result<QByteArray>::err(
+            Error(Error::NotFound, "容器中没有密钥对", "SkfPlugin::exportPublicKey"));
+    }
+
+    // 缓冲区按两种公钥结构中较大者分配
+    QByteArray blob(static_cast<int>(std::max(sizeof(skf::ECCPUBLICKEYBLOB), sizeof(skf::RSAPUBLICKEYBLOB))), '\0');
+    skf::ULONG blobLen = static_cast<skf::ULONG>(blob.size());
+    ret = lib_->ExportPublicKey(containerResult.value(), isSignKey ? 1 : 0,
+                                reinterpret_cast<skf::BYTE*>(blob.data()), &blobLen);
+    closeContainerHandle(devName, appName, containerName);
+    if (ret != skf::SAR_OK) {
+        return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_ExportPublicKey"));
+    }
+
+    EvpPKeyGuard key;
+    if (containerType == 2) {
+        key.pkey = createSm2EvpPKey(*reinterpret_cast<const skf::ECCPUBLICKEYBLOB*>(blob.constData()));
+    } else {
+        key.pkey = createRsaEvpPKey(*reinterpret_cast<const skf::RSAPUBLICKEYBLOB*>(blob.constData()));
+    }
+    unsigned char* der = nullptr;
+    int derLen = key.pkey ? i2d_PUBKEY(key.pkey, &der) : 0;
+    if (derLen <= 0 || !der) {
+        return Result<QByteArray>::err(
+            Error(Error::Fail, "公钥编码失败", "SkfPlugin::exportPublicKey"));
+    }
+    QByteArray spki(reinterpret_cast<const char*>(der), derLen);
+    OPENSSL_free(der);
+
+    publicKeyCache_.insert(cacheKey, spki);
+    return Result<QByteArray>::ok(spki);
+}
+
+Result<QByteArray> SkfPlugin::privateDecrypt(const QString& devName, const QString& appName,
+                                              const QString& containerName, const QByteArray& cipherText) {
+    TimedMutexLocker locker(&mutex_);
+
+    // 检查登录状态（私钥运算需要先登录应用）
+    QString loginKey = devName + "/" + appName;
+    if (!loginCache_.contains(loginKey)) {
+        qCWarning(lcSkf) << "[privateDecrypt] 应用未登录, devName:" << devName << "appName:" << appName;
+        return Result<QByteArray>::err(
+            Error(Error::NotLoggedIn, "应用未登录，请先登录", "SkfPlugin::privateDecrypt"));
+    }
+
+    auto appResult = openAppHandle(devName, appName);
+    if (appResult.isErr()) {
+        return Result<QByteArray>::err(appResult.error());
+    }
+    const LoginInfo& cached = loginCache_[loginKey];
+    if (!lib_->VerifyPIN || !lib_->GetContainerType) {
+        closeAppHandle(devName, appName);
+        return Result<QByteArray>::err(
+            Error(Error::PluginLoadFailed, "SKF_VerifyPIN/GetContainerType 函数不可用",
+                  "SkfPlugin::privateDecrypt"));
+    }
+    skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
+    QByteArray pinBytes = cached.pin.toLocal8Bit();
+    skf::ULONG retryCount = 0;
+    skf::ULONG ret = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
+    if (ret != skf::SAR_OK) {
+        qCWarning(lcSkf) << "[privateDecrypt] VerifyPIN 失败, ret:" << QString::number(ret, 16);
+        closeAppHandle(devName, appName);
+        return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_VerifyPIN"));
+    }
+
+    auto containerResult = openContainerHandle(devName, appName, containerName);
+    if (containerResult.isErr()) {
+        return Result<QByteArray>::err(containerResult.error());
+    }
+
+    skf::ULONG containerType = 0;
+    ret = lib_->GetContainerType(containerResult.value(), &containerType);
+    if (ret != skf::SAR_OK) {
+        closeContainerHandle(devName, appName, containerName);
+        return Result<QByteArray>::err(Error::fromSkf(ret, "SKF_GetContainerType"));
+    }
+
+    QByteArray plain;
+    skf::ULONG plainLen = 0;
+    const char* function = nullptr;
+    if (containerType == 2) {
+        function = "SKF_ECCDecrypt";
+        if (!lib_->ECCDecrypt) {
+            closeContainerHandle(devName, appName, containerName);
+            return Result<QByteArray>::err(
+                Error(Error::SkfNotSupported, "SKF 库未提供 SKF_ECCDecrypt", "SkfPlugin::privateDecrypt"));
+        }
+        auto blobResult = sm2CipherToBlob(cipherText);
+        if (blobResult.isErr()) {
+            closeContainerHandle(devName, appName, containerName);
+            return blobResult;
+        }
+        QByteArray blob = blobResult.value();
+        auto* cipher = reinterpret_cast<skf::ECCCIPHERBLOB*>(blob.data());
+        // SM2 明文与 C2 等长
+        plain.resize(static_cast<int>(cipher->cipherLen));
+        plainLen = cipher->cipherLen;
+        ret = lib_->ECCDecrypt(containerResult.value(), cipher, reinterpret_cast<skf::BYTE*>(plain.data()),
+                               &plainLen);
+    } else if (containerType == 1) {
+        function = "SKF_RSADecrypt";
+        if (!lib_->RSADecrypt) {
+            closeContainerHandle(devName, appName, containerName);
+            return Result<QByteArray>::err(
+                Error(Error::SkfNotSupported, "SKF 库未提供 SKF_RSADecrypt", "SkfPlugin::privateDecrypt"));
+        }
+        QByteArray in = cipherText;
+        plain.resize(in.size());
+        plainLen = static_cast<skf::ULONG>(plain.size());
+        ret = lib_->RSADecrypt(containerResult.value(), reinterpret_cast<skf::BYTE*>(in.data()),
+                               static_cast<skf::ULONG>(in.size()), reinterpret_cast<skf::BYTE*>(plain.data()),
+                               &plainLen);
+    } else {
+        closeContainerHandle(devName, appName, containerName);
+        return Result<QByteArray>::err(
+            Error(Error::NotFound, "容器中没有密钥对", "SkfPlugin::privateDecrypt"));
+    }
+    closeContainerHandle(devName, appName, containerName);
+
+    if (ret != skf::SAR_OK) {
+        qCWarning(lcSkf) << "[privateDecrypt]" << function << "失败, ret:" << QString::number(ret, 16);
+        return Result<QByteArray>::err(Error::fromSkf(ret, function));
+    }
+    plain.resize(static_cast<int>(plainLen));
+    return Result<QByteArray>::ok(plain);
+}
+
 //=== 文件操作 ===
 
 Result<QStringList> SkfPlugin::enumFiles(const QString& devName, const QString& appName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -2444,7 +2815,7 @@ Result<QStringList> SkfPlugin::enumFiles(const QString& devName, const QString&
 }
 
 Result<QByteArray> SkfPlugin::readFile(const QString& devName, const QString& appName, const QString& fileName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -2478,16 +2849,16 @@ Result<QByteArray> SkfPlugin::readFile(const QString& devName, const QString& ap
 
 Result<void> SkfPlugin::writeFile(const QString& devName, const QString& appName, const QString& fileName,
                                    const QByteArray& data, int readRights, int writeRights) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
-    qDebug() << "[writeFile] devName:" << devName << "appName:" << appName
+    qCDebug(lcSkf) << "[writeFile] devName:" << devName << "appName:" << appName
              << "fileName:" << fileName << "dataSize:" << data.size()
              << "readRights:" << Qt::hex << readRights << "writeRights:" << Qt::hex << writeRights;
 
     // 检查登录状态（写文件需要先登录应用验证 PIN）
     QString loginKey = devName + "/" + appName;
     if (!loginCache_.contains(loginKey)) {
-        qWarning() << "[writeFile] 应用未登录, devName:" << devName << "appName:" << appName;
+        qCWarning(lcSkf) << "[writeFile] 应用未登录, devName:" << devName << "appName:" << appName;
         return Result<void>::err(
             Error(Error::NotLoggedIn, "应用未登录，请先登录应用", "SkfPlugin::writeFile"));
     }
@@ -2503,14 +2874,14 @@ Result<void> SkfPlugin::writeFile(const QString& devName, const QString& appName
         skf::ULONG pinType = (cached.role.toLower() == "admin") ? 0 : 1;
         QByteArray pinBytes = cached.pin.toLocal8Bit();
         skf::ULONG retryCount = 0;
-        skf::ULONG verifyRet = lib_->VerifyPIN(appResult.value(), pinType, pinBytes.constData(), &retryCount);
+        skf::ULONG verifyRet = verifyCachedPin(devName, appName, appResult.value(), pinType, pinBytes, &retryCount);
         if (verifyRet != skf::SAR_OK) {
             closeAppHandle(devName, appName);
-            qWarning() << "[writeFile] VerifyPIN 失败, ret:" << Qt::hex << verifyRet
+            qCWarning(lcSkf) << "[writeFile] VerifyPIN 失败, ret:" << Qt::hex << verifyRet
                        << "retryCount:" << retryCount;
             return Result<void>::err(Error::fromSkf(verifyRet, "SKF_VerifyPIN"));
         }
-        qDebug() << "[writeFile] VerifyPIN 成功, role:" << cached.role;
+        qCDebug(lcSkf) << "[writeFile] VerifyPIN 成功, role:" << cached.role;
     }
 
     if (!lib_->WriteFile) {
@@ -2533,16 +2904,16 @@ Result<void> SkfPlugin::writeFile(const QString& devName, const QString& appName
             static_cast<skf::ULONG>(readRights),
             static_cast<skf::ULONG>(writeRights));
         if (createRet == skf::SAR_OK) {
-            qDebug() << "[writeFile] SKF_CreateFile 成功, fileName:" << fileName;
+            qCDebug(lcSkf) << "[writeFile] SKF_CreateFile 成功, fileName:" << fileName;
         } else if (createRet == skf::SAR_FILE_ALREADY_EXIST) {
-            qDebug() << "[writeFile] 文件已存在，直接覆盖写入, fileName:" << fileName;
+            qCDebug(lcSkf) << "[writeFile] 文件已存在，直接覆盖写入, fileName:" << fileName;
         } else {
             closeAppHandle(devName, appName);
-            qWarning() << "[writeFile] SKF_CreateFile 失败, ret:" << Qt::hex << createRet;
+            qCWarning(lcSkf) << "[writeFile] SKF_CreateFile 失败, ret:" << Qt::hex << createRet;
             return Result<void>::err(Error::fromSkf(createRet, "SKF_CreateFile"));
         }
     } else {
-        qWarning() << "[writeFile] SKF_CreateFile 不可用，直接尝试写入";
+        qCWarning(lcSkf) << "[writeFile] SKF_CreateFile 不可用，直接尝试写入";
     }
 
     // 写入数据
@@ -2553,16 +2924,16 @@ Result<void> SkfPlugin::writeFile(const QString& devName, const QString& appName
     closeAppHandle(devName, appName);
 
     if (ret != skf::SAR_OK) {
-        qWarning() << "[writeFile] SKF_WriteFile 失败, ret:" << Qt::hex << ret;
+        qCWarning(lcSkf) << "[writeFile] SKF_WriteFile 失败, ret:" << Qt::hex << ret;
         return Result<void>::err(Error::fromSkf(ret, "SKF_WriteFile"));
     }
 
-    qDebug() << "[writeFile] 写入成功, fileName:" << fileName;
+    qCDebug(lcSkf) << "[writeFile] 写入成功, fileName:" << fileName;
     return Result<void>::ok();
 }
 
 Result<void> SkfPlugin::deleteFile(const QString& devName, const QString& appName, const QString& fileName) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto appResult = openAppHandle(devName, appName);
     if (appResult.isErr()) {
@@ -2589,7 +2960,7 @@ Result<void> SkfPlugin::deleteFile(const QString& devName, const QString& appNam
 //=== 其他 ===
 
 Result<QByteArray> SkfPlugin::generateRandom(const QString& devName, int count) {
-    QMutexLocker locker(&mutex_);
+    TimedMutexLocker locker(&mutex_);
 
     auto devResult = openDevice(devName);
     if (devResult.isErr()) {
@@ -2614,6 +2985,272 @@ Result<QByteArray> SkfPlugin::generateRandom(const QString& devName, int count)
     return Result<QByteArray>::ok(buffer);
 }
 
+//=== 批量执行 ===
+
+namespace {
+
+/// 支持的操作及其必填参数
+const QHash<QString, QStringList>& operationParams() {
+    static const QHash<QString, QStringList> table = {
+        {"enumApps", {}},
+        {"openApp", {"appName", "role", "pin"}},
+        {"closeApp", {"appName"}},
+        {"getRetryCount", {"appName", "role", "pin"}},
+        {"enumContainers", {"appName"}},
+        {"createContainer", {"appName", "containerName"}},
+        {"deleteContainer", {"appName", "containerName"}},
+        {"generateKeyPair", {"appName", "containerName", "keyType"}},
+        {"generateCsr", {"appName", "containerName"}},
+        {"importCert", {"appName", "containerName", "certData"}},
+        {"importKeyCert", {"appName", "containerName", "sigCert"}},
+        {"exportCert", {"appName", "containerName"}},
+        {"sign", {"appName", "containerName", "data"}},
+        {"verify", {"appName", "containerName", "data", "signature"}},
+        {"enumFiles", {"appName"}},
+        {"readFile", {"appName", "fileName"}},
+        {"writeFile", {"appName", "fileName", "data"}},
+        {"deleteFile", {"appName", "fileName"}},
+        {"generateRandom", {"count"}},
+    };
+    return table;
+}
+
+/// 参数值为 "${id}" 时返回引用的步骤标识，否则返回空
+QString referencedStep(const QVariant& value) {
+    if (value.typeId() != QMetaType::QString) {
+        return {};
+    }
+    const QString text = value.toString();
+    if (text.size() > 3 && text.startsWith("${") && text.endsWith('}')) {
+        return text.mid(2, text.size() - 3);
+    }
+    return {};
+}
+
+/// 二进制参数：QByteArray 原样使用，字符串按 Base64 解码
+QByteArray bytesParam(const QVariantMap& params, const QString& key) {
+    const QVariant value = params.value(key);
+    if (value.typeId() == QMetaType::QByteArray) {
+        return value.toByteArray();
+    }
+    return QByteArray::fromBase64(value.toString().toLatin1());
+}
+
+template <typename T>
+Result<QVariant> toOutput(const Result<T>& result) {
+    if (result.isErr()) {
+        return Result<QVariant>::err(result.error());
+    }
+    return Result<QVariant>::ok(QVariant::fromValue(result.value()));
+}
+
+Result<QVariant> toOutput(const Result<void>& result) {
+    if (result.isErr()) {
+        return Result<QVariant>::err(result.error());
+    }
+    return Result<QVariant>::ok(QVariant());
+}
+
+}  // namespace
+
+Result<QList<OperationResult>> SkfPlugin::execute(const QString& devName, const OperationList& operations) {
+    // 先校验整个列表，拼写或引用错误不应在执行到一半时才发现
+    if (operations.isEmpty()) {
+        return Result<QList<OperationResult>>::err(
+            Error(Error::InvalidParam, "操作列表为空", "SkfPlugin::execute"));
+    }
+    QHash<QString, int> stepIndex;
+    for (int i = 0; i < operations.size(); ++i) {
+        const auto& operation = operations[i];
+        auto spec = operationParams().constFind(operation.op);
+        if (spec == operationParams().constEnd()) {
+            return Result<QList<OperationResult>>::err(
+                Error(Error::InvalidParam, QString("第 %1 步：不支持的操作 %2").arg(i + 1).arg(operation.op),
+                      "SkfPlugin::execute"));
+        }
+        for (const auto& key : *spec) {
+            if (!operation.params.contains(key)) {
+                return Result<QList<OperationResult>>::err(
+                    Error(Error::InvalidParam,
+                          QString("第 %1 步（%2）：缺少参数 %3").arg(i + 1).arg(operation.op, key),
+                          "SkfPlugin::execute"));
+            }
+        }
+        for (auto it = operation.params.constBegin(); it != operation.params.constEnd(); ++it) {
+            const QString ref = referencedStep(it.value());
+            if (!ref.isEmpty() && !stepIndex.contains(ref)) {
+                return Result<QList<OperationResult>>::err(
+                    Error(Error::InvalidParam,
+                          QString("第 %1 步：引用了不存在或靠后的步骤 %2").arg(i + 1).arg(ref),
+                          "SkfPlugin::execute"));
+            }
+        }
+        if (!operation.id.isEmpty()) {
+            if (stepIndex.contains(operation.id)) {
+                return Result<QList<OperationResult>>::err(
+                    Error(Error::InvalidParam, QString("步骤标识重复：%1").arg(operation.id),
+                          "SkfPlugin::execute"));
+            }
+            stepIndex.insert(operation.id, i);
+        }
+    }
+
+    // 外层持锁贯穿整个列表，各步骤的公开方法重入同一把锁
+    TimedMutexLocker locker(&mutex_, false);
+    session_ = Session();
+    session_.active = true;
+
+    QList<OperationResult> results;
+    results.reserve(operations.size());
+    bool stopped = false;
+    for (const auto& operation : operations) {
+        OperationResult result;
+        result.id = operation.id;
+        result.op = operation.op;
+        if (stopped) {
+            result.status = OperationResult::Status::Skipped;
+            results.append(result);
+            continue;
+        }
+
+        // 替换对前序步骤输出的引用
+        QVariantMap params = operation.params;
+        Result<QVariant> outcome = Result<QVariant>::ok(QVariant());
+        bool resolved = true;
+        for (auto it = params.begin(); it != params.end(); ++it) {
+            const QString ref = referencedStep(it.value());
+            if (ref.isEmpty()) {
+                continue;
+            }
+            const auto& source = results[stepIndex.value(ref)];
+            if (source.status != OperationResult::Status::Succeeded) {
+                outcome = Result<QVariant>::err(
+                    Error(Error::InvalidParam, QString("引用的步骤 %1 未成功执行").arg(ref), "SkfPlugin::execute"));
+                resolved = false;
+                break;
+            }
+            it.value() = source.output;
+        }
+        if (resolved) {
+            outcome = runOperation(devName, operation.op, params);
+        }
+
+        if (outcome.isOk()) {
+            result.status = OperationResult::Status::Succeeded;
+            result.output = outcome.value();
+        } else {
+            result.status = OperationResult::Status::Failed;
+            result.error = outcome.error();
+            qCWarning(lcSkf) << "[execute]" << operation.op << "失败:" << outcome.error().message();
+            if (!operation.continueOnError) {
+                stopped = true;
+            }
+        }
+        results.append(result);
+    }
+
+    // 结束会话，关闭期间推迟的应用句柄（已登录的应用仍按常规保留）
+    const auto deferredApps = session_.deferredApps;
+    session_ = Session();
+    for (const auto& app : deferredApps) {
+        closeAppHandle(app.first, app.second);
+    }
+
+    return Result<QList<OperationResult>>::ok(results);
+}
+
+Result<QVariant> SkfPlugin::runOperation(const QString& devName, const QString& op, const QVariantMap& params) {
+    const QString appName = params.value("appName").toString();
+    const QString containerName = params.value("containerName").toString();
+
+    if (op == "enumApps") {
+        auto result = enumApps(devName);
+        if (result.isErr()) {
+            return Result<QVariant>::err(result.error());
+        }
+        QStringList names;
+        for (const auto& app : result.value()) {
+            names.append(app.appName);
+        }
+        return Result<QVariant>::ok(names);
+    }
+    if (op == "openApp") {
+        return toOutput(openApp(devName, appName, params.value("role").toString(), params.value("pin").toString()));
+    }
+    if (op == "closeApp") {
+        return toOutput(closeApp(devName, appName));
+    }
+    if (op == "getRetryCount") {
+        return toOutput(getRetryCount(devName, appName, params.value("role").toString(),
+                                      params.value("pin").toString()));
+    }
+    if (op == "enumContainers") {
+        auto result = enumContainers(devName, appName);
+        if (result.isErr()) {
+            return Result<QVariant>::err(result.error());
+        }
+        QStringList names;
+        for (const auto& container : result.value()) {
+            names.append(container.containerName);
+        }
+        return Result<QVariant>::ok(names);
+    }
+    if (op == "createContainer") {
+        return toOutput(createContainer(devName, appName, containerName));
+    }
+    if (op == "deleteContainer") {
+        return toOutput(deleteContainer(devName, appName, containerName));
+    }
+    if (op == "generateKeyPair") {
+        return toOutput(generateKeyPair(devName, appName, containerName, params.value("keyType").toString()));
+    }
+    if (op == "generateCsr") {
+        // 其余参数（keyType、keySize、cname、renewKey 等）原样作为 CSR 参数
+        QVariantMap args = params;
+        args.remove("appName");
+        args.remove("containerName");
+        return toOutput(generateCsr(devName, appName, containerName, args));
+    }
+    if (op == "importCert") {
+        return toOutput(importCert(devName, appName, containerName, bytesParam(params, "certData"),
+                                   params.value("isSignCert", true).toBool()));
+    }
+    if (op == "importKeyCert") {
+        return toOutput(importKeyCert(devName, appName, containerName, bytesParam(params, "sigCert"),
+                                      bytesParam(params, "encCert"), bytesParam(params, "encPrivate"),
+                                      params.value("nonGM", false).toBool()));
+    }
+    if (op == "exportCert") {
+        return toOutput(exportCert(devName, appName, containerName, params.value("isSignCert", true).toBool()));
+    }
+    if (op == "sign") {
+        return toOutput(sign(devName, appName, containerName, bytesParam(params, "data")));
+    }
+    if (op == "verify") {
+        return toOutput(verify(devName, appName, containerName, bytesParam(params, "data"),
+                               bytesParam(params, "signature")));
+    }
+    if (op == "enumFiles") {
+        return toOutput(enumFiles(devName, appName));
+    }
+    if (op == "readFile") {
+        return toOutput(readFile(devName, appName, params.value("fileName").toString()));
+    }
+    if (op == "writeFile") {
+        return toOutput(writeFile(devName, appName, params.value("fileName").toString(), bytesParam(params, "data"),
+                                  params.value("readRights", 0xFF).toInt(), params.value("writeRights", 0x01).toInt()));
+    }
+    if (op == "deleteFile") {
+        return toOutput(deleteFile(devName, appName, params.value("fileName").toString()));
+    }
+    if (op == "generateRandom") {
+        return toOutput(generateRandom(devName, params.value("count").toInt()));
+    }
+
+    return Result<QVariant>::err(
+        Error(Error::InvalidParam, QString("不支持的操作：%1").arg(op), "SkfPlugin::runOperation"));
+}
+
 //=== 证书解析辅助方法 ===
 
 /**
@@ -2655,7 +3292,7 @@ Result<SkfPlugin::ParsedCertInfo> SkfPlugin::parseDerCertificate(const QByteArra
     const unsigned char* p = reinterpret_cast<const unsigned char*>(certData.constData());
     X509* x509 = d2i_X509(nullptr, &p, certData.size());
     if (!x509) {
-        qWarning() << "[parseDerCertificate] d2i_X509 failed:" << ERR_error_string(ERR_get_error(), nullptr);
+        qCWarning(lcSkf) << "[parseDerCertificate] d2i_X509 failed:" << ERR_error_string(ERR_get_error(), nullptr);
         return Result<ParsedCertInfo>::err(
             Error(Error::InvalidParam, "X.509 证书解析失败", "parseDerCertificate"));
     }
@@ -2706,7 +3343,7 @@ Result<SkfPlugin::ParsedCertInfo> SkfPlugin::parseDerCertificate(const QByteArra
 
     X509_free(x509);
 
-    qDebug() << "[parseDerCertificate] subject:" << info.subjectDn
+    qCDebug(lcSkf) << "[parseDerCertificate] subject:" << info.subjectDn
              << "CN:" << info.commonName
              << "issuer:" << info.issuerDn
              << "serial:" << info.serialNumber
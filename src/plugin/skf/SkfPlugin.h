@@ -10,10 +10,12 @@
 #include <QMap>
 #include <QMutex>
 #include <QObject>
+#include <QPair>
 #include <QSet>
 #include <QString>
 #include <memory>
 
+#include "DeviceExecutor.h"
 #include "SkfLibrary.h"
 #include "common/Result.h"
 #include "plugin/interface/IDriverPlugin.h"
@@ -74,12 +76,21 @@ public:
 
     //=== IDriverPlugin 接口实现 ===
 
+    /**
+     * @brief 投递到设备执行器
+     *
+     * 同一设备的调用串行、按提交顺序执行；SKF 调用本身仍由 mutex_ 全局串行，
+     * 执行器只负责让调用方不必占用线程等待。
+     */
+    void post(const QString& devName, std::function<void()> task) override;
+
     //--- 设备管理 (4 个方法) ---
 
     Result<QList<DeviceInfo>> enumDevices(bool login = false) override;
     Result<void> changeDeviceAuth(const QString& devName, const QString& oldPin, const QString& newPin) override;
     Result<void> setDeviceLabel(const QString& devName, const QString& label) override;
     Result<int> waitForDeviceEvent() override;
+    Result<void> cancelWaitForDeviceEvent() override;
 
     //--- 应用管理 (8 个方法) ---
 
@@ -130,6 +141,13 @@ public:
     Result<bool> verify(const QString& devName, const QString& appName, const QString& containerName,
                         const QByteArray& data, const QByteArray& signature) override;
 
+    //--- 非对称加解密 (2 个方法) ---
+
+    Result<QByteArray> exportPublicKey(const QString& devName, const QString& appName, const QString& containerName,
+                                       bool isSignKey) override;
+    Result<QByteArray> privateDecrypt(const QString& devName, const QString& appName, const QString& containerName,
+                                      const QByteArray& cipherText) override;
+
     //--- 文件操作 (4 个方法) ---
 
     Result<QStringList> enumFiles(const QString& devName, const QString& appName) override;
@@ -142,6 +160,10 @@ public:
 
     Result<QByteArray> generateRandom(const QString& devName, int count) override;
 
+    //--- 批量执行 ---
+
+    Result<QList<OperationResult>> execute(const QString& devName, const OperationList& operations) override;
+
 private:
     /**
      * @brief 打开设备
@@ -197,6 +219,28 @@ private:
      */
     void closeContainerHandle(const QString& devName, const QString& appName, const QString& containerName);
 
+    /**
+     * @brief 用缓存的凭据验证 PIN
+     *
+     * 批量执行会话中同一应用、同一角色只在第一次调用时真正执行 SKF_VerifyPIN
+     * （会话期间应用句柄不关闭，认证状态保持）。
+     * @return SKF 返回码
+     */
+    skf::ULONG verifyCachedPin(const QString& devName, const QString& appName, skf::HAPPLICATION appHandle,
+                               skf::ULONG pinType, const QByteArray& pin, skf::ULONG* retryCount);
+
+    /**
+     * @brief 清除公钥缓存
+     *
+     * 只给 devName 时清除整台设备，给 appName 时清除整个应用，三者都给时只清除该容器。
+     */
+    void forgetPublicKeys(const QString& devName, const QString& appName = {}, const QString& containerName = {});
+
+    /**
+     * @brief 执行批量操作中的一步（已持锁，引用已替换）
+     */
+    Result<QVariant> runOperation(const QString& devName, const QString& op, const QVariantMap& params);
+
     /**
      * @brief 生成句柄键
      * @param dev 设备名称
@@ -237,7 +281,21 @@ private:
     QMap<QString, HandleInfo> handles_;  ///< 句柄映射表
     QMap<QString, LoginInfo> loginCache_;  ///< 登录凭据缓存，key = "devName/appName"
     QMap<QString, DeviceInfo> devInfoCache_;  ///< 设备信息缓存，key = deviceName
-    mutable QMutex mutex_;  ///< 线程安全互斥锁
+    QMap<QString, QByteArray> publicKeyCache_;  ///< 公钥（SPKI DER）缓存，key = "devName/appName/containerName#sign|enc"
+    /**
+     * @brief 批量执行会话状态（仅在 execute() 持锁期间有效）
+     */
+    struct Session {
+        bool active = false;
+        QSet<QString> verified;                    ///< 已验证 PIN 的 "devName/appName#pinType"
+        QList<QPair<QString, QString>> deferredApps;  ///< 推迟到会话结束再关闭的应用句柄
+    };
+
+    Session session_;
+    /// 线程安全互斥锁（批量执行时外层持锁，各步骤重入）。所有设备共用一把锁：厂商 SKF 库普遍不可重入，
+    /// 因此不同设备的调用（包括 ProvisionService 的多个工作任务）也是串行的
+    mutable QRecursiveMutex mutex_;
+    DeviceExecutor executor_;  ///< 异步调用的按设备执行器
 };
 
 }  // namespace wekey